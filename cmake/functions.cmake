@@ -1,9 +1,37 @@
 # ——— Helper function to add & register tests —————————————————————————
 include_guard()
 
+# Precompiles the headers every test translation unit includes (PPC_USE_PCH); WITH_BENCHMARK adds Google
+# Benchmark for targets that link it through ppc_link_benchmark(). The first target of a directory builds each
+# variant and later ones reuse it, so the per-task executables share the PCH of the integrated runners. A PCH is not
+# shared across directories, which differ in their compile definitions
+function(ppc_precompile_test_headers target_name)
+  if(NOT PPC_USE_PCH)
+    return()
+  endif()
+  cmake_parse_arguments(PCH "WITH_BENCHMARK" "" "" ${ARGN})
+  set(owner_property PPC_PCH_OWNER)
+  if(PCH_WITH_BENCHMARK)
+    string(APPEND owner_property _BENCHMARK)
+  endif()
+  get_directory_property(owner ${owner_property})
+  if(owner)
+    target_precompile_headers(${target_name} REUSE_FROM ${owner})
+    return()
+  endif()
+  set_directory_properties(PROPERTIES ${owner_property} ${target_name})
+  target_precompile_headers(
+    ${target_name} PRIVATE <gtest/gtest.h> <nlohmann/json.hpp>
+    "${CMAKE_SOURCE_DIR}/modules/task/include/task.hpp")
+  if(PCH_WITH_BENCHMARK)
+    target_precompile_headers(${target_name} PRIVATE <benchmark/benchmark.h>)
+  endif()
+endfunction()
+
 function(ppc_add_test test_name test_src USE_FLAG)
   if(${USE_FLAG})
     add_executable(${test_name} "${PROJECT_SOURCE_DIR}/${test_src}")
+    target_link_libraries(${test_name} PUBLIC core_module_lib)
     enable_testing()
     add_test(NAME ${test_name} COMMAND ${test_name})
     install(TARGETS ${test_name} RUNTIME DESTINATION bin)
@@ -57,12 +85,50 @@ function(setup_implementation)
   # link core module
   target_link_libraries(${LIB_NAME} PUBLIC core_module_lib)
 
+  # OpenMP target regions need the device toolchain both when compiling the
+  # implementation and when linking the test executables
+  if(SETUP_NAME STREQUAL "offload" AND PPC_OFFLOAD_FLAGS)
+    separate_arguments(OFFLOAD_FLAGS NATIVE_COMMAND "${PPC_OFFLOAD_FLAGS}")
+    if(CPP_SOURCES)
+      target_compile_options(${LIB_NAME} PRIVATE ${OFFLOAD_FLAGS})
+      target_link_options(${LIB_NAME} PUBLIC ${OFFLOAD_FLAGS})
+    else()
+      target_compile_options(${LIB_NAME} INTERFACE ${OFFLOAD_FLAGS})
+      target_link_options(${LIB_NAME} INTERFACE ${OFFLOAD_FLAGS})
+    endif()
+  endif()
+
   # and link into each enabled test executable
   foreach(test_exec ${SETUP_TESTS})
     target_link_libraries(${test_exec} PUBLIC ${LIB_NAME})
   endforeach()
 endfunction()
 
+# Creates <task>_func_tests / <task>_perf_tests for PPC_PER_TASK_TESTS; they get the task's test sources and
+# implementation libraries through add_tests() and setup_implementation() like the integrated runners
+function(ppc_add_task_test_executables TASK)
+  if(NOT PPC_PER_TASK_TESTS)
+    return()
+  endif()
+  ppc_add_test(${TASK}_func_tests common/runners/functional.cpp USE_FUNC_TESTS)
+  ppc_add_test(${TASK}_perf_tests common/runners/performance.cpp USE_PERF_TESTS)
+  if(USE_FUNC_TESTS)
+    ppc_precompile_test_headers(${TASK}_func_tests)
+  endif()
+  if(USE_PERF_TESTS)
+    ppc_link_benchmark(${TASK}_perf_tests)
+    ppc_precompile_test_headers(${TASK}_perf_tests WITH_BENCHMARK)
+  endif()
+endfunction()
+
+# Adds the tests/<subdir> sources of the current task to its own executables as well
+macro(ppc_add_task_tests TASK)
+  if(PPC_PER_TASK_TESTS)
+    add_tests(USE_FUNC_TESTS ${TASK}_func_tests functional)
+    add_tests(USE_PERF_TESTS ${TASK}_perf_tests performance)
+  endif()
+endmacro()
+
 # Function to configure each subproject
 function(ppc_configure_subproject SUBDIR)
   # Module-specific compile-time definitions
@@ -81,6 +147,8 @@ function(ppc_configure_subproject SUBDIR)
   # Register functional and performance test runners
   add_tests(USE_FUNC_TESTS ${FUNC_TEST_EXEC} functional)
   add_tests(USE_PERF_TESTS ${PERF_TEST_EXEC} performance)
+  ppc_add_task_test_executables(${SUBDIR})
+  ppc_add_task_tests(${SUBDIR})
 
   message(STATUS "${SUBDIR}")
 
@@ -104,6 +172,8 @@ function(ppc_configure_meta_part PROJ_NAME BASE_DIR)
 
   add_tests(USE_FUNC_TESTS ${FUNC_TEST_EXEC} functional)
   add_tests(USE_PERF_TESTS ${PERF_TEST_EXEC} performance)
+  # PPC_META_TASK is set by ppc_configure_meta_project
+  ppc_add_task_tests(${PPC_META_TASK})
 
   message(STATUS "  -- ${PROJ_NAME}")
 
@@ -127,6 +197,8 @@ function(ppc_configure_meta_project SUBDIR)
 
   project(${SUBDIR})
   message(STATUS "${SUBDIR}")
+  set(PPC_META_TASK ${SUBDIR})
+  ppc_add_task_test_executables(${SUBDIR})
 
   if(EXISTS "${CMAKE_CURRENT_SOURCE_DIR}/${SUBDIR}/threads")
     ppc_configure_meta_part(${SUBDIR}_threads
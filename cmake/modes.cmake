@@ -27,3 +27,23 @@ if(USE_PERF_TESTS)
   message(STATUS "Enable performance tests")
   add_compile_definitions(USE_PERF_TESTS)
 endif(USE_PERF_TESTS)
+
+option(PPC_PER_TASK_TESTS
+       "Also build <task>_func_tests and <task>_perf_tests for every task" OFF)
+
+option(PPC_USE_PCH
+       "Precompile gtest, benchmark, nlohmann/json and task.hpp for test targets"
+       OFF)
+
+option(USE_ALLOCATION_COUNTER
+       "Count heap allocations in core_module_lib for performance tests" OFF)
+
+option(USE_MPI_PROFILER
+       "Intercept MPI calls through PMPI and report them in performance tests"
+       OFF)
+
+# Empty runs the target regions of offload implementations on the host
+set(PPC_OFFLOAD_FLAGS
+    ""
+    CACHE STRING
+          "Compile and link flags for offload implementations, e.g. -foffload=nvptx-none")
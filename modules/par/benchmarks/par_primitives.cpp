@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "par/include/par.hpp"
+#include "task/include/task.hpp"
+
+// Throughput of the ppc::par primitives per threading backend, with PPC_NUM_THREADS threads.
+
+namespace {
+
+using ppc::task::TypeOfTask;
+
+std::vector<int64_t> MakeValues(std::size_t size) {
+  std::vector<int64_t> values(size);
+  for (std::size_t i = 0; i < size; i++) {
+    values[i] = static_cast<int64_t>((i * 2654435761U) % 100'003);
+  }
+  return values;
+}
+
+template <TypeOfTask Backend>
+void ParReduce(benchmark::State &state) {
+  const auto values = MakeValues(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ppc::par::Reduce<Backend>(std::span<const int64_t>(values)));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <TypeOfTask Backend>
+void ParInclusiveScan(benchmark::State &state) {
+  const auto values = MakeValues(static_cast<std::size_t>(state.range(0)));
+  std::vector<int64_t> out(values.size());
+  for (auto _ : state) {
+    ppc::par::InclusiveScan<Backend>(std::span<const int64_t>(values), std::span<int64_t>(out));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <TypeOfTask Backend>
+void ParSort(benchmark::State &state) {
+  const auto values = MakeValues(static_cast<std::size_t>(state.range(0)));
+  std::vector<int64_t> data;
+  for (auto _ : state) {
+    state.PauseTiming();
+    data = values;
+    state.ResumeTiming();
+    ppc::par::Sort<Backend>(std::span<int64_t>(data));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <TypeOfTask Backend>
+void ParHistogram(benchmark::State &state) {
+  const auto values = MakeValues(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        ppc::par::Histogram<Backend>(std::span<const int64_t>(values), 256, [](int64_t value) { return value & 255; }));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+constexpr int64_t kMinSize = int64_t{1} << 12;
+constexpr int64_t kMaxSize = int64_t{1} << 22;
+
+#define PPC_PAR_BENCHMARK(primitive)                                                                \
+  BENCHMARK_TEMPLATE(primitive, TypeOfTask::kSEQ)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);   \
+  BENCHMARK_TEMPLATE(primitive, TypeOfTask::kOMP)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);   \
+  BENCHMARK_TEMPLATE(primitive, TypeOfTask::kTBB)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);   \
+  BENCHMARK_TEMPLATE(primitive, TypeOfTask::kSTL)->RangeMultiplier(8)->Range(kMinSize, kMaxSize)
+
+PPC_PAR_BENCHMARK(ParReduce);
+PPC_PAR_BENCHMARK(ParInclusiveScan);
+PPC_PAR_BENCHMARK(ParSort);
+PPC_PAR_BENCHMARK(ParHistogram);
+
+}  // namespace
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <mpi.h>
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "task/include/task.hpp"
+#include "util/include/decomposition.hpp"
+#include "util/include/per_thread.hpp"
+#include "util/include/schedule.hpp"
+#include "util/include/thread_pool.hpp"
+#include "util/include/util.hpp"
+
+namespace ppc::par {
+
+using ppc::task::TypeOfTask;
+
+namespace detail {
+
+/// Smallest block handed to one thread; shorter inputs use fewer threads.
+inline constexpr std::size_t kMinBlockSize = 2048;
+
+/// Per-block partial result on its own cache line, so neighbouring threads never write to a shared line.
+template <typename T>
+using BlockSlot = ppc::util::Padded<std::optional<T>>;
+
+template <TypeOfTask Backend>
+constexpr bool kUsesThreads = Backend != TypeOfTask::kSEQ && Backend != TypeOfTask::kMPI;
+
+template <TypeOfTask Backend>
+constexpr bool kUsesRanks = Backend == TypeOfTask::kMPI || Backend == TypeOfTask::kALL;
+
+/// Number of blocks @p size elements are split into for @p Backend.
+template <TypeOfTask Backend>
+int NumBlocks(std::size_t size) {
+  if constexpr (!kUsesThreads<Backend>) {
+    return 1;
+  } else {
+    const std::size_t by_size = std::max<std::size_t>((size + kMinBlockSize - 1) / kMinBlockSize, 1);
+    return static_cast<int>(std::min<std::size_t>(by_size, std::max(ppc::util::GetNumThreads(), 1)));
+  }
+}
+
+/// Elements of block @p block out of @p blocks.
+inline std::pair<std::size_t, std::size_t> BlockBounds(std::size_t size, int blocks, int block) {
+  const auto range = ppc::util::BlockPartition(static_cast<int64_t>(size), blocks, block);
+  return {static_cast<std::size_t>(range.begin), static_cast<std::size_t>(range.End())};
+}
+
+/// Calls @p body(block) for every block in [0, @p blocks) with the threading technology of @p Backend and the
+/// PPC_SCHEDULE policy. kALL threads with OpenMP, whose team size the hybrid topology already fits to the rank's
+/// share of the node. OpenMP keeps schedule(static) unless PPC_SCHEDULE names another kind, as there is one block
+/// per thread.
+template <TypeOfTask Backend, typename Body>
+void ForEachBlock(int blocks, const Body &body) {
+  if constexpr (Backend == TypeOfTask::kOMP || Backend == TypeOfTask::kALL) {
+    ppc::util::SchedulePolicy policy = ppc::util::GetSchedulePolicy();
+    if (policy.kind == ppc::util::ScheduleKind::kAuto) {
+      policy.kind = ppc::util::ScheduleKind::kStatic;
+    }
+    ppc::util::OmpParallelFor(0, blocks, body, policy, blocks);
+  } else if constexpr (Backend == TypeOfTask::kTBB) {
+    ppc::util::TbbParallelFor(0, blocks, body);
+  } else if constexpr (Backend == TypeOfTask::kSTL) {
+    ppc::util::GetThreadPool().ParallelFor(0, blocks, [&](int block) { body(block); });
+  } else {
+    for (int block = 0; block < blocks; block++) {
+      body(block);
+    }
+  }
+}
+
+/// Per-rank partial results of MPI_COMM_WORLD in rank order; only the caller's entry without MPI.
+template <typename T>
+std::vector<std::optional<T>> GatherPartials(const std::optional<T> &local) {
+  static_assert(std::is_trivially_copyable_v<T>, "Partials are exchanged between ranks as raw bytes");
+  if (!ppc::util::IsMpiActive()) {
+    return {local};
+  }
+  int size = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  const int has_value = local.has_value() ? 1 : 0;
+  const T value = local.value_or(T{});
+  std::vector<int> flags(static_cast<std::size_t>(size));
+  std::vector<T> values(static_cast<std::size_t>(size));
+  MPI_Allgather(&has_value, 1, MPI_INT, flags.data(), 1, MPI_INT, MPI_COMM_WORLD);
+  MPI_Allgather(&value, sizeof(T), MPI_BYTE, values.data(), sizeof(T), MPI_BYTE, MPI_COMM_WORLD);
+  std::vector<std::optional<T>> partials(values.size());
+  for (std::size_t rank = 0; rank < values.size(); rank++) {
+    if (flags[rank] != 0) {
+      partials[rank] = values[rank];
+    }
+  }
+  return partials;
+}
+
+template <typename T, typename Op>
+void Combine(std::optional<T> &total, const std::optional<T> &partial, const Op &op) {
+  if (partial) {
+    total = total ? op(*total, *partial) : *partial;
+  }
+}
+
+}  // namespace detail
+
+/// @brief Folds @p data with the associative @p op, starting from @p init.
+/// @details Blocks are folded in parallel and their results combined in order, so @p op need not be commutative.
+///          For kMPI and kALL @p data is the rank's share and every rank gets the result over MPI_COMM_WORLD.
+template <TypeOfTask Backend, typename T, typename Op = std::plus<>>
+T Reduce(std::span<const T> data, T init = T{}, Op op = {}) {
+  const int blocks = detail::NumBlocks<Backend>(data.size());
+  std::vector<detail::BlockSlot<T>> partials(static_cast<std::size_t>(blocks));
+  detail::ForEachBlock<Backend>(blocks, [&](int block) {
+    const auto [begin, end] = detail::BlockBounds(data.size(), blocks, block);
+    if (begin == end) {
+      return;
+    }
+    T value = data[begin];
+    for (std::size_t i = begin + 1; i < end; i++) {
+      value = op(value, data[i]);
+    }
+    partials[static_cast<std::size_t>(block)].value = std::move(value);
+  });
+  std::optional<T> local;
+  for (const auto &partial : partials) {
+    detail::Combine(local, partial.value, op);
+  }
+  std::optional<T> total(std::move(init));
+  if constexpr (detail::kUsesRanks<Backend>) {
+    for (const auto &partial : detail::GatherPartials(local)) {
+      detail::Combine(total, partial, op);
+    }
+  } else {
+    detail::Combine(total, local, op);
+  }
+  return *total;
+}
+
+/// @brief Writes the inclusive prefix fold of @p in under @p op to @p out, which may alias @p in.
+/// @details Two passes: blocks are scanned in parallel, then each block is offset by the fold of the blocks before it.
+///          For kMPI and kALL the scan continues across ranks of MPI_COMM_WORLD in rank order.
+template <TypeOfTask Backend, typename T, typename Op = std::plus<>>
+void InclusiveScan(std::span<const T> in, std::span<T> out, Op op = {}) {
+  const int blocks = detail::NumBlocks<Backend>(in.size());
+  std::vector<detail::BlockSlot<T>> totals(static_cast<std::size_t>(blocks));
+  detail::ForEachBlock<Backend>(blocks, [&](int block) {
+    const auto [begin, end] = detail::BlockBounds(in.size(), blocks, block);
+    if (begin == end) {
+      return;
+    }
+    out[begin] = in[begin];
+    for (std::size_t i = begin + 1; i < end; i++) {
+      out[i] = op(out[i - 1], in[i]);
+    }
+    totals[static_cast<std::size_t>(block)].value = out[end - 1];
+  });
+
+  std::optional<T> rank_prefix;
+  if constexpr (detail::kUsesRanks<Backend>) {
+    std::optional<T> local;
+    for (const auto &total : totals) {
+      detail::Combine(local, total.value, op);
+    }
+    const std::vector<std::optional<T>> partials = detail::GatherPartials(local);
+    const int rank = ppc::util::IsMpiActive() ? ppc::util::GetMPIRank() : 0;
+    for (int lower = 0; lower < rank; lower++) {
+      detail::Combine(rank_prefix, partials[static_cast<std::size_t>(lower)], op);
+    }
+  }
+  std::vector<std::optional<T>> prefixes(static_cast<std::size_t>(blocks));
+  std::optional<T> running = rank_prefix;
+  for (std::size_t block = 0; block < prefixes.size(); block++) {
+    prefixes[block] = running;
+    detail::Combine(running, totals[block].value, op);
+  }
+  detail::ForEachBlock<Backend>(blocks, [&](int block) {
+    const std::optional<T> &prefix = prefixes[static_cast<std::size_t>(block)];
+    if (!prefix) {
+      return;
+    }
+    const auto [begin, end] = detail::BlockBounds(in.size(), blocks, block);
+    for (std::size_t i = begin; i < end; i++) {
+      out[i] = op(*prefix, out[i]);
+    }
+  });
+}
+
+/// @brief Sorts @p data by @p comp.
+/// @details kTBB uses tbb::parallel_sort; the other threaded backends sort blocks in parallel and merge neighbouring
+///          runs pairwise. kMPI and kALL sort each rank's data on its own; no elements move between ranks.
+template <TypeOfTask Backend, typename T, typename Compare = std::less<>>
+void Sort(std::span<T> data, Compare comp = {}) {
+  if constexpr (Backend == TypeOfTask::kTBB) {
+    tbb::parallel_sort(data.begin(), data.end(), comp);
+  } else {
+    const int blocks = detail::NumBlocks<Backend>(data.size());
+    detail::ForEachBlock<Backend>(blocks, [&](int block) {
+      const auto [begin, end] = detail::BlockBounds(data.size(), blocks, block);
+      std::sort(data.begin() + static_cast<std::ptrdiff_t>(begin), data.begin() + static_cast<std::ptrdiff_t>(end),
+                comp);
+    });
+    for (int width = 1; width < blocks; width *= 2) {
+      const int merges = (blocks + (2 * width) - 1) / (2 * width);
+      detail::ForEachBlock<Backend>(merges, [&](int merge) {
+        const int first = merge * 2 * width;
+        const int middle = std::min(first + width, blocks);
+        const int last = std::min(first + (2 * width), blocks);
+        if (middle == last) {
+          return;
+        }
+        auto at = [&](int block) {
+          return data.begin() + static_cast<std::ptrdiff_t>(detail::BlockBounds(data.size(), blocks, block).first);
+        };
+        std::inplace_merge(at(first), at(middle), at(last), comp);
+      });
+    }
+  }
+}
+
+/// @brief Stable partition: elements satisfying @p pred move to the front, keeping their relative order.
+/// @return Number of elements that satisfy @p pred.
+/// @details kMPI and kALL partition each rank's data on its own.
+template <TypeOfTask Backend, typename T, typename Pred>
+std::size_t Partition(std::span<T> data, Pred pred) {
+  const int blocks = detail::NumBlocks<Backend>(data.size());
+  std::vector<detail::BlockSlot<std::size_t>> selected(static_cast<std::size_t>(blocks));
+  detail::ForEachBlock<Backend>(blocks, [&](int block) {
+    const auto [begin, end] = detail::BlockBounds(data.size(), blocks, block);
+    selected[static_cast<std::size_t>(block)].value = static_cast<std::size_t>(
+        std::count_if(data.begin() + static_cast<std::ptrdiff_t>(begin),
+                      data.begin() + static_cast<std::ptrdiff_t>(end), [&](const T &value) { return pred(value); }));
+  });
+  std::vector<std::size_t> true_offsets(static_cast<std::size_t>(blocks));
+  std::size_t num_true = 0;
+  for (std::size_t block = 0; block < true_offsets.size(); block++) {
+    true_offsets[block] = num_true;
+    num_true += *selected[block].value;
+  }
+
+  std::vector<T> partitioned(data.size());
+  detail::ForEachBlock<Backend>(blocks, [&](int block) {
+    const auto [begin, end] = detail::BlockBounds(data.size(), blocks, block);
+    std::size_t next_true = true_offsets[static_cast<std::size_t>(block)];
+    std::size_t next_false = num_true + (begin - next_true);
+    for (std::size_t i = begin; i < end; i++) {
+      partitioned[pred(data[i]) ? next_true++ : next_false++] = std::move(data[i]);
+    }
+  });
+  detail::ForEachBlock<Backend>(blocks, [&](int block) {
+    const auto [begin, end] = detail::BlockBounds(data.size(), blocks, block);
+    const auto first = static_cast<std::ptrdiff_t>(begin);
+    const auto last = static_cast<std::ptrdiff_t>(end);
+    std::move(partitioned.begin() + first, partitioned.begin() + last, data.begin() + first);
+  });
+  return num_true;
+}
+
+/// @brief Counts the elements of @p data per bin, where @p bin_of maps an element to its bin.
+/// @details Every block fills a private histogram that is summed at the end. Elements whose bin is not in
+///          [0, @p bins) are not counted. For kMPI and kALL the counts are summed over MPI_COMM_WORLD.
+template <TypeOfTask Backend, typename T, typename BinOf>
+std::vector<int64_t> Histogram(std::span<const T> data, std::size_t bins, BinOf bin_of) {
+  const int blocks = detail::NumBlocks<Backend>(data.size());
+  std::vector<std::vector<int64_t>> partials(static_cast<std::size_t>(blocks));
+  detail::ForEachBlock<Backend>(blocks, [&](int block) {
+    const auto [begin, end] = detail::BlockBounds(data.size(), blocks, block);
+    std::vector<int64_t> counts(bins, 0);
+    for (std::size_t i = begin; i < end; i++) {
+      const auto bin = static_cast<std::size_t>(bin_of(data[i]));
+      if (bin < bins) {
+        counts[bin]++;
+      }
+    }
+    partials[static_cast<std::size_t>(block)] = std::move(counts);
+  });
+  std::vector<int64_t> histogram(bins, 0);
+  for (const auto &counts : partials) {
+    std::ranges::transform(histogram, counts, histogram.begin(), std::plus<>());
+  }
+  if constexpr (detail::kUsesRanks<Backend>) {
+    if (ppc::util::IsMpiActive()) {
+      MPI_Allreduce(MPI_IN_PLACE, histogram.data(), static_cast<int>(bins), MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+    }
+  }
+  return histogram;
+}
+
+}  // namespace ppc::par
@@ -0,0 +1,144 @@
+#include "par/include/par.hpp"
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <libenvpp/detail/environment.hpp>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "task/include/task.hpp"
+#include "util/include/util.hpp"
+
+namespace {
+
+using ppc::task::TypeOfTask;
+
+template <TypeOfTask Backend>
+using BackendTag = std::integral_constant<TypeOfTask, Backend>;
+
+template <typename Tag>
+class ParPrimitives : public ::testing::Test {
+ protected:
+  static constexpr TypeOfTask kBackend = Tag::value;
+  static constexpr std::size_t kSize = 50'003;
+
+  // Enough threads and elements that every threaded backend splits the input into several blocks
+  env::detail::set_scoped_environment_variable threads_{"PPC_NUM_THREADS", "4"};
+
+  static std::vector<int64_t> MakeValues() {
+    std::vector<int64_t> values(kSize);
+    for (std::size_t i = 0; i < values.size(); i++) {
+      values[i] = static_cast<int64_t>((i * 7919) % 1009) - 500;
+    }
+    return values;
+  }
+
+  /// Number of ranks that contribute their data to kMPI and kALL results.
+  static int64_t Contributors() {
+    int size = 1;
+    if ((kBackend == TypeOfTask::kMPI || kBackend == TypeOfTask::kALL) && ppc::util::IsMpiActive()) {
+      MPI_Comm_size(MPI_COMM_WORLD, &size);
+    }
+    return size;
+  }
+};
+
+using Backends = ::testing::Types<BackendTag<TypeOfTask::kSEQ>, BackendTag<TypeOfTask::kOMP>,
+                                  BackendTag<TypeOfTask::kTBB>, BackendTag<TypeOfTask::kSTL>,
+                                  BackendTag<TypeOfTask::kMPI>, BackendTag<TypeOfTask::kALL>>;
+
+class BackendNames {
+ public:
+  template <typename Tag>
+  static std::string GetName(int /*index*/) {
+    return std::string(ppc::task::TypeOfTaskToString(Tag::value));
+  }
+};
+
+TYPED_TEST_SUITE(ParPrimitives, Backends, BackendNames);
+
+}  // namespace
+
+TYPED_TEST(ParPrimitives, ReduceMatchesAccumulate) {
+  const auto values = TestFixture::MakeValues();
+  const int64_t local = std::accumulate(values.begin(), values.end(), int64_t{0});
+  EXPECT_EQ(ppc::par::Reduce<TestFixture::kBackend>(std::span<const int64_t>(values), int64_t{5}),
+            5 + (local * TestFixture::Contributors()));
+  const std::vector<int64_t> empty;
+  EXPECT_EQ(ppc::par::Reduce<TestFixture::kBackend>(std::span<const int64_t>(empty), int64_t{7}), 7);
+}
+
+TYPED_TEST(ParPrimitives, ReduceKeepsOrderOfNonCommutativeOp) {
+  // Composition of affine maps x -> a * x + b is associative but not commutative
+  struct Affine {
+    int64_t a = 1;
+    int64_t b = 0;
+  };
+  std::vector<Affine> maps(TestFixture::kSize);
+  for (std::size_t i = 0; i < maps.size(); i++) {
+    maps[i] = {.a = (i % 3 == 0) ? -1 : 1, .b = static_cast<int64_t>(i % 5)};
+  }
+  auto compose = [](const Affine &lhs, const Affine &rhs) {
+    return Affine{.a = rhs.a * lhs.a, .b = (rhs.a * lhs.b) + rhs.b};
+  };
+  Affine expected;
+  for (int64_t rank = 0; rank < TestFixture::Contributors(); rank++) {
+    for (const auto &map : maps) {
+      expected = compose(expected, map);
+    }
+  }
+  const Affine result = ppc::par::Reduce<TestFixture::kBackend>(std::span<const Affine>(maps), Affine{}, compose);
+  EXPECT_EQ(result.a, expected.a);
+  EXPECT_EQ(result.b, expected.b);
+}
+
+TYPED_TEST(ParPrimitives, InclusiveScanMatchesSequentialScan) {
+  auto values = TestFixture::MakeValues();
+  std::vector<int64_t> expected(values.size());
+  std::inclusive_scan(values.begin(), values.end(), expected.begin());
+  if (TestFixture::Contributors() > 1) {
+    const int64_t offset = expected.back() * ppc::util::GetMPIRank();
+    std::ranges::transform(expected, expected.begin(), [offset](int64_t value) { return value + offset; });
+  }
+  ppc::par::InclusiveScan<TestFixture::kBackend>(std::span<const int64_t>(values), std::span<int64_t>(values));
+  EXPECT_EQ(values, expected);
+}
+
+TYPED_TEST(ParPrimitives, SortMatchesStdSort) {
+  auto values = TestFixture::MakeValues();
+  auto expected = values;
+  std::ranges::sort(expected, std::greater<>());
+  ppc::par::Sort<TestFixture::kBackend>(std::span<int64_t>(values), std::greater<>());
+  EXPECT_EQ(values, expected);
+}
+
+TYPED_TEST(ParPrimitives, PartitionIsStable) {
+  auto values = TestFixture::MakeValues();
+  auto expected = values;
+  auto is_even = [](int64_t value) { return value % 2 == 0; };
+  const auto split = std::ranges::stable_partition(expected, is_even);
+  const std::size_t num_true = ppc::par::Partition<TestFixture::kBackend>(std::span<int64_t>(values), is_even);
+  EXPECT_EQ(num_true, static_cast<std::size_t>(split.begin() - expected.begin()));
+  EXPECT_EQ(values, expected);
+}
+
+TYPED_TEST(ParPrimitives, HistogramCountsEveryBin) {
+  const auto values = TestFixture::MakeValues();
+  constexpr std::size_t kBins = 10;
+  auto bin_of = [](int64_t value) { return (value + 500) / 100; };
+  std::vector<int64_t> expected(kBins, 0);
+  for (const int64_t value : values) {
+    const auto bin = static_cast<std::size_t>(bin_of(value));
+    if (bin < kBins) {
+      expected[bin] += TestFixture::Contributors();
+    }
+  }
+  EXPECT_EQ(ppc::par::Histogram<TestFixture::kBackend>(std::span<const int64_t>(values), kBins, bin_of), expected);
+}
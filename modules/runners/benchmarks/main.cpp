@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+#include <mpi.h>
+
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "oneapi/tbb/global_control.h"
+#include "util/include/thread_pool.hpp"
+#include "util/include/topology.hpp"
+#include "util/include/util.hpp"
+
+// Entry point of ppc_infra_bench, which times the course infrastructure itself rather than student tasks.
+// Every rank runs every benchmark so collective benchmarks stay matched; only rank 0 reports.
+
+namespace {
+
+class NullBenchmarkReporter final : public benchmark::BenchmarkReporter {
+ public:
+  bool ReportContext(const Context & /*context*/) override {
+    return true;
+  }
+
+  void ReportRuns(const std::vector<Run> & /*report*/) override {}
+};
+
+int RunInfraBenchmarks(int argc, char **argv) {
+  ppc::util::ConfigureMpiEnvironment();
+  const int init_res = MPI_Init(&argc, &argv);
+  if (init_res != MPI_SUCCESS) {
+    std::cerr << "[  ERROR  ] MPI_Init failed with code " << init_res << '\n';
+    return init_res;
+  }
+  int status = EXIT_SUCCESS;
+  {
+    const ppc::util::ScopedHybridTopology topology;
+    const int num_threads = ppc::util::GetNumThreads();
+    tbb::global_control control(tbb::global_control::max_allowed_parallelism, num_threads);
+    const ppc::util::ScopedThreadPool thread_pool(num_threads);
+
+    benchmark::Initialize(&argc, argv);
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (rank == 0) {
+      benchmark::AddCustomContext("ppc_num_threads", std::to_string(num_threads));
+      benchmark::RunSpecifiedBenchmarks();
+    } else {
+      NullBenchmarkReporter reporter;
+      std::ofstream null_stream;
+#ifdef _WIN32
+      null_stream.open("NUL");
+#else
+      null_stream.open("/dev/null");
+#endif
+      if (null_stream.is_open()) {
+        reporter.SetOutputStream(&null_stream);
+        reporter.SetErrorStream(&null_stream);
+      }
+      benchmark::RunSpecifiedBenchmarks(&reporter, nullptr);
+    }
+    benchmark::Shutdown();
+  }
+  if (MPI_Finalize() != MPI_SUCCESS) {
+    status = EXIT_FAILURE;
+  }
+  return status;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  try {
+    return RunInfraBenchmarks(argc, argv);
+  } catch (const std::exception &e) {
+    std::cerr << "[  ERROR  ] Unhandled exception in infrastructure benchmarks: " << e.what() << '\n';
+  } catch (...) {
+    std::cerr << "[  ERROR  ] Unknown unhandled exception in infrastructure benchmarks" << '\n';
+  }
+  return EXIT_FAILURE;
+}
@@ -3,19 +3,35 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <optional>
+#include <string>
 #include <utility>
 
+#include "util/include/affinity.hpp"
+#include "util/include/topology.hpp"
+
 namespace ppc::runners {
 
-/// @brief GTest event listener that checks for unread MPI messages after each test.
+/// @brief GTest event listener that checks for unread MPI messages between tests.
+/// @details Every check is collective over MPI_COMM_WORLD. A lazy detector checks only every few tests and at the
+///          end of each test suite, so a leftover message is reported with the range of tests that may have sent it.
 /// @note Used to detect unexpected inter-process communication leftovers.
 class UnreadMessagesDetector : public ::testing::EmptyTestEventListener {
  public:
-  UnreadMessagesDetector() = default;
-  /// @brief Called by GTest after a test ends. Checks for unread messages.
-  void OnTestEnd(const ::testing::TestInfo & /*test_info*/) override;
+  /// @param check_interval Tests between two checks; 1 checks after every test, 0 only at the end of each suite.
+  explicit UnreadMessagesDetector(int check_interval = 1) : check_interval_(check_interval) {}
+  /// @brief Called by GTest after a test ends. Checks for unread messages when the interval is reached.
+  void OnTestEnd(const ::testing::TestInfo &test_info) override;
+  /// @brief Checks the tests of the suite that were not checked yet.
+  void OnTestSuiteEnd(const ::testing::TestSuite & /*test_suite*/) override;
 
  private:
+  void Check();
+
+  int check_interval_;
+  int unchecked_tests_ = 0;
+  std::string first_unchecked_test_;
+  std::string last_unchecked_test_;
 };
 
 /// @brief GTest event listener that prints additional information on test failures in worker processes.
@@ -36,7 +52,34 @@ class WorkerTestFailurePrinter : public ::testing::EmptyTestEventListener {
   std::shared_ptr<::testing::TestEventListener> base_;
 };
 
+/// @brief Tests between two unread-message checks from PPC_UNREAD_CHECK.
+/// @details `strict` (or 1) checks after every test, `lazy` (the default) at the end of every test suite, and a
+///          positive number N after every N tests and at the end of every suite.
+/// @throws std::runtime_error If the value is not one of these.
+int GetUnreadMessagesCheckInterval();
+
+/// @brief Makes the start-up state of rank 0 the state of every rank with a single broadcast.
+/// @details Shares the GoogleTest random seed and filter, PPC_UNREAD_CHECK, the checkpoint settings, PPC_CLOCK,
+///          the interference probe settings, PPC_AFFINITY and PPC_THREAD_BUDGET, which must agree for collective
+///          checks, checkpoints, timings and start-up errors. Call after ::testing::InitGoogleTest().
+void SyncRunnerState();
+
+/// @brief PPC_AFFINITY as ppc::util::GetAffinityPolicy() reads it, or std::nullopt after printing why it is invalid.
+/// @details Call after SyncRunnerState(), so that every rank reads the value of rank 0 and all of them fail together.
+std::optional<ppc::util::AffinityPolicy> ReadAffinityPolicy();
+
+/// @brief PPC_THREAD_BUDGET as ppc::util::GetThreadBudgetMode() reads it, or std::nullopt after printing why it is
+///        invalid.
+/// @details Call after SyncRunnerState() and before creating the ppc::util::ScopedHybridTopology it configures.
+std::optional<ppc::util::ThreadBudgetMode> ReadThreadBudgetMode();
+
+/// @brief Installs the MPI listeners: rank-tagged failure printers on workers and the unread-message detector.
+/// @details Workers keep the default printer when @p argv contains `--print-workers`.
+void InstallMpiListeners(int argc, char **argv);
+
 /// @brief Initializes the testing environment (e.g., MPI, logging).
+/// @details PPC_SHARD="<index>/<total>" runs only that GoogleTest shard; every rank of an MPI job must get the same
+///          value.
 /// @param argc Argument count.
 /// @param argv Argument vector.
 /// @return Exit code from RUN_ALL_TESTS or MPI error code if initialization/
@@ -44,6 +87,7 @@ class WorkerTestFailurePrinter : public ::testing::EmptyTestEventListener {
 int Init(int argc, char **argv);
 
 /// @brief Initializes the testing environment only for gtest.
+/// @details Honours PPC_SHARD like Init().
 /// @param argc Argument count.
 /// @param argv Argument vector.
 /// @return Exit code from RUN_ALL_TESTS.
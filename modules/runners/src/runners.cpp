@@ -4,24 +4,57 @@
 
 #include <mpi.h>
 
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <exception>
 #include <format>
 #include <iostream>
+#include <libenvpp/detail/environment.hpp>
+#include <libenvpp/detail/get.hpp>
 #include <memory>
+#include <optional>
 #include <random>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <utility>
 
 #include "oneapi/tbb/global_control.h"
+#include "util/include/affinity.hpp"
+#include "util/include/checkpoint.hpp"
+#include "util/include/thread_pool.hpp"
+#include "util/include/topology.hpp"
+#include "util/include/trace.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::runners {
 
-void UnreadMessagesDetector::OnTestEnd(const ::testing::TestInfo & /*test_info*/) {
+void UnreadMessagesDetector::OnTestEnd(const ::testing::TestInfo &test_info) {
+  std::string name = std::format("{}.{}", test_info.test_suite_name(), test_info.name());
+  if (unchecked_tests_ == 0) {
+    first_unchecked_test_ = name;
+  }
+  last_unchecked_test_ = std::move(name);
+  unchecked_tests_++;
+  if (check_interval_ > 0 && unchecked_tests_ >= check_interval_) {
+    Check();
+  }
+}
+
+void UnreadMessagesDetector::OnTestSuiteEnd(const ::testing::TestSuite & /*test_suite*/) {
+  if (unchecked_tests_ > 0) {
+    Check();
+  }
+}
+
+void UnreadMessagesDetector::Check() {
   int rank = -1;
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
@@ -37,15 +70,20 @@ void UnreadMessagesDetector::OnTestEnd(const ::testing::TestInfo & /*test_info*/
   }
 
   if (flag != 0) {
-    std::cerr
-        << std::format(
-               "[  PROCESS {}  ] [  FAILED  ] MPI message queue has an unread message from process {} with tag {}",
-               rank, status.MPI_SOURCE, status.MPI_TAG)
-        << '\n';
+    // A lazy check only knows the range of tests that ran since the previous one
+    const std::string tests =
+        unchecked_tests_ == 1 ? first_unchecked_test_
+                              : std::format("one of the {} tests from {} to {} (rerun with PPC_UNREAD_CHECK=strict)",
+                                            unchecked_tests_, first_unchecked_test_, last_unchecked_test_);
+    std::cerr << std::format("[  PROCESS {}  ] [  FAILED  ] MPI message queue has an unread message from process {} "
+                             "with tag {} after {}",
+                             rank, status.MPI_SOURCE, status.MPI_TAG, tests)
+              << '\n';
     MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
   }
 
   MPI_Barrier(MPI_COMM_WORLD);
+  unchecked_tests_ = 0;
 }
 
 void WorkerTestFailurePrinter::OnTestEnd(const ::testing::TestInfo &test_info) {
@@ -54,6 +92,11 @@ void WorkerTestFailurePrinter::OnTestEnd(const ::testing::TestInfo &test_info) {
   }
   PrintProcessRank();
   base_->OnTestEnd(test_info);
+  if (ppc::util::GetCheckpointInterval() > 0.0) {
+    std::cerr << std::format("[  CHECKPOINT  ] Rerun with PPC_CHECKPOINT_DIR={} to resume from the last checkpoint",
+                             ppc::util::GetCheckpointDir())
+              << '\n';
+  }
   // Abort the whole MPI job on any test failure to avoid other ranks hanging on barriers.
   MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
 }
@@ -82,38 +125,93 @@ int RunAllTests() {
   return status;
 }
 
-void SyncGTestSeed() {
-  int rank = -1;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-  int seed = ::testing::GTEST_FLAG(random_seed);
-  if (rank == 0 && seed == 0) {
-    try {
-      seed = static_cast<int>((std::random_device{}() % 99999U) + 1U);
-    } catch (...) {
-      seed = 0;
-    }
-    if (seed == 0) {
-      const auto now = static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
-      seed = static_cast<int>((now % 99999ULL) + 1ULL);
-    }
+int GenerateSeed() {
+  int seed = 0;
+  try {
+    seed = static_cast<int>((std::random_device{}() % 99999U) + 1U);
+  } catch (...) {
+    seed = 0;
+  }
+  if (seed == 0) {
+    const auto now = static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    seed = static_cast<int>((now % 99999ULL) + 1ULL);
   }
-  MPI_Bcast(&seed, 1, MPI_INT, 0, MPI_COMM_WORLD);
-  ::testing::GTEST_FLAG(random_seed) = seed;
+  return seed;
 }
 
-void SyncGTestFilter() {
-  int rank = -1;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-  std::string filter = (rank == 0) ? ::testing::GTEST_FLAG(filter) : std::string{};
-  int len = static_cast<int>(filter.size());
-  MPI_Bcast(&len, 1, MPI_INT, 0, MPI_COMM_WORLD);
-  if (rank != 0) {
-    filter.resize(static_cast<std::size_t>(len));
+/// Environment variables read by collective checks, checkpoints, the benchmark clock and the interference probe,
+/// which must agree on every rank. PPC_AFFINITY is shared so that an invalid value stops every rank.
+constexpr std::array<const char *, 9> kSyncedVariables = {
+    "PPC_UNREAD_CHECK",
+    "PPC_CHECKPOINT_DIR",
+    "PPC_CHECKPOINT_INTERVAL",
+    "PPC_CLOCK",
+    "PPC_PERF_INTERFERENCE",
+    "PPC_PERF_INTERFERENCE_THRESHOLD",
+    "PPC_PERF_INTERFERENCE_RETRIES",
+    "PPC_AFFINITY",
+    "PPC_THREAD_BUDGET",
+};
+
+/// Size of the first broadcast of SyncRunnerState(); larger states follow in a second one.
+constexpr std::size_t kStateBroadcastBytes = 4096;
+
+void PackInt(std::string &buffer, std::int32_t value) {
+  buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+std::int32_t UnpackInt(std::string_view &buffer) {
+  std::int32_t value = 0;
+  std::memcpy(&value, buffer.data(), sizeof(value));
+  buffer.remove_prefix(sizeof(value));
+  return value;
+}
+
+/// Length-prefixed @p value; length -1 marks an unset variable.
+void PackString(std::string &buffer, const std::optional<std::string> &value) {
+  PackInt(buffer, value ? static_cast<std::int32_t>(value->size()) : -1);
+  if (value) {
+    buffer += *value;
   }
-  if (len > 0) {
-    MPI_Bcast(filter.data(), len, MPI_CHAR, 0, MPI_COMM_WORLD);
+}
+
+std::optional<std::string> UnpackString(std::string_view &buffer) {
+  const std::int32_t size = UnpackInt(buffer);
+  if (size < 0) {
+    return std::nullopt;
+  }
+  std::string value(buffer.substr(0, static_cast<std::size_t>(size)));
+  buffer.remove_prefix(static_cast<std::size_t>(size));
+  return value;
+}
+
+/// Total size, random seed, GoogleTest filter and kSyncedVariables of rank 0.
+std::string PackRunnerState() {
+  std::string state;
+  PackInt(state, 0);
+  const int seed = ::testing::GTEST_FLAG(random_seed);
+  PackInt(state, seed == 0 ? GenerateSeed() : seed);
+  PackString(state, std::string(::testing::GTEST_FLAG(filter)));
+  for (const char *name : kSyncedVariables) {
+    PackString(state, env::get<std::string>(name));
+  }
+  const auto size = static_cast<std::int32_t>(state.size());
+  std::memcpy(state.data(), &size, sizeof(size));
+  return state;
+}
+
+void ApplyRunnerState(std::string_view state) {
+  UnpackInt(state);
+  ::testing::GTEST_FLAG(random_seed) = UnpackInt(state);
+  ::testing::GTEST_FLAG(filter) = UnpackString(state).value_or("");
+  for (const char *name : kSyncedVariables) {
+    const auto value = UnpackString(state);
+    if (value) {
+      env::detail::set_environment_variable(name, *value);
+    } else {
+      env::detail::delete_environment_variable(name);
+    }
   }
-  ::testing::GTEST_FLAG(filter) = filter;
 }
 
 bool HasFlag(int argc, char **argv, std::string_view flag) {
@@ -125,6 +223,22 @@ bool HasFlag(int argc, char **argv, std::string_view flag) {
   return false;
 }
 
+/// Maps PPC_SHARD onto the GoogleTest sharding variables read by RUN_ALL_TESTS().
+/// @return False, after reporting the error, for a malformed shard.
+bool ApplyTestShard() {
+  try {
+    const auto shard = ppc::util::GetTestShard();
+    if (shard && env::get<std::string>("PPC_SHARD").has_value()) {
+      env::detail::set_environment_variable("GTEST_SHARD_INDEX", std::to_string(shard->index));
+      env::detail::set_environment_variable("GTEST_TOTAL_SHARDS", std::to_string(shard->total));
+    }
+    return true;
+  } catch (const std::exception &e) {
+    std::cerr << std::format("[  ERROR  ] {}", e.what()) << '\n';
+    return false;
+  }
+}
+
 int RunAllTestsSafely() {
   try {
     return RunAllTests();
@@ -140,24 +254,60 @@ int RunAllTestsSafely() {
 }
 }  // namespace
 
-int Init(int argc, char **argv) {
-  ppc::util::ConfigureMpiEnvironment();
-  const int init_res = MPI_Init(&argc, &argv);
-  if (init_res != MPI_SUCCESS) {
-    std::cerr << std::format("[  ERROR  ] MPI_Init failed with code {}", init_res) << '\n';
-    MPI_Abort(MPI_COMM_WORLD, init_res);
-    return init_res;
+int GetUnreadMessagesCheckInterval() {
+  const auto check = env::get<std::string>("PPC_UNREAD_CHECK");
+  if (!check.has_value() || check.value().empty() || check.value() == "lazy") {
+    return 0;
+  }
+  if (check.value() == "strict") {
+    return 1;
+  }
+  int interval = 0;
+  const auto *end = check.value().data() + check.value().size();
+  const auto [ptr, error] = std::from_chars(check.value().data(), end, interval);
+  if (error != std::errc() || ptr != end || interval <= 0) {
+    throw std::runtime_error("PPC_UNREAD_CHECK must be 'strict', 'lazy' or a positive number of tests, got '" +
+                             check.value() + "'");
   }
+  return interval;
+}
 
-  // Limit the number of threads in TBB
-  tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetNumThreads());
+void SyncRunnerState() {
+  int rank = -1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  std::string state = (rank == 0) ? PackRunnerState() : std::string{};
+  const std::size_t size = state.size();
+  state.resize(std::max(size, kStateBroadcastBytes));
+  MPI_Bcast(state.data(), static_cast<int>(kStateBroadcastBytes), MPI_CHAR, 0, MPI_COMM_WORLD);
+  std::int32_t total = 0;
+  std::memcpy(&total, state.data(), sizeof(total));
+  if (std::cmp_greater(total, kStateBroadcastBytes)) {
+    state.resize(static_cast<std::size_t>(total));
+    MPI_Bcast(state.data() + kStateBroadcastBytes, total - static_cast<int>(kStateBroadcastBytes), MPI_CHAR, 0,
+              MPI_COMM_WORLD);
+  }
+  ApplyRunnerState(std::string_view(state).substr(0, static_cast<std::size_t>(total)));
+}
 
-  ::testing::InitGoogleTest(&argc, argv);
+std::optional<ppc::util::AffinityPolicy> ReadAffinityPolicy() {
+  try {
+    return ppc::util::GetAffinityPolicy();
+  } catch (const std::exception &e) {
+    std::cerr << std::format("[  ERROR  ] {}", e.what()) << '\n';
+    return std::nullopt;
+  }
+}
 
-  // Synchronize GoogleTest internals across ranks to avoid divergence
-  SyncGTestSeed();
-  SyncGTestFilter();
+std::optional<ppc::util::ThreadBudgetMode> ReadThreadBudgetMode() {
+  try {
+    return ppc::util::GetThreadBudgetMode();
+  } catch (const std::exception &e) {
+    std::cerr << std::format("[  ERROR  ] {}", e.what()) << '\n';
+    return std::nullopt;
+  }
+}
 
+void InstallMpiListeners(int argc, char **argv) {
   auto &listeners = ::testing::UnitTest::GetInstance()->listeners();
   int rank = -1;
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
@@ -166,9 +316,52 @@ int Init(int argc, char **argv) {
     auto *listener = listeners.Release(listeners.default_result_printer());
     listeners.Append(new WorkerTestFailurePrinter(std::shared_ptr<::testing::TestEventListener>(listener)));
   }
-  listeners.Append(new UnreadMessagesDetector());
+  listeners.Append(new UnreadMessagesDetector(GetUnreadMessagesCheckInterval()));
+}
+
+int Init(int argc, char **argv) {
+  if (!ApplyTestShard()) {
+    return EXIT_FAILURE;
+  }
+  ppc::util::ConfigureMpiEnvironment();
+  const int init_res = MPI_Init(&argc, &argv);
+  if (init_res != MPI_SUCCESS) {
+    std::cerr << std::format("[  ERROR  ] MPI_Init failed with code {}", init_res) << '\n';
+    MPI_Abort(MPI_COMM_WORLD, init_res);
+    return init_res;
+  }
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  // Synchronize GoogleTest internals and the PPC_* settings across ranks to avoid divergence
+  SyncRunnerState();
+  const auto affinity_policy = ReadAffinityPolicy();
+  const auto thread_budget_mode = ReadThreadBudgetMode();
+  if (!affinity_policy || !thread_budget_mode) {
+    MPI_Finalize();
+    return EXIT_FAILURE;
+  }
+  // Give ranks that share a node a fair slice of its cores before threads are configured
+  const ppc::util::ScopedHybridTopology topology(*thread_budget_mode);
+  // Limit the number of threads in TBB
+  tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetNumThreads());
+  // Pin threads according to PPC_AFFINITY before the STL pool starts its workers
+  const ppc::util::ScopedThreadAffinity affinity(*affinity_policy, ppc::util::GetNumThreads());
+  // Keep STL worker threads alive for the whole run
+  const ppc::util::ScopedThreadPool thread_pool(ppc::util::GetNumThreads());
+  try {
+    InstallMpiListeners(argc, argv);
+  } catch (const std::exception &e) {
+    // The settings read here are synced, so every rank fails and finalizes together
+    std::cerr << std::format("[  ERROR  ] {}", e.what()) << '\n';
+    MPI_Finalize();
+    return EXIT_FAILURE;
+  }
+  int rank = -1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
   const int status = RunAllTestsSafely();
+  ppc::util::FlushTrace(rank);
 
   const int finalize_res = MPI_Finalize();
   if (finalize_res != MPI_SUCCESS) {
@@ -180,11 +373,24 @@ int Init(int argc, char **argv) {
 }
 
 int SimpleInit(int argc, char **argv) {
+  if (!ApplyTestShard()) {
+    return EXIT_FAILURE;
+  }
+  const auto affinity_policy = ReadAffinityPolicy();
+  if (!affinity_policy) {
+    return EXIT_FAILURE;
+  }
   // Limit the number of threads in TBB
   tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetNumThreads());
+  // Pin threads according to PPC_AFFINITY before the STL pool starts its workers
+  const ppc::util::ScopedThreadAffinity affinity(*affinity_policy, ppc::util::GetNumThreads());
+  // Keep STL worker threads alive for the whole run
+  const ppc::util::ScopedThreadPool thread_pool(ppc::util::GetNumThreads());
 
   testing::InitGoogleTest(&argc, argv);
-  return RunAllTests();
+  const int status = RunAllTests();
+  ppc::util::FlushTrace(0);
+  return status;
 }
 
 }  // namespace ppc::runners
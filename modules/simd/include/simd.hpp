@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace ppc::simd {
+
+/// @brief Instruction set used by the kernels of this module.
+enum class SimdIsa : uint8_t {
+  /// Plain C++ loops
+  kScalar,
+  /// x86-64 AVX2 with FMA, 256-bit vectors
+  kAvx2,
+  /// x86-64 AVX-512F, 512-bit vectors
+  kAvx512,
+  /// AArch64 Advanced SIMD, 128-bit vectors
+  kNeon,
+};
+
+constexpr std::string_view SimdIsaToString(SimdIsa isa) {
+  switch (isa) {
+    case SimdIsa::kScalar:
+      return "off";
+    case SimdIsa::kAvx2:
+      return "avx2";
+    case SimdIsa::kAvx512:
+      return "avx512";
+    case SimdIsa::kNeon:
+      return "neon";
+  }
+  return "off";
+}
+
+/// @brief True if this build has kernels for @p isa and the CPU executes them.
+bool IsSimdIsaSupported(SimdIsa isa);
+
+/// @brief Widest instruction set supported by the CPU.
+SimdIsa DetectSimdIsa();
+
+/// @brief Instruction set selected with PPC_SIMD (off, auto, avx2, avx512 or neon); auto when unset.
+/// @details Read once; SetSimdIsa() changes it afterwards.
+/// @throws std::runtime_error If PPC_SIMD holds another value or names an instruction set the CPU lacks.
+SimdIsa GetSimdIsa();
+
+/// @brief Makes every later kernel call use @p isa.
+/// @throws std::runtime_error If @p isa is not supported.
+void SetSimdIsa(SimdIsa isa);
+
+/// @brief Selects @p isa for the lifetime of the scope, e.g. to compare against the scalar baseline.
+class ScopedSimdIsa {
+ public:
+  explicit ScopedSimdIsa(SimdIsa isa) : previous_(GetSimdIsa()) {
+    SetSimdIsa(isa);
+  }
+  ScopedSimdIsa(const ScopedSimdIsa &) = delete;
+  ScopedSimdIsa &operator=(const ScopedSimdIsa &) = delete;
+  ~ScopedSimdIsa() {
+    SetSimdIsa(previous_);
+  }
+
+ private:
+  SimdIsa previous_;
+};
+
+/// @brief Sum of all elements. Vector kernels add in a different order, so results may differ in the last bits.
+float Sum(std::span<const float> values);
+double Sum(std::span<const double> values);
+
+/// @throws std::runtime_error If the spans differ in size.
+float Dot(std::span<const float> lhs, std::span<const float> rhs);
+double Dot(std::span<const double> lhs, std::span<const double> rhs);
+
+/// @brief y += alpha * x.
+/// @throws std::runtime_error If the spans differ in size.
+void Axpy(float alpha, std::span<const float> x, std::span<float> y);
+void Axpy(double alpha, std::span<const double> x, std::span<double> y);
+
+/// @brief Writes the transpose of the row-major @p rows x @p cols matrix @p src to @p dst.
+/// @details A scalar, cache-blocked transpose in every build; the instruction set only sets the tile size.
+/// @throws std::runtime_error If a span does not hold rows * cols elements.
+void Transpose(std::span<const float> src, std::size_t rows, std::size_t cols, std::span<float> dst);
+void Transpose(std::span<const double> src, std::size_t rows, std::size_t cols, std::span<double> dst);
+
+/// @brief out[i] = sum over k of signal[i + k] * kernel[k], for every window that fits inside @p signal.
+/// @throws std::runtime_error If @p out does not hold signal.size() - kernel.size() + 1 elements.
+void Convolve(std::span<const float> signal, std::span<const float> kernel, std::span<float> out);
+void Convolve(std::span<const double> signal, std::span<const double> kernel, std::span<double> out);
+
+namespace detail {
+
+/// @brief Kernel entry points of one instruction set.
+struct SimdKernels {
+  float (*sum_f32)(const float *, std::size_t);
+  double (*sum_f64)(const double *, std::size_t);
+  float (*dot_f32)(const float *, const float *, std::size_t);
+  double (*dot_f64)(const double *, const double *, std::size_t);
+  void (*axpy_f32)(float, const float *, float *, std::size_t);
+  void (*axpy_f64)(double, const double *, double *, std::size_t);
+  void (*transpose_f32)(const float *, std::size_t, std::size_t, float *);
+  void (*transpose_f64)(const double *, std::size_t, std::size_t, double *);
+  void (*convolve_f32)(const float *, std::size_t, const float *, std::size_t, float *);
+  void (*convolve_f64)(const double *, std::size_t, const double *, std::size_t, double *);
+};
+
+/// @brief Kernels of each instruction set, or nullptr when this build has none for it.
+const SimdKernels *ScalarKernels();
+const SimdKernels *Avx2Kernels();
+const SimdKernels *Avx512Kernels();
+const SimdKernels *NeonKernels();
+
+}  // namespace detail
+
+}  // namespace ppc::simd
@@ -0,0 +1,129 @@
+#pragma once
+
+// Kernels written once against an Ops traits type and instantiated by every ISA translation unit with its own
+// traits. Instantiations are local to their translation unit because the traits live in an anonymous namespace, and
+// they are compiled with that unit's target options. Avoid standard library calls here: their inline definitions
+// would be emitted with the wider target and could be picked by the linker for the whole program.
+
+#include <cstddef>
+
+#include "simd/include/simd.hpp"
+
+namespace ppc::simd::detail {
+
+// Ops provides: T, V, kWidth, Zero(), Set1(T), Load(const T *), Store(T *, V), Add(V, V), Mul(V, V),
+// Fma(V a, V b, V c) = a * b + c and ReduceAdd(V).
+
+template <typename Ops>
+typename Ops::T SumKernel(const typename Ops::T *x, std::size_t n) {
+  constexpr std::size_t kStep = 4 * Ops::kWidth;
+  typename Ops::V acc0 = Ops::Zero();
+  typename Ops::V acc1 = Ops::Zero();
+  typename Ops::V acc2 = Ops::Zero();
+  typename Ops::V acc3 = Ops::Zero();
+  std::size_t i = 0;
+  for (; i + kStep <= n; i += kStep) {
+    acc0 = Ops::Add(acc0, Ops::Load(x + i));
+    acc1 = Ops::Add(acc1, Ops::Load(x + i + Ops::kWidth));
+    acc2 = Ops::Add(acc2, Ops::Load(x + i + (2 * Ops::kWidth)));
+    acc3 = Ops::Add(acc3, Ops::Load(x + i + (3 * Ops::kWidth)));
+  }
+  for (; i + Ops::kWidth <= n; i += Ops::kWidth) {
+    acc0 = Ops::Add(acc0, Ops::Load(x + i));
+  }
+  typename Ops::T sum = Ops::ReduceAdd(Ops::Add(Ops::Add(acc0, acc1), Ops::Add(acc2, acc3)));
+  for (; i < n; i++) {
+    sum += x[i];
+  }
+  return sum;
+}
+
+template <typename Ops>
+typename Ops::T DotKernel(const typename Ops::T *x, const typename Ops::T *y, std::size_t n) {
+  constexpr std::size_t kStep = 4 * Ops::kWidth;
+  typename Ops::V acc0 = Ops::Zero();
+  typename Ops::V acc1 = Ops::Zero();
+  typename Ops::V acc2 = Ops::Zero();
+  typename Ops::V acc3 = Ops::Zero();
+  std::size_t i = 0;
+  for (; i + kStep <= n; i += kStep) {
+    acc0 = Ops::Fma(Ops::Load(x + i), Ops::Load(y + i), acc0);
+    acc1 = Ops::Fma(Ops::Load(x + i + Ops::kWidth), Ops::Load(y + i + Ops::kWidth), acc1);
+    acc2 = Ops::Fma(Ops::Load(x + i + (2 * Ops::kWidth)), Ops::Load(y + i + (2 * Ops::kWidth)), acc2);
+    acc3 = Ops::Fma(Ops::Load(x + i + (3 * Ops::kWidth)), Ops::Load(y + i + (3 * Ops::kWidth)), acc3);
+  }
+  for (; i + Ops::kWidth <= n; i += Ops::kWidth) {
+    acc0 = Ops::Fma(Ops::Load(x + i), Ops::Load(y + i), acc0);
+  }
+  typename Ops::T sum = Ops::ReduceAdd(Ops::Add(Ops::Add(acc0, acc1), Ops::Add(acc2, acc3)));
+  for (; i < n; i++) {
+    sum += x[i] * y[i];
+  }
+  return sum;
+}
+
+template <typename Ops>
+void AxpyKernel(typename Ops::T alpha, const typename Ops::T *x, typename Ops::T *y, std::size_t n) {
+  const typename Ops::V scale = Ops::Set1(alpha);
+  std::size_t i = 0;
+  for (; i + Ops::kWidth <= n; i += Ops::kWidth) {
+    Ops::Store(y + i, Ops::Fma(scale, Ops::Load(x + i), Ops::Load(y + i)));
+  }
+  for (; i < n; i++) {
+    y[i] += alpha * x[i];
+  }
+}
+
+template <typename Ops>
+void TransposeKernel(const typename Ops::T *src, std::size_t rows, std::size_t cols, typename Ops::T *dst) {
+  // Tiles of 4 vectors a side stay in L1 for both the row-wise reads and the column-wise writes
+  constexpr std::size_t kTile = 4 * Ops::kWidth;
+  for (std::size_t row_tile = 0; row_tile < rows; row_tile += kTile) {
+    const std::size_t row_end = row_tile + kTile < rows ? row_tile + kTile : rows;
+    for (std::size_t col_tile = 0; col_tile < cols; col_tile += kTile) {
+      const std::size_t col_end = col_tile + kTile < cols ? col_tile + kTile : cols;
+      for (std::size_t col = col_tile; col < col_end; col++) {
+        for (std::size_t row = row_tile; row < row_end; row++) {
+          dst[(col * rows) + row] = src[(row * cols) + col];
+        }
+      }
+    }
+  }
+}
+
+template <typename Ops>
+void ConvolveKernel(const typename Ops::T *signal, std::size_t n, const typename Ops::T *kernel, std::size_t k,
+                    typename Ops::T *out) {
+  const std::size_t outputs = n - k + 1;
+  std::size_t i = 0;
+  for (; i + Ops::kWidth <= outputs; i += Ops::kWidth) {
+    typename Ops::V acc = Ops::Zero();
+    for (std::size_t tap = 0; tap < k; tap++) {
+      acc = Ops::Fma(Ops::Set1(kernel[tap]), Ops::Load(signal + i + tap), acc);
+    }
+    Ops::Store(out + i, acc);
+  }
+  for (; i < outputs; i++) {
+    typename Ops::T acc{};
+    for (std::size_t tap = 0; tap < k; tap++) {
+      acc += kernel[tap] * signal[i + tap];
+    }
+    out[i] = acc;
+  }
+}
+
+template <typename F32, typename F64>
+constexpr SimdKernels MakeKernels() {
+  return {.sum_f32 = &SumKernel<F32>,
+          .sum_f64 = &SumKernel<F64>,
+          .dot_f32 = &DotKernel<F32>,
+          .dot_f64 = &DotKernel<F64>,
+          .axpy_f32 = &AxpyKernel<F32>,
+          .axpy_f64 = &AxpyKernel<F64>,
+          .transpose_f32 = &TransposeKernel<F32>,
+          .transpose_f64 = &TransposeKernel<F64>,
+          .convolve_f32 = &ConvolveKernel<F32>,
+          .convolve_f64 = &ConvolveKernel<F64>};
+}
+
+}  // namespace ppc::simd::detail
@@ -0,0 +1,101 @@
+#include "simd/include/simd.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#  include <immintrin.h>
+
+#  include <cstddef>
+
+#  if defined(__clang__)
+#    pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#  elif defined(__GNUC__)
+#    pragma GCC push_options
+#    pragma GCC target("avx2,fma")
+#  endif
+
+#  include "simd/src/kernel_templates.hpp"
+
+namespace {
+
+struct Avx2F32 {
+  using T = float;
+  using V = __m256;
+  static constexpr std::size_t kWidth = 8;
+
+  static V Zero() {
+    return _mm256_setzero_ps();
+  }
+  static V Set1(T value) {
+    return _mm256_set1_ps(value);
+  }
+  static V Load(const T *ptr) {
+    return _mm256_loadu_ps(ptr);
+  }
+  static void Store(T *ptr, V value) {
+    _mm256_storeu_ps(ptr, value);
+  }
+  static V Add(V lhs, V rhs) {
+    return _mm256_add_ps(lhs, rhs);
+  }
+  static V Fma(V a, V b, V c) {
+    return _mm256_fmadd_ps(a, b, c);
+  }
+  static T ReduceAdd(V value) {
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+  }
+};
+
+struct Avx2F64 {
+  using T = double;
+  using V = __m256d;
+  static constexpr std::size_t kWidth = 4;
+
+  static V Zero() {
+    return _mm256_setzero_pd();
+  }
+  static V Set1(T value) {
+    return _mm256_set1_pd(value);
+  }
+  static V Load(const T *ptr) {
+    return _mm256_loadu_pd(ptr);
+  }
+  static void Store(T *ptr, V value) {
+    _mm256_storeu_pd(ptr, value);
+  }
+  static V Add(V lhs, V rhs) {
+    return _mm256_add_pd(lhs, rhs);
+  }
+  static V Fma(V a, V b, V c) {
+    return _mm256_fmadd_pd(a, b, c);
+  }
+  static T ReduceAdd(V value) {
+    __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(value), _mm256_extractf128_pd(value, 1));
+    sum = _mm_add_sd(sum, _mm_unpackhi_pd(sum, sum));
+    return _mm_cvtsd_f64(sum);
+  }
+};
+
+}  // namespace
+
+#  if defined(__clang__)
+#    pragma clang attribute pop
+#  elif defined(__GNUC__)
+#    pragma GCC pop_options
+#  endif
+
+// The table is built at compile time; only the kernels it points to need the wider target
+const ppc::simd::detail::SimdKernels *ppc::simd::detail::Avx2Kernels() {
+  static constexpr SimdKernels kKernels = MakeKernels<Avx2F32, Avx2F64>();
+  return &kKernels;
+}
+
+#else
+
+const ppc::simd::detail::SimdKernels *ppc::simd::detail::Avx2Kernels() {
+  return nullptr;
+}
+
+#endif
@@ -0,0 +1,109 @@
+#include "simd/include/simd.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#  include <immintrin.h>
+
+#  include <cstddef>
+
+#  if defined(__clang__)
+#    pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#  elif defined(__GNUC__)
+#    pragma GCC push_options
+#    pragma GCC target("avx512f")
+#  endif
+
+#  include "simd/src/kernel_templates.hpp"
+
+namespace {
+
+struct Avx512F32 {
+  using T = float;
+  using V = __m512;
+  static constexpr std::size_t kWidth = 16;
+
+  static V Zero() {
+    return _mm512_setzero_ps();
+  }
+  static V Set1(T value) {
+    return _mm512_set1_ps(value);
+  }
+  static V Load(const T *ptr) {
+    return _mm512_loadu_ps(ptr);
+  }
+  static void Store(T *ptr, V value) {
+    _mm512_storeu_ps(ptr, value);
+  }
+  static V Add(V lhs, V rhs) {
+    return _mm512_add_ps(lhs, rhs);
+  }
+  static V Fma(V a, V b, V c) {
+    return _mm512_fmadd_ps(a, b, c);
+  }
+  static T ReduceAdd(V value) {
+    // _mm512_reduce_add_ps trips -Wuninitialized inside GCC 12's headers; one store per call costs nothing
+    alignas(64) T lanes[kWidth];
+    _mm512_store_ps(lanes, value);
+    T sum{};
+    for (const T lane : lanes) {
+      sum += lane;
+    }
+    return sum;
+  }
+};
+
+struct Avx512F64 {
+  using T = double;
+  using V = __m512d;
+  static constexpr std::size_t kWidth = 8;
+
+  static V Zero() {
+    return _mm512_setzero_pd();
+  }
+  static V Set1(T value) {
+    return _mm512_set1_pd(value);
+  }
+  static V Load(const T *ptr) {
+    return _mm512_loadu_pd(ptr);
+  }
+  static void Store(T *ptr, V value) {
+    _mm512_storeu_pd(ptr, value);
+  }
+  static V Add(V lhs, V rhs) {
+    return _mm512_add_pd(lhs, rhs);
+  }
+  static V Fma(V a, V b, V c) {
+    return _mm512_fmadd_pd(a, b, c);
+  }
+  static T ReduceAdd(V value) {
+    alignas(64) T lanes[kWidth];
+    _mm512_store_pd(lanes, value);
+    T sum{};
+    for (const T lane : lanes) {
+      sum += lane;
+    }
+    return sum;
+  }
+};
+
+}  // namespace
+
+#  if defined(__clang__)
+#    pragma clang attribute pop
+#  elif defined(__GNUC__)
+#    pragma GCC pop_options
+#  endif
+
+// The table is built at compile time; only the kernels it points to need the wider target
+const ppc::simd::detail::SimdKernels *ppc::simd::detail::Avx512Kernels() {
+  static constexpr SimdKernels kKernels = MakeKernels<Avx512F32, Avx512F64>();
+  return &kKernels;
+}
+
+#else
+
+const ppc::simd::detail::SimdKernels *ppc::simd::detail::Avx512Kernels() {
+  return nullptr;
+}
+
+#endif
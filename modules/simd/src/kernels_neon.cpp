@@ -0,0 +1,83 @@
+#include "simd/include/simd.hpp"
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+#  include <arm_neon.h>
+
+#  include <cstddef>
+
+#  include "simd/src/kernel_templates.hpp"
+
+namespace {
+
+struct NeonF32 {
+  using T = float;
+  using V = float32x4_t;
+  static constexpr std::size_t kWidth = 4;
+
+  static V Zero() {
+    return vdupq_n_f32(0.0F);
+  }
+  static V Set1(T value) {
+    return vdupq_n_f32(value);
+  }
+  static V Load(const T *ptr) {
+    return vld1q_f32(ptr);
+  }
+  static void Store(T *ptr, V value) {
+    vst1q_f32(ptr, value);
+  }
+  static V Add(V lhs, V rhs) {
+    return vaddq_f32(lhs, rhs);
+  }
+  static V Fma(V a, V b, V c) {
+    return vfmaq_f32(c, a, b);
+  }
+  static T ReduceAdd(V value) {
+    return vaddvq_f32(value);
+  }
+};
+
+struct NeonF64 {
+  using T = double;
+  using V = float64x2_t;
+  static constexpr std::size_t kWidth = 2;
+
+  static V Zero() {
+    return vdupq_n_f64(0.0);
+  }
+  static V Set1(T value) {
+    return vdupq_n_f64(value);
+  }
+  static V Load(const T *ptr) {
+    return vld1q_f64(ptr);
+  }
+  static void Store(T *ptr, V value) {
+    vst1q_f64(ptr, value);
+  }
+  static V Add(V lhs, V rhs) {
+    return vaddq_f64(lhs, rhs);
+  }
+  static V Fma(V a, V b, V c) {
+    return vfmaq_f64(c, a, b);
+  }
+  static T ReduceAdd(V value) {
+    return vaddvq_f64(value);
+  }
+};
+
+}  // namespace
+
+// Advanced SIMD is part of the AArch64 baseline, so no target options are needed
+const ppc::simd::detail::SimdKernels *ppc::simd::detail::NeonKernels() {
+  static constexpr SimdKernels kKernels = MakeKernels<NeonF32, NeonF64>();
+  return &kKernels;
+}
+
+#else
+
+const ppc::simd::detail::SimdKernels *ppc::simd::detail::NeonKernels() {
+  return nullptr;
+}
+
+#endif
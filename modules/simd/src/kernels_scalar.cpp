@@ -0,0 +1,42 @@
+#include <cstddef>
+
+#include "simd/include/simd.hpp"
+#include "simd/src/kernel_templates.hpp"
+
+namespace {
+
+template <typename Scalar>
+struct ScalarOps {
+  using T = Scalar;
+  using V = Scalar;
+  static constexpr std::size_t kWidth = 1;
+
+  static V Zero() {
+    return V{};
+  }
+  static V Set1(T value) {
+    return value;
+  }
+  static V Load(const T *ptr) {
+    return *ptr;
+  }
+  static void Store(T *ptr, V value) {
+    *ptr = value;
+  }
+  static V Add(V lhs, V rhs) {
+    return lhs + rhs;
+  }
+  static V Fma(V a, V b, V c) {
+    return (a * b) + c;
+  }
+  static T ReduceAdd(V value) {
+    return value;
+  }
+};
+
+}  // namespace
+
+const ppc::simd::detail::SimdKernels *ppc::simd::detail::ScalarKernels() {
+  static constexpr SimdKernels kKernels = MakeKernels<ScalarOps<float>, ScalarOps<double>>();
+  return &kKernels;
+}
@@ -0,0 +1,203 @@
+#include "simd/include/simd.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <libenvpp/detail/get.hpp>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#  include <immintrin.h>
+#  include <intrin.h>
+#endif
+
+namespace {
+
+bool CpuHasAvx2() {
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+  return __builtin_cpu_supports("avx2") != 0 && __builtin_cpu_supports("fma") != 0;
+#elif defined(_MSC_VER) && defined(_M_X64)
+  std::array<int, 4> info{};
+  __cpuid(info.data(), 1);
+  const bool fma = (info[2] & (1 << 12)) != 0;
+  const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+  __cpuidex(info.data(), 7, 0);
+  return fma && os_saves_ymm && (info[1] & (1 << 5)) != 0;
+#else
+  return false;
+#endif
+}
+
+bool CpuHasAvx512() {
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+  return __builtin_cpu_supports("avx512f") != 0;
+#elif defined(_MSC_VER) && defined(_M_X64)
+  std::array<int, 4> info{};
+  __cpuid(info.data(), 1);
+  const bool os_saves_zmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0xE6) == 0xE6;
+  __cpuidex(info.data(), 7, 0);
+  return os_saves_zmm && (info[1] & (1 << 16)) != 0;
+#else
+  return false;
+#endif
+}
+
+const ppc::simd::detail::SimdKernels *KernelsFor(ppc::simd::SimdIsa isa) {
+  using ppc::simd::SimdIsa;
+  switch (isa) {
+    case SimdIsa::kScalar:
+      return ppc::simd::detail::ScalarKernels();
+    case SimdIsa::kAvx2:
+      return CpuHasAvx2() ? ppc::simd::detail::Avx2Kernels() : nullptr;
+    case SimdIsa::kAvx512:
+      return CpuHasAvx512() ? ppc::simd::detail::Avx512Kernels() : nullptr;
+    case SimdIsa::kNeon:
+      return ppc::simd::detail::NeonKernels();
+  }
+  return nullptr;
+}
+
+ppc::simd::SimdIsa IsaFromEnvironment() {
+  using ppc::simd::SimdIsa;
+  const auto value = env::get<std::string>("PPC_SIMD");
+  if (!value.has_value() || value.value().empty() || value.value() == "auto") {
+    return ppc::simd::DetectSimdIsa();
+  }
+  for (const SimdIsa isa : {SimdIsa::kScalar, SimdIsa::kAvx2, SimdIsa::kAvx512, SimdIsa::kNeon}) {
+    if (value.value() == ppc::simd::SimdIsaToString(isa)) {
+      if (!ppc::simd::IsSimdIsaSupported(isa)) {
+        throw std::runtime_error("PPC_SIMD=" + value.value() + " is not supported on this CPU");
+      }
+      return isa;
+    }
+  }
+  throw std::runtime_error("Invalid PPC_SIMD '" + value.value() + "', expected off, auto, avx2, avx512 or neon");
+}
+
+struct Selection {
+  ppc::simd::SimdIsa isa;
+  const ppc::simd::detail::SimdKernels *kernels;
+};
+
+std::atomic<const Selection *> &SelectionSlot() {
+  static std::atomic<const Selection *> slot{nullptr};
+  return slot;
+}
+
+/// One immutable Selection per ISA, so readers never see a half-updated pair.
+const Selection *SelectionFor(ppc::simd::SimdIsa isa) {
+  using ppc::simd::SimdIsa;
+  static const std::array<Selection, 4> kSelections = {{{SimdIsa::kScalar, KernelsFor(SimdIsa::kScalar)},
+                                                        {SimdIsa::kAvx2, KernelsFor(SimdIsa::kAvx2)},
+                                                        {SimdIsa::kAvx512, KernelsFor(SimdIsa::kAvx512)},
+                                                        {SimdIsa::kNeon, KernelsFor(SimdIsa::kNeon)}}};
+  return &kSelections[static_cast<std::size_t>(isa)];
+}
+
+const Selection &CurrentSelection() {
+  const Selection *selection = SelectionSlot().load(std::memory_order_acquire);
+  if (selection == nullptr) {
+    selection = SelectionFor(IsaFromEnvironment());
+    SelectionSlot().store(selection, std::memory_order_release);
+  }
+  return *selection;
+}
+
+const ppc::simd::detail::SimdKernels &Kernels() {
+  return *CurrentSelection().kernels;
+}
+
+void CheckSameSize(std::size_t lhs, std::size_t rhs) {
+  if (lhs != rhs) {
+    throw std::runtime_error("SIMD kernel operands differ in size");
+  }
+}
+
+void CheckTransposeSizes(std::size_t src, std::size_t rows, std::size_t cols, std::size_t dst) {
+  if (src != rows * cols || dst != rows * cols) {
+    throw std::runtime_error("Transpose buffers do not hold rows * cols elements");
+  }
+}
+
+void CheckConvolveSizes(std::size_t signal, std::size_t kernel, std::size_t out) {
+  if (kernel == 0 || kernel > signal || out != signal - kernel + 1) {
+    throw std::runtime_error("Convolution output must hold signal.size() - kernel.size() + 1 elements");
+  }
+}
+
+}  // namespace
+
+bool ppc::simd::IsSimdIsaSupported(SimdIsa isa) {
+  return KernelsFor(isa) != nullptr;
+}
+
+ppc::simd::SimdIsa ppc::simd::DetectSimdIsa() {
+  for (const SimdIsa isa : {SimdIsa::kAvx512, SimdIsa::kAvx2, SimdIsa::kNeon}) {
+    if (IsSimdIsaSupported(isa)) {
+      return isa;
+    }
+  }
+  return SimdIsa::kScalar;
+}
+
+ppc::simd::SimdIsa ppc::simd::GetSimdIsa() {
+  return CurrentSelection().isa;
+}
+
+void ppc::simd::SetSimdIsa(SimdIsa isa) {
+  if (!IsSimdIsaSupported(isa)) {
+    throw std::runtime_error("SIMD instruction set " + std::string(SimdIsaToString(isa)) + " is not supported");
+  }
+  SelectionSlot().store(SelectionFor(isa), std::memory_order_release);
+}
+
+float ppc::simd::Sum(std::span<const float> values) {
+  return Kernels().sum_f32(values.data(), values.size());
+}
+
+double ppc::simd::Sum(std::span<const double> values) {
+  return Kernels().sum_f64(values.data(), values.size());
+}
+
+float ppc::simd::Dot(std::span<const float> lhs, std::span<const float> rhs) {
+  CheckSameSize(lhs.size(), rhs.size());
+  return Kernels().dot_f32(lhs.data(), rhs.data(), lhs.size());
+}
+
+double ppc::simd::Dot(std::span<const double> lhs, std::span<const double> rhs) {
+  CheckSameSize(lhs.size(), rhs.size());
+  return Kernels().dot_f64(lhs.data(), rhs.data(), lhs.size());
+}
+
+void ppc::simd::Axpy(float alpha, std::span<const float> x, std::span<float> y) {
+  CheckSameSize(x.size(), y.size());
+  Kernels().axpy_f32(alpha, x.data(), y.data(), x.size());
+}
+
+void ppc::simd::Axpy(double alpha, std::span<const double> x, std::span<double> y) {
+  CheckSameSize(x.size(), y.size());
+  Kernels().axpy_f64(alpha, x.data(), y.data(), x.size());
+}
+
+void ppc::simd::Transpose(std::span<const float> src, std::size_t rows, std::size_t cols, std::span<float> dst) {
+  CheckTransposeSizes(src.size(), rows, cols, dst.size());
+  Kernels().transpose_f32(src.data(), rows, cols, dst.data());
+}
+
+void ppc::simd::Transpose(std::span<const double> src, std::size_t rows, std::size_t cols, std::span<double> dst) {
+  CheckTransposeSizes(src.size(), rows, cols, dst.size());
+  Kernels().transpose_f64(src.data(), rows, cols, dst.data());
+}
+
+void ppc::simd::Convolve(std::span<const float> signal, std::span<const float> kernel, std::span<float> out) {
+  CheckConvolveSizes(signal.size(), kernel.size(), out.size());
+  Kernels().convolve_f32(signal.data(), signal.size(), kernel.data(), kernel.size(), out.data());
+}
+
+void ppc::simd::Convolve(std::span<const double> signal, std::span<const double> kernel, std::span<double> out) {
+  CheckConvolveSizes(signal.size(), kernel.size(), out.size());
+  Kernels().convolve_f64(signal.data(), signal.size(), kernel.data(), kernel.size(), out.data());
+}
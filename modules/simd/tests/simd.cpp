@@ -0,0 +1,132 @@
+#include "simd/include/simd.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <libenvpp/detail/environment.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+std::vector<ppc::simd::SimdIsa> SupportedIsas() {
+  std::vector<ppc::simd::SimdIsa> isas;
+  for (const auto isa : {ppc::simd::SimdIsa::kScalar, ppc::simd::SimdIsa::kAvx2, ppc::simd::SimdIsa::kAvx512,
+                         ppc::simd::SimdIsa::kNeon}) {
+    if (ppc::simd::IsSimdIsaSupported(isa)) {
+      isas.push_back(isa);
+    }
+  }
+  return isas;
+}
+
+template <typename T>
+std::vector<T> MakeValues(std::size_t count, T scale) {
+  std::vector<T> values(count);
+  for (std::size_t i = 0; i < count; i++) {
+    values[i] = scale * static_cast<T>((static_cast<int>(i * 7) % 13) - 6);
+  }
+  return values;
+}
+
+}  // namespace
+
+TEST(Simd, ScalarIsAlwaysSupported) {
+  EXPECT_TRUE(ppc::simd::IsSimdIsaSupported(ppc::simd::SimdIsa::kScalar));
+  EXPECT_TRUE(ppc::simd::IsSimdIsaSupported(ppc::simd::DetectSimdIsa()));
+}
+
+TEST(Simd, ScopedIsaRestoresPrevious) {
+  const ppc::simd::SimdIsa before = ppc::simd::GetSimdIsa();
+  {
+    const ppc::simd::ScopedSimdIsa scalar(ppc::simd::SimdIsa::kScalar);
+    EXPECT_EQ(ppc::simd::GetSimdIsa(), ppc::simd::SimdIsa::kScalar);
+  }
+  EXPECT_EQ(ppc::simd::GetSimdIsa(), before);
+}
+
+TEST(Simd, RejectsUnsupportedIsa) {
+  for (const auto isa : {ppc::simd::SimdIsa::kAvx2, ppc::simd::SimdIsa::kAvx512, ppc::simd::SimdIsa::kNeon}) {
+    if (!ppc::simd::IsSimdIsaSupported(isa)) {
+      EXPECT_THROW(ppc::simd::SetSimdIsa(isa), std::runtime_error);
+    }
+  }
+}
+
+TEST(Simd, ReductionsMatchScalarOnEveryIsa) {
+  // Sizes around the vector widths and unroll factors exercise every tail
+  for (const std::size_t size : {0U, 1U, 7U, 16U, 63U, 64U, 1001U}) {
+    const auto xf = MakeValues<float>(size, 0.5F);
+    const auto yf = MakeValues<float>(size, -0.25F);
+    const auto xd = MakeValues<double>(size, 0.5);
+    const auto yd = MakeValues<double>(size, -0.25);
+    double sum_ref = 0.0;
+    double dot_ref = 0.0;
+    for (std::size_t i = 0; i < size; i++) {
+      sum_ref += xd[i];
+      dot_ref += xd[i] * yd[i];
+    }
+    for (const auto isa : SupportedIsas()) {
+      const ppc::simd::ScopedSimdIsa scope(isa);
+      EXPECT_NEAR(ppc::simd::Sum(xf), sum_ref, 1e-3) << ppc::simd::SimdIsaToString(isa) << " size " << size;
+      EXPECT_NEAR(ppc::simd::Sum(xd), sum_ref, 1e-9) << ppc::simd::SimdIsaToString(isa) << " size " << size;
+      EXPECT_NEAR(ppc::simd::Dot(xf, yf), dot_ref, 1e-3) << ppc::simd::SimdIsaToString(isa) << " size " << size;
+      EXPECT_NEAR(ppc::simd::Dot(xd, yd), dot_ref, 1e-9) << ppc::simd::SimdIsaToString(isa) << " size " << size;
+    }
+  }
+}
+
+TEST(Simd, AxpyMatchesScalarOnEveryIsa) {
+  const auto x = MakeValues<double>(37, 1.0);
+  for (const auto isa : SupportedIsas()) {
+    const ppc::simd::ScopedSimdIsa scope(isa);
+    std::vector<double> y = MakeValues<double>(37, 2.0);
+    ppc::simd::Axpy(3.0, x, y);
+    for (std::size_t i = 0; i < y.size(); i++) {
+      EXPECT_DOUBLE_EQ(y[i], 5.0 * x[i]) << ppc::simd::SimdIsaToString(isa);
+    }
+  }
+}
+
+TEST(Simd, TransposeIsExactOnEveryIsa) {
+  const std::size_t rows = 37;
+  const std::size_t cols = 70;
+  const auto src = MakeValues<float>(rows * cols, 1.0F);
+  for (const auto isa : SupportedIsas()) {
+    const ppc::simd::ScopedSimdIsa scope(isa);
+    std::vector<float> dst(rows * cols);
+    ppc::simd::Transpose(src, rows, cols, dst);
+    for (std::size_t row = 0; row < rows; row++) {
+      for (std::size_t col = 0; col < cols; col++) {
+        ASSERT_EQ(dst[(col * rows) + row], src[(row * cols) + col]) << ppc::simd::SimdIsaToString(isa);
+      }
+    }
+  }
+}
+
+TEST(Simd, ConvolveMatchesDirectSumOnEveryIsa) {
+  const auto signal = MakeValues<double>(53, 1.0);
+  const std::vector<double> kernel = {0.25, 0.5, -1.0, 0.125, 2.0};
+  for (const auto isa : SupportedIsas()) {
+    const ppc::simd::ScopedSimdIsa scope(isa);
+    std::vector<double> out(signal.size() - kernel.size() + 1);
+    ppc::simd::Convolve(signal, kernel, out);
+    for (std::size_t i = 0; i < out.size(); i++) {
+      double expected = 0.0;
+      for (std::size_t tap = 0; tap < kernel.size(); tap++) {
+        expected += signal[i + tap] * kernel[tap];
+      }
+      EXPECT_NEAR(out[i], expected, 1e-12) << ppc::simd::SimdIsaToString(isa);
+    }
+  }
+}
+
+TEST(Simd, RejectsMismatchedSizes) {
+  const std::vector<float> four(4);
+  std::vector<float> three(3);
+  EXPECT_THROW((void)ppc::simd::Dot(four, three), std::runtime_error);
+  EXPECT_THROW(ppc::simd::Axpy(1.0F, four, three), std::runtime_error);
+  EXPECT_THROW(ppc::simd::Transpose(four, 3, 2, three), std::runtime_error);
+  EXPECT_THROW(ppc::simd::Convolve(three, four, three), std::runtime_error);
+}
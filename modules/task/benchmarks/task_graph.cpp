@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "task/include/graph.hpp"
+#include "task/include/task.hpp"
+
+// Whole filter -> transform -> reduce graph per iteration, with the Run() time of every node as a counter, i.e. the
+// scheduling and hand-off cost the graph adds on top of its tasks.
+
+namespace {
+
+using Values = std::vector<int64_t>;
+
+class KeepEven : public ppc::task::Task<Values, Values> {
+ public:
+  explicit KeepEven(Values in) {
+    GetInput() = std::move(in);
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return true;
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    GetOutput() = GetInput();
+    std::erase_if(GetOutput(), [](int64_t value) { return value % 2 != 0; });
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+class Square : public ppc::task::Task<Values, Values> {
+ public:
+  explicit Square(Values in) {
+    GetInput() = std::move(in);
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return true;
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    GetOutput() = std::move(GetInput());
+    for (int64_t &value : GetOutput()) {
+      value *= value;
+    }
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+class Sum : public ppc::task::Task<Values, int64_t> {
+ public:
+  explicit Sum(Values in) {
+    GetInput() = std::move(in);
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return true;
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    GetOutput() = std::accumulate(GetInput().begin(), GetInput().end(), int64_t{0});
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+/// The argument is the number of input elements; the second argument selects Run() (1) or RunSequential() (0).
+void TaskGraphChain(benchmark::State &state) {
+  Values input(static_cast<std::size_t>(state.range(0)));
+  std::iota(input.begin(), input.end(), int64_t{0});
+  ppc::task::Graph graph;
+  const auto filter = graph.AddTask("filter", std::make_unique<KeepEven>(std::move(input)));
+  const auto square = graph.AddTask<Square>("square");
+  const auto sum = graph.AddTask<Sum>("sum");
+  graph.Connect(filter, square);
+  graph.Connect(square, sum);
+  std::vector<double> run_seconds(graph.GetNodeTimings().size(), 0.0);
+  for (auto _ : state) {
+    if (state.range(1) != 0) {
+      graph.Run();
+    } else {
+      graph.RunSequential();
+    }
+    benchmark::DoNotOptimize(graph.GetOutput(sum));
+    const auto timings = graph.GetNodeTimings();
+    for (std::size_t i = 0; i < timings.size(); i++) {
+      run_seconds[i] += timings[i].run_seconds;
+    }
+  }
+  const auto timings = graph.GetNodeTimings();
+  for (std::size_t i = 0; i < timings.size(); i++) {
+    state.counters[timings[i].name + "_run_seconds"] =
+        benchmark::Counter(run_seconds[i], benchmark::Counter::kAvgIterations);
+  }
+}
+BENCHMARK(TaskGraphChain)->ArgsProduct({{1, 1 << 16}, {0, 1}});
+
+}  // namespace
@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+
+#include "task/include/static_task.hpp"
+#include "task/include/task.hpp"
+
+// Cost of the pipeline machinery around a task whose stages do no work, i.e. what the harness adds to every
+// measured stage of a real task.
+
+namespace {
+
+class EmptyTask : public ppc::task::Task<int, int> {
+ public:
+  explicit EmptyTask(int in) {
+    GetInput() = in;
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return true;
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    GetOutput() = GetInput();
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+class EmptyStaticTask : public ppc::task::StaticTask<EmptyStaticTask, int, int> {
+ public:
+  explicit EmptyStaticTask(int in) {
+    GetInput() = in;
+  }
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return ppc::task::TypeOfTask::kSEQ;
+  }
+
+  bool ValidationImpl() {
+    return true;
+  }
+
+  bool PreProcessingImpl() {
+    return true;
+  }
+
+  bool RunImpl() {
+    GetOutput() = GetInput();
+    return true;
+  }
+
+  bool PostProcessingImpl() {
+    return true;
+  }
+};
+
+void TaskPipeline(benchmark::State &state) {
+  EmptyTask task(1);
+  for (auto _ : state) {
+    task.Reset();
+    benchmark::DoNotOptimize(task.Validation() && task.PreProcessing() && task.Run() && task.PostProcessing());
+  }
+}
+BENCHMARK(TaskPipeline);
+
+/// Time of a single stage; the argument is the stage index from Validation (0) to PostProcessing (3).
+void TaskStage(benchmark::State &state) {
+  EmptyTask task(1);
+  const std::array<std::function<bool()>, 4> stages = {[&] { return task.Validation(); },
+                                                       [&] { return task.PreProcessing(); },
+                                                       [&] { return task.Run(); },
+                                                       [&] { return task.PostProcessing(); }};
+  const auto measured = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    task.Reset();
+    for (std::size_t stage = 0; stage < stages.size(); stage++) {
+      if (stage != measured) {
+        stages[stage]();
+        continue;
+      }
+      const auto begin = std::chrono::steady_clock::now();
+      benchmark::DoNotOptimize(stages[stage]());
+      state.SetIterationTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count());
+    }
+  }
+}
+BENCHMARK(TaskStage)->DenseRange(0, 3)->UseManualTime();
+
+void StaticTaskPipeline(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ppc::task::RunPipeline<EmptyStaticTask>(1));
+  }
+}
+BENCHMARK(StaticTaskPipeline);
+
+}  // namespace
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <mpi.h>
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "task/include/task.hpp"
+#include "util/include/decomposition.hpp"
+
+namespace ppc::task {
+
+/// @brief How BatchTask spreads independent instances.
+enum class BatchBackend : uint8_t {
+  /// Every instance in turn on the calling thread.
+  kSequential,
+  /// Instances are divided among TBB worker threads.
+  kThreads,
+  /// Every MPI rank processes a contiguous block of instances; outputs are then exchanged so that all ranks get all.
+  kProcesses,
+};
+
+/// @brief Runs many independent inputs through the pipeline of one task type.
+/// @details Each worker builds a single task from the factory and re-runs it after Task::Reset() for every further
+///          instance, so task construction and scratch allocations are paid once per worker instead of once per
+///          instance. The parallel backends require tasks that do not communicate themselves; MPI tasks run with
+///          kSequential on every rank. kProcesses exchanges outputs as raw bytes and needs a trivially copyable
+///          OutType and a batch whose outputs take at most INT_MAX bytes; without MPI it runs sequentially.
+/// @tparam InType Input type of one instance.
+/// @tparam OutType Output type of one instance.
+template <typename InType, typename OutType>
+class BatchTask {
+ public:
+  using TaskFactory = std::function<TaskPtr<InType, OutType>(InType)>;
+
+  explicit BatchTask(TaskFactory factory, BatchBackend backend = BatchBackend::kThreads)
+      : factory_(std::move(factory)), backend_(backend) {}
+
+  /// @brief Runs the full pipeline for every element of @p inputs.
+  /// @return Outputs in input order, on every rank.
+  /// @throws std::runtime_error If any stage of an instance reports failure; with kProcesses every rank throws.
+  std::vector<OutType> RunBatch(std::span<const InType> inputs) {
+    std::vector<OutType> outputs(inputs.size());
+    if (backend_ == BatchBackend::kThreads) {
+      tbb::parallel_for(tbb::blocked_range<std::size_t>(0, inputs.size()),
+                        [&](const tbb::blocked_range<std::size_t> &range) {
+                          TaskPtr<InType, OutType> &task = thread_tasks_.local();
+                          for (std::size_t i = range.begin(); i != range.end(); i++) {
+                            outputs[i] = RunInstance(task, inputs[i], i);
+                          }
+                        });
+    } else if (backend_ == BatchBackend::kProcesses) {
+      RunOnRanks(inputs, outputs);
+    } else {
+      for (std::size_t i = 0; i < inputs.size(); i++) {
+        outputs[i] = RunInstance(task_, inputs[i], i);
+      }
+    }
+    return outputs;
+  }
+
+  /// @brief Testing mode applied to every task built by this batch.
+  StateOfTesting &GetStateOfTesting() {
+    return state_of_testing_;
+  }
+
+  [[nodiscard]] BatchBackend GetBackend() const {
+    return backend_;
+  }
+
+ private:
+  OutType RunInstance(TaskPtr<InType, OutType> &task, const InType &input, std::size_t index) {
+    if (task) {
+      task->Reset();
+      task->GetInput() = input;
+    } else {
+      task = factory_(input);
+    }
+    try {
+      task->GetStateOfTesting() = state_of_testing_;
+      if (!task->Validation() || !task->PreProcessing() || !task->Run() || !task->PostProcessing()) {
+        throw std::runtime_error("Batch instance " + std::to_string(index) + " failed");
+      }
+    } catch (...) {
+      // A task stopped mid-pipeline cannot be reset, so the next instance of this worker builds a new one
+      task->MarkFailed();
+      task.reset();
+      throw;
+    }
+    return std::move(task->GetOutput());
+  }
+
+  void RunOnRanks(std::span<const InType> inputs, std::vector<OutType> &outputs) {
+    if constexpr (std::is_trivially_copyable_v<OutType> && !std::is_same_v<OutType, bool>) {
+      int initialized = 0;
+      MPI_Initialized(&initialized);
+      if (initialized == 0) {
+        for (std::size_t i = 0; i < inputs.size(); i++) {
+          outputs[i] = RunInstance(task_, inputs[i], i);
+        }
+        return;
+      }
+      // Every rank sees the same batch size, so all of them reject an oversized batch before running anything
+      if (inputs.size() > static_cast<std::size_t>(INT_MAX) / sizeof(OutType)) {
+        throw std::runtime_error("BatchBackend::kProcesses supports at most INT_MAX bytes of outputs per batch");
+      }
+      int rank = 0;
+      int size = 1;
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      MPI_Comm_size(MPI_COMM_WORLD, &size);
+      std::vector<int> counts(static_cast<std::size_t>(size));
+      std::vector<int> displacements(static_cast<std::size_t>(size));
+      for (std::size_t proc = 0; proc < counts.size(); proc++) {
+        const auto block = ppc::util::BlockPartition(static_cast<int64_t>(inputs.size()), size, static_cast<int>(proc));
+        counts[proc] = static_cast<int>(static_cast<std::size_t>(block.count) * sizeof(OutType));
+        displacements[proc] = static_cast<int>(static_cast<std::size_t>(block.begin) * sizeof(OutType));
+      }
+      std::exception_ptr error;
+      try {
+        const auto block = ppc::util::BlockPartition(static_cast<int64_t>(inputs.size()), size, rank);
+        for (auto i = static_cast<std::size_t>(block.begin); i < static_cast<std::size_t>(block.End()); i++) {
+          outputs[i] = RunInstance(task_, inputs[i], i);
+        }
+      } catch (...) {
+        error = std::current_exception();
+      }
+      // Agree on the outcome first, so that a failure on one rank does not leave the others in the gather
+      int local_ok = error ? 0 : 1;
+      int all_ok = 0;
+      MPI_Allreduce(&local_ok, &all_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+      if (error) {
+        std::rethrow_exception(error);
+      }
+      if (all_ok == 0) {
+        throw std::runtime_error("Batch instance failed on another rank");
+      }
+      MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, outputs.data(), counts.data(), displacements.data(), MPI_BYTE,
+                     MPI_COMM_WORLD);
+    } else {
+      throw std::runtime_error("BatchBackend::kProcesses requires a trivially copyable output type other than bool");
+    }
+  }
+
+  TaskFactory factory_;
+  BatchBackend backend_;
+  StateOfTesting state_of_testing_ = StateOfTesting::kFunc;
+  TaskPtr<InType, OutType> task_;
+  tbb::enumerable_thread_specific<TaskPtr<InType, OutType>> thread_tasks_;
+};
+
+}  // namespace ppc::task
@@ -0,0 +1,329 @@
+#pragma once
+
+#include <tbb/flow_graph.h>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "task/include/task.hpp"
+
+namespace ppc::task {
+
+namespace detail {
+
+template <typename InType, typename OutType>
+std::pair<InType, OutType> TaskIoOf(const Task<InType, OutType> *);
+
+}  // namespace detail
+
+/// @brief Input type of a task derived from ppc::task::Task.
+template <typename TaskType>
+using TaskInType = typename decltype(detail::TaskIoOf(std::declval<TaskType *>()))::first_type;
+
+/// @brief Output type of a task derived from ppc::task::Task.
+template <typename TaskType>
+using TaskOutType = typename decltype(detail::TaskIoOf(std::declval<TaskType *>()))::second_type;
+
+/// @brief Directed acyclic graph of tasks in which the output of a node becomes the input of its successors.
+/// @details A source node owns a task built up front; every other node builds its task from the output of its single
+///          upstream node once that node has finished, so a filter -> transform -> reduce chain is three nodes and two
+///          edges. The output is moved to the last successor and copied only for the others when a node fans out.
+///          Run() executes independent nodes concurrently on a TBB flow graph; RunSequential() executes them one by
+///          one in the same topological order on every rank. Run() rejects MPI and ALL nodes, because concurrent
+///          nodes would issue collectives on the same communicator at once; graphs with such nodes use RunSequential().
+class Graph {
+ public:
+  template <typename InType, typename OutType>
+  using TaskFactory = std::function<TaskPtr<InType, OutType>(InType)>;
+
+  /// @brief Typed handle of a node; Connect() only accepts edges whose output and input types match.
+  template <typename InType, typename OutType>
+  class Node {
+   public:
+    [[nodiscard]] std::size_t Id() const {
+      return id_;
+    }
+
+   private:
+    friend class Graph;
+    explicit Node(std::size_t id) : id_(id) {}
+
+    std::size_t id_;
+  };
+
+  /// @brief Wall time one node spent in the last run of the graph.
+  struct NodeTiming {
+    std::string name;
+    /// @brief Seconds spent in Task::Run().
+    double run_seconds = 0.0;
+    /// @brief Seconds from building the task to handing its output downstream.
+    double total_seconds = 0.0;
+  };
+
+  /// @brief Adds a source node that runs @p task; a source is reset and run again on every run of the graph.
+  template <typename TaskType>
+  Node<TaskInType<TaskType>, TaskOutType<TaskType>> AddTask(std::string name, std::unique_ptr<TaskType> task) {
+    using InType = TaskInType<TaskType>;
+    using OutType = TaskOutType<TaskType>;
+    if (!task) {
+      throw std::runtime_error("Task graph node '" + name + "' has no task");
+    }
+    auto node = std::make_unique<NodeImpl<InType, OutType>>(std::move(name));
+    node->task_type = task->GetDynamicTypeOfTask();
+    node->task = std::move(task);
+    return Node<InType, OutType>(Insert(std::move(node)));
+  }
+
+  /// @brief Adds a node whose task is built by @p factory from the output of the node connected to it.
+  /// @param task_type Backend of the built task, if known; Run() then rejects MPI and ALL before building anything.
+  template <typename InType, typename OutType>
+  Node<InType, OutType> AddTask(std::string name, TaskFactory<InType, OutType> factory,
+                                TypeOfTask task_type = TypeOfTask::kUnknown) {
+    if (!factory) {
+      throw std::runtime_error("Task graph node '" + name + "' has no task factory");
+    }
+    auto node = std::make_unique<NodeImpl<InType, OutType>>(std::move(name));
+    node->factory = std::move(factory);
+    node->task_type = task_type;
+    return Node<InType, OutType>(Insert(std::move(node)));
+  }
+
+  /// @brief Adds a node that constructs TaskType from the output of the node connected to it.
+  template <typename TaskType>
+  Node<TaskInType<TaskType>, TaskOutType<TaskType>> AddTask(std::string name) {
+    using InType = TaskInType<TaskType>;
+    using OutType = TaskOutType<TaskType>;
+    return AddTask<InType, OutType>(
+        std::move(name),
+        [](InType in) -> TaskPtr<InType, OutType> { return TaskGetter<TaskType>(std::move(in)); },
+        TaskType::GetStaticTypeOfTask());
+  }
+
+  /// @brief Feeds the output of @p from into @p to.
+  /// @throws std::runtime_error If @p to is a source or already has an upstream node.
+  template <typename InType, typename MidType, typename OutType>
+  void Connect(Node<InType, MidType> from, Node<MidType, OutType> to) {
+    auto &producer = Get(from);
+    auto &consumer = Get(to);
+    if (consumer.IsSource()) {
+      throw std::runtime_error("Task graph node '" + consumer.name + "' is a source and cannot have an input");
+    }
+    if (consumer.num_predecessors != 0) {
+      throw std::runtime_error("Task graph node '" + consumer.name + "' already has an input");
+    }
+    consumer.num_predecessors++;
+    producer.successors.push_back(to.id_);
+    producer.deliver.emplace_back([&consumer](MidType &&value) { consumer.pending_input.emplace(std::move(value)); });
+  }
+
+  /// @brief Runs every node once, independent nodes concurrently.
+  /// @details A task whose stage fails is marked failed; a failed source cannot run again.
+  /// @throws std::runtime_error If the graph is incomplete or cyclic, a stage fails, or a node is an MPI or ALL task.
+  void Run() {
+    (void)TopologicalOrder();
+    for (const auto &node : nodes_) {
+      RejectMpiTask(node->task_type, node->name);
+    }
+    tbb::flow::graph flow;
+    using FlowNode = tbb::flow::continue_node<tbb::flow::continue_msg>;
+    std::vector<std::unique_ptr<FlowNode>> flow_nodes;
+    flow_nodes.reserve(nodes_.size());
+    for (const auto &node : nodes_) {
+      flow_nodes.push_back(std::make_unique<FlowNode>(flow, [&node, this](const tbb::flow::continue_msg &) {
+        node->Execute(state_of_testing_, true);
+      }));
+    }
+    for (std::size_t id = 0; id < nodes_.size(); id++) {
+      for (const std::size_t successor : nodes_[id]->successors) {
+        tbb::flow::make_edge(*flow_nodes[id], *flow_nodes[successor]);
+      }
+    }
+    for (std::size_t id = 0; id < nodes_.size(); id++) {
+      if (nodes_[id]->num_predecessors == 0) {
+        flow_nodes[id]->try_put(tbb::flow::continue_msg());
+      }
+    }
+    flow.wait_for_all();
+  }
+
+  /// @brief Runs every node once on the calling thread in a topological order that is the same on every rank.
+  /// @throws std::runtime_error If the graph is incomplete or cyclic, or a stage fails.
+  void RunSequential() {
+    for (const std::size_t id : TopologicalOrder()) {
+      nodes_[id]->Execute(state_of_testing_, false);
+    }
+  }
+
+  /// @brief Output of @p node after the last run; only nodes without successors keep theirs.
+  /// @throws std::runtime_error If the node has not run yet.
+  template <typename InType, typename OutType>
+  OutType &GetOutput(Node<InType, OutType> node) {
+    auto &impl = Get(node);
+    if (!impl.task || !impl.finished) {
+      throw std::runtime_error("Task graph node '" + impl.name + "' has not run");
+    }
+    return impl.task->GetOutput();
+  }
+
+  /// @brief Timings of the last run, one entry per node in the order the nodes were added.
+  [[nodiscard]] std::vector<NodeTiming> GetNodeTimings() const {
+    std::vector<NodeTiming> timings;
+    timings.reserve(nodes_.size());
+    for (const auto &node : nodes_) {
+      timings.push_back(node->timing);
+    }
+    return timings;
+  }
+
+  /// @brief Testing mode applied to every task of the graph.
+  StateOfTesting &GetStateOfTesting() {
+    return state_of_testing_;
+  }
+
+ private:
+  struct NodeBase {
+    explicit NodeBase(std::string node_name) : name(std::move(node_name)) {
+      timing.name = name;
+    }
+    NodeBase(const NodeBase &) = delete;
+    NodeBase &operator=(const NodeBase &) = delete;
+    NodeBase(NodeBase &&) = delete;
+    NodeBase &operator=(NodeBase &&) = delete;
+    virtual ~NodeBase() = default;
+
+    /// Builds or resets the task, runs its pipeline and hands the output to the successors.
+    virtual void Execute(StateOfTesting state_of_testing, bool concurrent) = 0;
+    [[nodiscard]] virtual bool IsSource() const = 0;
+
+    std::string name;
+    /// Backend of the task when known before it is built.
+    TypeOfTask task_type = TypeOfTask::kUnknown;
+    std::vector<std::size_t> successors;
+    std::size_t num_predecessors = 0;
+    NodeTiming timing;
+  };
+
+  template <typename InType, typename OutType>
+  struct NodeImpl final : NodeBase {
+    using NodeBase::NodeBase;
+
+    void Execute(StateOfTesting state_of_testing, bool concurrent) override {
+      using Clock = std::chrono::steady_clock;
+      const auto begin = Clock::now();
+      finished = false;
+      if (factory) {
+        if (!pending_input) {
+          throw std::runtime_error("Task graph node '" + name + "' received no input");
+        }
+        task = factory(std::move(*pending_input));
+        pending_input.reset();
+      } else if (ran) {
+        task->Reset();
+      }
+      ran = true;
+      try {
+        if (concurrent) {
+          RejectMpiTask(task->GetDynamicTypeOfTask(), name);
+        }
+        task->GetStateOfTesting() = state_of_testing;
+        Expect(task->Validation() && task->PreProcessing());
+        const auto run_begin = Clock::now();
+        Expect(task->Run());
+        timing.run_seconds = std::chrono::duration<double>(Clock::now() - run_begin).count();
+        Expect(task->PostProcessing());
+      } catch (...) {
+        // A built task is released; a source keeps its task, which can no longer be reset
+        task->MarkFailed();
+        if (factory) {
+          task.reset();
+        }
+        throw;
+      }
+      finished = true;
+      if (!deliver.empty()) {
+        for (std::size_t i = 0; i + 1 < deliver.size(); i++) {
+          deliver[i](OutType(task->GetOutput()));
+        }
+        deliver.back()(std::move(task->GetOutput()));
+      }
+      timing.total_seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+    }
+
+    [[nodiscard]] bool IsSource() const override {
+      return !factory;
+    }
+
+    void Expect(bool stage_succeeded) const {
+      if (!stage_succeeded) {
+        throw std::runtime_error("Task graph node '" + name + "' failed");
+      }
+    }
+
+    TaskFactory<InType, OutType> factory;
+    std::optional<InType> pending_input;
+    TaskPtr<InType, OutType> task;
+    std::vector<std::function<void(OutType &&)>> deliver;
+    bool ran = false;
+    bool finished = false;
+  };
+
+  static void RejectMpiTask(TypeOfTask task_type, const std::string &name) {
+    if (task_type == TypeOfTask::kMPI || task_type == TypeOfTask::kALL) {
+      throw std::runtime_error("Task graph node '" + name + "' is an MPI task; use RunSequential()");
+    }
+  }
+
+  std::size_t Insert(std::unique_ptr<NodeBase> node) {
+    nodes_.push_back(std::move(node));
+    return nodes_.size() - 1;
+  }
+
+  template <typename InType, typename OutType>
+  NodeImpl<InType, OutType> &Get(Node<InType, OutType> node) {
+    if (node.id_ >= nodes_.size()) {
+      throw std::runtime_error("Task graph node " + std::to_string(node.id_) + " does not exist");
+    }
+    return static_cast<NodeImpl<InType, OutType> &>(*nodes_[node.id_]);
+  }
+
+  /// Kahn's order: sources in insertion order, then every node as soon as its input is ready, following the
+  /// successor lists. It depends only on the graph, so every rank executes the nodes identically.
+  [[nodiscard]] std::vector<std::size_t> TopologicalOrder() const {
+    std::vector<std::size_t> pending(nodes_.size());
+    std::vector<std::size_t> order;
+    order.reserve(nodes_.size());
+    for (std::size_t id = 0; id < nodes_.size(); id++) {
+      const auto &node = *nodes_[id];
+      pending[id] = node.num_predecessors;
+      if (node.num_predecessors == 0) {
+        if (!node.IsSource()) {
+          throw std::runtime_error("Task graph node '" + node.name + "' has no input");
+        }
+        order.push_back(id);
+      }
+    }
+    for (std::size_t next = 0; next < order.size(); next++) {
+      for (const std::size_t successor : nodes_[order[next]]->successors) {
+        if (--pending[successor] == 0) {
+          order.push_back(successor);
+        }
+      }
+    }
+    if (order.size() != nodes_.size()) {
+      throw std::runtime_error("Task graph has a cycle");
+    }
+    return order;
+  }
+
+  std::vector<std::unique_ptr<NodeBase>> nodes_;
+  StateOfTesting state_of_testing_ = StateOfTesting::kFunc;
+};
+
+}  // namespace ppc::task
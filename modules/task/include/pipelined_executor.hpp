@@ -0,0 +1,134 @@
+#pragma once
+
+#include <tbb/parallel_pipeline.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "task/include/task.hpp"
+
+namespace ppc::task {
+
+/// @brief Streams consecutive tasks through their pipelines with the stages of neighbouring tasks overlapped.
+/// @details Validation and PreProcessing of task N+1, Run() of task N and PostProcessing of task N-1 execute at the
+///          same time on TBB threads. Each stage group is serial and in order, so every task still goes through its
+///          own stage checks and outputs arrive in input order. MPI and ALL tasks are always rejected: the runners
+///          initialize MPI without thread support, and even under MPI_THREAD_MULTIPLE the collectives of tasks in
+///          different stages would run concurrently on the same communicator, which MPI does not allow.
+/// @tparam InType Input type of one task.
+/// @tparam OutType Output type of one task.
+template <typename InType, typename OutType>
+class PipelinedExecutor {
+ public:
+  using TaskFactory = std::function<TaskPtr<InType, OutType>(InType)>;
+
+  /// @param max_in_flight Largest number of tasks alive at once; at least three are needed for full overlap.
+  /// @param task_type Backend of the tasks built by @p factory, if known. MPI and ALL are then rejected before any
+  ///        task is built; otherwise the backend of every built task is checked.
+  explicit PipelinedExecutor(TaskFactory factory, std::size_t max_in_flight = 3,
+                             TypeOfTask task_type = TypeOfTask::kUnknown)
+      : factory_(std::move(factory)), max_in_flight_(std::max<std::size_t>(max_in_flight, 1)), task_type_(task_type) {}
+
+  /// @brief Pulls inputs from @p next_input until it returns std::nullopt and hands every output to @p consume.
+  /// @details @p next_input and @p consume are never called concurrently with themselves.
+  /// @throws std::runtime_error If a stage of any task reports failure, or a task is an MPI or ALL task.
+  void RunStream(const std::function<std::optional<InType>()> &next_input,
+                 const std::function<void(OutType &&)> &consume) {
+    RejectMpiTasks(task_type_);
+    using Item = std::shared_ptr<InFlightTask>;
+    std::size_t next_index = 0;
+    auto prepare = [&](tbb::flow_control &control) -> Item {
+      std::optional<InType> input = next_input();
+      if (!input) {
+        control.stop();
+        return nullptr;
+      }
+      auto item = std::make_shared<InFlightTask>(next_index++, factory_(std::move(*input)));
+      RejectMpiTasks(item->task->GetDynamicTypeOfTask());
+      item->task->GetStateOfTesting() = state_of_testing_;
+      Expect(item->task->Validation() && item->task->PreProcessing(), *item);
+      return item;
+    };
+    auto run = [](Item item) -> Item {
+      Expect(item->task->Run(), *item);
+      return item;
+    };
+    auto finish = [&](const Item &item) {
+      Expect(item->task->PostProcessing(), *item);
+      item->finished = true;
+      consume(std::move(item->task->GetOutput()));
+    };
+    constexpr auto kInOrder = tbb::filter_mode::serial_in_order;
+    tbb::parallel_pipeline(max_in_flight_, tbb::make_filter<void, Item>(kInOrder, prepare) &
+                                               tbb::make_filter<Item, Item>(kInOrder, run) &
+                                               tbb::make_filter<Item, void>(kInOrder, finish));
+  }
+
+  /// @brief Runs every element of @p inputs and returns the outputs in input order.
+  std::vector<OutType> Run(std::span<const InType> inputs) {
+    std::vector<OutType> outputs;
+    outputs.reserve(inputs.size());
+    std::size_t next = 0;
+    RunStream(
+        [&]() -> std::optional<InType> {
+          if (next == inputs.size()) {
+            return std::nullopt;
+          }
+          return inputs[next++];
+        },
+        [&](OutType &&output) { outputs.push_back(std::move(output)); });
+    return outputs;
+  }
+
+  /// @brief Testing mode applied to every task built by this executor.
+  StateOfTesting &GetStateOfTesting() {
+    return state_of_testing_;
+  }
+
+ private:
+  /// A task between its factory call and its output; dropped unfinished when the stream is cancelled by a failure.
+  struct InFlightTask {
+    InFlightTask(std::size_t task_index, TaskPtr<InType, OutType> in_flight_task)
+        : index(task_index), task(std::move(in_flight_task)) {}
+    InFlightTask(const InFlightTask &) = delete;
+    InFlightTask &operator=(const InFlightTask &) = delete;
+    InFlightTask(InFlightTask &&) = delete;
+    InFlightTask &operator=(InFlightTask &&) = delete;
+    ~InFlightTask() {
+      if (task && !finished) {
+        task->MarkFailed();
+      }
+    }
+
+    std::size_t index;
+    TaskPtr<InType, OutType> task;
+    bool finished = false;
+  };
+
+  static void Expect(bool stage_succeeded, const InFlightTask &item) {
+    if (!stage_succeeded) {
+      throw std::runtime_error("Pipelined task " + std::to_string(item.index) + " failed");
+    }
+  }
+
+  static void RejectMpiTasks(TypeOfTask task_type) {
+    if (task_type == TypeOfTask::kMPI || task_type == TypeOfTask::kALL) {
+      throw std::runtime_error("Pipelined execution does not support MPI or ALL tasks; run them one at a time");
+    }
+  }
+
+  TaskFactory factory_;
+  std::size_t max_in_flight_;
+  TypeOfTask task_type_;
+  StateOfTesting state_of_testing_ = StateOfTesting::kFunc;
+};
+
+}  // namespace ppc::task
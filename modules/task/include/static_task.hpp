@@ -0,0 +1,168 @@
+#pragma once
+
+#include <concepts>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "task/include/task.hpp"
+#include "util/include/scratch_arena.hpp"
+#include "util/include/trace.hpp"
+
+namespace ppc::task {
+
+/// @brief CRTP base of a task whose stages are resolved at compile time.
+/// @details Derived implements public ValidationImpl(), PreProcessingImpl(), RunImpl() and PostProcessingImpl()
+///          and may hide GetStaticTypeOfTask() and ResetOutput(). Stages are only reachable through RunStages() and
+///          RunPipeline(), which call them in order, so there is no virtual call, no heap allocation and no stage
+///          bookkeeping. Wrap the task in StaticTaskAdapter where a TaskPtr is required.
+/// @tparam Derived The task type itself.
+/// @tparam InType Input data type.
+/// @tparam OutType Output data type.
+template <typename Derived, typename InType, typename OutType>
+class StaticTask {
+ public:
+  using InputType = InType;
+  using OutputType = OutType;
+
+  static constexpr TypeOfTask GetStaticTypeOfTask() {
+    return TypeOfTask::kUnknown;
+  }
+
+  InType &GetInput() {
+    return input_;
+  }
+
+  OutType &GetOutput() {
+    return output_;
+  }
+
+  ppc::util::ScratchArena &GetScratchArena() {
+    return scratch_arena_;
+  }
+
+  /// @brief Restores the output before the task is run again; value-initializes it by default.
+  void ResetOutput() {
+    output_ = OutType{};
+  }
+
+ private:
+  InType input_{};
+  OutType output_{};
+  ppc::util::ScratchArena scratch_arena_;
+};
+
+template <typename T>
+concept StaticPipelineTask =
+    std::derived_from<T, StaticTask<T, typename T::InputType, typename T::OutputType>> && requires(T &task) {
+      { task.ValidationImpl() } -> std::convertible_to<bool>;
+      { task.PreProcessingImpl() } -> std::convertible_to<bool>;
+      { task.RunImpl() } -> std::convertible_to<bool>;
+      { task.PostProcessingImpl() } -> std::convertible_to<bool>;
+    };
+
+/// @brief Runs the four stages of @p task in order, stopping at the first that fails.
+/// @return True if every stage succeeded.
+template <StaticPipelineTask T>
+bool RunStages(T &task) {
+  {
+    const ppc::util::TraceScope trace("Validation", "task");
+    if (!task.ValidationImpl()) {
+      return false;
+    }
+  }
+  {
+    const ppc::util::TraceScope trace("PreProcessing", "task");
+    if (!task.PreProcessingImpl()) {
+      return false;
+    }
+  }
+  {
+    const ppc::util::TraceScope trace("Run", "task");
+    if (!task.RunImpl()) {
+      return false;
+    }
+  }
+  const ppc::util::TraceScope trace("PostProcessing", "task");
+  return task.PostProcessingImpl();
+}
+
+/// @brief Builds a T on the stack from @p in, runs its pipeline and returns the output.
+/// @throws std::runtime_error If a stage fails.
+template <StaticPipelineTask T>
+typename T::OutputType RunPipeline(typename T::InputType in) {
+  T task(std::move(in));
+  if (!RunStages(task)) {
+    throw std::runtime_error("Static task pipeline failed");
+  }
+  return std::move(task.GetOutput());
+}
+
+/// @brief Exposes a StaticTask through the virtual Task interface used by the test runners, BatchTask and
+///        PipelinedExecutor.
+/// @details The Task keeps its stage checks and timing; the wrapped task is built from a copy of the Task input,
+///          receives a fresh copy at the Validation() of every later run and hands over its output at
+///          PostProcessing().
+template <StaticPipelineTask T>
+class StaticTaskAdapter final : public Task<typename T::InputType, typename T::OutputType> {
+ public:
+  using InType = typename T::InputType;
+
+  explicit StaticTaskAdapter(InType in) : impl_(StoreInput(std::move(in))) {
+    this->SetTypeOfTask(T::GetStaticTypeOfTask());
+    this->GetOutput() = impl_.GetOutput();
+  }
+
+  static constexpr TypeOfTask GetStaticTypeOfTask() {
+    return T::GetStaticTypeOfTask();
+  }
+
+ protected:
+  void ResetOutput() override {
+    impl_.GetScratchArena().Release();
+    impl_.ResetOutput();
+    this->GetOutput() = impl_.GetOutput();
+    // The run may have changed the wrapped input, and the Task input may be replaced before the next one
+    impl_input_current_ = false;
+  }
+
+  bool ValidationImpl() override {
+    if (!impl_input_current_) {
+      impl_.GetInput() = this->GetInput();
+      impl_input_current_ = true;
+    }
+    return impl_.ValidationImpl();
+  }
+
+  bool PreProcessingImpl() override {
+    return impl_.PreProcessingImpl();
+  }
+
+  bool RunImpl() override {
+    return impl_.RunImpl();
+  }
+
+  bool PostProcessingImpl() override {
+    const bool ok = impl_.PostProcessingImpl();
+    this->GetOutput() = std::move(impl_.GetOutput());
+    return ok;
+  }
+
+ private:
+  /// Moves @p in into the Task input, from which the wrapped task is then built.
+  const InType &StoreInput(InType in) {
+    this->GetInput() = std::move(in);
+    return this->GetInput();
+  }
+
+  T impl_;
+  bool impl_input_current_ = true;
+};
+
+/// @brief TaskPtr holding a StaticTaskAdapter<T>, for task lists such as MakeAllFuncTasks().
+template <StaticPipelineTask T>
+TaskPtr<typename T::InputType, typename T::OutputType> MakeStaticTaskAdapter(typename T::InputType in) {
+  return std::make_unique<StaticTaskAdapter<T>>(std::move(in));
+}
+
+}  // namespace ppc::task
@@ -6,13 +6,14 @@
 #include <chrono>
 #include <cstdint>
 #include <cstdlib>
-#include <fstream>
 #include <iostream>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <util/include/scratch_arena.hpp>
+#include <util/include/trace.hpp>
 #include <util/include/util.hpp>
 #include <utility>
 
@@ -33,19 +34,22 @@ enum class TypeOfTask : uint8_t {
   kSTL,
   /// Intel Threading Building Blocks (TBB)
   kTBB,
+  /// OpenMP target offload to an accelerator; target regions run on the host when no device is present
+  kOffload,
   /// Unknown task type
   kUnknown,
 };
 
 using TaskMapping = std::pair<TypeOfTask, std::string_view>;
-using TaskMappingArray = std::array<TaskMapping, 6>;
+using TaskMappingArray = std::array<TaskMapping, 7>;
 
 inline constexpr TaskMappingArray kTaskTypeMappings = {{{TypeOfTask::kALL, "all"},
                                                         {TypeOfTask::kMPI, "mpi"},
                                                         {TypeOfTask::kOMP, "omp"},
                                                         {TypeOfTask::kSEQ, "seq"},
                                                         {TypeOfTask::kSTL, "stl"},
-                                                        {TypeOfTask::kTBB, "tbb"}}};
+                                                        {TypeOfTask::kTBB, "tbb"},
+                                                        {TypeOfTask::kOffload, "offload"}}};
 
 constexpr std::string_view TypeOfTaskToString(TypeOfTask type) {
   for (const auto &[key, value] : kTaskTypeMappings) {
@@ -137,13 +141,7 @@ struct TaskDescriptor {
 /// @throws std::runtime_error If the file cannot be opened or the requested settings key is missing.
 inline StatusOfTask GetTaskStatus(TypeOfTask type_of_task, const std::string &settings_file_path,
                                   std::string_view settings_task_path = {}) {
-  std::ifstream file(settings_file_path);
-  if (!file.is_open()) {
-    throw std::runtime_error("Failed to open " + settings_file_path);
-  }
-
-  auto list_settings = ppc::util::InitJSONPtr();
-  file >> *list_settings;
+  const auto list_settings = ppc::util::LoadSettingsJson(settings_file_path);
 
   const std::string_view type_str = TypeOfTaskToString(type_of_task);
   if (type_str == "unknown") {
@@ -212,6 +210,7 @@ class Task {
       stage_ = PipelineStage::kException;
       throw std::runtime_error("Validation should be called before preprocessing");
     }
+    const ppc::util::TraceScope trace("Validation", "task");
     return ValidationImpl();
   }
 
@@ -227,6 +226,7 @@ class Task {
     if (state_of_testing_ == StateOfTesting::kFunc) {
       InternalTimeTest();
     }
+    const ppc::util::TraceScope trace("PreProcessing", "task");
     return PreProcessingImpl();
   }
 
@@ -239,6 +239,7 @@ class Task {
       stage_ = PipelineStage::kException;
       throw std::runtime_error("Run should be called after preprocessing");
     }
+    const ppc::util::TraceScope trace("Run", "task");
     return RunImpl();
   }
 
@@ -254,9 +255,32 @@ class Task {
     if (state_of_testing_ == StateOfTesting::kFunc) {
       InternalTimeTest();
     }
+    const ppc::util::TraceScope trace("PostProcessing", "task");
     return PostProcessingImpl();
   }
 
+  /// @brief Returns a finished task to its initial stage so the pipeline can be executed again.
+  /// @details Keeps the input, restores the output through ResetOutput() and releases the scratch arena.
+  /// @throws std::runtime_error If called while the pipeline is in progress.
+  virtual void Reset() final {
+    if (stage_ != PipelineStage::kNone && stage_ != PipelineStage::kDone) {
+      stage_ = PipelineStage::kException;
+      throw std::runtime_error("Reset should be called before validation or after postprocessing");
+    }
+    stage_ = PipelineStage::kNone;
+    scratch_arena_.Release();
+    ResetOutput();
+  }
+
+  /// @brief Ends a pipeline that will not be completed, e.g. because one of its stages failed.
+  /// @details The task can then be destroyed without being reported as incomplete, but not reset. A finished
+  ///          pipeline is left as it is.
+  virtual void MarkFailed() final {
+    if (stage_ != PipelineStage::kDone) {
+      stage_ = PipelineStage::kException;
+    }
+  }
+
   /// @brief Returns the current testing mode.
   /// @return Reference to the current StateOfTesting.
   StateOfTesting &GetStateOfTesting() {
@@ -299,6 +323,12 @@ class Task {
     return output_;
   }
 
+  /// @brief Returns the per-thread scratch memory of this task.
+  /// @details Released by Reset(); use ppc::util::ScratchArena::Scope for buffers local to a loop body.
+  ppc::util::ScratchArena &GetScratchArena() {
+    return scratch_arena_;
+  }
+
   /// @brief Destructor. Verifies that the pipeline was executed in the correct order.
   /// @note Terminates the program if the pipeline order is incorrect or incomplete.
   virtual ~Task() {
@@ -337,6 +367,12 @@ class Task {
     }
   }
 
+  /// @brief Restores the output to the state expected by ValidationImpl().
+  /// @details Called by Reset(). The default implementation value-initializes the output.
+  virtual void ResetOutput() {
+    output_ = OutType{};
+  }
+
   /// @brief User-defined validation logic.
   /// @return True if validation is successful.
   virtual bool ValidationImpl() = 0;
@@ -360,6 +396,7 @@ class Task {
   TypeOfTask type_of_task_ = TypeOfTask::kUnknown;
   StatusOfTask status_of_task_ = StatusOfTask::kEnabled;
   std::chrono::high_resolution_clock::time_point tmp_time_point_;
+  ppc::util::ScratchArena scratch_arena_;
   enum class PipelineStage : uint8_t {
     kNone,
     kValidation,
@@ -377,13 +414,15 @@ template <typename InType, typename OutType>
 using TaskPtr = std::unique_ptr<Task<InType, OutType>>;
 
 /// @brief Constructs and returns a pointer to a task with the given input.
+/// @details The input is moved into the task constructor, so a task that accepts `InType` by value
+///          (or by rvalue reference) and moves it into GetInput() is created without copying the input.
 /// @tparam TaskType Type of the task to create.
 /// @tparam InType Type of the input.
 /// @param in Input to pass to the task constructor.
 /// @return Unique pointer to the newly created task.
 template <typename TaskType, typename InType>
-std::unique_ptr<TaskType> TaskGetter(const InType &in) {
-  return std::make_unique<TaskType>(in);
+std::unique_ptr<TaskType> TaskGetter(InType in) {
+  return std::make_unique<TaskType>(std::move(in));
 }
 
 }  // namespace ppc::task
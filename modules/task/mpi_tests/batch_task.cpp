@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "task/include/batch_task.hpp"
+#include "task/include/task.hpp"
+
+namespace {
+
+class SquareTask : public ppc::task::Task<int, int> {
+ public:
+  explicit SquareTask(int in) {
+    SetTypeOfTask(ppc::task::TypeOfTask::kSEQ);
+    GetInput() = in;
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return GetInput() >= 0;
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    GetOutput() = GetInput() * GetInput();
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+ppc::task::TaskPtr<int, int> MakeSquareTask(int in) {
+  return std::make_unique<SquareTask>(in);
+}
+
+}  // namespace
+
+TEST(BatchTaskRanks, EveryRankThrowsWhenOneRankFails) {
+  // The last instance belongs to the last rank, so the other ranks succeed locally and must not wait in the gather
+  std::vector<int> inputs(11, 3);
+  inputs.back() = -1;
+  ppc::task::BatchTask<int, int> batch(MakeSquareTask, ppc::task::BatchBackend::kProcesses);
+  EXPECT_THROW(batch.RunBatch(inputs), std::runtime_error);
+
+  inputs.back() = 3;
+  const std::vector<int> outputs = batch.RunBatch(inputs);
+  ASSERT_EQ(outputs.size(), inputs.size());
+  for (std::size_t i = 0; i < outputs.size(); i++) {
+    EXPECT_EQ(outputs[i], 9);
+  }
+}
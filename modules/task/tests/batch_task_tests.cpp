@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "task/include/batch_task.hpp"
+#include "task/include/task.hpp"
+#include "util/include/util.hpp"
+
+namespace {
+
+std::atomic<int> constructed_tasks{0};
+
+class SquareTask : public ppc::task::Task<int, int> {
+ public:
+  explicit SquareTask(int in) {
+    SetTypeOfTask(ppc::task::TypeOfTask::kSEQ);
+    GetInput() = in;
+    constructed_tasks++;
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return GetInput() >= 0;
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    GetOutput() = GetInput() * GetInput();
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+ppc::task::TaskPtr<int, int> MakeSquareTask(int in) {
+  return std::make_unique<SquareTask>(in);
+}
+
+std::vector<int> MakeInputs(std::size_t count) {
+  std::vector<int> inputs(count);
+  for (std::size_t i = 0; i < count; i++) {
+    inputs[i] = static_cast<int>(i);
+  }
+  return inputs;
+}
+
+void ExpectSquares(const std::vector<int> &inputs, const std::vector<int> &outputs) {
+  ASSERT_EQ(outputs.size(), inputs.size());
+  for (std::size_t i = 0; i < inputs.size(); i++) {
+    EXPECT_EQ(outputs[i], inputs[i] * inputs[i]);
+  }
+}
+
+}  // namespace
+
+TEST(BatchTask, SequentialBatchReusesOneTask) {
+  const std::vector<int> inputs = MakeInputs(50);
+  ppc::task::BatchTask<int, int> batch(MakeSquareTask, ppc::task::BatchBackend::kSequential);
+  constructed_tasks = 0;
+  ExpectSquares(inputs, batch.RunBatch(inputs));
+  EXPECT_EQ(constructed_tasks, 1);
+}
+
+TEST(BatchTask, ThreadedBatchKeepsInputOrder) {
+  const std::vector<int> inputs = MakeInputs(1000);
+  ppc::task::BatchTask<int, int> batch(MakeSquareTask, ppc::task::BatchBackend::kThreads);
+  ExpectSquares(inputs, batch.RunBatch(inputs));
+  ExpectSquares(inputs, batch.RunBatch(inputs));
+}
+
+TEST(BatchTask, ProcessBatchGathersAllOutputs) {
+  const std::vector<int> inputs = MakeInputs(17);
+  ppc::task::BatchTask<int, int> batch(MakeSquareTask, ppc::task::BatchBackend::kProcesses);
+  ExpectSquares(inputs, batch.RunBatch(inputs));
+}
+
+TEST(BatchTask, EmptyBatchReturnsNoOutputs) {
+  ppc::task::BatchTask<int, int> batch(MakeSquareTask);
+  EXPECT_TRUE(batch.RunBatch(std::vector<int>{}).empty());
+}
+
+TEST(BatchTask, ThrowsWhenInstanceFailsValidation) {
+  const std::vector<int> inputs = {1, -1};
+  ppc::task::BatchTask<int, int> batch(MakeSquareTask, ppc::task::BatchBackend::kSequential);
+  EXPECT_THROW(batch.RunBatch(inputs), std::runtime_error);
+}
+
+TEST(BatchTask, RunsAgainAfterFailedBatch) {
+  const std::vector<int> inputs = MakeInputs(9);
+  for (const auto backend : {ppc::task::BatchBackend::kSequential, ppc::task::BatchBackend::kThreads}) {
+    {
+      ppc::task::BatchTask<int, int> batch(MakeSquareTask, backend);
+      EXPECT_THROW(batch.RunBatch(std::vector<int>{1, -1, 2}), std::runtime_error);
+      ExpectSquares(inputs, batch.RunBatch(inputs));
+    }
+    EXPECT_FALSE(ppc::util::DestructorFailureFlag::Get());
+  }
+}
@@ -0,0 +1,280 @@
+#include <gtest/gtest.h>
+
+#include <tbb/global_control.h>
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "task/include/graph.hpp"
+#include "task/include/task.hpp"
+#include "util/include/util.hpp"
+
+namespace {
+
+/// Values passed along the graph; counts copies so the tests can check that edges move.
+struct Tracked {
+  Tracked() = default;
+  explicit Tracked(std::vector<int> init) : values(std::move(init)) {}
+  Tracked(const Tracked &other) : values(other.values) {
+    copies++;
+  }
+  Tracked &operator=(const Tracked &other) {
+    values = other.values;
+    copies++;
+    return *this;
+  }
+  Tracked(Tracked &&) = default;
+  Tracked &operator=(Tracked &&) = default;
+  ~Tracked() = default;
+
+  std::vector<int> values;
+  static inline int copies = 0;
+};
+
+class KeepEven : public ppc::task::Task<Tracked, Tracked> {
+ public:
+  explicit KeepEven(Tracked in) {
+    SetTypeOfTask(ppc::task::TypeOfTask::kSEQ);
+    GetInput() = std::move(in);
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return true;
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    auto &values = GetInput().values;
+    std::erase_if(values, [](int value) { return value % 2 != 0; });
+    GetOutput().values = std::move(values);
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+class Square : public ppc::task::Task<Tracked, Tracked> {
+ public:
+  explicit Square(Tracked in) {
+    SetTypeOfTask(ppc::task::TypeOfTask::kSEQ);
+    GetInput() = std::move(in);
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return true;
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    GetOutput() = std::move(GetInput());
+    for (int &value : GetOutput().values) {
+      value *= value;
+    }
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+class Sum : public ppc::task::Task<Tracked, int64_t> {
+ public:
+  explicit Sum(Tracked in) {
+    SetTypeOfTask(ppc::task::TypeOfTask::kSEQ);
+    GetInput() = std::move(in);
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return !GetInput().values.empty();
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    GetOutput() = std::accumulate(GetInput().values.begin(), GetInput().values.end(), int64_t{0});
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+std::atomic<int> active_runs{0};
+std::atomic<int> max_active_runs{0};
+
+class SleepTask : public ppc::task::Task<int, int> {
+ public:
+  explicit SleepTask(int in) {
+    SetTypeOfTask(ppc::task::TypeOfTask::kSEQ);
+    GetInput() = in;
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return true;
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    const int active = ++active_runs;
+    int seen = max_active_runs.load();
+    while (active > seen && !max_active_runs.compare_exchange_weak(seen, active)) {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    --active_runs;
+    GetOutput() = GetInput() + 1;
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+std::vector<int> Iota(int count) {
+  std::vector<int> values(static_cast<std::size_t>(count));
+  std::iota(values.begin(), values.end(), 1);
+  return values;
+}
+
+}  // namespace
+
+TEST(TaskGraph, ChainMovesOutputsDownstream) {
+  ppc::task::Graph graph;
+  const auto filter = graph.AddTask("filter", std::make_unique<KeepEven>(Tracked(Iota(10))));
+  const auto square = graph.AddTask<Square>("square");
+  const auto sum = graph.AddTask<Sum>("sum");
+  graph.Connect(filter, square);
+  graph.Connect(square, sum);
+  Tracked::copies = 0;
+  graph.Run();
+  // 2^2 + 4^2 + 6^2 + 8^2 + 10^2
+  EXPECT_EQ(graph.GetOutput(sum), 220);
+  EXPECT_EQ(Tracked::copies, 0);
+  const auto timings = graph.GetNodeTimings();
+  ASSERT_EQ(timings.size(), 3U);
+  EXPECT_EQ(timings[1].name, "square");
+  EXPECT_GE(timings[1].total_seconds, timings[1].run_seconds);
+}
+
+TEST(TaskGraph, FanOutCopiesForAllButLastSuccessor) {
+  ppc::task::Graph graph;
+  const auto filter = graph.AddTask("filter", std::make_unique<KeepEven>(Tracked(Iota(4))));
+  const auto sum = graph.AddTask<Sum>("sum");
+  const auto square = graph.AddTask<Square>("square");
+  graph.Connect(filter, sum);
+  graph.Connect(filter, square);
+  Tracked::copies = 0;
+  graph.RunSequential();
+  EXPECT_EQ(graph.GetOutput(sum), 6);
+  EXPECT_EQ(graph.GetOutput(square).values, (std::vector<int>{4, 16}));
+  EXPECT_EQ(Tracked::copies, 1);
+}
+
+TEST(TaskGraph, RunsAgainWithResetSources) {
+  ppc::task::Graph graph;
+  const auto source = graph.AddTask("source", std::make_unique<SleepTask>(1));
+  const auto next = graph.AddTask<SleepTask>("next");
+  graph.Connect(source, next);
+  graph.Run();
+  graph.Run();
+  EXPECT_EQ(graph.GetOutput(next), 3);
+}
+
+TEST(TaskGraph, RunsIndependentNodesConcurrently) {
+  if (tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism) < 2) {
+    GTEST_SKIP() << "Concurrency needs at least two TBB threads";
+  }
+  // Run() sleeps, so an explicit arena overlaps the branches even on a single core
+  tbb::task_arena arena(3);
+  max_active_runs = 0;
+  ppc::task::Graph graph;
+  for (int branch = 0; branch < 3; branch++) {
+    const auto source = graph.AddTask("source", std::make_unique<SleepTask>(branch));
+    graph.Connect(source, graph.AddTask<SleepTask>("next"));
+  }
+  arena.execute([&] { graph.Run(); });
+  EXPECT_GE(max_active_runs.load(), 2);
+}
+
+TEST(TaskGraph, RejectsIncompleteAndInvalidGraphs) {
+  ppc::task::Graph unconnected;
+  (void)unconnected.AddTask<Sum>("sum");
+  EXPECT_THROW(unconnected.Run(), std::runtime_error);
+
+  ppc::task::Graph cyclic;
+  const auto first = cyclic.AddTask<Square>("first");
+  const auto second = cyclic.AddTask<Square>("second");
+  cyclic.Connect(first, second);
+  cyclic.Connect(second, first);
+  EXPECT_THROW(cyclic.RunSequential(), std::runtime_error);
+
+  ppc::task::Graph graph;
+  const auto source = graph.AddTask("source", std::make_unique<KeepEven>(Tracked(Iota(2))));
+  const auto square = graph.AddTask<Square>("square");
+  graph.Connect(source, square);
+  EXPECT_THROW(graph.Connect(source, square), std::runtime_error);
+  EXPECT_THROW(graph.Connect(square, source), std::runtime_error);
+  EXPECT_THROW((void)graph.GetOutput(square), std::runtime_error);
+  graph.Run();
+}
+
+TEST(TaskGraph, ThrowsWhenNodeFails) {
+  {
+    ppc::task::Graph graph;
+    // An odd-only input leaves nothing for Sum, whose validation then fails
+    const auto filter = graph.AddTask("filter", std::make_unique<KeepEven>(Tracked({1, 3, 5})));
+    graph.Connect(filter, graph.AddTask<Sum>("sum"));
+    EXPECT_THROW(graph.Run(), std::runtime_error);
+  }
+  EXPECT_FALSE(ppc::util::DestructorFailureFlag::Get());
+}
+
+TEST(TaskGraph, RejectsDeclaredMpiNodeBeforeBuildingIt) {
+  {
+    int built = 0;
+    ppc::task::Graph graph;
+    const auto source = graph.AddTask("source", std::make_unique<KeepEven>(Tracked(Iota(4))));
+    const auto square = graph.AddTask<Tracked, Tracked>(
+        "square",
+        [&built](Tracked in) -> ppc::task::TaskPtr<Tracked, Tracked> {
+          built++;
+          return std::make_unique<Square>(std::move(in));
+        },
+        ppc::task::TypeOfTask::kMPI);
+    graph.Connect(source, square);
+    EXPECT_THROW(graph.Run(), std::runtime_error);
+    EXPECT_EQ(built, 0);
+    // Run() started nothing, so the graph still runs sequentially
+    graph.RunSequential();
+    EXPECT_EQ(built, 1);
+  }
+  EXPECT_FALSE(ppc::util::DestructorFailureFlag::Get());
+}
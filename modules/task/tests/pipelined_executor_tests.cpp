@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <tbb/global_control.h>
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "task/include/pipelined_executor.hpp"
+#include "task/include/task.hpp"
+#include "util/include/util.hpp"
+
+namespace {
+
+std::atomic<int> active_stages{0};
+std::atomic<int> max_active_stages{0};
+
+class StageCounter {
+ public:
+  StageCounter() {
+    const int active = ++active_stages;
+    int seen = max_active_stages.load();
+    while (active > seen && !max_active_stages.compare_exchange_weak(seen, active)) {
+    }
+  }
+  StageCounter(const StageCounter &) = delete;
+  StageCounter &operator=(const StageCounter &) = delete;
+  ~StageCounter() {
+    --active_stages;
+  }
+};
+
+class SlowStagesTask : public ppc::task::Task<int, int> {
+ public:
+  explicit SlowStagesTask(int in) {
+    SetTypeOfTask(ppc::task::TypeOfTask::kSEQ);
+    GetInput() = in;
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return GetInput() >= 0;
+  }
+
+  bool PreProcessingImpl() override {
+    const StageCounter counter;
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    return true;
+  }
+
+  bool RunImpl() override {
+    const StageCounter counter;
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    GetOutput() = GetInput() + 1;
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    const StageCounter counter;
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    return true;
+  }
+};
+
+ppc::task::TaskPtr<int, int> MakeSlowStagesTask(int in) {
+  return std::make_unique<SlowStagesTask>(in);
+}
+
+}  // namespace
+
+TEST(PipelinedExecutor, KeepsInputOrder) {
+  std::vector<int> inputs(20);
+  for (std::size_t i = 0; i < inputs.size(); i++) {
+    inputs[i] = static_cast<int>(i);
+  }
+  ppc::task::PipelinedExecutor<int, int> executor(MakeSlowStagesTask);
+  const std::vector<int> outputs = executor.Run(inputs);
+  ASSERT_EQ(outputs.size(), inputs.size());
+  for (std::size_t i = 0; i < inputs.size(); i++) {
+    EXPECT_EQ(outputs[i], inputs[i] + 1);
+  }
+}
+
+TEST(PipelinedExecutor, OverlapsStagesOfConsecutiveTasks) {
+  if (tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism) < 2) {
+    GTEST_SKIP() << "Overlap needs at least two TBB threads";
+  }
+  // Stages sleep, so an explicit arena overlaps them even on a single core
+  tbb::task_arena arena(3);
+  max_active_stages = 0;
+  const std::vector<int> inputs(12, 1);
+  ppc::task::PipelinedExecutor<int, int> executor(MakeSlowStagesTask);
+  arena.execute([&] { executor.Run(inputs); });
+  EXPECT_GE(max_active_stages.load(), 2);
+}
+
+TEST(PipelinedExecutor, StreamsUntilInputRunsOut) {
+  int next = 0;
+  int sum = 0;
+  ppc::task::PipelinedExecutor<int, int> executor(MakeSlowStagesTask, 4);
+  executor.RunStream([&]() -> std::optional<int> { return next < 5 ? std::optional<int>(next++) : std::nullopt; },
+                     [&](int &&output) { sum += output; });
+  EXPECT_EQ(sum, 15);
+}
+
+TEST(PipelinedExecutor, ThrowsWhenTaskFails) {
+  const std::vector<int> inputs = {1, -1, 2};
+  ppc::task::PipelinedExecutor<int, int> executor(MakeSlowStagesTask);
+  EXPECT_THROW(executor.Run(inputs), std::runtime_error);
+  // The failed task and the ones after it are dropped unfinished without being reported as incomplete
+  EXPECT_FALSE(ppc::util::DestructorFailureFlag::Get());
+}
+
+TEST(PipelinedExecutor, RejectsDeclaredMpiTasksBeforeBuildingThem) {
+  for (auto task_type : {ppc::task::TypeOfTask::kMPI, ppc::task::TypeOfTask::kALL}) {
+    int built = 0;
+    ppc::task::PipelinedExecutor<int, int> executor(
+        [&built](int in) {
+          built++;
+          return MakeSlowStagesTask(in);
+        },
+        3, task_type);
+    EXPECT_THROW(executor.Run(std::vector<int>{1, 2}), std::runtime_error);
+    EXPECT_EQ(built, 0);
+  }
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "task/include/batch_task.hpp"
+#include "task/include/static_task.hpp"
+#include "task/include/task.hpp"
+
+namespace {
+
+class StaticSquareTask : public ppc::task::StaticTask<StaticSquareTask, int, int> {
+ public:
+  explicit StaticSquareTask(int in) {
+    GetInput() = in;
+  }
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return ppc::task::TypeOfTask::kSEQ;
+  }
+
+  bool ValidationImpl() {
+    return GetInput() >= 0 && GetOutput() == 0;
+  }
+
+  bool PreProcessingImpl() {
+    return true;
+  }
+
+  bool RunImpl() {
+    GetOutput() = GetInput() * GetInput();
+    return true;
+  }
+
+  bool PostProcessingImpl() {
+    return true;
+  }
+};
+
+static_assert(ppc::task::StaticPipelineTask<StaticSquareTask>);
+
+struct CopyCountingInput {
+  CopyCountingInput() = default;
+  CopyCountingInput(const CopyCountingInput &other) : copies(other.copies + 1) {}
+  CopyCountingInput(CopyCountingInput &&other) noexcept = default;
+  CopyCountingInput &operator=(const CopyCountingInput &other) {
+    copies = other.copies + 1;
+    return *this;
+  }
+  CopyCountingInput &operator=(CopyCountingInput &&other) noexcept = default;
+  ~CopyCountingInput() = default;
+
+  int copies = 0;
+};
+
+class StaticCopyCountingTask : public ppc::task::StaticTask<StaticCopyCountingTask, CopyCountingInput, int> {
+ public:
+  explicit StaticCopyCountingTask(const CopyCountingInput &in) {
+    GetInput() = in;
+  }
+
+  bool ValidationImpl() {
+    return true;
+  }
+
+  bool PreProcessingImpl() {
+    return true;
+  }
+
+  bool RunImpl() {
+    GetOutput() = GetInput().copies;
+    return true;
+  }
+
+  bool PostProcessingImpl() {
+    return true;
+  }
+};
+
+}  // namespace
+
+TEST(StaticTask, RunPipelineReturnsOutput) {
+  EXPECT_EQ(ppc::task::RunPipeline<StaticSquareTask>(7), 49);
+}
+
+TEST(StaticTask, RunPipelineThrowsWhenStageFails) {
+  EXPECT_THROW((void)ppc::task::RunPipeline<StaticSquareTask>(-1), std::runtime_error);
+}
+
+TEST(StaticTask, RunStagesStopsAtFailedValidation) {
+  StaticSquareTask task(3);
+  task.GetOutput() = 1;
+  EXPECT_FALSE(ppc::task::RunStages(task));
+  EXPECT_EQ(task.GetOutput(), 1);
+}
+
+TEST(StaticTask, AdapterRunsThroughTaskInterface) {
+  auto task = ppc::task::MakeStaticTaskAdapter<StaticSquareTask>(5);
+  EXPECT_EQ(task->GetDynamicTypeOfTask(), ppc::task::TypeOfTask::kSEQ);
+  EXPECT_TRUE(task->Validation());
+  EXPECT_TRUE(task->PreProcessing());
+  EXPECT_TRUE(task->Run());
+  EXPECT_TRUE(task->PostProcessing());
+  EXPECT_EQ(task->GetOutput(), 25);
+}
+
+TEST(StaticTask, AdapterCanBeReusedByBatchTask) {
+  ppc::task::BatchTask<int, int> batch(ppc::task::MakeStaticTaskAdapter<StaticSquareTask>,
+                                       ppc::task::BatchBackend::kSequential);
+  const std::vector<int> inputs = {1, 2, 3, 4};
+  const std::vector<int> outputs = batch.RunBatch(inputs);
+  for (std::size_t i = 0; i < inputs.size(); i++) {
+    EXPECT_EQ(outputs[i], inputs[i] * inputs[i]);
+  }
+}
+
+TEST(StaticTask, AdapterCopiesInputOncePerRun) {
+  auto task = ppc::task::MakeStaticTaskAdapter<StaticCopyCountingTask>(CopyCountingInput{});
+  for (int run = 0; run < 2; run++) {
+    task->Reset();
+    EXPECT_TRUE(task->Validation());
+    EXPECT_TRUE(task->PreProcessing());
+    EXPECT_TRUE(task->Run());
+    EXPECT_TRUE(task->PostProcessing());
+    // The Task keeps the moved input and the wrapped task holds a single copy of it
+    EXPECT_EQ(task->GetOutput(), 1);
+  }
+}
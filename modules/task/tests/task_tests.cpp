@@ -198,8 +198,8 @@ TEST(TaskTest, GetStringTaskTypeEachTypeWithValidFile) {
   std::string path = "settings_valid_all.json";
   ScopedFile cleaner(path);
   std::ofstream file(path);
-  file
-      << R"({"tasks": {"all": "enabled", "stl": "enabled", "omp": "enabled", "mpi": "enabled", "tbb": "enabled", "seq": "enabled"}})";
+  file << R"({"tasks": {"all": "enabled", "stl": "enabled", "omp": "enabled", "mpi": "enabled", "tbb": "enabled", )"
+       << R"("seq": "enabled", "offload": "disabled"}})";
   file.close();
 
   EXPECT_EQ(GetStringTaskType(TypeOfTask::kALL, path), "all_enabled");
@@ -208,6 +208,7 @@ TEST(TaskTest, GetStringTaskTypeEachTypeWithValidFile) {
   EXPECT_EQ(GetStringTaskType(TypeOfTask::kMPI, path), "mpi_enabled");
   EXPECT_EQ(GetStringTaskType(TypeOfTask::kTBB, path), "tbb_enabled");
   EXPECT_EQ(GetStringTaskType(TypeOfTask::kSEQ, path), "seq_enabled");
+  EXPECT_EQ(GetStringTaskType(TypeOfTask::kOffload, path), "offload_disabled");
 }
 
 TEST(TaskTest, GetStringTaskTypeExceptionMessageContainsPath) {
@@ -277,6 +278,33 @@ TEST(TaskTest, GetStringTaskTypeThrowsIfJsonValueIsNull) {
   EXPECT_THROW(GetStringTaskType(TypeOfTask::kSEQ, path), NlohmannJsonTypeError);
 }
 
+TEST(TaskTest, LoadSettingsJsonParsesFileOnce) {
+  std::string path = "settings_cached.json";
+  ScopedFile cleaner(path);
+  std::ofstream file(path);
+  file << R"({"tasks": {"seq": "enabled"}})";
+  file.close();
+
+  const auto first = ppc::util::LoadSettingsJson(path);
+  const auto second = ppc::util::LoadSettingsJson(path);
+  EXPECT_EQ(first.get(), second.get());
+  EXPECT_EQ(GetStringTaskType(TypeOfTask::kSEQ, path), "seq_enabled");
+}
+
+TEST(TaskTest, LoadSettingsJsonReloadsChangedFile) {
+  std::string path = "settings_changed.json";
+  ScopedFile cleaner(path);
+  std::ofstream file(path);
+  file << R"({"tasks": {"seq": "enabled"}})";
+  file.close();
+  EXPECT_EQ(GetStringTaskType(TypeOfTask::kSEQ, path), "seq_enabled");
+
+  file.open(path, std::ios::trunc);
+  file << R"({"tasks": {"seq": "disabled"}})";
+  file.close();
+  EXPECT_EQ(GetStringTaskType(TypeOfTask::kSEQ, path), "seq_disabled");
+}
+
 TEST(TaskTest, TaskDestructorThrowsIfStageIncomplete) {
   {
     std::vector<int32_t> in(20, 1);
@@ -306,6 +334,37 @@ TEST(TaskTest, TaskDestructorThrowsIfStageIncomplete) {
   ppc::util::DestructorFailureFlag::Unset();
 }
 
+TEST(TaskTest, MarkFailedEndsAnIncompletePipeline) {
+  {
+    std::vector<int32_t> in(20, 1);
+    struct LocalTask : Task<std::vector<int32_t>, int32_t> {
+     public:
+      explicit LocalTask(const std::vector<int32_t> &in) {
+        this->GetInput() = in;
+      }
+
+     protected:
+      bool ValidationImpl() override {
+        return true;
+      }
+      bool PreProcessingImpl() override {
+        return false;
+      }
+      bool RunImpl() override {
+        return true;
+      }
+      bool PostProcessingImpl() override {
+        return true;
+      }
+    } task(in);
+    ASSERT_TRUE(task.Validation());
+    ASSERT_FALSE(task.PreProcessing());
+    task.MarkFailed();
+    EXPECT_THROW(task.Reset(), std::runtime_error);
+  }
+  EXPECT_FALSE(ppc::util::DestructorFailureFlag::Get());
+}
+
 TEST(TaskTest, TaskDestructorThrowsIfEmpty) {
   {
     std::vector<int32_t> in(20, 1);
@@ -421,6 +480,90 @@ TEST(TaskTest, PostProcessingThrowsIfCalledBeforeRun) {
   EXPECT_THROW(task->PostProcessing(), std::runtime_error);
 }
 
+TEST(TaskTest, ResetAllowsPipelineToRunAgain) {
+  std::vector<int32_t> in(20, 1);
+  ppc::test::TestTask<std::vector<int32_t>, int32_t> test_task(in);
+  for (int iteration = 0; iteration < 3; iteration++) {
+    test_task.Reset();
+    ASSERT_TRUE(test_task.Validation());
+    test_task.PreProcessing();
+    test_task.Run();
+    test_task.PostProcessing();
+    EXPECT_EQ(static_cast<size_t>(test_task.GetOutput()), in.size());
+  }
+}
+
+TEST(TaskTest, ResetRestoresOutput) {
+  DummyTask task;
+  task.Validation();
+  task.PreProcessing();
+  task.Run();
+  task.PostProcessing();
+  task.GetOutput() = 42;
+  task.Reset();
+  EXPECT_EQ(task.GetOutput(), 0);
+  task.Validation();
+  task.PreProcessing();
+  task.Run();
+  task.PostProcessing();
+}
+
+TEST(TaskTest, ResetThrowsIfPipelineIsInProgress) {
+  auto task = std::make_unique<DummyTask>();
+  task->Validation();
+  task->PreProcessing();
+  EXPECT_THROW(task->Reset(), std::runtime_error);
+}
+
+namespace {
+
+struct CopyCountingInput {
+  CopyCountingInput() = default;
+  CopyCountingInput(const CopyCountingInput &other) : copies(other.copies + 1) {}
+  CopyCountingInput(CopyCountingInput &&other) noexcept = default;
+  CopyCountingInput &operator=(const CopyCountingInput &other) {
+    copies = other.copies + 1;
+    return *this;
+  }
+  CopyCountingInput &operator=(CopyCountingInput &&other) noexcept = default;
+  ~CopyCountingInput() = default;
+
+  int copies = 0;
+};
+
+class MoveInputTask : public Task<CopyCountingInput, int> {
+ public:
+  explicit MoveInputTask(CopyCountingInput in) {
+    GetInput() = std::move(in);
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return true;
+  }
+  bool PreProcessingImpl() override {
+    return true;
+  }
+  bool RunImpl() override {
+    GetOutput() = GetInput().copies;
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+}  // namespace
+
+TEST(TaskTest, TaskGetterMovesInputIntoTask) {
+  auto task = ppc::task::TaskGetter<MoveInputTask>(CopyCountingInput{});
+  task->Validation();
+  task->PreProcessing();
+  task->Run();
+  task->PostProcessing();
+  EXPECT_EQ(task->GetOutput(), 0);
+}
+
 int main(int argc, char **argv) {
   return ppc::runners::SimpleInit(argc, argv);
 }
@@ -0,0 +1,138 @@
+#include <benchmark/benchmark.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <system_error>
+
+#include "task/include/task.hpp"
+#include "util/include/per_thread.hpp"
+#include "util/include/perf_test_util.hpp"
+#include "util/include/util.hpp"
+
+// Overheads of the helpers that wrap every measured task run. Collective benchmarks use a fixed iteration count,
+// because each rank would otherwise pick its own and the collectives would no longer match up.
+
+namespace {
+
+using ppc::task::TypeOfTask;
+
+constexpr int64_t kCollectiveIterations = 2000;
+
+TypeOfTask TaskTypeArg(const benchmark::State &state) {
+  return static_cast<TypeOfTask>(state.range(0));
+}
+
+void AddTaskTypeArgs(benchmark::internal::Benchmark *benchmark) {
+  for (const auto type : {TypeOfTask::kSEQ, TypeOfTask::kOMP, TypeOfTask::kTBB, TypeOfTask::kSTL, TypeOfTask::kMPI}) {
+    benchmark->Arg(static_cast<int64_t>(type));
+  }
+}
+
+void MakeBenchmarkTimer(benchmark::State &state) {
+  state.SetLabel(std::string(ppc::task::TypeOfTaskToString(TaskTypeArg(state))));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ppc::util::detail::MakeBenchmarkTimer(TaskTypeArg(state)));
+  }
+}
+BENCHMARK(MakeBenchmarkTimer)->Apply(AddTaskTypeArgs);
+
+/// Cost of one reading; the resolution counter is the smallest nonzero step between consecutive readings.
+void BenchmarkTimerRead(benchmark::State &state) {
+  state.SetLabel(std::string(ppc::task::TypeOfTaskToString(TaskTypeArg(state))));
+  const auto timer = ppc::util::detail::MakeBenchmarkTimer(TaskTypeArg(state));
+  double previous = timer();
+  double resolution = std::numeric_limits<double>::max();
+  for (auto _ : state) {
+    const double now = timer();
+    if (now > previous) {
+      resolution = std::min(resolution, now - previous);
+    }
+    previous = now;
+  }
+  state.counters["resolution_ns"] = resolution == std::numeric_limits<double>::max() ? 0.0 : resolution * 1e9;
+}
+BENCHMARK(BenchmarkTimerRead)->Apply(AddTaskTypeArgs);
+
+void SynchronizeMpiRanks(benchmark::State &state) {
+  int ranks = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &ranks);
+  for (auto _ : state) {
+    ppc::util::SynchronizeMpiRanks();
+  }
+  state.counters["ranks"] = static_cast<double>(ranks);
+}
+BENCHMARK(SynchronizeMpiRanks)->Iterations(kCollectiveIterations);
+
+void MaxElapsedTimeAcrossMpiRanks(benchmark::State &state) {
+  int ranks = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &ranks);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ppc::util::detail::MaxElapsedTimeAcrossMpiRanks(1.0, TypeOfTask::kMPI));
+  }
+  state.counters["ranks"] = static_cast<double>(ranks);
+}
+BENCHMARK(MaxElapsedTimeAcrossMpiRanks)->Iterations(kCollectiveIterations);
+
+/// Status lookup of a nested task entry; the parsed settings file is cached after the first call.
+void GetTaskStatus(benchmark::State &state) {
+  const auto path = std::filesystem::temp_directory_path() /
+                    ("ppc_bench_settings_" + std::to_string(ppc::util::GetMPIRank()) + ".json");
+  std::ofstream(path) << R"({"tasks": {"threads": {"omp": "enabled", "seq": "disabled"}}})";
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ppc::task::GetTaskStatus(TypeOfTask::kOMP, path.string(), "threads"));
+  }
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+}
+BENCHMARK(GetTaskStatus);
+
+/// Environment setup of one test including creation of its temporary directory.
+void ScopedPerTestEnv(benchmark::State &state) {
+  const std::string token = "infra_bench_" + std::to_string(ppc::util::GetMPIRank());
+  const auto tmp_dir = std::filesystem::temp_directory_path() / ("ppc_test_" + token);
+  std::error_code ec;
+  for (auto _ : state) {
+    {
+      const ppc::util::test::ScopedPerTestEnv scoped(token);
+      benchmark::ClobberMemory();
+    }
+    state.PauseTiming();
+    std::filesystem::remove_all(tmp_dir, ec);
+    state.ResumeTiming();
+  }
+}
+BENCHMARK(ScopedPerTestEnv);
+
+constexpr int kIncrementsPerIteration = 1024;
+
+/// One atomic shared by all benchmark threads, the pattern PerThread replaces.
+void SharedAtomicCounter(benchmark::State &state) {
+  static std::atomic<int64_t> counter{0};
+  for (auto _ : state) {
+    for (int i = 0; i < kIncrementsPerIteration; i++) {
+      counter.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kIncrementsPerIteration);
+}
+BENCHMARK(SharedAtomicCounter)->ThreadRange(1, 16)->UseRealTime();
+
+void PerThreadCounter(benchmark::State &state) {
+  static ppc::util::PerThread<int64_t> counter;
+  for (auto _ : state) {
+    for (int i = 0; i < kIncrementsPerIteration; i++) {
+      counter.Local()++;
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kIncrementsPerIteration);
+}
+BENCHMARK(PerThreadCounter)->ThreadRange(1, 16)->UseRealTime();
+
+}  // namespace
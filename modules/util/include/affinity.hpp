@@ -0,0 +1,91 @@
+#pragma once
+
+#include <omp.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "util/include/util.hpp"
+
+namespace ppc::util {
+
+/// @brief Thread pinning policy selected with PPC_AFFINITY.
+enum class AffinityPolicy : uint8_t {
+  /// Threads are not pinned
+  kNone,
+  /// Consecutive threads fill one NUMA node before moving to the next
+  kCompact,
+  /// Consecutive threads alternate between NUMA nodes
+  kScatter,
+};
+
+/// @brief Reads PPC_AFFINITY (none, compact or scatter); defaults to none.
+/// @throws std::runtime_error If the variable holds another value.
+AffinityPolicy GetAffinityPolicy();
+
+constexpr std::string_view AffinityPolicyToString(AffinityPolicy policy) {
+  switch (policy) {
+    case AffinityPolicy::kNone:
+      return "none";
+    case AffinityPolicy::kCompact:
+      return "compact";
+    case AffinityPolicy::kScatter:
+      return "scatter";
+  }
+  return "none";
+}
+
+/// @brief CPUs usable by this process grouped by NUMA node; a single group when the topology is unknown.
+std::vector<std::vector<int>> GetNumaNodeCpus();
+
+/// @brief Orders the CPUs of @p numa_nodes in which threads are placed under @p policy.
+std::vector<int> MakeAffinityCpuOrder(AffinityPolicy policy, const std::vector<std::vector<int>> &numa_nodes);
+
+/// @brief Binds the calling thread to @p cpu.
+/// @return False when pinning is unsupported or was refused.
+bool PinCurrentThread(int cpu);
+
+/// @brief CPU assigned to thread @p thread_index of this rank, or -1 when no affinity scope is active.
+/// @details Index 0 is the main thread; worker indices follow OpenMP, TBB and ThreadPool numbering.
+int AffinityCpuForThread(int thread_index);
+
+/// @brief CPUs assigned to the threads of this rank by the active affinity scope.
+std::vector<int> GetAffinityCpus();
+
+/// @brief Applies a PPC_AFFINITY policy to OpenMP, TBB and ThreadPool threads.
+/// @details Ranks sharing a node take consecutive slices of the CPU order, so MPI ranks are not stacked on
+///          the same cores. OpenMP workers are pinned once by a parallel region of @p num_threads threads, TBB
+///          workers are pinned by a scheduler observer when they join the arena, and ThreadPool workers created
+///          while the scope is alive pin themselves on start-up. The calling thread is bound to the whole slice
+///          rather than one CPU and gets its previous mask back when the scope ends; worker threads stay pinned.
+class ScopedThreadAffinity {
+ public:
+  ScopedThreadAffinity(AffinityPolicy policy, int num_threads);
+  ScopedThreadAffinity(const ScopedThreadAffinity &) = delete;
+  ScopedThreadAffinity &operator=(const ScopedThreadAffinity &) = delete;
+  ~ScopedThreadAffinity();
+
+ private:
+  class TbbObserver;
+  std::unique_ptr<TbbObserver> tbb_observer_;
+  /// Mask of the calling thread before the scope; empty when nothing was pinned
+  std::vector<int> main_thread_cpus_;
+};
+
+/// @brief Fills @p data with @p value from OpenMP threads using a static schedule.
+/// @details Pages are placed on the NUMA node of the thread that first writes them, so an input filled this way
+///          lands next to the threads that later process it with the same static partition.
+template <typename T>
+void FirstTouchFill(std::span<T> data, const T &value) {
+  const auto size = static_cast<std::int64_t>(data.size());
+#pragma omp parallel for schedule(static) default(none) shared(data, value, size) num_threads(GetNumThreads())
+  for (std::int64_t i = 0; i < size; i++) {
+    data[static_cast<std::size_t>(i)] = value;
+  }
+}
+
+}  // namespace ppc::util
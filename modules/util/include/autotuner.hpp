@@ -0,0 +1,222 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "task/include/task.hpp"
+#include "util/include/clock.hpp"
+#include "util/include/num_threads.hpp"
+#include "util/include/task_descriptor_util.hpp"
+#include "util/include/util.hpp"
+
+namespace ppc::util {
+
+/// @brief Backend and thread count that won the calibration of one size bucket.
+struct AutotuneChoice {
+  /// @brief Display name of the winning task, as produced by MakeTaskDescriptor().
+  std::string task;
+  ppc::task::TypeOfTask type = ppc::task::TypeOfTask::kUnknown;
+  /// @brief Thread count the winner ran with; 0 for backends that do not use threads.
+  int num_threads = 0;
+  /// @brief Best pipeline time of the winner during calibration.
+  double seconds = 0.0;
+};
+
+/// @brief Returns the autotuning cache file from PPC_AUTOTUNE_CACHE, or std::nullopt to keep choices in memory.
+std::optional<std::string> GetAutotuneCachePath();
+
+/// @brief Size bucket of an input with @p size elements: floor(log2(size)), 0 for empty inputs.
+std::size_t AutotuneSizeBucket(std::size_t size);
+
+/// @brief Winners keyed by tuner name, machine and size bucket, persisted as JSON.
+/// @details The machine part of the key is the hardware concurrency, so a cache copied to another machine is
+///          recalibrated there instead of reusing choices measured elsewhere.
+class AutotuneCache {
+ public:
+  /// @brief Loads @p path when it exists; an empty path keeps the cache in memory only.
+  /// @throws std::runtime_error If the file exists but is not a valid cache.
+  explicit AutotuneCache(std::string path = {});
+
+  [[nodiscard]] std::optional<AutotuneChoice> Find(std::string_view tuner, std::size_t bucket) const;
+
+  /// @brief Records @p choice and rewrites the cache file.
+  /// @throws std::runtime_error If the file cannot be written.
+  void Store(std::string_view tuner, std::size_t bucket, const AutotuneChoice &choice);
+
+ private:
+  [[nodiscard]] static std::string Key(std::string_view tuner, std::size_t bucket);
+  void Save() const;
+
+  std::string path_;
+  std::map<std::string, AutotuneChoice> choices_;
+};
+
+/// @brief Routes every input to the fastest of several implementations of one task.
+/// @details The candidates are the enabled thread-level backends (SEQ, OMP, TBB, STL) among @p TaskTypes, described
+///          from the same settings file as the performance tests. The first input of every size
+///          bucket is run by every candidate at every thread count of CandidateThreadCounts(), and the fastest
+///          pipeline wins the bucket. MPI backends are left out because ranks would have to agree on the winner.
+/// @tparam InType Input type shared by all implementations.
+/// @tparam OutType Output type shared by all implementations.
+/// @tparam TaskTypes Implementations, in the order given to MakeAllPerfTasks() by the performance tests.
+template <typename InType, typename OutType, typename... TaskTypes>
+class Autotuner {
+ public:
+  using SizeFunction = std::function<std::size_t(const InType &)>;
+
+  /// @param name Key of this tuner in the cache, e.g. the task namespace.
+  /// @param size_of Number of elements of an input, which selects its size bucket.
+  /// @param cache_path Cache file; by default GetAutotuneCachePath(), no path keeps choices in memory.
+  Autotuner(std::string name, SizeFunction size_of, const std::string &settings_path,
+            std::string_view settings_task_path = {}, std::optional<std::string> cache_path = GetAutotuneCachePath())
+      : name_(std::move(name)), size_of_(std::move(size_of)), cache_(cache_path.value_or(std::string{})) {
+    (AddCandidate<TaskTypes>(settings_path, settings_task_path), ...);
+    if (candidates_.empty()) {
+      throw std::runtime_error("Autotuner '" + name_ + "' has no enabled thread-level backend");
+    }
+  }
+
+  /// @brief Runs @p input on the best implementation for its size, calibrating the bucket first if needed.
+  /// @throws std::runtime_error If the chosen implementation fails.
+  OutType Run(const InType &input) {
+    const AutotuneChoice choice = Choose(input);
+    const auto &candidate = FindCandidate(choice);
+    std::optional<ScopedNumThreads> num_threads_scope;
+    if (choice.num_threads > 0) {
+      num_threads_scope.emplace(choice.num_threads);
+    }
+    auto task = candidate.getter(input);
+    if (!RunPipeline(*task)) {
+      throw std::runtime_error("Autotuned task '" + choice.task + "' failed");
+    }
+    return std::move(task->GetOutput());
+  }
+
+  /// @brief Cached choice for @p input, or the result of calibrating its bucket with it.
+  AutotuneChoice Choose(const InType &input) {
+    const std::size_t bucket = AutotuneSizeBucket(size_of_(input));
+    if (auto cached = cache_.Find(name_, bucket); cached && HasCandidate(*cached)) {
+      return *cached;
+    }
+    AutotuneChoice choice = Calibrate(input);
+    cache_.Store(name_, bucket, choice);
+    return choice;
+  }
+
+  /// @brief Times every candidate on @p input and returns the fastest, without touching the cache.
+  /// @throws std::runtime_error If a candidate fails on @p input.
+  AutotuneChoice Calibrate(const InType &input) {
+    std::optional<AutotuneChoice> best;
+    for (const auto &candidate : candidates_) {
+      const bool uses_threads = IsThreadSweepTaskType(candidate.type);
+      const std::vector<int> thread_counts = uses_threads ? CandidateThreadCounts() : std::vector<int>{0};
+      for (const int num_threads : thread_counts) {
+        const double seconds = Probe(candidate, input, num_threads);
+        if (!best || seconds < best->seconds) {
+          best = AutotuneChoice{};
+          best->task = candidate.name;
+          best->type = candidate.type;
+          best->num_threads = num_threads;
+          best->seconds = seconds;
+        }
+      }
+    }
+    return *best;
+  }
+
+  /// @brief Thread counts probed for threaded backends: powers of two below GetNumThreads() and GetNumThreads().
+  static std::vector<int> CandidateThreadCounts() {
+    const int max_threads = std::max(GetNumThreads(), 1);
+    std::vector<int> counts;
+    for (int count = 1; count < max_threads; count *= 2) {
+      counts.push_back(count);
+    }
+    counts.push_back(max_threads);
+    return counts;
+  }
+
+ private:
+  static constexpr int kProbeRepetitions = 3;
+
+  struct Candidate {
+    std::string name;
+    ppc::task::TypeOfTask type = ppc::task::TypeOfTask::kUnknown;
+    std::function<ppc::task::TaskPtr<InType, OutType>(const InType &)> getter;
+  };
+
+  template <typename TaskType>
+  void AddCandidate(const std::string &settings_path, std::string_view settings_task_path) {
+    const auto descriptor = MakeTaskDescriptor(GetNamespace<TaskType>(), TaskType::GetStaticTypeOfTask(),
+                                               settings_path, settings_task_path);
+    if (descriptor.status == ppc::task::StatusOfTask::kDisabled || IsMpiTaskType(descriptor.type)) {
+      return;
+    }
+    Candidate candidate;
+    candidate.name = descriptor.display_name;
+    candidate.type = descriptor.type;
+    candidate.getter = ppc::task::TaskGetter<TaskType, const InType &>;
+    candidates_.push_back(std::move(candidate));
+  }
+
+  /// Runs every stage of @p task; a stage that fails or throws ends the pipeline with MarkFailed().
+  static bool RunPipeline(ppc::task::Task<InType, OutType> &task) {
+    task.GetStateOfTesting() = ppc::task::StateOfTesting::kPerf;
+    try {
+      if (task.Validation() && task.PreProcessing() && task.Run() && task.PostProcessing()) {
+        return true;
+      }
+    } catch (...) {
+      task.MarkFailed();
+      throw;
+    }
+    task.MarkFailed();
+    return false;
+  }
+
+  /// Best pipeline time out of kProbeRepetitions runs.
+  double Probe(const Candidate &candidate, const InType &input, int num_threads) const {
+    std::optional<ScopedNumThreads> num_threads_scope;
+    if (num_threads > 0) {
+      num_threads_scope.emplace(num_threads);
+    }
+    double best = std::numeric_limits<double>::infinity();
+    for (int repetition = 0; repetition < kProbeRepetitions; repetition++) {
+      auto task = candidate.getter(input);
+      const double begin = ClockNow();
+      if (!RunPipeline(*task)) {
+        throw std::runtime_error("Backend '" + candidate.name + "' of autotuner '" + name_ +
+                                 "' failed during calibration");
+      }
+      best = std::min(best, ClockNow() - begin);
+    }
+    return best;
+  }
+
+  [[nodiscard]] bool HasCandidate(const AutotuneChoice &choice) const {
+    return std::ranges::any_of(candidates_, [&choice](const Candidate &c) { return c.name == choice.task; });
+  }
+
+  [[nodiscard]] const Candidate &FindCandidate(const AutotuneChoice &choice) const {
+    const auto it = std::ranges::find(candidates_, choice.task, &Candidate::name);
+    if (it == candidates_.end()) {
+      throw std::runtime_error("Autotuner '" + name_ + "' has no backend '" + choice.task + "'");
+    }
+    return *it;
+  }
+
+  std::string name_;
+  SizeFunction size_of_;
+  AutotuneCache cache_;
+  std::vector<Candidate> candidates_;
+};
+
+}  // namespace ppc::util
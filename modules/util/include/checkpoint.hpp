@@ -0,0 +1,104 @@
+#pragma once
+
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Tasks whose progress can be saved and restored by a Checkpointer.
+/// @details SaveState() returns the rank-local state; LoadState() receives exactly those bytes on the same rank of a
+///          later run and returns false when it cannot continue from them.
+template <typename TaskType>
+concept Checkpointable = requires(TaskType &task, const TaskType &const_task, std::span<const std::byte> state) {
+  { const_task.SaveState() } -> std::same_as<std::vector<std::byte>>;
+  { task.LoadState(state) } -> std::same_as<bool>;
+};
+
+/// @brief Seconds between checkpoints from PPC_CHECKPOINT_INTERVAL; 0 (the default) disables checkpointing.
+double GetCheckpointInterval();
+
+/// @brief Directory of the checkpoint files shared by all ranks.
+/// @details PPC_CHECKPOINT_DIR when set, otherwise a directory under the system temporary path named after
+///          PPC_TEST_UID. PPC_TEST_TMPDIR is not used because it differs between ranks.
+std::string GetCheckpointDir();
+
+/// @brief Writes every rank's @p local_state to one file at @p path; collective over MPI_COMM_WORLD when MPI is active.
+/// @details Rank offsets come from an exclusive scan of the state sizes and the data is written with
+///          MPI_File_write_at_all. The file is written next to @p path and renamed once complete, so a failure during
+///          the write keeps the previous checkpoint.
+/// @throws std::runtime_error If the file cannot be written or a rank's state exceeds 2 GiB.
+void WriteCheckpoint(const std::string &path, const std::string &fingerprint, std::span<const std::byte> local_state);
+
+/// @brief Reads the state of the calling rank from @p path; collective over MPI_COMM_WORLD when MPI is active.
+/// @return std::nullopt when the file is missing, or was written by a different number of ranks or for a different
+///         @p fingerprint.
+/// @throws std::runtime_error If the file is truncated or not a checkpoint.
+std::optional<std::vector<std::byte>> ReadCheckpoint(const std::string &path, const std::string &fingerprint);
+
+/// @brief Periodic coordinated checkpoints of one task.
+/// @details Every method is collective: all ranks must call it at the same point of the computation, typically
+///          Resume() at the start of RunImpl(), Step() after every outer iteration and Complete() at the end.
+///          When GetCheckpointInterval() is 0 the methods do nothing.
+class Checkpointer {
+ public:
+  /// @param name Identifies the checkpoint file, e.g. the task namespace.
+  /// @param fingerprint Describes the input; a checkpoint written for a different fingerprint is ignored.
+  Checkpointer(const std::string &name, std::string fingerprint);
+
+  [[nodiscard]] bool Enabled() const {
+    return interval_ > 0.0;
+  }
+
+  [[nodiscard]] const std::string &Path() const {
+    return path_;
+  }
+
+  /// @brief Restores @p task from the last checkpoint of a previous run.
+  /// @return True if the task continues from a checkpoint.
+  template <Checkpointable TaskType>
+  bool Resume(TaskType &task) {
+    if (!Enabled()) {
+      return false;
+    }
+    const auto state = ReadCheckpoint(path_, fingerprint_);
+    if (!state) {
+      return false;
+    }
+    if (!task.LoadState(*state)) {
+      throw std::runtime_error("Task rejected its checkpoint " + path_);
+    }
+    return true;
+  }
+
+  /// @brief Saves @p task when the interval has elapsed since the last checkpoint.
+  /// @details Rank 0 decides and broadcasts the decision, so all ranks write together.
+  /// @return True if a checkpoint was written.
+  template <Checkpointable TaskType>
+  bool Step(const TaskType &task) {
+    if (!Enabled() || !Due()) {
+      return false;
+    }
+    WriteCheckpoint(path_, fingerprint_, task.SaveState());
+    last_checkpoint_ = std::chrono::steady_clock::now();
+    return true;
+  }
+
+  /// @brief Removes the checkpoint once the task has finished.
+  void Complete();
+
+ private:
+  [[nodiscard]] bool Due() const;
+
+  std::string path_;
+  std::string fingerprint_;
+  double interval_ = 0.0;
+  std::chrono::steady_clock::time_point last_checkpoint_ = std::chrono::steady_clock::now();
+};
+
+}  // namespace ppc::util
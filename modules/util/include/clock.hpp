@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#  include <x86intrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#  include <intrin.h>
+#endif
+
+#if defined(__linux__) || defined(__APPLE__)
+#  include <ctime>
+#else
+#  include <chrono>
+#endif
+
+namespace ppc::util {
+
+/// @brief Counter behind ClockNow().
+enum class ClockSource : uint8_t {
+  /// @brief Time-stamp counter of a CPU that reports an invariant TSC.
+  kTsc,
+  /// @brief clock_gettime(CLOCK_MONOTONIC_RAW), or std::chrono::steady_clock where it does not exist.
+  kMonotonicRaw,
+};
+
+std::string_view ClockSourceToString(ClockSource source);
+
+/// @brief Conversion of raw ticks to seconds, fixed by the first GetClockCalibration() call of the process.
+struct ClockCalibration {
+  ClockSource source = ClockSource::kMonotonicRaw;
+  /// @brief Tick count at calibration; ClockNow() counts from it.
+  uint64_t origin_ticks = 0;
+  double seconds_per_tick = 1e-9;
+  /// @brief Smallest nonzero difference between two consecutive readings, in seconds.
+  double resolution = 0.0;
+  /// @brief Mean cost of one clock reading, in seconds.
+  double overhead = 0.0;
+};
+
+/// @brief True if the CPU reports an invariant TSC, i.e. one that ticks at a constant rate in every power state.
+bool InvariantTscAvailable();
+
+/// @brief Source named by PPC_CLOCK (tsc or monotonic_raw); by default the TSC when it is invariant.
+/// @throws std::runtime_error If PPC_CLOCK is not a known source, or requests a TSC that is not invariant.
+ClockSource GetClockSource();
+
+namespace detail {
+
+/// @brief Measures the rate of @p source against CLOCK_MONOTONIC_RAW for a couple of milliseconds, then its
+///        resolution and read overhead.
+ClockCalibration CalibrateClock(ClockSource source);
+
+inline uint64_t ReadClockTicks(ClockSource source) noexcept {
+#if defined(__x86_64__) || defined(__i386__) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+  if (source == ClockSource::kTsc) {
+    return __rdtsc();
+  }
+#else
+  (void)source;
+#endif
+#if defined(__linux__) || defined(__APPLE__)
+  timespec now{};
+  clock_gettime(CLOCK_MONOTONIC_RAW, &now);
+  return (static_cast<uint64_t>(now.tv_sec) * 1'000'000'000U) + static_cast<uint64_t>(now.tv_nsec);
+#else
+  return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch() / std::chrono::nanoseconds(1));
+#endif
+}
+
+}  // namespace detail
+
+/// @brief Calibration used by ClockNow(); the first call calibrates the clock for the whole process.
+inline const ClockCalibration &GetClockCalibration() {
+  static const ClockCalibration kCalibration = detail::CalibrateClock(GetClockSource());
+  return kCalibration;
+}
+
+/// @brief Seconds since clock calibration on the single clock every backend is benchmarked with.
+inline double ClockNow() {
+  const ClockCalibration &calibration = GetClockCalibration();
+  // Signed, so a core whose TSC lags the calibrating one by a few ticks reads slightly negative instead of wrapping
+  const auto ticks = static_cast<int64_t>(detail::ReadClockTicks(calibration.source) - calibration.origin_ticks);
+  return static_cast<double>(ticks) * calibration.seconds_per_tick;
+}
+
+}  // namespace ppc::util
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace ppc::util {
+
+/// @brief Read-only view of a whole file, memory-mapped where the platform supports it.
+/// @details Elsewhere the file is read into memory once; the interface is the same.
+class MappedFile {
+ public:
+  /// @throws std::runtime_error If the file cannot be opened or mapped.
+  explicit MappedFile(std::string path);
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  ~MappedFile();
+
+  [[nodiscard]] std::span<const std::byte> Bytes() const {
+    return {data_, size_};
+  }
+
+  [[nodiscard]] const std::string &Path() const {
+    return path_;
+  }
+
+  /// @brief Reinterprets the bytes from @p offset to the end as an array of @p T without copying.
+  /// @throws std::runtime_error If the bytes are misaligned for @p T or not a whole number of elements.
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  [[nodiscard]] std::span<const T> As(std::size_t offset = 0) const {
+    if (offset > size_ || (size_ - offset) % sizeof(T) != 0 ||
+        reinterpret_cast<std::uintptr_t>(data_ + offset) % alignof(T) != 0) {
+      throw std::runtime_error("Mapped data of " + path_ + " does not form an array of the requested type");
+    }
+    return {reinterpret_cast<const T *>(data_ + offset), (size_ - offset) / sizeof(T)};
+  }
+
+ private:
+  std::string path_;
+  const std::byte *data_ = nullptr;
+  std::size_t size_ = 0;
+  bool mapped_ = false;
+};
+
+/// @brief Maps @p path once per process; later calls share the mapping until the file changes on disk.
+std::shared_ptr<const MappedFile> MapDataFile(const std::string &path);
+
+/// @brief MapDataFile() for a file under the data directory of a task, see GetAbsoluteTaskPath().
+std::shared_ptr<const MappedFile> MapTaskData(const std::string &id_path, const std::string &relative_path);
+
+/// @brief Drops all cached mappings; views handed out earlier stay valid while their owners hold them.
+void ClearDataFileCache();
+
+/// @brief Interleaved 8-bit image pixels viewed in place.
+struct ImageView {
+  int width = 0;
+  int height = 0;
+  int channels = 0;
+  std::span<const uint8_t> pixels;
+};
+
+/// @brief Parses a binary PPM (P6, RGB) or PGM (P5, grey) image with a maximum value of at most 255.
+/// @throws std::runtime_error If the header is malformed or the pixel data is truncated.
+ImageView ParsePnm(std::span<const std::byte> bytes);
+
+/// @brief Image view that keeps its mapping alive.
+struct MappedImage {
+  std::shared_ptr<const MappedFile> file;
+  ImageView image;
+};
+
+/// @brief Maps a PPM/PGM file from the data directory of a task and returns a zero-copy view of its pixels.
+MappedImage MapTaskImage(const std::string &id_path, const std::string &relative_path);
+
+}  // namespace ppc::util
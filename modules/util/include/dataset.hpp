@@ -0,0 +1,159 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Element type stored in a dataset file.
+enum class DatasetType : uint32_t {
+  kInt8 = 1,
+  kUInt8,
+  kInt32,
+  kUInt32,
+  kInt64,
+  kUInt64,
+  kFloat32,
+  kFloat64,
+};
+
+template <typename T>
+constexpr DatasetType DatasetTypeOf() {
+  if constexpr (std::is_same_v<T, int8_t>) {
+    return DatasetType::kInt8;
+  } else if constexpr (std::is_same_v<T, uint8_t>) {
+    return DatasetType::kUInt8;
+  } else if constexpr (std::is_same_v<T, int32_t>) {
+    return DatasetType::kInt32;
+  } else if constexpr (std::is_same_v<T, uint32_t>) {
+    return DatasetType::kUInt32;
+  } else if constexpr (std::is_same_v<T, int64_t>) {
+    return DatasetType::kInt64;
+  } else if constexpr (std::is_same_v<T, uint64_t>) {
+    return DatasetType::kUInt64;
+  } else if constexpr (std::is_same_v<T, float>) {
+    return DatasetType::kFloat32;
+  } else {
+    static_assert(std::is_same_v<T, double>, "Unsupported dataset element type");
+    return DatasetType::kFloat64;
+  }
+}
+
+std::size_t DatasetTypeSize(DatasetType type);
+
+/// @brief Location and FNV-1a checksum of one chunk of elements.
+struct DatasetChunk {
+  uint64_t offset = 0;
+  uint64_t bytes = 0;
+  uint64_t checksum = 0;
+};
+
+/// @brief Parsed header of a dataset file.
+/// @details The file layout is little-endian: the 8-byte magic "PPCDSET", version, element type, number of dimensions
+///          and a reserved word (4 bytes each), the shape, the chunk size in elements and the chunk count (8 bytes
+///          each), the chunk table and finally the chunks, stored back to back from a 64-byte aligned offset so that
+///          any range of consecutive chunks is one contiguous read.
+struct DatasetHeader {
+  static constexpr uint32_t kVersion = 1;
+
+  DatasetType type = DatasetType::kUInt8;
+  std::vector<uint64_t> shape;
+  uint64_t chunk_elements = 0;
+  std::vector<DatasetChunk> chunks;
+
+  [[nodiscard]] uint64_t NumElements() const;
+
+  /// @brief Index of the first element stored in chunk @p chunk.
+  [[nodiscard]] uint64_t FirstElementOfChunk(std::size_t chunk) const {
+    return chunk * chunk_elements;
+  }
+};
+
+/// @brief FNV-1a 64-bit hash used for chunk checksums.
+uint64_t DatasetChecksum(std::span<const std::byte> bytes);
+
+/// @brief Writes @p data, interpreted with @p shape, as a dataset split into chunks of @p chunk_elements elements.
+/// @throws std::runtime_error If the shape does not match the data or the file cannot be written.
+void WriteDatasetBytes(const std::string &path, DatasetType type, std::span<const std::byte> data,
+                       const std::vector<uint64_t> &shape, uint64_t chunk_elements);
+
+template <typename T>
+void WriteDataset(const std::string &path, std::span<const T> data, const std::vector<uint64_t> &shape,
+                  uint64_t chunk_elements) {
+  WriteDatasetBytes(path, DatasetTypeOf<T>(), std::as_bytes(data), shape, chunk_elements);
+}
+
+/// @brief Elements of a contiguous range of chunks read by one rank.
+template <typename T>
+struct DatasetSlice {
+  std::size_t first_chunk = 0;
+  std::size_t num_chunks = 0;
+  uint64_t first_element = 0;
+  std::vector<T> data;
+};
+
+/// @brief Reads a dataset file chunk by chunk.
+/// @details Every chunk is checked against its checksum when @p verify_checksums is set.
+class DatasetReader {
+ public:
+  /// @throws std::runtime_error If the file is missing, has a different version or a corrupt header.
+  explicit DatasetReader(std::string path, bool verify_checksums = true);
+
+  [[nodiscard]] const DatasetHeader &Header() const {
+    return header_;
+  }
+
+  /// @brief Reads chunks [@p first_chunk, @p first_chunk + @p num_chunks) into @p out, in parallel on the STL pool.
+  void ReadChunksBytes(std::size_t first_chunk, std::size_t num_chunks, std::span<std::byte> out) const;
+
+  /// @brief Reads the whole dataset with all threads of the STL pool.
+  template <typename T>
+  std::vector<T> ReadAll() const {
+    CheckType<T>();
+    std::vector<T> data(header_.NumElements());
+    ReadChunksBytes(0, header_.chunks.size(), std::as_writable_bytes(std::span(data)));
+    return data;
+  }
+
+  /// @brief Reads only this rank's contiguous block of chunks of @p comm through collective MPI-IO.
+  /// @details Chunks are distributed like elements of a block decomposition: the first ranks get one extra chunk
+  ///          when the count does not divide evenly. Without MPI the single process reads every chunk.
+  template <typename T>
+  DatasetSlice<T> ReadLocalChunks(MPI_Comm comm) const {
+    CheckType<T>();
+    DatasetSlice<T> slice;
+    std::size_t bytes = 0;
+    LocalChunkRange(comm, slice.first_chunk, slice.num_chunks, bytes);
+    slice.first_element = header_.FirstElementOfChunk(slice.first_chunk);
+    slice.data.resize(bytes / sizeof(T));
+    ReadChunksCollective(comm, slice.first_chunk, slice.num_chunks, std::as_writable_bytes(std::span(slice.data)));
+    return slice;
+  }
+
+ private:
+  template <typename T>
+  void CheckType() const {
+    if (DatasetTypeOf<T>() != header_.type) {
+      throw std::runtime_error("Dataset " + path_ + " holds a different element type");
+    }
+  }
+
+  void LocalChunkRange(MPI_Comm comm, std::size_t &first_chunk, std::size_t &num_chunks, std::size_t &bytes) const;
+  void ReadChunksCollective(MPI_Comm comm, std::size_t first_chunk, std::size_t num_chunks,
+                            std::span<std::byte> out) const;
+  void VerifyChunks(std::size_t first_chunk, std::size_t num_chunks, std::span<const std::byte> data) const;
+  [[nodiscard]] std::size_t ChunkRangeBytes(std::size_t first_chunk, std::size_t num_chunks) const;
+
+  std::string path_;
+  bool verify_checksums_;
+  DatasetHeader header_;
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Half-open range [begin, begin + count) of global indices.
+struct BlockRange {
+  int64_t begin = 0;
+  int64_t count = 0;
+
+  [[nodiscard]] constexpr int64_t End() const {
+    return begin + count;
+  }
+};
+
+/// @brief Block @p index of @p total items split into @p parts blocks; the first total % parts blocks are one longer.
+constexpr BlockRange BlockPartition(int64_t total, int parts, int index) {
+  const int64_t base = total / std::max(parts, 1);
+  const int64_t extra = total % std::max(parts, 1);
+  return {.begin = (index * base) + std::min<int64_t>(index, extra), .count = base + (index < extra ? 1 : 0)};
+}
+
+/// @brief Block decomposition of a global grid over a Cartesian communicator.
+/// @details Dimension 0 is the slowest-varying one, like rows of a row-major matrix. Processes per dimension are
+///          taken from @p dims, where 0 lets MPI_Dims_create choose. Boundaries are not periodic. Without MPI the
+///          whole grid belongs to the calling process and every neighbour is MPI_PROC_NULL.
+class BlockDecomposition {
+ public:
+  BlockDecomposition(MPI_Comm comm, std::vector<int64_t> extents, std::vector<int> dims = {});
+  BlockDecomposition(const BlockDecomposition &) = delete;
+  BlockDecomposition &operator=(const BlockDecomposition &) = delete;
+  ~BlockDecomposition();
+
+  [[nodiscard]] int NumDims() const {
+    return static_cast<int>(extents_.size());
+  }
+
+  /// @brief Cartesian communicator, or MPI_COMM_NULL without MPI.
+  [[nodiscard]] MPI_Comm Comm() const {
+    return cart_comm_;
+  }
+
+  [[nodiscard]] const std::vector<int64_t> &Extents() const {
+    return extents_;
+  }
+
+  [[nodiscard]] const std::vector<int> &Dims() const {
+    return dims_;
+  }
+
+  [[nodiscard]] const std::vector<int> &Coords() const {
+    return coords_;
+  }
+
+  /// @brief Global indices owned by this process along @p dim.
+  [[nodiscard]] BlockRange Local(int dim) const {
+    return BlockPartition(extents_.at(dim), dims_.at(dim), coords_.at(dim));
+  }
+
+  /// @brief Rank in Comm() one step along @p dim towards lower (@p direction < 0) or higher indices.
+  /// @return MPI_PROC_NULL at the edge of the grid.
+  [[nodiscard]] int Neighbor(int dim, int direction) const {
+    return direction < 0 ? lower_.at(dim) : upper_.at(dim);
+  }
+
+ private:
+  std::vector<int64_t> extents_;
+  std::vector<int> dims_;
+  std::vector<int> coords_;
+  std::vector<int> lower_;
+  std::vector<int> upper_;
+  MPI_Comm cart_comm_ = MPI_COMM_NULL;
+};
+
+}  // namespace ppc::util
@@ -106,6 +106,7 @@ class BaseRunFuncTests : public ::testing::TestWithParam<FuncTestParam<InType, O
   }
 
   /// @brief Initializes task instance and runs it through the full pipeline.
+  /// @details The input returned by GetTestInputData() is moved through the task getter into the task.
   void InitializeAndRunTask(const FuncTestParam<InType, OutType, TestType> &test_param) {
     task_ = std::get<static_cast<std::size_t>(GTestParamIndex::kTaskGetter)>(test_param)(GetTestInputData());
     ExecuteTaskPipeline();
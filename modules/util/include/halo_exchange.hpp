@@ -0,0 +1,149 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "util/include/decomposition.hpp"
+#include "util/include/mpi_datatype.hpp"
+#include "util/include/util.hpp"
+
+namespace ppc::util {
+
+/// @brief Ghost-cell exchange of a 1D or 2D block field on persistent non-blocking requests.
+/// @details Works on raw bytes; HaloExchange<T> is the typed front end. The requests and derived datatypes are set
+///          up once, so every Start() is a single MPI_Startall over at most four sends and four receives.
+class HaloExchangeBytes {
+ public:
+  HaloExchangeBytes(const BlockDecomposition &decomposition, std::byte *field, std::size_t element_size, int ghost);
+  HaloExchangeBytes(const HaloExchangeBytes &) = delete;
+  HaloExchangeBytes &operator=(const HaloExchangeBytes &) = delete;
+  ~HaloExchangeBytes();
+
+  void Start();
+  void Wait();
+
+ private:
+  void CreateFaces(const BlockDecomposition &decomposition, std::byte *field, std::size_t element_size, int ghost);
+  void AddFace(MPI_Datatype face, std::byte *send, std::byte *recv, int neighbor, int send_tag, int recv_tag);
+  /// Frees the persistent requests and datatypes, also those of a constructor that failed half-way.
+  void Release();
+
+  MPI_Comm comm_;
+  std::vector<MPI_Request> requests_;
+  std::vector<MPI_Datatype> types_;
+  bool started_ = false;
+};
+
+/// @brief Exchanges the ghost cells of this process's block of @p decomposition with its neighbours.
+/// @details @p field holds the local block padded by @p ghost cells on both sides of every dimension, row-major
+///          with the last dimension fastest (see PaddedExtents()). Only faces are exchanged, which suits 3- and
+///          5-point stencils; corner ghosts of a 2D field are left untouched. Edge ghosts of the global grid are
+///          never written. Overlap computation with communication by updating the interior between Start() and
+///          Wait(), and the cells next to the ghosts afterwards.
+template <typename T>
+class HaloExchange {
+  static_assert(std::is_trivially_copyable_v<T>, "Ghost cells are exchanged as raw bytes");
+
+ public:
+  /// @throws std::runtime_error If @p field does not have the padded size or a block is thinner than @p ghost.
+  HaloExchange(const BlockDecomposition &decomposition, std::span<T> field, int ghost = 1)
+      : exchange_(decomposition, CheckedData(decomposition, field, ghost), sizeof(T), ghost) {}
+
+  /// @brief Local extents including the ghost cells, one per dimension.
+  static std::vector<int64_t> PaddedExtents(const BlockDecomposition &decomposition, int ghost) {
+    std::vector<int64_t> extents;
+    for (int dim = 0; dim < decomposition.NumDims(); dim++) {
+      extents.push_back(decomposition.Local(dim).count + (2 * static_cast<int64_t>(ghost)));
+    }
+    return extents;
+  }
+
+  static std::size_t PaddedSize(const BlockDecomposition &decomposition, int ghost) {
+    std::size_t size = 1;
+    for (const int64_t extent : PaddedExtents(decomposition, ghost)) {
+      size *= static_cast<std::size_t>(extent);
+    }
+    return size;
+  }
+
+  /// @brief Posts all ghost sends and receives.
+  void Start() {
+    exchange_.Start();
+  }
+
+  /// @brief Completes the exchange started by Start(); ghost cells are valid afterwards.
+  void Wait() {
+    exchange_.Wait();
+  }
+
+  void Exchange() {
+    Start();
+    Wait();
+  }
+
+ private:
+  static std::byte *CheckedData(const BlockDecomposition &decomposition, std::span<T> field, int ghost) {
+    if (field.size() != PaddedSize(decomposition, ghost)) {
+      throw std::runtime_error("Halo field does not match the padded local block");
+    }
+    return reinterpret_cast<std::byte *>(field.data());
+  }
+
+  HaloExchangeBytes exchange_;
+};
+
+/// @brief Non-blocking MPI_Iallreduce; computation can go on until Wait().
+/// @details The destructor waits, so the buffers must outlive the object. Without MPI @p send is copied to @p recv.
+template <typename T>
+class PendingAllreduce {
+ public:
+  PendingAllreduce(std::span<const T> send, std::span<T> recv, MPI_Op op, MPI_Comm comm = MPI_COMM_WORLD) {
+    if (send.size() != recv.size()) {
+      throw std::runtime_error("Allreduce buffers differ in size");
+    }
+    if (!IsMpiActive()) {
+      if (send.data() != recv.data()) {
+        std::ranges::copy(send, recv.begin());
+      }
+      return;
+    }
+    // Reducing a buffer into itself is only legal through MPI_IN_PLACE
+    const void *send_buffer = send.data() == recv.data() ? MPI_IN_PLACE : send.data();
+    MPI_Iallreduce(send_buffer, recv.data(), static_cast<int>(send.size()), MpiDatatypeOf<T>(), op, comm, &request_);
+  }
+
+  PendingAllreduce(const PendingAllreduce &) = delete;
+  PendingAllreduce &operator=(const PendingAllreduce &) = delete;
+
+  ~PendingAllreduce() {
+    Wait();
+  }
+
+  /// @brief True once the result is in the receive buffer; progresses the reduction otherwise.
+  bool Test() {
+    if (request_ == MPI_REQUEST_NULL) {
+      return true;
+    }
+    int done = 0;
+    MPI_Test(&request_, &done, MPI_STATUS_IGNORE);
+    return done != 0;
+  }
+
+  void Wait() {
+    if (request_ != MPI_REQUEST_NULL) {
+      MPI_Wait(&request_, MPI_STATUS_IGNORE);
+    }
+  }
+
+ private:
+  MPI_Request request_ = MPI_REQUEST_NULL;
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Hardware events sampled around Task::Run() in performance tests.
+enum class HardwareEvent : uint8_t {
+  kCycles,
+  kInstructions,
+  kCacheMisses,
+  kBranchMisses,
+};
+
+inline constexpr std::size_t kNumHardwareEvents = 4;
+
+/// @brief Event counts indexed by HardwareEvent.
+using HardwareEventCounts = std::array<uint64_t, kNumHardwareEvents>;
+
+constexpr std::string_view HardwareEventName(HardwareEvent event) {
+  switch (event) {
+    case HardwareEvent::kCycles:
+      return "cycles";
+    case HardwareEvent::kInstructions:
+      return "instructions";
+    case HardwareEvent::kCacheMisses:
+      return "cache_misses";
+    case HardwareEvent::kBranchMisses:
+      return "branch_misses";
+  }
+  return "unknown";
+}
+
+/// @brief Returns true when PPC_PERF_COUNTERS requests hardware counter collection.
+bool HardwareCountersEnabled();
+
+/// @brief Per-process hardware event counters backed by Linux perf_event.
+/// @details Counts user-space events of every thread the process has when the counters are built, so that OpenMP,
+///          TBB and ThreadPool workers started earlier are included, and of threads they spawn while counting. On
+///          other platforms, or when the kernel refuses an event, that event stays unavailable and reads as 0.
+class HardwareCounters {
+ public:
+  HardwareCounters();
+  HardwareCounters(const HardwareCounters &) = delete;
+  HardwareCounters &operator=(const HardwareCounters &) = delete;
+  ~HardwareCounters();
+
+  /// @brief Returns true if at least one event could be opened.
+  [[nodiscard]] bool IsAvailable() const;
+
+  /// @brief Resets and starts all available events.
+  void Start();
+
+  /// @brief Stops all events and adds their values to the running totals.
+  void Stop();
+
+  /// @brief Returns the counts accumulated over every Start()/Stop() pair.
+  [[nodiscard]] const HardwareEventCounts &Totals() const {
+    return totals_;
+  }
+
+ private:
+  /// @brief One descriptor per event for every counted thread; -1 where the event could not be opened.
+  std::vector<std::array<int, kNumHardwareEvents>> fds_;
+  HardwareEventCounts totals_{};
+};
+
+}  // namespace ppc::util
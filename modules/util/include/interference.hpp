@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace ppc::util {
+
+/// @brief Use of the interference probe by the performance runner, selected with PPC_PERF_INTERFERENCE.
+enum class InterferenceMode : uint8_t {
+  /// No probe runs
+  kOff,
+  /// Every benchmark is probed before and after its measured iterations and reports the probes as counters
+  kRecord,
+  /// Like kRecord, and a benchmark waits while the probe before it shows interference
+  kPause,
+};
+
+/// @brief Reads PPC_PERF_INTERFERENCE (off, record or pause); defaults to off.
+/// @throws std::runtime_error If the variable holds another value.
+InterferenceMode GetInterferenceMode();
+
+constexpr std::string_view InterferenceModeToString(InterferenceMode mode) {
+  switch (mode) {
+    case InterferenceMode::kOff:
+      return "off";
+    case InterferenceMode::kRecord:
+      return "record";
+    case InterferenceMode::kPause:
+      return "pause";
+  }
+  return "off";
+}
+
+/// @brief Slowdown above which a probe counts as interfered, from PPC_PERF_INTERFERENCE_THRESHOLD; defaults to 0.1.
+/// @throws std::runtime_error If the value is not in (0, 1).
+double GetInterferenceThreshold();
+
+/// @brief Number of pauses a benchmark waits for a quiet probe under kPause, from PPC_PERF_INTERFERENCE_RETRIES;
+///        defaults to 3.
+/// @throws std::runtime_error If the value is negative.
+int GetInterferenceRetries();
+
+/// @brief Rates measured by one probe of this process.
+struct InterferenceSample {
+  /// @brief STREAM triad bandwidth of one thread, counting 24 bytes per element.
+  double bytes_per_second = 0.0;
+  /// @brief Steps of a dependent integer multiply-add chain; proportional to the core clock frequency.
+  double core_steps_per_second = 0.0;
+};
+
+/// @brief Runs the bandwidth and core frequency probes on the calling thread, keeping the best of a few trials.
+/// @details Takes a few milliseconds with the default @p stream_elements doubles per array.
+InterferenceSample MeasureInterferenceSample(std::size_t stream_elements = std::size_t{1} << 20);
+
+/// @brief Relative slowdown of @p sample against @p reference: the larger drop of its two rates, 0 when not slower.
+double InterferenceSlowdown(const InterferenceSample &sample, const InterferenceSample &reference);
+
+/// @brief One probe of every rank.
+struct InterferenceProbe {
+  /// @brief Sample of this rank.
+  InterferenceSample sample;
+  /// @brief Largest InterferenceSlowdown() of any rank against its quiet reference.
+  double slowdown = 0.0;
+};
+
+/// @brief Probes this rank, folds the sample into its quiet reference and reduces the slowdown over all ranks.
+/// @details The quiet reference holds the best rates seen by the process, so the first probe never shows a
+///          slowdown. Collective while MPI is active.
+InterferenceProbe ProbeInterference();
+
+/// @brief Quiet reference of this rank, or std::nullopt when ProbeInterference() was never called.
+std::optional<InterferenceSample> GetInterferenceReference();
+
+/// @brief cgroup v2 directory the performance runner moves into, from PPC_PERF_CGROUP.
+std::optional<std::string> GetPerfCgroup();
+
+/// @brief Moves this process into the cgroup v2 directory @p cgroup and returns its effective CPU list.
+/// @details The directory is prepared outside the runner, usually as an isolated cpuset partition. A non-empty
+///          @p cpus is first written to its cpuset.cpus. Call before threads are pinned, as the cpuset narrows the
+///          CPUs they may use.
+/// @throws std::runtime_error If the cgroup does not exist, cannot be written or the platform has no cgroups.
+std::string JoinCgroup(const std::string &cgroup, const std::string &cpus = {});
+
+}  // namespace ppc::util
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Adds the lifetime of the current scope to the busy time of the calling thread.
+/// @details ThreadPool::ParallelFor() participants are measured automatically; OpenMP and TBB tasks place one inside
+///          their parallel bodies to have their threads included in the thread imbalance metrics.
+class ScopedBusyTime {
+ public:
+  ScopedBusyTime();
+  ScopedBusyTime(const ScopedBusyTime &) = delete;
+  ScopedBusyTime &operator=(const ScopedBusyTime &) = delete;
+  ~ScopedBusyTime();
+
+ private:
+  int64_t begin_ns_;
+};
+
+/// @brief Cumulative busy time in seconds of every thread that has used ScopedBusyTime, by registration order.
+std::vector<double> GetThreadBusyTimes();
+
+/// @brief Spread of per-worker times; @c factor is max / mean, 1 for a perfectly balanced run.
+struct LoadImbalance {
+  double min = 0.0;
+  double mean = 0.0;
+  double max = 0.0;
+  double factor = 1.0;
+};
+
+/// @brief Summarizes @p times; a non-positive mean yields a factor of 1.
+LoadImbalance ComputeLoadImbalance(std::span<const double> times);
+
+/// @brief Collects this rank's Run() time and the busy time of its threads over all measured Run() calls.
+class LoadBalanceTracker {
+ public:
+  /// @brief Snapshots the thread busy times before Run().
+  void Start();
+
+  /// @brief Adds @p run_time, this rank's Run() time, and the busy time every thread accumulated since Start().
+  void Stop(double run_time);
+
+  [[nodiscard]] std::size_t Runs() const {
+    return runs_;
+  }
+
+  /// @brief Sum of this rank's Run() times.
+  [[nodiscard]] double RunTime() const {
+    return run_time_;
+  }
+
+  /// @brief Busy time summed over runs for every thread that did work during at least one of them.
+  [[nodiscard]] std::vector<double> ThreadBusyTimes() const;
+
+ private:
+  std::vector<double> start_busy_;
+  std::vector<double> busy_;
+  double run_time_ = 0.0;
+  std::size_t runs_ = 0;
+};
+
+}  // namespace ppc::util
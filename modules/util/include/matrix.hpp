@@ -0,0 +1,319 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "util/include/mpi_datatype.hpp"
+
+namespace ppc::util {
+
+/// @brief Element order of a Matrix in memory.
+enum class MatrixLayout : uint8_t {
+  kRowMajor,
+  kColMajor,
+  /// Square tiles stored one after another in row-major tile order, each tile row-major inside.
+  kTiled,
+};
+
+/// @brief Allocator that returns storage aligned to @p Alignment bytes.
+template <typename T, std::size_t Alignment>
+struct AlignedAllocator {
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() = default;
+  template <typename U>
+  explicit(false) AlignedAllocator(const AlignedAllocator<U, Alignment> & /*other*/) noexcept {}
+
+  [[nodiscard]] T *allocate(std::size_t n) {
+    return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+  }
+
+  void deallocate(T *p, std::size_t n) noexcept {
+    ::operator delete(p, n * sizeof(T), std::align_val_t{Alignment});
+  }
+
+  friend bool operator==(const AlignedAllocator & /*lhs*/, const AlignedAllocator & /*rhs*/) = default;
+};
+
+/// @brief Extents and layout of a matrix, shared by Matrix and its views.
+struct MatrixShape {
+  std::size_t rows = 0;
+  std::size_t cols = 0;
+  MatrixLayout layout = MatrixLayout::kRowMajor;
+  std::size_t tile = 1;
+
+  [[nodiscard]] std::size_t TileRows() const {
+    return (rows + tile - 1) / tile;
+  }
+
+  [[nodiscard]] std::size_t TileCols() const {
+    return (cols + tile - 1) / tile;
+  }
+
+  /// @brief Number of stored elements, including the padding of partial edge tiles.
+  [[nodiscard]] std::size_t StorageSize() const {
+    return layout == MatrixLayout::kTiled ? TileRows() * TileCols() * tile * tile : rows * cols;
+  }
+
+  /// @brief Position of element (@p row, @p col) in the storage.
+  [[nodiscard]] std::size_t Offset(std::size_t row, std::size_t col) const {
+    switch (layout) {
+      case MatrixLayout::kColMajor:
+        return (col * rows) + row;
+      case MatrixLayout::kTiled:
+        return ((((row / tile) * TileCols()) + (col / tile)) * tile * tile) + ((row % tile) * tile) + (col % tile);
+      case MatrixLayout::kRowMajor:
+      default:
+        return (row * cols) + col;
+    }
+  }
+};
+
+/// @brief Zero-copy view of a rectangular block of a Matrix.
+/// @tparam T Element type; const for read-only views.
+template <typename T>
+class MatrixView {
+ public:
+  MatrixView(T *storage, MatrixShape shape, std::size_t row, std::size_t col, std::size_t rows, std::size_t cols)
+      : storage_(storage), shape_(shape), row_(row), col_(col), rows_(rows), cols_(cols) {}
+
+  [[nodiscard]] std::size_t Rows() const {
+    return rows_;
+  }
+
+  [[nodiscard]] std::size_t Cols() const {
+    return cols_;
+  }
+
+  T &operator()(std::size_t row, std::size_t col) const {
+    return storage_[shape_.Offset(row_ + row, col_ + col)];
+  }
+
+  /// @brief Address to pass to MPI together with MpiBlockType().
+  [[nodiscard]] T *BasePointer() const {
+    return storage_ + shape_.Offset(row_, col_);
+  }
+
+  /// @brief Derived datatype that describes the block in place, starting at BasePointer().
+  /// @details Tiled blocks must start on a tile corner and end on one or at the matrix edge; their type covers whole
+  ///          tiles, padding included, so they transfer into a tiled block of the same tile size.
+  /// @throws std::runtime_error If a tiled block does not follow tile boundaries.
+  [[nodiscard]] ScopedMpiDatatype MpiBlockType() const {
+    const MPI_Datatype element = MpiDatatypeOf<std::remove_const_t<T>>();
+    MPI_Datatype type = MPI_DATATYPE_NULL;
+    if (shape_.layout == MatrixLayout::kRowMajor) {
+      MPI_Type_vector(Int(rows_), Int(cols_), Int(shape_.cols), element, &type);
+    } else if (shape_.layout == MatrixLayout::kColMajor) {
+      MPI_Type_vector(Int(cols_), Int(rows_), Int(shape_.rows), element, &type);
+    } else {
+      CheckTileAligned();
+      const std::size_t tile_elements = shape_.tile * shape_.tile;
+      const std::size_t tile_rows = (rows_ + shape_.tile - 1) / shape_.tile;
+      const std::size_t tile_cols = (cols_ + shape_.tile - 1) / shape_.tile;
+      MPI_Type_vector(Int(tile_rows), Int(tile_cols * tile_elements), Int(shape_.TileCols() * tile_elements),
+                      element, &type);
+    }
+    return ScopedMpiDatatype(type);
+  }
+
+ private:
+  static int Int(std::size_t value) {
+    return static_cast<int>(value);
+  }
+
+  void CheckTileAligned() const {
+    const std::size_t tile = shape_.tile;
+    const bool rows_end_on_tile = rows_ % tile == 0 || row_ + rows_ == shape_.rows;
+    const bool cols_end_on_tile = cols_ % tile == 0 || col_ + cols_ == shape_.cols;
+    if (row_ % tile != 0 || col_ % tile != 0 || !rows_end_on_tile || !cols_end_on_tile) {
+      throw std::runtime_error("Block of a tiled matrix must follow tile boundaries");
+    }
+  }
+
+  T *storage_;
+  MatrixShape shape_;
+  std::size_t row_;
+  std::size_t col_;
+  std::size_t rows_;
+  std::size_t cols_;
+};
+
+/// @brief Dense matrix with row-major, column-major or cache-blocked tiled storage.
+/// @details Storage is 64-byte aligned and value-initialised, and in the tiled layout every tile starts on a cache
+///          line, so the padding of partial edge tiles stays zero unless written explicitly.
+template <typename T>
+class Matrix {
+ public:
+  static constexpr std::size_t kAlignment = 64;
+  static constexpr std::size_t kDefaultTileSize = 32;
+
+  Matrix() = default;
+
+  /// @throws std::runtime_error If a tiled layout gets a tile size whose tiles are not whole cache lines.
+  Matrix(std::size_t rows, std::size_t cols, MatrixLayout layout = MatrixLayout::kRowMajor,
+         std::size_t tile = kDefaultTileSize)
+      : shape_{.rows = rows, .cols = cols, .layout = layout, .tile = layout == MatrixLayout::kTiled ? tile : 1} {
+    if (layout == MatrixLayout::kTiled && (tile == 0 || (tile * tile * sizeof(T)) % kAlignment != 0)) {
+      throw std::runtime_error("Tile size " + std::to_string(tile) + " does not fill whole cache lines");
+    }
+    storage_.resize(shape_.StorageSize());
+  }
+
+  [[nodiscard]] std::size_t Rows() const {
+    return shape_.rows;
+  }
+
+  [[nodiscard]] std::size_t Cols() const {
+    return shape_.cols;
+  }
+
+  [[nodiscard]] MatrixLayout Layout() const {
+    return shape_.layout;
+  }
+
+  /// @brief Tile edge in elements; 1 for the untiled layouts.
+  [[nodiscard]] std::size_t TileSize() const {
+    return shape_.tile;
+  }
+
+  [[nodiscard]] const MatrixShape &Shape() const {
+    return shape_;
+  }
+
+  [[nodiscard]] std::size_t Offset(std::size_t row, std::size_t col) const {
+    return shape_.Offset(row, col);
+  }
+
+  T &operator()(std::size_t row, std::size_t col) {
+    return storage_[Offset(row, col)];
+  }
+
+  const T &operator()(std::size_t row, std::size_t col) const {
+    return storage_[Offset(row, col)];
+  }
+
+  /// @brief Raw storage in layout order.
+  [[nodiscard]] std::span<T> Storage() {
+    return storage_;
+  }
+
+  [[nodiscard]] std::span<const T> Storage() const {
+    return storage_;
+  }
+
+  /// @brief Block of @p rows x @p cols elements whose top-left corner is (@p row, @p col).
+  /// @throws std::runtime_error If the block does not fit in the matrix.
+  MatrixView<T> Block(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) {
+    CheckBlock(row, col, rows, cols);
+    return {storage_.data(), shape_, row, col, rows, cols};
+  }
+
+  MatrixView<const T> Block(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) const {
+    CheckBlock(row, col, rows, cols);
+    return {storage_.data(), shape_, row, col, rows, cols};
+  }
+
+  /// @brief Copy of the matrix in another layout.
+  [[nodiscard]] Matrix ToLayout(MatrixLayout layout, std::size_t tile = kDefaultTileSize) const {
+    Matrix converted(shape_.rows, shape_.cols, layout, tile);
+    for (std::size_t row = 0; row < shape_.rows; row++) {
+      for (std::size_t col = 0; col < shape_.cols; col++) {
+        converted(row, col) = (*this)(row, col);
+      }
+    }
+    return converted;
+  }
+
+ private:
+  void CheckBlock(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) const {
+    if (row + rows > shape_.rows || col + cols > shape_.cols) {
+      throw std::runtime_error("Matrix block exceeds the matrix");
+    }
+  }
+
+  MatrixShape shape_;
+  std::vector<T, AlignedAllocator<T, kAlignment>> storage_;
+};
+
+namespace detail {
+
+/// c += alpha * a * b for three row-major tiles of tile x tile elements.
+template <typename T>
+void GemmTile(const T *a, const T *b, T *c, std::size_t tile, T alpha) {
+  for (std::size_t i = 0; i < tile; i++) {
+    for (std::size_t k = 0; k < tile; k++) {
+      const T scaled = alpha * a[(i * tile) + k];
+      const T *b_row = b + (k * tile);
+      T *c_row = c + (i * tile);
+      for (std::size_t j = 0; j < tile; j++) {
+        c_row[j] += scaled * b_row[j];
+      }
+    }
+  }
+}
+
+}  // namespace detail
+
+/// @brief Reference GEMM: @p c = @p alpha * @p a * @p b + @p beta * @p c.
+/// @details When all three matrices are tiled with the same tile size the product runs tile by tile on whole cache
+///          lines, relying on the zero padding of edge tiles; any other combination of layouts goes element-wise.
+/// @throws std::runtime_error If the extents do not match.
+template <typename T>
+void Gemm(const Matrix<T> &a, const Matrix<T> &b, Matrix<T> &c, T alpha = T{1}, T beta = T{0}) {
+  if (a.Cols() != b.Rows() || c.Rows() != a.Rows() || c.Cols() != b.Cols()) {
+    throw std::runtime_error("Gemm extents do not match");
+  }
+  std::span<T> c_storage = c.Storage();
+  if (beta == T{0}) {
+    std::ranges::fill(c_storage, T{0});
+  } else if (beta != T{1}) {
+    for (T &value : c_storage) {
+      value *= beta;
+    }
+  }
+
+  const bool tiled = a.Layout() == MatrixLayout::kTiled && b.Layout() == MatrixLayout::kTiled &&
+                     c.Layout() == MatrixLayout::kTiled && a.TileSize() == b.TileSize() &&
+                     a.TileSize() == c.TileSize();
+  if (tiled) {
+    const std::size_t tile = c.TileSize();
+    const std::size_t tile_elements = tile * tile;
+    const std::size_t inner_tiles = a.Shape().TileCols();
+    for (std::size_t ti = 0; ti < c.Shape().TileRows(); ti++) {
+      for (std::size_t tk = 0; tk < inner_tiles; tk++) {
+        const T *a_tile = a.Storage().data() + (((ti * inner_tiles) + tk) * tile_elements);
+        for (std::size_t tj = 0; tj < c.Shape().TileCols(); tj++) {
+          const T *b_tile = b.Storage().data() + (((tk * b.Shape().TileCols()) + tj) * tile_elements);
+          T *c_tile = c_storage.data() + (((ti * c.Shape().TileCols()) + tj) * tile_elements);
+          detail::GemmTile(a_tile, b_tile, c_tile, tile, alpha);
+        }
+      }
+    }
+    return;
+  }
+
+  for (std::size_t i = 0; i < a.Rows(); i++) {
+    for (std::size_t k = 0; k < a.Cols(); k++) {
+      const T scaled = alpha * a(i, k);
+      for (std::size_t j = 0; j < b.Cols(); j++) {
+        c(i, j) += scaled * b(k, j);
+      }
+    }
+  }
+}
+
+}  // namespace ppc::util
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ppc::util {
+
+/// @brief Heap allocations made through operator new.
+struct AllocationStats {
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+};
+
+/// @brief Returns true when core_module_lib was built with USE_ALLOCATION_COUNTER.
+bool AllocationCounterEnabled();
+
+/// @brief Process-wide allocation totals since start-up; all zero unless AllocationCounterEnabled().
+AllocationStats GetAllocationStats();
+
+/// @brief Resident set size of the process in bytes, or 0 when unknown.
+uint64_t GetCurrentRssBytes();
+
+/// @brief Resident set size high-water mark of the process in bytes, or 0 when unknown.
+uint64_t GetPeakRssBytes();
+
+/// @brief Returns true when PPC_PERF_MEMORY requests memory tracking in performance tests.
+bool MemoryTrackingEnabled();
+
+/// @brief Per-process memory footprint collected around Task::Run() in performance tests.
+/// @details On Linux the RSS high-water mark is reset before every Run(), so the reported growth belongs to that run
+///          only; elsewhere it is measured against the process-wide peak and may under-report later runs.
+class MemoryTracker {
+ public:
+  /// @brief Records the RSS and allocation counters before Run().
+  void Start();
+
+  /// @brief Adds the allocations made since Start() and keeps the largest RSS growth seen.
+  void Stop();
+
+  [[nodiscard]] const AllocationStats &Allocations() const {
+    return allocations_;
+  }
+
+  /// @brief Largest RSS growth over a single run, in bytes.
+  [[nodiscard]] uint64_t PeakRssDeltaBytes() const {
+    return peak_rss_delta_bytes_;
+  }
+
+ private:
+  AllocationStats start_allocations_;
+  uint64_t start_rss_bytes_ = 0;
+  AllocationStats allocations_;
+  uint64_t peak_rss_delta_bytes_ = 0;
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <type_traits>
+#include <utility>
+
+namespace ppc::util {
+
+/// @brief MPI datatype matching the arithmetic type @p T.
+template <typename T>
+MPI_Datatype MpiDatatypeOf() {
+  if constexpr (std::is_same_v<T, char>) {
+    return MPI_CHAR;
+  } else if constexpr (std::is_same_v<T, int>) {
+    return MPI_INT;
+  } else if constexpr (std::is_same_v<T, unsigned>) {
+    return MPI_UNSIGNED;
+  } else if constexpr (std::is_same_v<T, long>) {
+    return MPI_LONG;
+  } else if constexpr (std::is_same_v<T, unsigned long>) {
+    return MPI_UNSIGNED_LONG;
+  } else if constexpr (std::is_same_v<T, long long>) {
+    return MPI_LONG_LONG;
+  } else if constexpr (std::is_same_v<T, unsigned long long>) {
+    return MPI_UNSIGNED_LONG_LONG;
+  } else if constexpr (std::is_same_v<T, float>) {
+    return MPI_FLOAT;
+  } else {
+    static_assert(std::is_same_v<T, double>, "No MPI datatype for this type");
+    return MPI_DOUBLE;
+  }
+}
+
+/// @brief Owns a committed derived MPI datatype and frees it on destruction.
+class ScopedMpiDatatype {
+ public:
+  ScopedMpiDatatype() = default;
+  /// @brief Commits @p type and takes ownership of it.
+  explicit ScopedMpiDatatype(MPI_Datatype type) : type_(type) {
+    MPI_Type_commit(&type_);
+  }
+  ScopedMpiDatatype(const ScopedMpiDatatype &) = delete;
+  ScopedMpiDatatype &operator=(const ScopedMpiDatatype &) = delete;
+  ScopedMpiDatatype(ScopedMpiDatatype &&other) noexcept : type_(std::exchange(other.type_, MPI_DATATYPE_NULL)) {}
+  ScopedMpiDatatype &operator=(ScopedMpiDatatype &&other) noexcept {
+    std::swap(type_, other.type_);
+    return *this;
+  }
+  ~ScopedMpiDatatype() {
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (type_ != MPI_DATATYPE_NULL && finalized == 0) {
+      MPI_Type_free(&type_);
+    }
+  }
+
+  [[nodiscard]] MPI_Datatype Get() const {
+    return type_;
+  }
+
+ private:
+  MPI_Datatype type_ = MPI_DATATYPE_NULL;
+};
+
+}  // namespace ppc::util
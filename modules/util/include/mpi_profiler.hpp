@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace ppc::util {
+
+/// @brief MPI functions intercepted through PMPI when core_module_lib is built with USE_MPI_PROFILER.
+enum class MpiCall : uint8_t {
+  kSend,
+  kRecv,
+  kIsend,
+  kIrecv,
+  kWait,
+  kWaitall,
+  kSendrecv,
+  kBcast,
+  kScatter,
+  kScatterv,
+  kGather,
+  kGatherv,
+  kAllgather,
+  kAllgatherv,
+  kReduce,
+  kAllreduce,
+  kAlltoall,
+  kAlltoallv,
+  kBarrier,
+};
+
+inline constexpr std::size_t kNumMpiCalls = 19;
+
+constexpr std::string_view MpiCallName(MpiCall call) {
+  constexpr std::array<std::string_view, kNumMpiCalls> kNames = {
+      "Send",   "Recv",      "Isend",    "Irecv",     "Wait",   "Waitall", "Sendrecv",
+      "Bcast",  "Scatter",   "Scatterv", "Gather",    "Gatherv", "Allgather", "Allgatherv",
+      "Reduce", "Allreduce", "Alltoall", "Alltoallv", "Barrier"};
+  return kNames.at(static_cast<std::size_t>(call));
+}
+
+/// @brief Pipeline stage an MPI call is attributed to.
+enum class ProfiledStage : uint8_t {
+  kValidation,
+  kPreProcessing,
+  kRun,
+  kPostProcessing,
+};
+
+inline constexpr std::size_t kNumProfiledStages = 4;
+
+/// @brief Calls, payload bytes of this rank and wall time spent in one MPI function.
+struct MpiCallStats {
+  uint64_t calls = 0;
+  uint64_t bytes = 0;
+  double time = 0.0;
+};
+
+/// @brief Returns true when the PMPI wrappers are compiled in.
+bool MpiProfilerEnabled();
+
+/// @brief Clears all recorded statistics.
+void ResetMpiProfile();
+
+/// @brief Statistics of @p call made by this rank while @p stage was active.
+MpiCallStats GetMpiCallStats(ProfiledStage stage, MpiCall call);
+
+/// @brief Attributes MPI calls made in the current scope to @p stage.
+/// @details Calls made outside any scope, such as the harness' own synchronization, are not recorded.
+class ScopedMpiProfileStage {
+ public:
+  explicit ScopedMpiProfileStage(ProfiledStage stage);
+  ScopedMpiProfileStage(const ScopedMpiProfileStage &) = delete;
+  ScopedMpiProfileStage &operator=(const ScopedMpiProfileStage &) = delete;
+  ~ScopedMpiProfileStage();
+
+ private:
+  int previous_stage_;
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Read-only bytes stored once per node in an MPI shared-memory window.
+/// @details Collective over MPI_COMM_WORLD. The node leader allocates the window with MPI_Win_allocate_shared, the
+///          root rank copies its data into its own node's window and the leaders then broadcast it to the other
+///          nodes, so only inter-node traffic goes through a regular collective and every rank of a node reads the
+///          same memory. Node communicators come from the active ScopedHybridTopology; without one every rank is
+///          treated as its own node. Without MPI the bytes are simply copied.
+class NodeSharedBuffer {
+ public:
+  /// @param data Bytes to share; only read on @p root. If it is too short every rank throws std::runtime_error.
+  /// @param bytes Size of the buffer, equal on every rank.
+  NodeSharedBuffer(std::span<const std::byte> data, std::size_t bytes, int root = 0);
+  NodeSharedBuffer(const NodeSharedBuffer &) = delete;
+  NodeSharedBuffer &operator=(const NodeSharedBuffer &) = delete;
+  /// @brief Frees the window; collective over the node like the constructor.
+  ~NodeSharedBuffer();
+
+  [[nodiscard]] std::span<const std::byte> Bytes() const {
+    return {data_, bytes_};
+  }
+
+  /// @brief True when the bytes live in a shared window rather than a private copy.
+  [[nodiscard]] bool IsShared() const {
+    return window_ != MPI_WIN_NULL;
+  }
+
+ private:
+  void BroadcastBetweenNodes(std::byte *base, int root);
+
+  const std::byte *data_ = nullptr;
+  std::size_t bytes_ = 0;
+  MPI_Win window_ = MPI_WIN_NULL;
+  std::vector<std::byte> copy_;
+};
+
+/// @brief Typed view of a NodeSharedBuffer, e.g. for the input of an MPI task that every rank reads whole.
+/// @code
+///   const ppc::util::NodeSharedArray<double> matrix(GetInput(), GetInput().size());
+///   Multiply(matrix.View(), ...);  // one copy per node instead of one per rank
+/// @endcode
+template <typename T>
+class NodeSharedArray {
+  static_assert(std::is_trivially_copyable_v<T>, "Shared arrays are copied as raw bytes");
+
+ public:
+  /// @param data Elements to share; only read on @p root.
+  /// @param count Number of elements, equal on every rank.
+  NodeSharedArray(std::span<const T> data, std::size_t count, int root = 0)
+      : buffer_(std::as_bytes(data), count * sizeof(T), root), count_(count) {}
+
+  [[nodiscard]] std::span<const T> View() const {
+    return {reinterpret_cast<const T *>(buffer_.Bytes().data()), count_};
+  }
+
+  [[nodiscard]] bool IsShared() const {
+    return buffer_.IsShared();
+  }
+
+ private:
+  NodeSharedBuffer buffer_;
+  std::size_t count_;
+};
+
+}  // namespace ppc::util
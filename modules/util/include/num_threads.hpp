@@ -0,0 +1,35 @@
+#pragma once
+
+#include <omp.h>
+#include <oneapi/tbb/global_control.h>
+
+#include <cstddef>
+#include <libenvpp/detail/environment.hpp>
+#include <string>
+
+namespace ppc::util {
+
+/// @brief Overrides the thread count seen by GetNumThreads(), OpenMP and TBB for the current scope.
+class ScopedNumThreads {
+ public:
+  explicit ScopedNumThreads(int num_threads)
+      : previous_omp_threads_(omp_get_max_threads()),
+        set_num_threads_("PPC_NUM_THREADS", std::to_string(num_threads)),
+        tbb_control_(tbb::global_control::max_allowed_parallelism, static_cast<std::size_t>(num_threads)) {
+    omp_set_num_threads(num_threads);
+  }
+
+  ScopedNumThreads(const ScopedNumThreads &) = delete;
+  ScopedNumThreads &operator=(const ScopedNumThreads &) = delete;
+
+  ~ScopedNumThreads() {
+    omp_set_num_threads(previous_omp_threads_);
+  }
+
+ private:
+  int previous_omp_threads_;
+  env::detail::set_scoped_environment_variable set_num_threads_;
+  tbb::global_control tbb_control_;
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <omp.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace ppc::util {
+
+/// @brief Direction of a copy between host memory and the offload device.
+enum class OffloadDirection : uint8_t {
+  kHostToDevice,
+  kDeviceToHost,
+};
+
+inline constexpr std::size_t kNumOffloadDirections = 2;
+
+/// @brief Copies, bytes and wall time of the host-device transfers made through OffloadCopy().
+struct OffloadTransferStats {
+  uint64_t copies = 0;
+  uint64_t bytes = 0;
+  double time = 0.0;
+};
+
+/// @brief True if the OpenMP runtime has a target device besides the host.
+bool OffloadDeviceAvailable();
+
+/// @brief Device used by kOffload tasks: PPC_OFFLOAD_DEVICE, the OpenMP default device, or the host when the
+///        runtime has no device (target regions then run on the host).
+/// @details PPC_OFFLOAD_DEVICE may also hold omp_get_initial_device() to run the target regions on the host.
+/// @throws std::runtime_error If PPC_OFFLOAD_DEVICE names a device that does not exist.
+int GetOffloadDevice();
+
+/// @brief Waits for the deferred (`nowait`) target regions started by the calling thread.
+void OffloadSynchronize();
+
+/// @brief omp_target_memcpy() of @p bytes between the host and @p device, recorded in the transfer statistics.
+/// @throws std::runtime_error If the copy fails.
+void OffloadCopy(void *dst, const void *src, std::size_t bytes, OffloadDirection direction, int device);
+
+/// @brief Clears the transfer statistics.
+void ResetOffloadTransfers();
+
+/// @brief Transfers of @p direction recorded since the last ResetOffloadTransfers().
+OffloadTransferStats GetOffloadTransferStats(OffloadDirection direction);
+
+/// @brief Accumulates the transfers made between Start() and Stop(), e.g. inside Run().
+class OffloadTransferTracker {
+ public:
+  void Start();
+  void Stop();
+
+  [[nodiscard]] const OffloadTransferStats &Stats(OffloadDirection direction) const {
+    return totals_.at(static_cast<std::size_t>(direction));
+  }
+
+  /// @brief Transfer time in both directions.
+  [[nodiscard]] double Time() const;
+
+ private:
+  std::array<OffloadTransferStats, kNumOffloadDirections> begin_{};
+  std::array<OffloadTransferStats, kNumOffloadDirections> totals_{};
+};
+
+/// @brief Array of @p T allocated with omp_target_alloc() on an offload device.
+/// @details Pass Data() to target regions through `is_device_ptr`. Upload() and Download() go through OffloadCopy(),
+///          so the performance harness can separate transfer time from kernel time.
+template <typename T>
+class DeviceBuffer {
+  static_assert(std::is_trivially_copyable_v<T>, "Device buffers are copied as raw bytes");
+
+ public:
+  explicit DeviceBuffer(std::size_t size, int device = GetOffloadDevice())
+      : size_(size), device_(device), data_(Allocate(size, device)) {}
+
+  DeviceBuffer(const DeviceBuffer &) = delete;
+  DeviceBuffer &operator=(const DeviceBuffer &) = delete;
+
+  ~DeviceBuffer() {
+    if (data_ != nullptr) {
+      omp_target_free(data_, device_);
+    }
+  }
+
+  void Upload(std::span<const T> host) {
+    CheckSize(host.size());
+    OffloadCopy(data_, host.data(), host.size_bytes(), OffloadDirection::kHostToDevice, device_);
+  }
+
+  void Download(std::span<T> host) const {
+    CheckSize(host.size());
+    OffloadCopy(host.data(), data_, host.size_bytes(), OffloadDirection::kDeviceToHost, device_);
+  }
+
+  [[nodiscard]] T *Data() const {
+    return data_;
+  }
+
+  [[nodiscard]] std::size_t Size() const {
+    return size_;
+  }
+
+  [[nodiscard]] int Device() const {
+    return device_;
+  }
+
+ private:
+  static T *Allocate(std::size_t size, int device) {
+    if (size == 0) {
+      return nullptr;
+    }
+    auto *data = static_cast<T *>(omp_target_alloc(size * sizeof(T), device));
+    if (data == nullptr) {
+      throw std::runtime_error("Cannot allocate " + std::to_string(size * sizeof(T)) + " bytes on offload device " +
+                               std::to_string(device));
+    }
+    return data;
+  }
+
+  void CheckSize(std::size_t size) const {
+    if (size != size_) {
+      throw std::runtime_error("Host span of " + std::to_string(size) + " elements does not match device buffer of " +
+                               std::to_string(size_));
+    }
+  }
+
+  std::size_t size_;
+  int device_;
+  T *data_;
+};
+
+}  // namespace ppc::util
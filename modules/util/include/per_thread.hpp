@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace ppc::util {
+
+/// @brief Size of the cache line the padded types are aligned to.
+inline constexpr std::size_t kCacheLineSize = 64;
+
+/// @brief @p T alone on its own cache line(s), so writes to neighbouring instances never share a line.
+template <typename T>
+struct alignas(kCacheLineSize) Padded {
+  T value{};
+};
+
+/// @brief Largest number of threads that may use one PerThread at the same time.
+inline constexpr std::size_t kMaxThreadSlots = 4096;
+
+/// @brief Dense index of the calling thread, the same for OpenMP, TBB and thread pool workers.
+/// @details Indices are handed out on first use and returned when a thread exits, so they stay below the number
+///          of threads alive at once.
+/// @throws std::runtime_error If more than kMaxThreadSlots threads ask for an index.
+std::size_t ThisThreadIndex();
+
+/// @brief One cache-line padded @p T per thread, combined once the parallel work is done.
+/// @details Local() returns the calling thread's slot without locks or shared writes, replacing a shared atomic
+///          counter in hot reductions. Slots are allocated in chunks on first use by a thread of that chunk, and
+///          only slots handed out by Local() take part in ForEach() and Combine(). Combine() and ForEach() must not
+///          run concurrently with Local().
+template <typename T>
+class PerThread {
+ public:
+  explicit PerThread(T init = T{}) : init_(std::move(init)) {}
+  PerThread(const PerThread &) = delete;
+  PerThread &operator=(const PerThread &) = delete;
+  ~PerThread() {
+    for (auto &chunk : chunks_) {
+      delete[] chunk.load(std::memory_order_relaxed);
+    }
+  }
+
+  /// @brief Slot of the calling thread; it holds the initial value until a thread first writes it.
+  /// @details Slots carry over when ThisThreadIndex() hands an exited thread's index to a new thread: the new
+  ///          thread sees the value the exited one left, so that Combine() keeps both contributions. Accumulate
+  ///          into the slot rather than assign to it.
+  T &Local() {
+    const std::size_t index = ThisThreadIndex();
+    std::atomic<Padded<T> *> &chunk = chunks_[index / kChunkSize];
+    // Written once per thread; afterwards the hot path only reads it
+    std::atomic<uint64_t> &used = used_[index / kChunkSize];
+    const uint64_t bit = uint64_t{1} << (index % kChunkSize);
+    if ((used.load(std::memory_order_relaxed) & bit) == 0) {
+      used.fetch_or(bit, std::memory_order_relaxed);
+    }
+    Padded<T> *slots = chunk.load(std::memory_order_acquire);
+    if (slots == nullptr) {
+      auto fresh = std::make_unique<Padded<T>[]>(kChunkSize);
+      for (std::size_t i = 0; i < kChunkSize; i++) {
+        fresh[i].value = init_;
+      }
+      if (chunk.compare_exchange_strong(slots, fresh.get(), std::memory_order_acq_rel)) {
+        slots = fresh.release();
+      }
+    }
+    return slots[index % kChunkSize].value;
+  }
+
+  /// @brief Calls @p fn on every slot handed out by Local(), including slots of threads that have exited.
+  template <typename Fn>
+  void ForEach(Fn &&fn) const {
+    for (std::size_t c = 0; c < chunks_.size(); c++) {
+      const Padded<T> *slots = chunks_[c].load(std::memory_order_acquire);
+      const uint64_t used = used_[c].load(std::memory_order_relaxed);
+      for (std::size_t i = 0; slots != nullptr && i < kChunkSize; i++) {
+        if ((used & (uint64_t{1} << i)) != 0) {
+          fn(slots[i].value);
+        }
+      }
+    }
+  }
+
+  /// @brief Folds the slots handed out by Local() with @p op; the initial value when no thread used one.
+  /// @details Every slot starts from the initial value, which therefore is not folded in a second time.
+  template <typename Op = std::plus<>>
+  [[nodiscard]] T Combine(Op op = {}) const {
+    std::optional<T> total;
+    ForEach([&](const T &value) { total = total ? op(std::move(*total), value) : value; });
+    return total ? std::move(*total) : init_;
+  }
+
+  /// @brief Sets every allocated slot back to the initial value and forgets which threads used one.
+  void Reset() {
+    for (std::size_t c = 0; c < chunks_.size(); c++) {
+      Padded<T> *slots = chunks_[c].load(std::memory_order_acquire);
+      for (std::size_t i = 0; slots != nullptr && i < kChunkSize; i++) {
+        slots[i].value = init_;
+      }
+      used_[c].store(0, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  static constexpr std::size_t kChunkSize = 64;
+  static_assert(kChunkSize <= std::numeric_limits<uint64_t>::digits, "used_ holds one bit per slot of a chunk");
+
+  T init_;
+  std::array<std::atomic<Padded<T> *>, kMaxThreadSlots / kChunkSize> chunks_{};
+  /// Slots of each chunk handed out by Local()
+  std::array<std::atomic<uint64_t>, kMaxThreadSlots / kChunkSize> used_{};
+};
+
+}  // namespace ppc::util
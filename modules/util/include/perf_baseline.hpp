@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Real times in seconds of every repetition of each benchmark, keyed by run name.
+/// @details The run name is the Google Benchmark name without aggregate suffix, e.g.
+///          "example_threads_tbb_enabled/num_threads:4/manual_time".
+using PerfSamples = std::unordered_map<std::string, std::vector<double>>;
+
+/// @brief Baseline file named by PPC_PERF_BASELINE, if set.
+/// @details The performance runner reads it before any benchmark runs, so it may be the PPC_BENCHMARK_OUT file of
+///          the run that replaces it.
+std::optional<std::string> GetPerfBaselinePath();
+
+/// @brief Slowdown above which a run counts as a regression, from PPC_PERF_REGRESSION_THRESHOLD (default 0.1).
+double GetPerfRegressionThreshold();
+
+/// @brief Significance level of the regression test, from PPC_PERF_REGRESSION_ALPHA (default 0.05).
+double GetPerfRegressionAlpha();
+
+/// @brief Reads the per-repetition times of a JSON file written through PPC_BENCHMARK_OUT.
+/// @details Aggregate entries (mean, median, ...) and runs that reported an error are skipped.
+/// @throws std::runtime_error If the file cannot be read or is not Google Benchmark JSON.
+PerfSamples LoadPerfSamples(const std::string &path);
+
+/// @brief One-sided Mann-Whitney U test that @p current tends to be larger than @p baseline.
+/// @return p-value from the normal approximation with continuity correction; 1 without samples.
+double MannWhitneySlowerPValue(const std::vector<double> &current, const std::vector<double> &baseline);
+
+/// @brief Outcome of comparing one benchmark against its baseline.
+struct PerfComparison {
+  double baseline_median = 0.0;
+  double current_median = 0.0;
+  /// current_median / baseline_median - 1.
+  double slowdown = 0.0;
+  /// Mann-Whitney p-value, or std::nullopt when either side has fewer than kMinSamplesForTest samples.
+  std::optional<double> p_value;
+  bool regression = false;
+};
+
+/// @brief Fewest repetitions per side for which the rank test is used; below it only the medians decide.
+inline constexpr std::size_t kMinSamplesForTest = 3;
+
+/// @brief Flags a regression when the median slowed down by more than @p threshold and, with enough repetitions,
+///        the slowdown is significant at level @p alpha.
+PerfComparison ComparePerfSamples(const std::vector<double> &current, const std::vector<double> &baseline,
+                                  double threshold, double alpha);
+
+}  // namespace ppc::util
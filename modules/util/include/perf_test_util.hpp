@@ -4,23 +4,43 @@
 
 #include <benchmark/benchmark.h>
 #include <mpi.h>
-#include <omp.h>
-#include <tbb/tick_count.h>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <functional>
 #include <iostream>
+#include <libenvpp/detail/get.hpp>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
+#include "task/include/batch_task.hpp"
 #include "task/include/task.hpp"
+#include "util/include/clock.hpp"
+#include "util/include/hardware_counters.hpp"
+#include "util/include/interference.hpp"
+#include "util/include/load_balance.hpp"
+#include "util/include/memory_tracking.hpp"
+#include "util/include/mpi_profiler.hpp"
+#include "util/include/num_threads.hpp"
+#include "util/include/offload.hpp"
+#include "util/include/roofline.hpp"
+#include "util/include/schedule.hpp"
 #include "util/include/task_descriptor_util.hpp"
 #include "util/include/util.hpp"
 
@@ -33,12 +53,59 @@ inline double DefaultTimer() {
 struct PerfAttr {
   /// @brief Number of times the task is run for performance evaluation.
   uint64_t num_running = 5;
+  /// @brief Builds the task once and re-runs its pipeline after Task::Reset() on every iteration.
+  /// @details Measures steady-state Run() time without task construction and input copy costs.
+  bool reuse_task = false;
+  /// @brief Number of untimed pipeline runs executed before the measured iterations of each repetition.
+  uint64_t num_warmups = 0;
+  /// @brief Number of benchmark repetitions; more than one adds median, stddev, cv and p90 aggregates.
+  uint64_t num_repetitions = 1;
+  /// @brief Largest accepted coefficient of variation of Run() times within a repetition (0 disables the check).
+  double max_cv = 0.0;
+  /// @brief Times iterations on a clock shared by all MPI ranks and reduces them in one collective per repetition.
+  /// @details Replaces the per-iteration MPI_Allreduce; Run() time becomes the span from the earliest rank entering
+  ///          Run() to the last one leaving it.
+  bool defer_rank_reduction = false;
+  /// @brief Loop scheduling applied with ScopedSchedulePolicy while the benchmark runs; unset keeps PPC_SCHEDULE.
+  /// @details Entries of PPC_PERF_SCHEDULE_SWEEP override it for their benchmark variants.
+  std::optional<SchedulePolicy> schedule;
   /// @brief Timer function returning current time in seconds.
   /// @cond
   std::function<double()> current_timer = DefaultTimer;
   /// @endcond
 };
 
+/// @brief Geometric schedule of input sizes from @p lo to @p hi for BaseRunPerfTests::GetInputSizeSweep().
+/// @details Mirrors benchmark::Benchmark::Range(): every size is @p multiplier times the previous one, and @p hi is
+///          always included.
+/// @throws std::runtime_error If @p lo is zero, @p lo exceeds @p hi or @p multiplier is below 2.
+inline std::vector<std::size_t> InputSizeRange(std::size_t lo, std::size_t hi, std::size_t multiplier = 2) {
+  if (lo == 0 || lo > hi || multiplier < 2) {
+    throw std::runtime_error("Invalid input size range");
+  }
+  std::vector<std::size_t> sizes;
+  for (std::size_t size = lo; size < hi; size *= multiplier) {
+    sizes.push_back(size);
+    if (size > hi / multiplier) {
+      break;
+    }
+  }
+  sizes.push_back(hi);
+  return sizes;
+}
+
+/// @brief Work estimate of a task for a given input; empty for tasks without EstimateWork().
+template <typename InType>
+using WorkEstimator = std::function<WorkModel(const InType &)>;
+
+/// @brief Wall time in seconds spent in each pipeline stage of a single task run.
+struct StageTimes {
+  double validation = 0.0;
+  double pre_processing = 0.0;
+  double run = 0.0;
+  double post_processing = 0.0;
+};
+
 namespace detail {
 
 inline bool ContainsDescriptorToken(std::string_view filter, std::string_view descriptor_token) {
@@ -63,26 +130,34 @@ void RunTaskForValidation(const ppc::task::TaskPtr<InType, OutType> &task) {
   task->PostProcessing();
 }
 
-inline std::function<double()> MakeTechnologyTimer(ppc::task::TypeOfTask task_type) {
-  if (task_type == ppc::task::TypeOfTask::kMPI || task_type == ppc::task::TypeOfTask::kALL) {
-    return [] -> double { return GetTimeMPI(); };
-  }
-  if (task_type == ppc::task::TypeOfTask::kOMP) {
-    return [] -> double { return omp_get_wtime(); };
-  }
-  if (task_type == ppc::task::TypeOfTask::kTBB) {
-    const auto t0 = tbb::tick_count::now();
-    return [t0] -> double { return (tbb::tick_count::now() - t0).seconds(); };
+/// @brief Benchmark clock: ClockNow(), the same calibrated source for every backend, plus a fixed offset.
+/// @details kOffload timers first wait for deferred target regions. Called directly by the harness, so reads are
+///          inlined rather than going through a std::function.
+struct BenchmarkTimer {
+  double offset = 0.0;
+  bool synchronize_offload = false;
+
+  double operator()() const {
+    if (synchronize_offload) {
+      OffloadSynchronize();
+    }
+    return ClockNow() + offset;
   }
-  if (task_type == ppc::task::TypeOfTask::kSEQ || task_type == ppc::task::TypeOfTask::kSTL) {
-    const auto t0 = std::chrono::high_resolution_clock::now();
-    return [t0] -> double {
-      const auto now = std::chrono::high_resolution_clock::now();
-      const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - t0).count();
-      return static_cast<double>(ns) * 1e-9;
-    };
+};
+
+inline BenchmarkTimer MakeBenchmarkTimer(ppc::task::TypeOfTask task_type, double offset = 0.0) {
+  if (task_type == ppc::task::TypeOfTask::kUnknown) {
+    throw std::runtime_error("The task type is not supported for performance testing.");
   }
-  throw std::runtime_error("The task type is not supported for performance testing.");
+  BenchmarkTimer timer;
+  timer.offset = offset;
+  timer.synchronize_offload = task_type == ppc::task::TypeOfTask::kOffload;
+  return timer;
+}
+
+/// @brief Type-erased MakeBenchmarkTimer() for PerfAttr::current_timer.
+inline std::function<double()> MakeTechnologyTimer(ppc::task::TypeOfTask task_type) {
+  return MakeBenchmarkTimer(task_type);
 }
 
 inline double MaxElapsedTimeAcrossMpiRanks(double elapsed, ppc::task::TypeOfTask task_type) {
@@ -110,35 +185,625 @@ inline void CheckPerfTimeLimit(double elapsed) {
   }
 }
 
+inline StageTimes MaxStageTimesAcrossMpiRanks(const StageTimes &times, ppc::task::TypeOfTask task_type) {
+  if (task_type != ppc::task::TypeOfTask::kMPI && task_type != ppc::task::TypeOfTask::kALL) {
+    return times;
+  }
+  const std::array<double, 4> local = {times.validation, times.pre_processing, times.run, times.post_processing};
+  std::array<double, 4> global = local;
+  MPI_Allreduce(local.data(), global.data(), static_cast<int>(local.size()), MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  return {.validation = global[0], .pre_processing = global[1], .run = global[2], .post_processing = global[3]};
+}
+
+inline void AccumulateStageTimes(StageTimes &total, const StageTimes &times) {
+  total.validation += times.validation;
+  total.pre_processing += times.pre_processing;
+  total.run += times.run;
+  total.post_processing += times.post_processing;
+}
+
+/// @brief Exports per-stage times as counters averaged over benchmark iterations.
+inline void ReportStageCounters(benchmark::State &state, const StageTimes &total) {
+  constexpr auto kAvg = benchmark::Counter::kAvgIterations;
+  state.counters["validation_time"] = benchmark::Counter(total.validation, kAvg);
+  state.counters["preprocessing_time"] = benchmark::Counter(total.pre_processing, kAvg);
+  state.counters["run_time"] = benchmark::Counter(total.run, kAvg);
+  state.counters["postprocessing_time"] = benchmark::Counter(total.post_processing, kAvg);
+}
+
+/// @brief Sums hardware event counts over MPI ranks for process backends.
+/// @details The last element carries the number of ranks whose counters were available.
+inline std::array<uint64_t, kNumHardwareEvents + 1> SumHardwareCountsAcrossMpiRanks(
+    const HardwareCounters &counters, ppc::task::TypeOfTask task_type) {
+  std::array<uint64_t, kNumHardwareEvents + 1> local{};
+  std::ranges::copy(counters.Totals(), local.begin());
+  local.back() = counters.IsAvailable() ? 1 : 0;
+  if (task_type != ppc::task::TypeOfTask::kMPI && task_type != ppc::task::TypeOfTask::kALL) {
+    return local;
+  }
+  std::array<uint64_t, kNumHardwareEvents + 1> global{};
+  MPI_Allreduce(local.data(), global.data(), static_cast<int>(local.size()), MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+  return global;
+}
+
+/// @brief Exports hardware event counts of Run() as counters averaged over benchmark iterations.
+/// @details Adds instructions per cycle and an LLC-miss based estimate of memory bandwidth in bytes per second.
+inline void ReportHardwareCounters(benchmark::State &state, const HardwareCounters &counters,
+                                   ppc::task::TypeOfTask task_type, double total_run_time) {
+  constexpr double kCacheLineBytes = 64.0;
+  const auto sums = SumHardwareCountsAcrossMpiRanks(counters, task_type);
+  if (sums.back() == 0) {
+    return;
+  }
+  constexpr auto kAvg = benchmark::Counter::kAvgIterations;
+  for (std::size_t i = 0; i < kNumHardwareEvents; i++) {
+    const std::string name(HardwareEventName(static_cast<HardwareEvent>(i)));
+    state.counters[name] = benchmark::Counter(static_cast<double>(sums[i]), kAvg);
+  }
+  const auto cycles = static_cast<double>(sums[static_cast<std::size_t>(HardwareEvent::kCycles)]);
+  const auto instructions = static_cast<double>(sums[static_cast<std::size_t>(HardwareEvent::kInstructions)]);
+  const auto cache_misses = static_cast<double>(sums[static_cast<std::size_t>(HardwareEvent::kCacheMisses)]);
+  if (cycles > 0.0) {
+    state.counters["ipc"] = instructions / cycles;
+  }
+  if (total_run_time > 0.0) {
+    state.counters["llc_miss_bandwidth"] = cache_misses * kCacheLineBytes / total_run_time;
+  }
+}
+
+/// @brief Exports the memory footprint of Run() as benchmark counters.
+/// @details Allocation counts are summed over MPI ranks and averaged over iterations. RSS growth is reported both as
+///          the largest value of a single rank and as the sum over ranks, which exposes buffers replicated per rank.
+inline void ReportMemoryCounters(benchmark::State &state, const MemoryTracker &tracker,
+                                 ppc::task::TypeOfTask task_type) {
+  std::array<uint64_t, 3> sums = {tracker.Allocations().count, tracker.Allocations().bytes,
+                                  tracker.PeakRssDeltaBytes()};
+  uint64_t max_rss_delta = tracker.PeakRssDeltaBytes();
+  if (task_type == ppc::task::TypeOfTask::kMPI || task_type == ppc::task::TypeOfTask::kALL) {
+    const std::array<uint64_t, 3> local = sums;
+    MPI_Allreduce(local.data(), sums.data(), static_cast<int>(sums.size()), MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+    const uint64_t local_rss_delta = max_rss_delta;
+    MPI_Allreduce(&local_rss_delta, &max_rss_delta, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD);
+  }
+  if (AllocationCounterEnabled()) {
+    constexpr auto kAvg = benchmark::Counter::kAvgIterations;
+    state.counters["run_allocations"] = benchmark::Counter(static_cast<double>(sums[0]), kAvg);
+    state.counters["run_allocated_bytes"] = benchmark::Counter(static_cast<double>(sums[1]), kAvg);
+  }
+  state.counters["run_rss_delta_bytes"] = static_cast<double>(max_rss_delta);
+  state.counters["run_rss_delta_bytes_all_ranks"] = static_cast<double>(sums[2]);
+}
+
+/// @brief Exports the min, mean and max Run() time per rank and per busy thread, plus their max / mean factors.
+/// @details Rank metrics need an MPI backend and gather every rank's total in one collective. Thread metrics cover the
+///          threads that recorded ScopedBusyTime on the reporting rank. All times are averaged over runs.
+inline void ReportLoadBalance(benchmark::State &state, const LoadBalanceTracker &tracker,
+                              ppc::task::TypeOfTask task_type) {
+  if (tracker.Runs() == 0) {
+    return;
+  }
+  const auto runs = static_cast<double>(tracker.Runs());
+  auto report = [&state, runs](const std::string &prefix, std::span<const double> times) {
+    const LoadImbalance imbalance = ComputeLoadImbalance(times);
+    state.counters[prefix + "_min"] = imbalance.min / runs;
+    state.counters[prefix + "_mean"] = imbalance.mean / runs;
+    state.counters[prefix + "_max"] = imbalance.max / runs;
+  };
+  if (task_type == ppc::task::TypeOfTask::kMPI || task_type == ppc::task::TypeOfTask::kALL) {
+    int size = 1;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    std::vector<double> rank_times(static_cast<std::size_t>(size));
+    const double local = tracker.RunTime();
+    MPI_Allgather(&local, 1, MPI_DOUBLE, rank_times.data(), 1, MPI_DOUBLE, MPI_COMM_WORLD);
+    report("rank_run_time", rank_times);
+    state.counters["rank_imbalance"] = ComputeLoadImbalance(rank_times).factor;
+  }
+  const std::vector<double> thread_times = tracker.ThreadBusyTimes();
+  if (thread_times.size() > 1) {
+    report("thread_busy_time", thread_times);
+    state.counters["thread_imbalance"] = ComputeLoadImbalance(thread_times).factor;
+  }
+}
+
+/// @brief Exports the time, calls and bytes of intercepted MPI functions as benchmark counters.
+/// @details Times are the maximum over ranks, calls and bytes are summed over ranks; all are averaged over iterations.
+///          Run() additionally gets a per-function breakdown and the fraction of its time spent in MPI.
+inline void ReportMpiProfile(benchmark::State &state, ppc::task::TypeOfTask task_type, double total_run_time) {
+  if (!MpiProfilerEnabled() || (task_type != ppc::task::TypeOfTask::kMPI && task_type != ppc::task::TypeOfTask::kALL)) {
+    return;
+  }
+  constexpr std::size_t kEntries = kNumProfiledStages * kNumMpiCalls;
+  std::array<double, kEntries> times{};
+  std::array<uint64_t, 2 * kEntries> volumes{};
+  for (std::size_t stage = 0; stage < kNumProfiledStages; stage++) {
+    for (std::size_t call = 0; call < kNumMpiCalls; call++) {
+      const auto stats = GetMpiCallStats(static_cast<ProfiledStage>(stage), static_cast<MpiCall>(call));
+      const std::size_t index = (stage * kNumMpiCalls) + call;
+      times[index] = stats.time;
+      volumes[2 * index] = stats.calls;
+      volumes[(2 * index) + 1] = stats.bytes;
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, times.data(), static_cast<int>(times.size()), MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, volumes.data(), static_cast<int>(volumes.size()), MPI_UINT64_T, MPI_SUM,
+                MPI_COMM_WORLD);
+
+  constexpr auto kAvg = benchmark::Counter::kAvgIterations;
+  constexpr std::array<std::string_view, kNumProfiledStages> kStageNames = {"validation", "preprocessing", "run",
+                                                                             "postprocessing"};
+  for (std::size_t stage = 0; stage < kNumProfiledStages; stage++) {
+    double stage_time = 0.0;
+    uint64_t stage_calls = 0;
+    uint64_t stage_bytes = 0;
+    for (std::size_t call = 0; call < kNumMpiCalls; call++) {
+      const std::size_t index = (stage * kNumMpiCalls) + call;
+      stage_time += times[index];
+      stage_calls += volumes[2 * index];
+      stage_bytes += volumes[(2 * index) + 1];
+      if (static_cast<ProfiledStage>(stage) == ProfiledStage::kRun && volumes[2 * index] > 0) {
+        const std::string prefix = "mpi_run_" + std::string(MpiCallName(static_cast<MpiCall>(call)));
+        state.counters[prefix + "_time"] = benchmark::Counter(times[index], kAvg);
+        state.counters[prefix + "_bytes"] = benchmark::Counter(static_cast<double>(volumes[(2 * index) + 1]), kAvg);
+      }
+    }
+    if (stage_calls == 0) {
+      continue;
+    }
+    const std::string prefix = "mpi_" + std::string(kStageNames.at(stage));
+    state.counters[prefix + "_time"] = benchmark::Counter(stage_time, kAvg);
+    state.counters[prefix + "_calls"] = benchmark::Counter(static_cast<double>(stage_calls), kAvg);
+    state.counters[prefix + "_bytes"] = benchmark::Counter(static_cast<double>(stage_bytes), kAvg);
+    if (static_cast<ProfiledStage>(stage) == ProfiledStage::kRun && total_run_time > 0.0) {
+      state.counters["mpi_run_fraction"] = stage_time / total_run_time;
+    }
+  }
+}
+
+/// @brief Exports the host-device transfers of kOffload tasks as counters averaged over benchmark iterations.
+/// @details Transfers of the whole pipeline are reported per direction. Run() time is split into transfer and kernel
+///          time, the latter being everything Run() spent outside OffloadCopy().
+inline void ReportOffloadCounters(benchmark::State &state, const OffloadTransferTracker &tracker,
+                                  ppc::task::TypeOfTask task_type, double total_run_time) {
+  if (task_type != ppc::task::TypeOfTask::kOffload) {
+    return;
+  }
+  constexpr auto kAvg = benchmark::Counter::kAvgIterations;
+  constexpr std::array<std::string_view, kNumOffloadDirections> kPrefixes = {"offload_h2d", "offload_d2h"};
+  for (std::size_t i = 0; i < kNumOffloadDirections; i++) {
+    const auto stats = GetOffloadTransferStats(static_cast<OffloadDirection>(i));
+    const std::string prefix(kPrefixes.at(i));
+    state.counters[prefix + "_time"] = benchmark::Counter(stats.time, kAvg);
+    state.counters[prefix + "_bytes"] = benchmark::Counter(static_cast<double>(stats.bytes), kAvg);
+  }
+  state.counters["offload_run_transfer_time"] = benchmark::Counter(tracker.Time(), kAvg);
+  state.counters["offload_run_kernel_time"] = benchmark::Counter(std::max(total_run_time - tracker.Time(), 0.0), kAvg);
+  state.counters["offload_device"] = OffloadDeviceAvailable() ? 1.0 : 0.0;
+}
+
+/// @brief Optional measurements taken around every Run() call; null members are skipped.
+struct RunProbes {
+  HardwareCounters *hardware_counters = nullptr;
+  MemoryTracker *memory_tracker = nullptr;
+  LoadBalanceTracker *load_balance = nullptr;
+  OffloadTransferTracker *offload_transfers = nullptr;
+};
+
+/// @brief Local stage times of one pipeline run plus the timestamps bracketing its Run() stage.
+struct StageSample {
+  StageTimes times;
+  double run_begin = 0.0;
+  double run_end = 0.0;
+};
+
+/// @brief Exports the FLOP and byte rates of Run() declared through EstimateWork(), plus the arithmetic intensity.
+/// @details When ProbeMachinePeaks() ran in this process the rates are also related to the peaks as
+///          roofline_fraction.
+inline void ReportWorkCounters(benchmark::State &state, const WorkModel &work, double total_run_time) {
+  if (total_run_time <= 0.0) {
+    return;
+  }
+  const auto runs = static_cast<double>(state.iterations());
+  const double flops_per_second = work.flops * runs / total_run_time;
+  const double bytes_per_second = work.bytes * runs / total_run_time;
+  state.counters["run_flops_per_second"] = flops_per_second;
+  state.counters["run_bytes_per_second"] = bytes_per_second;
+  if (work.bytes > 0.0) {
+    state.counters["arithmetic_intensity"] = work.flops / work.bytes;
+  }
+  if (const auto peaks = GetProbedMachinePeaks()) {
+    state.counters["roofline_fraction"] = RooflineFraction(flops_per_second, bytes_per_second, *peaks);
+  }
+}
+
+/// @brief Runs the full pipeline of @p task on @p timer without reducing anything across ranks.
+/// @details @p synchronize is called right before Run() so that all ranks enter it together.
 template <typename InType, typename OutType>
-double RunTaskForBenchmark(const ppc::task::TaskPtr<InType, OutType> &task) {
-  const auto task_type = task->GetDynamicTypeOfTask();
-  const auto timer = MakeTechnologyTimer(task_type);
+StageSample SampleTaskStages(const ppc::task::TaskPtr<InType, OutType> &task, const BenchmarkTimer &timer,
+                             void (*synchronize)(), const RunProbes &probes) {
   task->GetStateOfTesting() = ppc::task::StateOfTesting::kPerf;
 
-  task->Validation();
-  task->PreProcessing();
+  StageSample sample;
+  double begin = timer();
+  {
+    const ScopedMpiProfileStage profile_stage(ProfiledStage::kValidation);
+    task->Validation();
+  }
+  sample.times.validation = timer() - begin;
+
+  begin = timer();
+  {
+    const ScopedMpiProfileStage profile_stage(ProfiledStage::kPreProcessing);
+    task->PreProcessing();
+  }
+  sample.times.pre_processing = timer() - begin;
+
+  synchronize();
+  if (probes.load_balance != nullptr) {
+    probes.load_balance->Start();
+  }
+  if (probes.memory_tracker != nullptr) {
+    probes.memory_tracker->Start();
+  }
+  if (probes.hardware_counters != nullptr) {
+    probes.hardware_counters->Start();
+  }
+  if (probes.offload_transfers != nullptr) {
+    probes.offload_transfers->Start();
+  }
+  sample.run_begin = timer();
+  {
+    const ScopedMpiProfileStage profile_stage(ProfiledStage::kRun);
+    task->Run();
+  }
+  sample.run_end = timer();
+  sample.times.run = sample.run_end - sample.run_begin;
+  if (probes.offload_transfers != nullptr) {
+    probes.offload_transfers->Stop();
+  }
+  if (probes.hardware_counters != nullptr) {
+    probes.hardware_counters->Stop();
+  }
+  if (probes.memory_tracker != nullptr) {
+    probes.memory_tracker->Stop();
+  }
+  if (probes.load_balance != nullptr) {
+    probes.load_balance->Stop(sample.times.run);
+  }
+
+  begin = timer();
+  {
+    const ScopedMpiProfileStage profile_stage(ProfiledStage::kPostProcessing);
+    task->PostProcessing();
+  }
+  sample.times.post_processing = timer() - begin;
+  return sample;
+}
+
+/// @brief Runs the full pipeline of @p task, timing every stage.
+/// @details The @p probes sample Run() only.
+template <typename InType, typename OutType>
+StageTimes RunTaskForBenchmark(const ppc::task::TaskPtr<InType, OutType> &task, const RunProbes &probes = {}) {
+  const auto task_type = task->GetDynamicTypeOfTask();
   SynchronizeMpiRanks();
-  const double begin = timer();
-  task->Run();
-  const double elapsed = timer() - begin;
-  task->PostProcessing();
-  const double max_elapsed = MaxElapsedTimeAcrossMpiRanks(elapsed, task_type);
-  CheckPerfTimeLimit(max_elapsed);
-  return max_elapsed;
+  const StageSample sample = SampleTaskStages(task, MakeBenchmarkTimer(task_type), SynchronizeMpiRanks, probes);
+
+  const StageTimes max_times = MaxStageTimesAcrossMpiRanks(sample.times, task_type);
+  CheckPerfTimeLimit(max_times.run);
+  return max_times;
+}
+
+/// @brief Offset in seconds that maps this rank's ClockNow() onto the clock of rank 0.
+/// @details Zero when MPI is not running. Every rank calibrates its own clock origin, so otherwise every rank
+///          ping-pongs with rank 0 a few times and keeps the estimate of the round trip with the smallest latency.
+///          Collective.
+inline double MeasureMpiClockOffset() {
+  int initialized = 0;
+  int finalized = 0;
+  MPI_Initialized(&initialized);
+  MPI_Finalized(&finalized);
+  if (initialized == 0 || finalized != 0) {
+    return 0.0;
+  }
+
+  constexpr int kRoundTrips = 8;
+  int rank = 0;
+  int size = 1;
+  MPI_Comm comm = MPI_COMM_NULL;
+  MPI_Comm_dup(MPI_COMM_WORLD, &comm);
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  double offset = 0.0;
+  double best_round_trip = std::numeric_limits<double>::infinity();
+  for (int peer = 1; peer < size; peer++) {
+    for (int trip = 0; trip < kRoundTrips; trip++) {
+      if (rank == 0) {
+        double request = 0.0;
+        MPI_Recv(&request, 1, MPI_DOUBLE, peer, 0, comm, MPI_STATUS_IGNORE);
+        const double reference = ClockNow();
+        MPI_Send(&reference, 1, MPI_DOUBLE, peer, 0, comm);
+      } else if (rank == peer) {
+        const double sent = ClockNow();
+        double reference = 0.0;
+        MPI_Send(&sent, 1, MPI_DOUBLE, 0, 0, comm);
+        MPI_Recv(&reference, 1, MPI_DOUBLE, 0, 0, comm, MPI_STATUS_IGNORE);
+        const double received = ClockNow();
+        if (received - sent < best_round_trip) {
+          best_round_trip = received - sent;
+          offset = reference - (0.5 * (sent + received));
+        }
+      }
+    }
+  }
+  MPI_Comm_free(&comm);
+  return offset;
+}
+
+/// @brief Timer whose readings are comparable across ranks: the benchmark clock shifted by @p mpi_clock_offset for
+///        process backends, unshifted otherwise.
+inline BenchmarkTimer MakeGlobalTimer(ppc::task::TypeOfTask task_type, double mpi_clock_offset) {
+  const bool is_process_backend =
+      task_type == ppc::task::TypeOfTask::kMPI || task_type == ppc::task::TypeOfTask::kALL;
+  return MakeBenchmarkTimer(task_type, is_process_backend ? mpi_clock_offset : 0.0);
+}
+
+/// @brief Barrier used before Run() when ranks are timed on a global clock.
+/// @details Benchmarks only run between MPI_Init and MPI_Finalize, so the state checks of SynchronizeMpiRanks() are
+///          skipped.
+inline void BarrierMpiRanks() {
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+inline void SkipRankSynchronization() {}
+
+/// @brief Pipeline run for PerfAttr::defer_rank_reduction; returns local samples taken on @p global_timer.
+template <typename InType, typename OutType>
+StageSample RunTaskForDeferredBenchmark(const ppc::task::TaskPtr<InType, OutType> &task,
+                                        const BenchmarkTimer &global_timer,
+                                        const RunProbes &probes = {}) {
+  const auto task_type = task->GetDynamicTypeOfTask();
+  const bool is_process_backend =
+      task_type == ppc::task::TypeOfTask::kMPI || task_type == ppc::task::TypeOfTask::kALL;
+  void (*synchronize)() = is_process_backend ? BarrierMpiRanks : SkipRankSynchronization;
+  return SampleTaskStages(task, global_timer, synchronize, probes);
+}
+
+/// @brief Per-iteration stage times over all ranks, reduced from @p samples with a single collective.
+/// @details Validation, pre- and post-processing take the slowest rank; Run() spans from the earliest begin to the
+///          latest end, so the samples must come from a global timer.
+inline std::vector<StageTimes> ReduceStageSamples(const std::vector<StageSample> &samples,
+                                                  ppc::task::TypeOfTask task_type) {
+  constexpr std::size_t kFields = 5;
+  std::vector<double> values(samples.size() * kFields);
+  for (std::size_t i = 0; i < samples.size(); i++) {
+    const StageSample &sample = samples[i];
+    double *row = values.data() + (i * kFields);
+    row[0] = sample.times.validation;
+    row[1] = sample.times.pre_processing;
+    row[2] = sample.times.post_processing;
+    row[3] = sample.run_end;
+    row[4] = -sample.run_begin;
+  }
+  if ((task_type == ppc::task::TypeOfTask::kMPI || task_type == ppc::task::TypeOfTask::kALL) && !values.empty()) {
+    MPI_Allreduce(MPI_IN_PLACE, values.data(), static_cast<int>(values.size()), MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  }
+  std::vector<StageTimes> times(samples.size());
+  for (std::size_t i = 0; i < samples.size(); i++) {
+    const double *row = values.data() + (i * kFields);
+    times[i] = {.validation = row[0], .pre_processing = row[1], .run = row[3] + row[4], .post_processing = row[2]};
+  }
+  return times;
+}
+
+/// @brief Sample coefficient of variation (stddev / mean) of the given values.
+/// @return 0 when fewer than two values are given or their mean is not positive.
+inline double CoefficientOfVariation(const std::vector<double> &values) {
+  if (values.size() < 2) {
+    return 0.0;
+  }
+  double mean = 0.0;
+  for (const double value : values) {
+    mean += value;
+  }
+  mean /= static_cast<double>(values.size());
+  if (mean <= 0.0) {
+    return 0.0;
+  }
+  double sum_sq = 0.0;
+  for (const double value : values) {
+    sum_sq += (value - mean) * (value - mean);
+  }
+  return std::sqrt(sum_sq / static_cast<double>(values.size() - 1)) / mean;
+}
+
+/// @brief Nearest-rank 90th percentile, used as a Google Benchmark repetition aggregate.
+inline double Percentile90(const std::vector<double> &values) {
+  if (values.empty()) {
+    return 0.0;
+  }
+  std::vector<double> sorted = values;
+  std::ranges::sort(sorted);
+  const auto rank = static_cast<std::size_t>(std::ceil(0.9 * static_cast<double>(sorted.size())));
+  return sorted[std::max<std::size_t>(rank, 1) - 1];
+}
+
+inline void CheckRunTimeVariation(benchmark::State &state, const std::vector<double> &run_times, double max_cv) {
+  if (run_times.size() < 2) {
+    return;
+  }
+  const double cv = CoefficientOfVariation(run_times);
+  state.counters["run_time_cv"] = cv;
+  if (max_cv > 0.0 && cv > max_cv) {
+    PerformanceFailureFlag::Set();
+    std::cerr << "[  NOISY  ] Run() time coefficient of variation " << cv << " exceeds max_cv " << max_cv << '\n';
+  }
+}
+
+/// @brief Interference probes taken around the measured iterations of one benchmark.
+struct InterferenceProbes {
+  InterferenceProbe before;
+  InterferenceProbe after;
+  int pauses = 0;
+};
+
+/// @brief First pause of InterferenceMode::kPause; every further pause doubles it.
+inline constexpr std::chrono::milliseconds kInterferencePause{250};
+
+/// @brief Probes every rank before the measured iterations; under kPause waits while the probe shows interference.
+/// @details The slowdown is reduced over all ranks, so every rank pauses the same number of times. Collective.
+inline InterferenceProbes ProbeBeforeBenchmark(InterferenceMode mode) {
+  InterferenceProbes probes;
+  probes.before = ProbeInterference();
+  if (mode != InterferenceMode::kPause) {
+    return probes;
+  }
+  const double threshold = GetInterferenceThreshold();
+  const int retries = GetInterferenceRetries();
+  auto pause = kInterferencePause;
+  while (probes.before.slowdown > threshold && probes.pauses < retries) {
+    std::this_thread::sleep_for(pause);
+    pause *= 2;
+    probes.pauses++;
+    probes.before = ProbeInterference();
+  }
+  return probes;
+}
+
+/// @brief Probes every rank after the measured iterations and reports both probes of this rank as counters.
+/// @details Warns when either probe shows interference on any rank. Collective.
+inline void ReportInterference(benchmark::State &state, InterferenceProbes &probes) {
+  probes.after = ProbeInterference();
+  state.counters["interference_bandwidth_before"] = probes.before.sample.bytes_per_second;
+  state.counters["interference_bandwidth_after"] = probes.after.sample.bytes_per_second;
+  state.counters["interference_core_rate_before"] = probes.before.sample.core_steps_per_second;
+  state.counters["interference_core_rate_after"] = probes.after.sample.core_steps_per_second;
+  const double slowdown = std::max(probes.before.slowdown, probes.after.slowdown);
+  state.counters["interference_slowdown"] = slowdown;
+  state.counters["interference_pauses"] = static_cast<double>(probes.pauses);
+  const double threshold = GetInterferenceThreshold();
+  if (slowdown > threshold && GetMPIRank() == 0) {
+    std::cerr << "[ INTERFERENCE ] Probe slowdown " << slowdown << " exceeds threshold " << threshold << '\n';
+  }
 }
 
 template <typename TaskGetter, typename InType>
 void RunBenchmarkBody(const TaskGetter &task_getter, const InType &input_data, const std::string &test_env_token,
+                      const PerfAttr &perf_attr, int num_threads, const WorkEstimator<InType> &estimate_work,
                       benchmark::State &state) noexcept {
   try {
     const auto benchmark_env_scope = ppc::util::test::ScopedPerTestEnv(test_env_token);
-    for (auto _ : state) {
-      auto task = task_getter(input_data);
-      const double elapsed = RunTaskForBenchmark(task);
-      state.SetIterationTime(elapsed);
+    std::optional<ScopedNumThreads> num_threads_scope;
+    if (num_threads > 0) {
+      num_threads_scope.emplace(num_threads);
+    }
+    std::optional<ScopedSchedulePolicy> schedule_scope;
+    if (perf_attr.schedule) {
+      schedule_scope.emplace(*perf_attr.schedule);
+    }
+    std::optional<HardwareCounters> hardware_counters;
+    if (HardwareCountersEnabled()) {
+      hardware_counters.emplace();
+    }
+    std::optional<MemoryTracker> memory_tracker;
+    if (MemoryTrackingEnabled()) {
+      memory_tracker.emplace();
+    }
+    LoadBalanceTracker load_balance;
+    OffloadTransferTracker offload_transfers;
+    const RunProbes measured_probes{.hardware_counters = hardware_counters ? &*hardware_counters : nullptr,
+                                    .memory_tracker = memory_tracker ? &*memory_tracker : nullptr,
+                                    .load_balance = &load_balance,
+                                    .offload_transfers = &offload_transfers};
+    using TaskPointer = decltype(task_getter(input_data));
+    TaskPointer reused_task = perf_attr.reuse_task ? task_getter(input_data) : TaskPointer{};
+    auto task_type = ppc::task::TypeOfTask::kUnknown;
+    std::size_t scratch_peak_bytes = 0;
+    const double mpi_clock_offset = perf_attr.defer_rank_reduction ? MeasureMpiClockOffset() : 0.0;
+    std::vector<StageSample> deferred_samples;
+    auto run_pipeline = [&](const auto &task, const RunProbes &probes) -> StageTimes {
+      task_type = task->GetDynamicTypeOfTask();
+      if (!perf_attr.defer_rank_reduction) {
+        return RunTaskForBenchmark(task, probes);
+      }
+      const auto timer = MakeGlobalTimer(task_type, mpi_clock_offset);
+      deferred_samples.push_back(RunTaskForDeferredBenchmark(task, timer, probes));
+      return deferred_samples.back().times;
+    };
+    auto run_once = [&](const RunProbes &probes) -> StageTimes {
+      if (reused_task) {
+        reused_task->Reset();
+        const StageTimes times = run_pipeline(reused_task, probes);
+        benchmark::DoNotOptimize(reused_task->GetOutput());
+        scratch_peak_bytes = std::max(scratch_peak_bytes, reused_task->GetScratchArena().PeakBytes());
+        return times;
+      }
+      const auto task = task_getter(input_data);
+      const StageTimes times = run_pipeline(task, probes);
       benchmark::DoNotOptimize(task->GetOutput());
+      scratch_peak_bytes = std::max(scratch_peak_bytes, task->GetScratchArena().PeakBytes());
+      return times;
+    };
+
+    for (uint64_t warmup = 0; warmup < perf_attr.num_warmups; warmup++) {
+      run_once(RunProbes{});
+    }
+    ResetMpiProfile();
+    ResetOffloadTransfers();
+    deferred_samples.clear();
+
+    const InterferenceMode interference_mode = GetInterferenceMode();
+    std::optional<InterferenceProbes> interference;
+    if (interference_mode != InterferenceMode::kOff) {
+      interference = ProbeBeforeBenchmark(interference_mode);
+    }
+    StageTimes total_times;
+    std::vector<double> run_times;
+    if (perf_attr.defer_rank_reduction) {
+      // Every iteration runs before the benchmark loop so that all of them are reduced in one collective; the loop
+      // then only replays the reduced times.
+      const auto iterations = static_cast<std::size_t>(state.max_iterations);
+      deferred_samples.reserve(iterations);
+      for (std::size_t iteration = 0; iteration < iterations; iteration++) {
+        run_once(measured_probes);
+      }
+      const std::vector<StageTimes> reduced_times = ReduceStageSamples(deferred_samples, task_type);
+      for (const StageTimes &times : reduced_times) {
+        CheckPerfTimeLimit(times.run);
+      }
+      std::size_t iteration = 0;
+      for (auto _ : state) {
+        const StageTimes &times = reduced_times[iteration++];
+        state.SetIterationTime(times.run);
+        AccumulateStageTimes(total_times, times);
+        run_times.push_back(times.run);
+      }
+    } else {
+      for (auto _ : state) {
+        const StageTimes times = run_once(measured_probes);
+        state.SetIterationTime(times.run);
+        AccumulateStageTimes(total_times, times);
+        run_times.push_back(times.run);
+      }
+    }
+    if (interference) {
+      ReportInterference(state, *interference);
+    }
+    ReportStageCounters(state, total_times);
+    if (scratch_peak_bytes > 0) {
+      state.counters["scratch_peak_bytes"] = static_cast<double>(scratch_peak_bytes);
     }
+    if (hardware_counters) {
+      ReportHardwareCounters(state, *hardware_counters, task_type, total_times.run);
+    }
+    if (memory_tracker) {
+      ReportMemoryCounters(state, *memory_tracker, task_type);
+    }
+    ReportLoadBalance(state, load_balance, task_type);
+    ReportMpiProfile(state, task_type, total_times.run);
+    ReportOffloadCounters(state, offload_transfers, task_type, total_times.run);
+    if (estimate_work) {
+      ReportWorkCounters(state, estimate_work(input_data), total_times.run);
+    }
+    CheckRunTimeVariation(state, run_times, perf_attr.max_cv);
   } catch (const std::exception &e) {
     PerformanceFailureFlag::Set();
     SkipBenchmarkWithError(state, e.what());
@@ -148,29 +813,181 @@ void RunBenchmarkBody(const TaskGetter &task_getter, const InType &input_data, c
   }
 }
 
+/// @brief Benchmark callable that shares one read-only input instance instead of owning a copy.
+/// @details A positive @p num_threads overrides the thread count for the duration of the benchmark.
 template <typename TaskGetter, typename InType>
 class BenchmarkTaskBody final {
  public:
-  BenchmarkTaskBody(TaskGetter task_getter, InType input_data, std::string test_env_token)
+  BenchmarkTaskBody(TaskGetter task_getter, std::shared_ptr<const InType> input_data, std::string test_env_token,
+                    PerfAttr perf_attr, int num_threads = 0, WorkEstimator<InType> estimate_work = {})
       : task_getter_(std::move(task_getter)),
         input_data_(std::move(input_data)),
-        test_env_token_(std::move(test_env_token)) {}
+        test_env_token_(std::move(test_env_token)),
+        perf_attr_(std::move(perf_attr)),
+        num_threads_(num_threads),
+        estimate_work_(std::move(estimate_work)) {}
+
+  void operator()(benchmark::State &state) const noexcept {
+    RunBenchmarkBody(task_getter_, *input_data_, test_env_token_, perf_attr_, num_threads_, estimate_work_, state);
+  }
+
+ private:
+  TaskGetter task_getter_;
+  std::shared_ptr<const InType> input_data_;
+  std::string test_env_token_;
+  PerfAttr perf_attr_;
+  int num_threads_;
+  WorkEstimator<InType> estimate_work_;
+};
+
+/// @brief One registered benchmark of a task: its name, thread count override and attributes.
+struct PerfVariant {
+  std::string name;
+  int num_threads = 0;
+  PerfAttr perf_attr;
+};
+
+/// @brief Applies the iteration, repetition and timing settings shared by all per-task benchmarks.
+inline void ConfigurePerfBenchmark(benchmark::internal::Benchmark *registered, const PerfAttr &perf_attr) {
+  const auto num_iterations = perf_attr.num_running == 0 ? 1 : perf_attr.num_running;
+  const auto num_repetitions = perf_attr.num_repetitions == 0 ? 1 : perf_attr.num_repetitions;
+  registered->UseManualTime()->Unit(benchmark::kSecond)->Iterations(static_cast<std::int64_t>(num_iterations));
+  if (num_repetitions > 1) {
+    registered->Repetitions(static_cast<int>(num_repetitions))->ComputeStatistics("p90", Percentile90);
+  }
+}
+
+/// @brief Inputs of the size sweep keyed by their size.
+template <typename InType>
+using SizeSweepInputs = std::map<int64_t, InType>;
+
+/// @brief Benchmark callable of one size sweep family; the benchmark argument selects the input size.
+/// @details Reports the size as complexity N and the Run() time per unit of size as run_time_per_n, whose jumps
+///          between neighbouring sizes mark where the working set leaves a cache level.
+template <typename TaskGetter, typename InType>
+class SizeSweepBenchmarkBody final {
+ public:
+  SizeSweepBenchmarkBody(TaskGetter task_getter, std::shared_ptr<const SizeSweepInputs<InType>> inputs,
+                         std::string test_env_token, PerfAttr perf_attr, int num_threads,
+                         WorkEstimator<InType> estimate_work)
+      : task_getter_(std::move(task_getter)),
+        inputs_(std::move(inputs)),
+        test_env_token_(std::move(test_env_token)),
+        perf_attr_(std::move(perf_attr)),
+        num_threads_(num_threads),
+        estimate_work_(std::move(estimate_work)) {}
+
+  void operator()(benchmark::State &state) const noexcept {
+    const int64_t size = state.range(0);
+    const auto input = inputs_->find(size);
+    if (input == inputs_->end()) {
+      SkipBenchmarkWithError(state, "No size sweep input for this size");
+      return;
+    }
+    RunBenchmarkBody(task_getter_, input->second, test_env_token_, perf_attr_, num_threads_, estimate_work_, state);
+    state.SetComplexityN(size);
+    try {
+      const auto run_time = state.counters.find("run_time");
+      if (run_time != state.counters.end()) {
+        state.counters["run_time_per_n"] =
+            benchmark::Counter(run_time->second.value / static_cast<double>(size), run_time->second.flags);
+      }
+    } catch (const std::exception &e) {
+      SkipBenchmarkWithError(state, e.what());
+    }
+  }
+
+ private:
+  TaskGetter task_getter_;
+  std::shared_ptr<const SizeSweepInputs<InType>> inputs_;
+  std::string test_env_token_;
+  PerfAttr perf_attr_;
+  int num_threads_;
+  WorkEstimator<InType> estimate_work_;
+};
+
+/// @brief Backend used for batch benchmarks: SEQ instances run in parallel on threads; tasks that parallelize
+///        themselves, or communicate across ranks, process their instances one after another.
+inline ppc::task::BatchBackend DefaultBatchBackend(ppc::task::TypeOfTask task_type) {
+  return task_type == ppc::task::TypeOfTask::kSEQ ? ppc::task::BatchBackend::kThreads
+                                                  : ppc::task::BatchBackend::kSequential;
+}
+
+/// @brief Times BatchTask::RunBatch() over @p inputs and reports throughput as items_per_second.
+template <typename TaskGetter, typename InType>
+void RunBatchBenchmarkBody(const TaskGetter &task_getter, const std::vector<InType> &inputs,
+                           ppc::task::TypeOfTask task_type, const std::string &test_env_token,
+                           const PerfAttr &perf_attr, benchmark::State &state) noexcept {
+  try {
+    const auto benchmark_env_scope = ppc::util::test::ScopedPerTestEnv(test_env_token);
+    using TaskPointer = decltype(task_getter(std::declval<InType>()));
+    using OutType = std::remove_reference_t<decltype(std::declval<TaskPointer>()->GetOutput())>;
+    ppc::task::BatchTask<InType, OutType> batch(task_getter, DefaultBatchBackend(task_type));
+    batch.GetStateOfTesting() = ppc::task::StateOfTesting::kPerf;
+    const auto timer = MakeBenchmarkTimer(task_type);
+
+    for (uint64_t warmup = 0; warmup < perf_attr.num_warmups; warmup++) {
+      benchmark::DoNotOptimize(batch.RunBatch(inputs));
+    }
+    const InterferenceMode interference_mode = GetInterferenceMode();
+    std::optional<InterferenceProbes> interference;
+    if (interference_mode != InterferenceMode::kOff) {
+      interference = ProbeBeforeBenchmark(interference_mode);
+    }
+    for (auto _ : state) {
+      SynchronizeMpiRanks();
+      const double begin = timer();
+      benchmark::DoNotOptimize(batch.RunBatch(inputs));
+      const double elapsed = MaxElapsedTimeAcrossMpiRanks(timer() - begin, task_type);
+      CheckPerfTimeLimit(elapsed);
+      state.SetIterationTime(elapsed);
+    }
+    if (interference) {
+      ReportInterference(state, *interference);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(inputs.size()));
+    state.counters["batch_size"] = static_cast<double>(inputs.size());
+  } catch (const std::exception &e) {
+    PerformanceFailureFlag::Set();
+    SkipBenchmarkWithError(state, e.what());
+  } catch (...) {
+    PerformanceFailureFlag::Set();
+    SkipBenchmarkWithError(state, "Unknown exception in batch performance benchmark");
+  }
+}
+
+/// @brief Batch counterpart of BenchmarkTaskBody.
+template <typename TaskGetter, typename InType>
+class BatchBenchmarkBody final {
+ public:
+  BatchBenchmarkBody(TaskGetter task_getter, std::shared_ptr<const std::vector<InType>> inputs,
+                     ppc::task::TypeOfTask task_type, std::string test_env_token, PerfAttr perf_attr)
+      : task_getter_(std::move(task_getter)),
+        inputs_(std::move(inputs)),
+        task_type_(task_type),
+        test_env_token_(std::move(test_env_token)),
+        perf_attr_(std::move(perf_attr)) {}
 
   void operator()(benchmark::State &state) const noexcept {
-    RunBenchmarkBody(task_getter_, input_data_, test_env_token_, state);
+    RunBatchBenchmarkBody(task_getter_, *inputs_, task_type_, test_env_token_, perf_attr_, state);
   }
 
  private:
   TaskGetter task_getter_;
-  InType input_data_;
+  std::shared_ptr<const std::vector<InType>> inputs_;
+  ppc::task::TypeOfTask task_type_;
   std::string test_env_token_;
+  PerfAttr perf_attr_;
 };
 
 }  // namespace detail
 
 template <typename InType, typename OutType>
-using PerfTestParam = std::tuple<std::function<ppc::task::TaskPtr<InType, OutType>(InType)>, std::string,
-                                 ppc::task::TaskCategory, ppc::task::TaskDescriptor>;
+using PerfTestParam = std::tuple<std::function<ppc::task::TaskPtr<InType, OutType>(const InType &)>, std::string,
+                                 ppc::task::TaskCategory, ppc::task::TaskDescriptor, WorkEstimator<InType>>;
+
+/// @brief Position of the WorkEstimator in PerfTestParam, after the fields indexed by GTestParamIndex.
+inline constexpr std::size_t kPerfWorkEstimatorIndex = 4;
 
 template <typename InType, typename OutType>
 /// @brief Base class for performance testing of parallel tasks.
@@ -188,6 +1005,58 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
   /// @brief Supplies input data for performance testing.
   virtual InType GetTestInputData() = 0;
 
+  /// @brief Returns the input shared by every implementation benchmarked by this test suite.
+  /// @details GetTestInputData() is called by the first implementation of the suite; the others reuse the same
+  ///          read-only instance.
+  const std::shared_ptr<const InType> &GetSharedTestInputData() {
+    auto &inputs = GetSuiteInputs();
+    if (!inputs.input_data) {
+      inputs.input_data = std::make_shared<const InType>(GetTestInputData());
+    }
+    return inputs.input_data;
+  }
+
+  /// @brief Drops the inputs of the finished suite; its registered benchmarks keep their own references.
+  static void TearDownTestSuite() {
+    SuiteInputsByName().erase(CurrentTestSuiteName());
+  }
+
+  /// @brief Supplies the instances of the batch benchmark; an empty batch (the default) registers none.
+  /// @details Every implementation gets an extra "<name>/batch:<size>" benchmark that runs all instances through
+  ///          ppc::task::BatchTask and reports items_per_second.
+  virtual std::vector<InType> GetBatchInputData() {
+    return {};
+  }
+
+  /// @brief Checks the outputs of the batch benchmark; by default every output must pass CheckTestOutputData().
+  virtual bool CheckBatchOutputData(const std::vector<InType> & /*inputs*/, std::vector<OutType> &outputs) {
+    return std::ranges::all_of(outputs, [this](OutType &output) { return CheckTestOutputData(output); });
+  }
+
+  /// @brief Input sizes of the size sweep; an empty schedule (the default) registers none.
+  /// @details Every implementation gets an extra "<name>/size_sweep" benchmark family with one "n:<size>" entry per
+  ///          size, measured with the same PerfAttr as the main benchmark. Google Benchmark fits
+  ///          GetInputSizeComplexity() over the family. Each input is generated once and kept until the benchmarks
+  ///          have run. See InputSizeRange() for a geometric schedule.
+  virtual std::vector<std::size_t> GetInputSizeSweep() {
+    return {};
+  }
+
+  /// @brief Generates the size sweep input of size @p n; must be overridden when GetInputSizeSweep() is not empty.
+  virtual InType GetSizedInputData(std::size_t /*n*/) {
+    throw std::runtime_error("GetInputSizeSweep() is not empty but GetSizedInputData() is not overridden");
+  }
+
+  /// @brief Checks the output for the size sweep input of size @p n; by default it must pass CheckTestOutputData().
+  virtual bool CheckSizedOutputData(std::size_t /*n*/, OutType &output_data) {
+    return CheckTestOutputData(output_data);
+  }
+
+  /// @brief Complexity fitted over the size sweep; benchmark::oAuto picks the best-fitting curve.
+  virtual benchmark::BigO GetInputSizeComplexity() {
+    return benchmark::oAuto;
+  }
+
   virtual void SetPerfAttributes(PerfAttr &perf_attrs) {
     perf_attrs.current_timer = detail::MakeTechnologyTimer(task_->GetDynamicTypeOfTask());
   }
@@ -195,6 +1064,7 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
   void ExecuteTest(const PerfTestParam<InType, OutType> &perf_test_param) {
     auto task_getter = std::get<static_cast<std::size_t>(GTestParamIndex::kTaskGetter)>(perf_test_param);
     const auto &descriptor = GetTaskDescriptor(perf_test_param);
+    const auto &estimate_work = std::get<kPerfWorkEstimatorIndex>(perf_test_param);
 
     ASSERT_NE(descriptor.type, ppc::task::TypeOfTask::kUnknown);
     if (descriptor.status == ppc::task::StatusOfTask::kDisabled) {
@@ -207,8 +1077,8 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
     const auto test_env_token = ppc::util::test::MakeCurrentGTestToken(descriptor.display_name);
     const auto test_env_scope = ppc::util::test::ScopedPerTestEnv(test_env_token);
 
-    const auto input_data = GetTestInputData();
-    task_ = task_getter(input_data);
+    const auto &input_data = GetSharedTestInputData();
+    task_ = task_getter(*input_data);
     task_->GetStateOfTesting() = ppc::task::StateOfTesting::kPerf;
     SynchronizeMpiRanks();
     detail::RunTaskForValidation(task_);
@@ -218,19 +1088,133 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
 
     PerfAttr perf_attr;
     SetPerfAttributes(perf_attr);
-    const auto num_iterations = perf_attr.num_running == 0 ? 1 : perf_attr.num_running;
 
-    using BenchmarkInputType = std::decay_t<decltype(input_data)>;
-    auto benchmark_body =
-        detail::BenchmarkTaskBody<decltype(task_getter), BenchmarkInputType>(task_getter, input_data, test_env_token);
+    const auto variants = MakeVariants(descriptor, perf_attr);
+    for (const auto &variant : variants) {
+      auto benchmark_body = detail::BenchmarkTaskBody<decltype(task_getter), InType>(
+          task_getter, input_data, test_env_token, variant.perf_attr, variant.num_threads, estimate_work);
+      detail::ConfigurePerfBenchmark(benchmark::RegisterBenchmark(variant.name, std::move(benchmark_body)),
+                                     variant.perf_attr);
+    }
+    // Registered after the main variants, so that they come first in every report
+    RegisterBatchBenchmark(task_getter, descriptor, test_env_token, perf_attr);
+    RegisterSizeSweepBenchmarks(task_getter, variants, test_env_token, estimate_work);
+  }
+
+ private:
+  /// Benchmarks of one task: one per PPC_PERF_THREAD_SWEEP entry, plus a copy of each for every PPC_PERF_SCHEDULE_SWEEP
+  /// entry. The scaling reporter and the scoreboard skip the "/schedule:" copies, so the plain runs stay as the scores.
+  static std::vector<detail::PerfVariant> MakeVariants(const ppc::task::TaskDescriptor &descriptor,
+                                                       const PerfAttr &perf_attr) {
+    std::vector<detail::PerfVariant> variants;
+    const bool sweeps = IsThreadSweepTaskType(descriptor.type);
+    const auto thread_sweep = sweeps ? GetPerfThreadSweep() : std::vector<int>{};
+    if (thread_sweep.empty()) {
+      variants.push_back({.name = descriptor.display_name, .num_threads = 0, .perf_attr = perf_attr});
+    }
+    for (const int num_threads : thread_sweep) {
+      variants.push_back({.name = descriptor.display_name + "/num_threads:" + std::to_string(num_threads),
+                          .num_threads = num_threads,
+                          .perf_attr = perf_attr});
+    }
+    const auto schedule_sweep = sweeps ? GetPerfScheduleSweep() : std::vector<SchedulePolicy>{};
+    const std::size_t num_plain = variants.size();
+    variants.reserve(num_plain * (schedule_sweep.size() + 1));
+    for (std::size_t i = 0; i < num_plain; i++) {
+      for (const auto &policy : schedule_sweep) {
+        const std::string policy_name = SchedulePolicyToString(policy);
+        auto &added = variants.emplace_back(variants[i]);
+        added.name += "/schedule:" + (policy_name.empty() ? std::string("default") : policy_name);
+        added.perf_attr.schedule = policy;
+      }
+    }
+    return variants;
+  }
+
+  template <typename TaskGetter>
+  void RegisterBatchBenchmark(const TaskGetter &task_getter, const ppc::task::TaskDescriptor &descriptor,
+                              const std::string &test_env_token, const PerfAttr &perf_attr) {
+    auto &batch_inputs = GetSuiteInputs().batch;
+    if (!batch_inputs) {
+      batch_inputs = std::make_shared<const std::vector<InType>>(GetBatchInputData());
+    }
+    if (batch_inputs->empty()) {
+      return;
+    }
+    ppc::task::BatchTask<InType, OutType> batch(task_getter, detail::DefaultBatchBackend(descriptor.type));
+    batch.GetStateOfTesting() = ppc::task::StateOfTesting::kPerf;
+    std::vector<OutType> outputs = batch.RunBatch(*batch_inputs);
+    ASSERT_TRUE(CheckBatchOutputData(*batch_inputs, outputs));
 
-    benchmark::RegisterBenchmark(descriptor.display_name, std::move(benchmark_body))
+    const auto num_iterations = perf_attr.num_running == 0 ? 1 : perf_attr.num_running;
+    auto body = detail::BatchBenchmarkBody<TaskGetter, InType>(task_getter, batch_inputs, descriptor.type,
+                                                               test_env_token, perf_attr);
+    benchmark::RegisterBenchmark(descriptor.display_name + "/batch:" + std::to_string(batch_inputs->size()),
+                                 std::move(body))
         ->UseManualTime()
         ->Unit(benchmark::kSecond)
         ->Iterations(static_cast<std::int64_t>(num_iterations));
   }
 
- private:
+  /// Registers "<variant>/size_sweep" for every variant; the scaling reporter and the scoreboard skip these runs.
+  template <typename TaskGetter>
+  void RegisterSizeSweepBenchmarks(const TaskGetter &task_getter,
+                                   const std::vector<detail::PerfVariant> &variants,
+                                   const std::string &test_env_token, const WorkEstimator<InType> &estimate_work) {
+    auto &size_sweep_inputs = GetSuiteInputs().size_sweep;
+    if (!size_sweep_inputs) {
+      auto inputs = std::make_shared<detail::SizeSweepInputs<InType>>();
+      for (const std::size_t size : GetInputSizeSweep()) {
+        inputs->try_emplace(static_cast<int64_t>(size), GetSizedInputData(size));
+      }
+      size_sweep_inputs = std::move(inputs);
+    }
+    if (size_sweep_inputs->empty()) {
+      return;
+    }
+    for (const auto &[size, input] : *size_sweep_inputs) {
+      auto task = task_getter(input);
+      task->GetStateOfTesting() = ppc::task::StateOfTesting::kPerf;
+      detail::RunTaskForValidation(task);
+      OutType output_data = task->GetOutput();
+      ASSERT_TRUE(CheckSizedOutputData(static_cast<std::size_t>(size), output_data)) << "size sweep n=" << size;
+    }
+
+    for (const auto &variant : variants) {
+      auto body = detail::SizeSweepBenchmarkBody<TaskGetter, InType>(task_getter, size_sweep_inputs,
+                                                                     test_env_token, variant.perf_attr,
+                                                                     variant.num_threads, estimate_work);
+      auto *registered = benchmark::RegisterBenchmark(variant.name + "/size_sweep", std::move(body))->ArgName("n");
+      for (const auto &[size, input] : *size_sweep_inputs) {
+        registered->Arg(size);
+      }
+      detail::ConfigurePerfBenchmark(registered, variant.perf_attr);
+      registered->Complexity(GetInputSizeComplexity());
+    }
+  }
+
+  /// Inputs generated once per test suite. GoogleTest builds a fixture for every implementation, so they cannot
+  /// live in the fixture itself.
+  struct SuiteInputs {
+    std::shared_ptr<const InType> input_data;
+    std::shared_ptr<const detail::SizeSweepInputs<InType>> size_sweep;
+    std::shared_ptr<const std::vector<InType>> batch;
+  };
+
+  static std::string CurrentTestSuiteName() {
+    const auto *suite = ::testing::UnitTest::GetInstance()->current_test_suite();
+    return suite != nullptr ? suite->name() : std::string{};
+  }
+
+  static std::map<std::string, SuiteInputs> &SuiteInputsByName() {
+    static std::map<std::string, SuiteInputs> inputs;
+    return inputs;
+  }
+
+  static SuiteInputs &GetSuiteInputs() {
+    return SuiteInputsByName()[CurrentTestSuiteName()];
+  }
+
   ppc::task::TaskPtr<InType, OutType> task_{};
 };
 
@@ -239,8 +1223,14 @@ auto MakePerfTaskTuples(const std::string &settings_path, std::string_view setti
   const auto descriptor =
       MakeTaskDescriptor(GetNamespace<TaskType>(), TaskType::GetStaticTypeOfTask(), settings_path, settings_task_path);
 
-  return std::make_tuple(std::make_tuple(ppc::task::TaskGetter<TaskType, InputType>, descriptor.display_name,
-                                         descriptor.category, descriptor));
+  WorkEstimator<InputType> estimate_work;
+  if constexpr (HasEstimateWork<TaskType, InputType>) {
+    estimate_work = [](const InputType &input) { return TaskType::EstimateWork(input); };
+  }
+  // Benchmarks build a task per iteration from one shared input, so the getter takes it by reference and the task
+  // constructor makes the only copy
+  return std::make_tuple(std::make_tuple(ppc::task::TaskGetter<TaskType, const InputType &>, descriptor.display_name,
+                                         descriptor.category, descriptor, std::move(estimate_work)));
 }
 
 template <typename Tuple, std::size_t... I>
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "util/include/decomposition.hpp"
+#include "util/include/thread_pool.hpp"
+
+namespace ppc::util {
+
+using PhiloxCounter = std::array<uint32_t, 4>;
+using PhiloxKey = std::array<uint32_t, 2>;
+
+/// @brief Philox4x32-10 block function: maps a 128-bit counter and a 64-bit key to 128 random bits.
+constexpr PhiloxCounter Philox4x32(PhiloxCounter counter, PhiloxKey key) {
+  constexpr uint64_t kMultiplier0 = 0xD2511F53U;
+  constexpr uint64_t kMultiplier1 = 0xCD9E8D57U;
+  constexpr uint32_t kWeyl0 = 0x9E3779B9U;
+  constexpr uint32_t kWeyl1 = 0xBB67AE85U;
+  for (int round = 0; round < 10; round++) {
+    const uint64_t product0 = kMultiplier0 * counter[0];
+    const uint64_t product1 = kMultiplier1 * counter[2];
+    counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0], static_cast<uint32_t>(product1),
+               static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1], static_cast<uint32_t>(product0)};
+    key = {key[0] + kWeyl0, key[1] + kWeyl1};
+  }
+  return counter;
+}
+
+/// @brief Counter-based generator: value number i depends only on the seed, the stream and i.
+/// @details Any slice of a sequence can therefore be produced on any rank or thread, in any order, and still be
+///          bit-identical to a serial run. Use distinct streams for independent inputs of one test.
+class CounterRng {
+ public:
+  explicit constexpr CounterRng(uint64_t seed, uint64_t stream = 0)
+      : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)}, stream_(stream) {}
+
+  /// @brief 64 random bits of value number @p index.
+  [[nodiscard]] constexpr uint64_t Bits(uint64_t index) const {
+    const PhiloxCounter block = Philox4x32({static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32),
+                                            static_cast<uint32_t>(stream_), static_cast<uint32_t>(stream_ >> 32)},
+                                           key_);
+    return (static_cast<uint64_t>(block[1]) << 32) | block[0];
+  }
+
+  /// @brief Value number @p index drawn from [@p lo, @p hi] for integers or [@p lo, @p hi) for floating point.
+  /// @details Integers are reduced modulo the range width; the bias is below 2^-32 for ranges narrower than 2^32.
+  template <typename T>
+  [[nodiscard]] constexpr T Uniform(uint64_t index, T lo, T hi) const {
+    if constexpr (std::floating_point<T>) {
+      constexpr double kInv53 = 1.0 / static_cast<double>(uint64_t{1} << 53);
+      const double unit = static_cast<double>(Bits(index) >> 11) * kInv53;
+      return static_cast<T>(static_cast<double>(lo) + (unit * (static_cast<double>(hi) - static_cast<double>(lo))));
+    } else {
+      static_assert(std::integral<T>, "Uniform() needs an arithmetic type");
+      const auto width = static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo) + 1;
+      const uint64_t offset = width == 0 ? Bits(index) : Bits(index) % width;
+      return static_cast<T>(static_cast<uint64_t>(lo) + offset);
+    }
+  }
+
+ private:
+  PhiloxKey key_;
+  uint64_t stream_;
+};
+
+/// @brief Seed of the current test run; ppc::runners::SyncRunnerState() makes it equal on every MPI rank.
+uint64_t TestInputSeed();
+
+/// @brief Fills @p out with values @p first_index, @p first_index + 1, ... of @p rng on the STL pool.
+template <typename T>
+void FillUniform(std::span<T> out, uint64_t first_index, T lo, T hi, const CounterRng &rng) {
+  constexpr std::size_t kBlock = 4096;
+  const std::size_t blocks = (out.size() + kBlock - 1) / kBlock;
+  GetThreadPool().ParallelFor(std::size_t{0}, blocks, [&](std::size_t block) {
+    const std::size_t end = std::min(out.size(), (block + 1) * kBlock);
+    for (std::size_t i = block * kBlock; i < end; i++) {
+      out[i] = rng.Uniform<T>(first_index + i, lo, hi);
+    }
+  });
+}
+
+template <typename T>
+std::vector<T> GenerateUniform(std::size_t count, T lo, T hi, const CounterRng &rng) {
+  std::vector<T> values(count);
+  FillUniform(std::span<T>(values), 0, lo, hi, rng);
+  return values;
+}
+
+/// @brief Block of a generated sequence owned by one MPI rank.
+template <typename T>
+struct GeneratedSlice {
+  uint64_t first_index = 0;
+  std::vector<T> data;
+};
+
+/// @brief Generates only this rank's block of a sequence of @p total values; without MPI the whole sequence.
+/// @details Blocks follow the usual decomposition where the first total % size ranks get one extra value.
+template <typename T>
+GeneratedSlice<T> GenerateLocalUniform(MPI_Comm comm, uint64_t total, T lo, T hi, const CounterRng &rng) {
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  int rank = 0;
+  int size = 1;
+  if (initialized != 0) {
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+  }
+  const BlockRange block = BlockPartition(static_cast<int64_t>(total), size, rank);
+  GeneratedSlice<T> slice;
+  slice.first_index = static_cast<uint64_t>(block.begin);
+  slice.data.resize(static_cast<std::size_t>(block.count));
+  FillUniform(std::span<T>(slice.data), slice.first_index, lo, hi, rng);
+  return slice;
+}
+
+}  // namespace ppc::util
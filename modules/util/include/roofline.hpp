@@ -0,0 +1,50 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <optional>
+
+namespace ppc::util {
+
+/// @brief Work done by one Task::Run() call, as declared by the task.
+/// @details Tasks opt in with `static ppc::util::WorkModel EstimateWork(const InType &)`; performance tests then
+///          report attained FLOP/s and bytes/s of Run().
+struct WorkModel {
+  /// @brief Floating point operations; a fused multiply-add counts as two.
+  double flops = 0.0;
+  /// @brief Bytes read from and written to memory, counting every element once per pass over it.
+  double bytes = 0.0;
+};
+
+template <typename TaskType, typename InType>
+concept HasEstimateWork = requires(const InType &input) {
+  { TaskType::EstimateWork(input) } -> std::same_as<WorkModel>;
+};
+
+/// @brief Peak rates the roofline is drawn from.
+struct MachinePeaks {
+  double flops_per_second = 0.0;
+  double bytes_per_second = 0.0;
+};
+
+/// @brief Returns true when PPC_PERF_ROOFLINE requests the peak probe and roofline fractions.
+bool RooflineEnabled();
+
+/// @brief Measures peak FLOP/s with independent multiply-add chains and bandwidth with a STREAM triad.
+/// @details Both kernels run on @p num_threads OpenMP threads and keep the best of a few trials. The FLOP peak is
+///          what the compiler generates for the build flags, not the ISA maximum; the triad uses
+///          @p stream_elements doubles per array and counts 24 bytes per element, without write-allocate traffic.
+MachinePeaks MeasureMachinePeaks(int num_threads, std::size_t stream_elements = std::size_t{1} << 22);
+
+/// @brief Measures the peaks of this process with GetNumThreads() threads on the first call and keeps them.
+/// @details The performance runner calls it on rank 0 before any benchmark when RooflineEnabled().
+const MachinePeaks &ProbeMachinePeaks();
+
+/// @brief Peaks kept by ProbeMachinePeaks(), or std::nullopt when they were never probed in this process.
+std::optional<MachinePeaks> GetProbedMachinePeaks();
+
+/// @brief Fraction of the roofline reached at the given rates: attained over attainable performance.
+/// @details Equals the larger of the FLOP and bandwidth utilizations; 0 when both peaks are unknown.
+double RooflineFraction(double flops_per_second, double bytes_per_second, const MachinePeaks &peaks);
+
+}  // namespace ppc::util
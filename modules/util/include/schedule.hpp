@@ -0,0 +1,88 @@
+#pragma once
+
+#include <omp.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <libenvpp/detail/environment.hpp>
+
+#include "util/include/schedule_policy.hpp"
+#include "util/include/util.hpp"
+
+namespace ppc::util {
+
+class ThreadPool;
+
+/// @brief Overrides the policy returned by GetSchedulePolicy() and the default policy of GetThreadPool() for the
+///        current scope.
+class ScopedSchedulePolicy {
+ public:
+  explicit ScopedSchedulePolicy(const SchedulePolicy &policy);
+  ScopedSchedulePolicy(const ScopedSchedulePolicy &) = delete;
+  ScopedSchedulePolicy &operator=(const ScopedSchedulePolicy &) = delete;
+  ~ScopedSchedulePolicy();
+
+ private:
+  env::detail::set_scoped_environment_variable set_schedule_;
+  ThreadPool &pool_;
+  SchedulePolicy previous_pool_policy_;
+};
+
+namespace detail {
+
+omp_sched_t ToOmpSchedule(ScheduleKind kind);
+
+}  // namespace detail
+
+/// @brief OpenMP loop over [@p begin, @p end) with the schedule kind and chunk size of @p policy.
+/// @details Runs `schedule(runtime)` with the runtime schedule set from @p policy and restored afterwards.
+template <typename Index, typename Body>
+void OmpParallelFor(Index begin, Index end, const Body &body, const SchedulePolicy &policy = GetSchedulePolicy(),
+                    int num_threads = GetNumThreads()) {
+  omp_sched_t previous_kind = omp_sched_auto;
+  int previous_chunk = 0;
+  omp_get_schedule(&previous_kind, &previous_chunk);
+  omp_set_schedule(detail::ToOmpSchedule(policy.kind), static_cast<int>(policy.grain_size));
+#pragma omp parallel for schedule(runtime) num_threads(std::max(num_threads, 1))
+  for (Index i = begin; i < end; i++) {
+    body(i);
+  }
+  omp_set_schedule(previous_kind, previous_chunk);
+}
+
+/// @brief tbb::parallel_for over [@p begin, @p end) with the grain size and partitioner of @p policy.
+/// @details The affinity partitioner is kept per calling thread, so consecutive loops issued by one thread replay
+///          the placement of the previous loop.
+template <typename Index, typename Body>
+void TbbParallelFor(Index begin, Index end, const Body &body, const SchedulePolicy &policy = GetSchedulePolicy()) {
+  if (begin >= end) {
+    return;
+  }
+  const tbb::blocked_range<Index> range(begin, end, std::max<std::size_t>(policy.grain_size, 1));
+  auto run = [&body](const tbb::blocked_range<Index> &chunk) {
+    for (Index i = chunk.begin(); i != chunk.end(); i++) {
+      body(i);
+    }
+  };
+  switch (policy.partitioner) {
+    case TbbPartitioner::kSimple:
+      tbb::parallel_for(range, run, tbb::simple_partitioner());
+      break;
+    case TbbPartitioner::kAffinity: {
+      thread_local tbb::affinity_partitioner affinity;
+      tbb::parallel_for(range, run, affinity);
+      break;
+    }
+    case TbbPartitioner::kStatic:
+      tbb::parallel_for(range, run, tbb::static_partitioner());
+      break;
+    case TbbPartitioner::kAuto:
+      tbb::parallel_for(range, run, tbb::auto_partitioner());
+      break;
+  }
+}
+
+}  // namespace ppc::util
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief How loop iterations are handed to threads by OmpParallelFor() and ThreadPool::ParallelFor().
+enum class ScheduleKind : uint8_t {
+  /// @brief The backend's own default: OpenMP schedule(auto), four pool chunks per thread.
+  kAuto,
+  kStatic,
+  kDynamic,
+  kGuided,
+};
+
+/// @brief TBB partitioner used by TbbParallelFor().
+enum class TbbPartitioner : uint8_t {
+  kAuto,
+  kSimple,
+  kAffinity,
+  kStatic,
+};
+
+/// @brief Loop scheduling shared by the OpenMP, TBB and thread-pool helpers.
+struct SchedulePolicy {
+  ScheduleKind kind = ScheduleKind::kAuto;
+  /// @brief Iterations per chunk (OpenMP chunk size, TBB range grain, pool chunk); 0 keeps the backend default.
+  std::size_t grain_size = 0;
+  TbbPartitioner partitioner = TbbPartitioner::kAuto;
+
+  bool operator==(const SchedulePolicy &) const = default;
+};
+
+/// @brief Parses a comma-separated list of `kind=`, `grain=` and `partitioner=` settings.
+/// @details For example `kind=dynamic,grain=64,partitioner=simple`; unspecified settings keep their defaults, and an
+///          empty string is the default policy.
+/// @throws std::runtime_error If a setting or value is unknown.
+SchedulePolicy ParseSchedulePolicy(std::string_view spec);
+
+/// @brief Inverse of ParseSchedulePolicy(), listing only the settings that differ from the default.
+std::string SchedulePolicyToString(const SchedulePolicy &policy);
+
+/// @brief Policy from PPC_SCHEDULE, or the default policy when it is unset.
+SchedulePolicy GetSchedulePolicy();
+
+/// @brief Policies of PPC_PERF_SCHEDULE_SWEEP, separated by ';'; empty when the variable is unset.
+std::vector<SchedulePolicy> GetPerfScheduleSweep();
+
+}  // namespace ppc::util
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Bump allocator of one thread; deallocation is a no-op and memory is reclaimed by rewinding.
+/// @details Blocks are kept after a rewind, so steady-state allocations do not reach the global allocator.
+class ThreadScratchArena final : public std::pmr::memory_resource {
+ public:
+  /// @brief Allocation position that can be restored with Rewind().
+  struct Mark {
+    std::size_t block = 0;
+    std::size_t offset = 0;
+    std::size_t in_use = 0;
+  };
+
+  [[nodiscard]] Mark GetMark() const {
+    return {.block = block_, .offset = offset_, .in_use = in_use_.load(std::memory_order_relaxed)};
+  }
+
+  /// @brief Frees everything allocated after @p mark was taken.
+  void Rewind(const Mark &mark) {
+    block_ = mark.block;
+    offset_ = mark.offset;
+    in_use_.store(mark.in_use, std::memory_order_relaxed);
+  }
+
+  /// @brief Largest number of bytes this thread has had in use at once.
+  [[nodiscard]] std::size_t PeakBytes() const {
+    return peak_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Block {
+    std::unique_ptr<std::byte[]> data;
+    std::size_t size = 0;
+  };
+
+  static constexpr std::size_t kMinBlockSize = std::size_t{64} * 1024;
+
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void * /*p*/, std::size_t /*bytes*/, std::size_t /*alignment*/) override {}
+  [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+  std::vector<Block> blocks_;
+  std::size_t block_ = 0;
+  std::size_t offset_ = 0;
+  std::atomic<std::size_t> in_use_{0};
+  std::atomic<std::size_t> peak_{0};
+};
+
+/// @brief Per-thread scratch memory owned by a task and released between pipeline runs.
+/// @details Every thread that calls Resource() gets its own ThreadScratchArena, so parallel regions allocate
+///          scratch buffers without contending on the global allocator.
+class ScratchArena {
+ public:
+  /// @brief Rewinds the calling thread's arena to where it was when the scope was entered.
+  class Scope {
+   public:
+    explicit Scope(ScratchArena &arena) : arena_(arena.Local()), mark_(arena_.GetMark()) {}
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+    ~Scope() {
+      arena_.Rewind(mark_);
+    }
+
+    /// @brief Memory resource for buffers that must not outlive the scope.
+    [[nodiscard]] std::pmr::memory_resource *Resource() const {
+      return &arena_;
+    }
+
+   private:
+    ThreadScratchArena &arena_;
+    ThreadScratchArena::Mark mark_;
+  };
+
+  ScratchArena();
+  ScratchArena(const ScratchArena &) = delete;
+  ScratchArena &operator=(const ScratchArena &) = delete;
+  ~ScratchArena() = default;
+
+  /// @brief Memory resource of the calling thread; valid until Release().
+  std::pmr::memory_resource *Resource() {
+    return &Local();
+  }
+
+  /// @brief Rewinds the arenas of all threads. Must not run concurrently with allocations.
+  void Release();
+
+  /// @brief Sum of the per-thread high-water marks since construction.
+  [[nodiscard]] std::size_t PeakBytes() const;
+
+ private:
+  ThreadScratchArena &Local();
+
+  std::uint64_t id_;
+  mutable std::mutex mutex_;
+  std::unordered_map<std::thread::id, std::unique_ptr<ThreadScratchArena>> arenas_;
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,324 @@
+#pragma once
+
+#include <mpi.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/parallel_scan.h>
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "util/include/decomposition.hpp"
+
+namespace ppc::util {
+
+/// @brief One nonzero of a sparse matrix given as (row, column, value).
+template <typename T>
+struct Triplet {
+  int32_t row = 0;
+  int32_t col = 0;
+  T value{};
+};
+
+/// @brief Directed edge of a graph.
+struct Edge {
+  int32_t from = 0;
+  int32_t to = 0;
+};
+
+/// @brief Compressed sparse row matrix: the nonzeros of row i are [row_offsets[i], row_offsets[i + 1]).
+template <typename T>
+struct CsrMatrix {
+  int32_t rows = 0;
+  int32_t cols = 0;
+  std::vector<int64_t> row_offsets = {0};
+  std::vector<int32_t> col_indices;
+  std::vector<T> values;
+
+  [[nodiscard]] int64_t NumNonZeros() const {
+    return row_offsets.back();
+  }
+
+  [[nodiscard]] std::span<const int32_t> RowCols(int32_t row) const {
+    return std::span(col_indices).subspan(Begin(row), Length(row));
+  }
+
+  [[nodiscard]] std::span<const T> RowValues(int32_t row) const {
+    return std::span(values).subspan(Begin(row), Length(row));
+  }
+
+ private:
+  [[nodiscard]] std::size_t Begin(int32_t row) const {
+    return static_cast<std::size_t>(row_offsets[static_cast<std::size_t>(row)]);
+  }
+
+  [[nodiscard]] std::size_t Length(int32_t row) const {
+    return static_cast<std::size_t>(row_offsets[static_cast<std::size_t>(row) + 1]) - Begin(row);
+  }
+};
+
+/// @brief Compressed sparse column matrix: the nonzeros of column j are [col_offsets[j], col_offsets[j + 1]).
+template <typename T>
+struct CscMatrix {
+  int32_t rows = 0;
+  int32_t cols = 0;
+  std::vector<int64_t> col_offsets = {0};
+  std::vector<int32_t> row_indices;
+  std::vector<T> values;
+};
+
+/// @brief ELLPACK matrix: every row owns @c width consecutive slots, unused ones hold column kPadding and zero.
+template <typename T>
+struct EllMatrix {
+  static constexpr int32_t kPadding = -1;
+
+  int32_t rows = 0;
+  int32_t cols = 0;
+  std::size_t width = 0;
+  std::vector<int32_t> col_indices;
+  std::vector<T> values;
+};
+
+/// @brief Graph in CSR adjacency form: the neighbours of v are [offsets[v], offsets[v + 1]) of @c neighbors.
+struct CsrGraph {
+  int32_t num_vertices = 0;
+  std::vector<int64_t> offsets = {0};
+  std::vector<int32_t> neighbors;
+
+  [[nodiscard]] int64_t NumEdges() const {
+    return offsets.back();
+  }
+
+  [[nodiscard]] std::span<const int32_t> Neighbors(int32_t vertex) const {
+    const auto begin = static_cast<std::size_t>(offsets[static_cast<std::size_t>(vertex)]);
+    const auto end = static_cast<std::size_t>(offsets[static_cast<std::size_t>(vertex) + 1]);
+    return std::span(neighbors).subspan(begin, end - begin);
+  }
+};
+
+/// @brief Contiguous block of rows of a larger CSR matrix, with global column indices.
+template <typename T>
+struct CsrRowBlock {
+  int32_t first_row = 0;
+  CsrMatrix<T> matrix;
+};
+
+namespace detail {
+
+/// @brief Offsets of every row in @p sorted_rows, an ascending list of row indices below @p num_rows.
+std::vector<int64_t> OffsetsFromSortedRows(std::span<const int32_t> sorted_rows, int32_t num_rows);
+
+/// @brief Rank and size of @p comm, or 0 and 1 without MPI.
+void CommPosition(MPI_Comm comm, int &rank, int &size);
+
+/// @brief Output position of every element of a sorted sequence after equal neighbours are merged.
+/// @details slots[i] is the index of the run element i belongs to; @p same_as_previous(i) tells whether element i
+///          continues the run of element i - 1. The positions come from a parallel prefix sum over run heads.
+template <typename SameAsPrevious>
+std::vector<int64_t> RunSlots(std::size_t count, const SameAsPrevious &same_as_previous) {
+  std::vector<int64_t> slots(count);
+  tbb::parallel_scan(
+      tbb::blocked_range<std::size_t>(0, count), int64_t{0},
+      [&](const tbb::blocked_range<std::size_t> &range, int64_t runs, bool is_final) {
+        for (std::size_t i = range.begin(); i != range.end(); i++) {
+          if (i == 0 || !same_as_previous(i)) {
+            runs++;
+          }
+          if (is_final) {
+            slots[i] = runs - 1;
+          }
+        }
+        return runs;
+      },
+      std::plus<>());
+  return slots;
+}
+
+template <typename Indices>
+void CheckIndices(const Indices &indices, int32_t bound, const char *what) {
+  if (std::ranges::any_of(indices, [bound](int32_t index) { return index < 0 || index >= bound; })) {
+    throw std::runtime_error(std::string(what) + " index out of range");
+  }
+}
+
+}  // namespace detail
+
+/// @brief Builds a CSR matrix from unordered triplets; duplicates of one position are summed.
+/// @details The triplets are sorted with tbb::parallel_sort and compacted through a parallel prefix sum, and row
+///          offsets are found by parallel binary search, so construction scales with the TBB worker count.
+/// @throws std::runtime_error If a triplet lies outside the matrix.
+template <typename T>
+CsrMatrix<T> BuildCsr(int32_t rows, int32_t cols, std::vector<Triplet<T>> triplets) {
+  detail::CheckIndices(triplets | std::views::transform(&Triplet<T>::row), rows, "Row");
+  detail::CheckIndices(triplets | std::views::transform(&Triplet<T>::col), cols, "Column");
+  tbb::parallel_sort(triplets.begin(), triplets.end(), [](const Triplet<T> &lhs, const Triplet<T> &rhs) {
+    return std::tie(lhs.row, lhs.col) < std::tie(rhs.row, rhs.col);
+  });
+  auto same_position = [&](std::size_t i) {
+    return triplets[i].row == triplets[i - 1].row && triplets[i].col == triplets[i - 1].col;
+  };
+  const std::vector<int64_t> slots = detail::RunSlots(triplets.size(), same_position);
+  const std::size_t nonzeros = triplets.empty() ? 0 : static_cast<std::size_t>(slots.back()) + 1;
+
+  CsrMatrix<T> matrix;
+  matrix.rows = rows;
+  matrix.cols = cols;
+  std::vector<int32_t> nonzero_rows(nonzeros);
+  matrix.col_indices.resize(nonzeros);
+  matrix.values.resize(nonzeros);
+  tbb::parallel_for(std::size_t{0}, triplets.size(), [&](std::size_t i) {
+    if (i != 0 && same_position(i)) {
+      return;
+    }
+    T sum = triplets[i].value;
+    for (std::size_t j = i + 1; j < triplets.size() && same_position(j); j++) {
+      sum += triplets[j].value;
+    }
+    const auto slot = static_cast<std::size_t>(slots[i]);
+    nonzero_rows[slot] = triplets[i].row;
+    matrix.col_indices[slot] = triplets[i].col;
+    matrix.values[slot] = sum;
+  });
+  matrix.row_offsets = detail::OffsetsFromSortedRows(nonzero_rows, rows);
+  return matrix;
+}
+
+/// @brief Builds the adjacency of @p num_vertices vertices from @p edges, dropping repeated edges.
+/// @param undirected Also insert the reverse of every edge.
+/// @throws std::runtime_error If an edge names a vertex outside the graph.
+CsrGraph BuildGraph(int32_t num_vertices, std::span<const Edge> edges, bool undirected = false);
+
+/// @brief Same nonzeros in compressed sparse column form.
+template <typename T>
+CscMatrix<T> ToCsc(const CsrMatrix<T> &matrix) {
+  std::vector<Triplet<T>> transposed(matrix.col_indices.size());
+  tbb::parallel_for(int32_t{0}, matrix.rows, [&](int32_t row) {
+    for (auto i = static_cast<std::size_t>(matrix.row_offsets[static_cast<std::size_t>(row)]);
+         i < static_cast<std::size_t>(matrix.row_offsets[static_cast<std::size_t>(row) + 1]); i++) {
+      transposed[i] = {.row = matrix.col_indices[i], .col = row, .value = matrix.values[i]};
+    }
+  });
+  CsrMatrix<T> transpose = BuildCsr(matrix.cols, matrix.rows, std::move(transposed));
+  return {.rows = matrix.rows,
+          .cols = matrix.cols,
+          .col_offsets = std::move(transpose.row_offsets),
+          .row_indices = std::move(transpose.col_indices),
+          .values = std::move(transpose.values)};
+}
+
+/// @brief Same nonzeros in ELLPACK form, as wide as the longest row.
+template <typename T>
+EllMatrix<T> ToEll(const CsrMatrix<T> &matrix) {
+  const int64_t width = tbb::parallel_reduce(
+      tbb::blocked_range<int32_t>(0, matrix.rows), int64_t{0},
+      [&](const tbb::blocked_range<int32_t> &range, int64_t longest) {
+        for (int32_t row = range.begin(); row != range.end(); row++) {
+          const auto index = static_cast<std::size_t>(row);
+          longest = std::max(longest, matrix.row_offsets[index + 1] - matrix.row_offsets[index]);
+        }
+        return longest;
+      },
+      [](int64_t lhs, int64_t rhs) { return std::max(lhs, rhs); });
+  EllMatrix<T> ell;
+  ell.rows = matrix.rows;
+  ell.cols = matrix.cols;
+  ell.width = static_cast<std::size_t>(width);
+  ell.col_indices.assign(static_cast<std::size_t>(matrix.rows) * ell.width, EllMatrix<T>::kPadding);
+  ell.values.assign(ell.col_indices.size(), T{});
+  tbb::parallel_for(int32_t{0}, matrix.rows, [&](int32_t row) {
+    const std::span<const int32_t> cols = matrix.RowCols(row);
+    const std::span<const T> values = matrix.RowValues(row);
+    const std::size_t base = static_cast<std::size_t>(row) * ell.width;
+    std::ranges::copy(cols, ell.col_indices.begin() + static_cast<std::ptrdiff_t>(base));
+    std::ranges::copy(values, ell.values.begin() + static_cast<std::ptrdiff_t>(base));
+  });
+  return ell;
+}
+
+/// @brief Rows [first, first + count) chosen so that the @p parts blocks hold about the same number of nonzeros.
+/// @param offsets Row offsets of a CSR matrix or graph.
+BlockRange NonZeroBalancedRows(std::span<const int64_t> offsets, int parts, int index);
+
+/// @brief Copy of the rows in @p range; column indices stay global.
+template <typename T>
+CsrMatrix<T> ExtractRows(const CsrMatrix<T> &matrix, BlockRange range) {
+  const auto first = static_cast<std::size_t>(range.begin);
+  const auto last = static_cast<std::size_t>(range.End());
+  const int64_t base = matrix.row_offsets[first];
+  CsrMatrix<T> block;
+  block.rows = static_cast<int32_t>(range.count);
+  block.cols = matrix.cols;
+  block.row_offsets.resize(last - first + 1);
+  for (std::size_t row = first; row <= last; row++) {
+    block.row_offsets[row - first] = matrix.row_offsets[row] - base;
+  }
+  const auto begin = static_cast<std::ptrdiff_t>(base);
+  const auto end = static_cast<std::ptrdiff_t>(matrix.row_offsets[last]);
+  block.col_indices.assign(matrix.col_indices.begin() + begin, matrix.col_indices.begin() + end);
+  block.values.assign(matrix.values.begin() + begin, matrix.values.begin() + end);
+  return block;
+}
+
+/// @brief This rank's share of a 1D row partition of @p matrix over @p comm, balanced by nonzeros.
+/// @details Without MPI the single process gets every row.
+template <typename T>
+CsrRowBlock<T> LocalRowBlock(const CsrMatrix<T> &matrix, MPI_Comm comm) {
+  int rank = 0;
+  int size = 1;
+  detail::CommPosition(comm, rank, size);
+  const BlockRange range = NonZeroBalancedRows(matrix.row_offsets, size, rank);
+  return {.first_row = static_cast<int32_t>(range.begin), .matrix = ExtractRows(matrix, range)};
+}
+
+/// @brief Reference sparse matrix-vector product @p y = @p matrix * @p x.
+/// @throws std::runtime_error If the vector lengths do not match the matrix.
+template <typename T>
+void SpMV(const CsrMatrix<T> &matrix, std::span<const T> x, std::span<T> y) {
+  if (x.size() != static_cast<std::size_t>(matrix.cols) || y.size() != static_cast<std::size_t>(matrix.rows)) {
+    throw std::runtime_error("SpMV vector lengths do not match the matrix");
+  }
+  for (int32_t row = 0; row < matrix.rows; row++) {
+    const std::span<const int32_t> cols = matrix.RowCols(row);
+    const std::span<const T> values = matrix.RowValues(row);
+    T sum{};
+    for (std::size_t i = 0; i < cols.size(); i++) {
+      sum += values[i] * x[static_cast<std::size_t>(cols[i])];
+    }
+    y[static_cast<std::size_t>(row)] = sum;
+  }
+}
+
+/// @brief Reference ELLPACK product @p y = @p matrix * @p x; padding slots are skipped.
+template <typename T>
+void SpMV(const EllMatrix<T> &matrix, std::span<const T> x, std::span<T> y) {
+  if (x.size() != static_cast<std::size_t>(matrix.cols) || y.size() != static_cast<std::size_t>(matrix.rows)) {
+    throw std::runtime_error("SpMV vector lengths do not match the matrix");
+  }
+  for (std::size_t row = 0; row < y.size(); row++) {
+    T sum{};
+    for (std::size_t slot = row * matrix.width; slot < (row + 1) * matrix.width; slot++) {
+      const int32_t col = matrix.col_indices[slot];
+      if (col != EllMatrix<T>::kPadding) {
+        sum += matrix.values[slot] * x[static_cast<std::size_t>(col)];
+      }
+    }
+    y[row] = sum;
+  }
+}
+
+/// @brief Reference breadth-first search from @p source.
+/// @return Hop distance of every vertex, -1 for vertices that cannot be reached.
+std::vector<int32_t> BreadthFirstSearch(const CsrGraph &graph, int32_t source);
+
+}  // namespace ppc::util
@@ -32,4 +32,11 @@ inline bool IsMpiTaskType(ppc::task::TypeOfTask type) {
   return type == ppc::task::TypeOfTask::kMPI || type == ppc::task::TypeOfTask::kALL;
 }
 
+/// @brief Backends that run on a thread count: their benchmarks are repeated for every PPC_PERF_THREAD_SWEEP entry
+///        and the autotuner probes them at several counts.
+inline bool IsThreadSweepTaskType(ppc::task::TypeOfTask task_type) {
+  return task_type == ppc::task::TypeOfTask::kOMP || task_type == ppc::task::TypeOfTask::kTBB ||
+         task_type == ppc::task::TypeOfTask::kSTL || task_type == ppc::task::TypeOfTask::kALL;
+}
+
 }  // namespace ppc::util
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "util/include/schedule_policy.hpp"
+
+namespace ppc::util {
+
+/// @brief Persistent work-stealing pool of worker threads.
+/// @details Every worker owns a deque: it pops its own jobs LIFO and steals from the others FIFO.
+///          Threads are started once, so STL implementations pay for thread creation only at start-up.
+class ThreadPool {
+ public:
+  /// @brief Starts the workers for up to @p num_threads concurrent participants.
+  /// @details The default loop policy is read from PPC_SCHEDULE here, once per pool.
+  explicit ThreadPool(int num_threads);
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  /// @brief Runs the jobs still queued, then joins the workers.
+  ~ThreadPool();
+
+  /// @brief Largest number of threads that execute a ParallelFor() concurrently.
+  [[nodiscard]] int GetNumThreads() const {
+    return num_threads_;
+  }
+
+  /// @brief Policy of ParallelFor() calls that pass none.
+  [[nodiscard]] const SchedulePolicy &GetDefaultSchedulePolicy() const {
+    return default_policy_;
+  }
+
+  /// @brief Replaces the policy of ParallelFor() calls that pass none; not synchronised with running loops.
+  void SetDefaultSchedulePolicy(const SchedulePolicy &policy) {
+    default_policy_ = policy;
+  }
+
+  /// @brief Schedules @p job on a worker thread.
+  /// @return Future holding the result or the exception thrown by @p job.
+  template <typename Job>
+  auto Submit(Job &&job) -> std::future<std::invoke_result_t<std::decay_t<Job>>> {
+    using Result = std::invoke_result_t<std::decay_t<Job>>;
+    std::packaged_task<Result()> packaged(std::forward<Job>(job));
+    auto future = packaged.get_future();
+    Push([packaged = std::move(packaged)]() mutable { packaged(); });
+    return future;
+  }
+
+  /// @brief Calls @p body(i) for every i in [begin, end) on the calling thread and the workers.
+  /// @details Uses min(GetNumThreads(), ppc::util::GetNumThreads()) threads, so the thread count set for the
+  ///          current test is honoured. The calling thread takes part, which also makes nested calls safe.
+  ///          The first exception thrown by @p body is rethrown after all started iterations finish. Chunks
+  ///          follow GetDefaultSchedulePolicy().
+  template <typename Index, typename Body>
+  void ParallelFor(Index begin, Index end, Body &&body) {
+    ParallelFor(begin, end, std::forward<Body>(body), default_policy_);
+  }
+
+  /// @brief ParallelFor() with the chunking of @p policy.
+  /// @details Participants always take the next free chunk; the policy decides the chunks. kAuto makes four even
+  ///          chunks per thread, kStatic one, kDynamic chunks of grain_size (default 1) and kGuided chunks of the
+  ///          remaining iterations divided by the thread count, but never fewer than grain_size. A grain_size
+  ///          given with kAuto or kStatic replaces the even split with chunks of that size. The TBB partitioner is
+  ///          ignored.
+  template <typename Index, typename Body>
+  void ParallelFor(Index begin, Index end, Body &&body, const SchedulePolicy &policy) {
+    if (begin >= end) {
+      return;
+    }
+    const auto range = static_cast<std::uint64_t>(end - begin);
+    const auto participants = static_cast<std::uint64_t>(ActiveThreads());
+    ChunkPlan plan = PlanChunks(range, participants, policy);
+    const std::uint64_t num_chunks = plan.num_chunks;
+
+    auto state = std::make_shared<ParallelForState>();
+    state->num_chunks = num_chunks;
+    state->run_chunk = [begin, range, plan = std::move(plan), &body](std::uint64_t chunk) {
+      const auto [chunk_begin, chunk_end] = plan.Bounds(chunk, range);
+      const auto first = static_cast<Index>(begin + static_cast<Index>(chunk_begin));
+      const auto last = static_cast<Index>(begin + static_cast<Index>(chunk_end));
+      for (Index i = first; i < last; i++) {
+        body(i);
+      }
+    };
+
+    const std::uint64_t helpers = std::min(participants, num_chunks) - 1;
+    for (std::uint64_t helper = 0; helper < helpers; helper++) {
+      Push([state] { RunChunks(*state); });
+    }
+    RunChunks(*state);
+
+    std::unique_lock lock(state->mutex);
+    state->done.wait(lock, [&state] { return state->active == 0; });
+    if (state->error) {
+      std::rethrow_exception(state->error);
+    }
+  }
+
+ private:
+  using Job = std::move_only_function<void()>;
+
+  static constexpr std::uint64_t kChunksPerThread = 4;
+
+  /// Chunks of one ParallelFor(): an even split, fixed-size chunks, or explicit offsets for guided scheduling.
+  struct ChunkPlan {
+    std::uint64_t num_chunks = 0;
+    /// Iterations per chunk; 0 splits the range evenly into num_chunks.
+    std::uint64_t chunk_size = 0;
+    /// num_chunks + 1 chunk offsets, used when not empty.
+    std::vector<std::uint64_t> offsets;
+
+    [[nodiscard]] std::pair<std::uint64_t, std::uint64_t> Bounds(std::uint64_t chunk, std::uint64_t range) const {
+      if (!offsets.empty()) {
+        return {offsets[chunk], offsets[chunk + 1]};
+      }
+      if (chunk_size != 0) {
+        return {chunk * chunk_size, std::min(range, (chunk + 1) * chunk_size)};
+      }
+      return {chunk * range / num_chunks, (chunk + 1) * range / num_chunks};
+    }
+  };
+
+  static ChunkPlan PlanChunks(std::uint64_t range, std::uint64_t participants, const SchedulePolicy &policy);
+
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+  };
+
+  struct ParallelForState {
+    std::atomic<std::uint64_t> next_chunk{0};
+    std::uint64_t num_chunks = 0;
+    std::function<void(std::uint64_t)> run_chunk;
+    std::mutex mutex;
+    std::condition_variable done;
+    int active = 0;
+    std::exception_ptr error;
+  };
+
+  static void RunChunks(ParallelForState &state);
+
+  [[nodiscard]] int ActiveThreads() const;
+  void Push(Job job);
+  bool TryPop(std::size_t worker_index, Job &job);
+  void WorkerLoop(std::size_t worker_index);
+
+  int num_threads_;
+  SchedulePolicy default_policy_;
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<std::size_t> next_queue_{0};
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::int64_t pending_ = 0;
+  bool stopping_ = false;
+};
+
+/// @brief Returns the pool installed by the innermost ScopedThreadPool.
+/// @details Without one, a pool sized from GetNumThreads() is created on first use and kept until exit.
+ThreadPool &GetThreadPool();
+
+/// @brief Installs a ThreadPool as the process-wide pool for the current scope.
+/// @details Created by the test runners next to tbb::global_control, so the pool lives for the whole run.
+class ScopedThreadPool {
+ public:
+  explicit ScopedThreadPool(int num_threads);
+  ScopedThreadPool(const ScopedThreadPool &) = delete;
+  ScopedThreadPool &operator=(const ScopedThreadPool &) = delete;
+  ~ScopedThreadPool();
+
+ private:
+  ThreadPool pool_;
+  ThreadPool *previous_;
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstdint>
+#include <libenvpp/detail/environment.hpp>
+#include <optional>
+
+namespace ppc::util {
+
+/// @brief Placement of this MPI rank among the nodes of MPI_COMM_WORLD.
+struct NodeTopology {
+  int world_rank = 0;
+  int world_size = 1;
+  /// Index of this rank's node; nodes are numbered in the order of their lowest world rank
+  int node_index = 0;
+  int num_nodes = 1;
+  /// Rank among the ranks sharing this node, and their count
+  int local_rank = 0;
+  int local_size = 1;
+  /// CPUs the ranks of the node may run on together, from their affinity masks
+  int node_cpus = 1;
+  /// Ranks of this node; MPI_COMM_SELF when no topology is installed
+  MPI_Comm node_comm = MPI_COMM_SELF;
+};
+
+/// @brief How ScopedHybridTopology limits the threads of ranks that share a node, selected with PPC_THREAD_BUDGET.
+enum class ThreadBudgetMode : uint8_t {
+  /// Threads per rank are lowered so that the ranks of a node together do not exceed the CPUs they may run on
+  kAuto,
+  /// PPC_NUM_THREADS is used as given
+  kOff,
+};
+
+/// @brief Reads PPC_THREAD_BUDGET (auto or off); defaults to auto.
+/// @throws std::runtime_error If the variable holds another value.
+ThreadBudgetMode GetThreadBudgetMode();
+
+/// @brief Threads rank @p local_rank of @p local_size ranks may use on a node with @p node_cpus CPUs.
+/// @details The CPUs are shared out evenly, the first ranks taking the remainder. The budget never
+///          exceeds @p requested and is at least one.
+int ComputeThreadBudget(int requested, int node_cpus, int local_rank, int local_size);
+
+/// @brief Topology installed by the active ScopedHybridTopology, or a single-rank topology without one.
+const NodeTopology &GetNodeTopology();
+
+/// @brief Splits MPI_COMM_WORLD into node-local communicators and applies the per-rank thread budget.
+/// @details Collective over MPI_COMM_WORLD. Created by the MPI runners before TBB, OpenMP and the STL pool are
+///          configured: when several ranks share a node and PPC_NUM_THREADS oversubscribes it, PPC_NUM_THREADS and
+///          the OpenMP default are lowered to the rank's budget for the lifetime of the scope. Without MPI the
+///          scope describes a single rank and changes nothing. Scopes nest: the enclosing topology is reinstalled
+///          when an inner scope ends.
+class ScopedHybridTopology {
+ public:
+  /// @brief Applies the thread budget mode of PPC_THREAD_BUDGET.
+  /// @throws std::runtime_error If PPC_THREAD_BUDGET is invalid; it is read before anything is created.
+  ScopedHybridTopology();
+  explicit ScopedHybridTopology(ThreadBudgetMode mode);
+  ScopedHybridTopology(const ScopedHybridTopology &) = delete;
+  ScopedHybridTopology &operator=(const ScopedHybridTopology &) = delete;
+  ~ScopedHybridTopology();
+
+  [[nodiscard]] const NodeTopology &Topology() const {
+    return topology_;
+  }
+
+  /// @brief Threads per rank after the budget, i.e. GetNumThreads() while the scope is alive.
+  [[nodiscard]] int ThreadBudget() const {
+    return thread_budget_;
+  }
+
+ private:
+  NodeTopology topology_;
+  int thread_budget_ = 1;
+  int previous_omp_threads_ = 1;
+  std::optional<env::detail::set_scoped_environment_variable> budget_env_;
+  /// Topology of the enclosing scope, reinstalled when this one ends
+  const NodeTopology *previous_topology_ = nullptr;
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief One completed region recorded by TraceScope.
+/// @details @c name and @c category must outlive the trace, which string literals do.
+struct TraceEvent {
+  const char *name = "";
+  const char *category = "";
+  /// @brief Nanoseconds since the trace epoch of this process.
+  int64_t begin_ns = 0;
+  int64_t duration_ns = 0;
+  /// @brief Index of the recording thread in registration order.
+  std::size_t thread_index = 0;
+};
+
+/// @brief Returns true when regions are being recorded.
+/// @details Initialized from PPC_TRACE on first use; SetTraceEnabled() overrides it.
+bool TraceEnabled();
+
+void SetTraceEnabled(bool enabled);
+
+/// @brief Labels the calling thread in the exported trace, e.g. "ppc pool worker 2".
+void SetTraceThreadName(std::string name);
+
+/// @brief All events recorded so far, ordered by thread and then by completion.
+/// @details Must not race with threads that are still recording.
+std::vector<TraceEvent> CollectTraceEvents();
+
+/// @brief Drops all recorded events; thread registrations and names are kept.
+void ClearTrace();
+
+/// @brief Writes the recorded events as Chrome trace-event JSON, loadable in chrome://tracing and Perfetto.
+/// @param rank Becomes the process id of every event, so per-rank files can be opened side by side.
+void WriteTrace(const std::filesystem::path &path, int rank);
+
+/// @brief Trace file of @p rank: ppc_trace_rank<rank>.json under PPC_TEST_TMPDIR, or the system temp directory.
+/// @details Sharded runs append the shard index, e.g. ppc_trace_rank0_shard2.json.
+std::filesystem::path TraceFilePath(int rank);
+
+/// @brief Writes TraceFilePath(@p rank) when tracing is enabled and reports where it went.
+/// @details Call after all parallel work has finished, e.g. from the test runners before MPI_Finalize().
+void FlushTrace(int rank);
+
+/// @brief Records the lifetime of the current scope as one trace event.
+/// @details Each thread appends to its own buffer, so recording takes no lock; disabled tracing costs one relaxed
+///          atomic load.
+class TraceScope {
+ public:
+  explicit TraceScope(const char *name, const char *category = "region");
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+  ~TraceScope();
+
+ private:
+  const char *name_;
+  const char *category_;
+  int64_t begin_ns_ = -1;
+};
+
+}  // namespace ppc::util
@@ -8,11 +8,13 @@
 #include <cstdlib>
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <string_view>
 #include <system_error>
 #include <typeinfo>
+#include <vector>
 #ifdef __GNUG__
 #  include <cxxabi.h>
 #endif
@@ -91,11 +93,27 @@ enum class GTestParamIndex : uint8_t {
 
 std::string GetAbsoluteTaskPath(const std::string &id_path, const std::string &relative_path);
 int GetNumThreads();
+std::vector<int> GetPerfThreadSweep();
+
+/// @brief Slice of the GoogleTest cases run by this process when a suite is split across concurrent processes.
+struct TestShard {
+  int index = 0;
+  int total = 1;
+};
+
+/// @brief Shard from PPC_SHARD ("<index>/<total>", 0-based) or else from GTEST_SHARD_INDEX and GTEST_TOTAL_SHARDS.
+/// @return std::nullopt when the run is not sharded.
+/// @throws std::runtime_error If the value is malformed or the index is not below the total.
+std::optional<TestShard> GetTestShard();
 int GetNumProc();
 double GetTaskMaxTime();
 double GetPerfMaxTime();
 double GetTimeMPI();
 int GetMPIRank();
+/// @brief True between MPI_Init and MPI_Finalize.
+bool IsMpiActive();
+/// @brief Id of this process, e.g. to keep the temporary files of concurrent processes apart.
+int GetProcessId();
 void ConfigureMpiEnvironment();
 void SynchronizeMpiRanks();
 
@@ -126,6 +144,12 @@ inline std::shared_ptr<nlohmann::json> InitJSONPtr() {
   return std::make_shared<nlohmann::json>();
 }
 
+/// @brief Returns the parsed contents of a settings file, reading it at most once per process.
+/// @details The cache is keyed by path and thread-safe; a file is re-parsed only when its size or
+///          modification time changes. Parse failures are not cached.
+/// @throws std::runtime_error If the file cannot be opened.
+std::shared_ptr<const nlohmann::json> LoadSettingsJson(const std::string &settings_file_path);
+
 bool IsUnderMpirun();
 
 namespace test {
@@ -164,7 +188,9 @@ class ScopedPerTestEnv {
       return std::string{};
     };
     const std::string rank_suffix = IsUnderMpirun() ? make_rank_suffix() : std::string{};
-    const fs::path tmp = fs::temp_directory_path() / (std::string("ppc_test_") + token + rank_suffix);
+    const auto shard = GetTestShard();
+    const std::string shard_suffix = shard ? "_shard_" + std::to_string(shard->index) : std::string{};
+    const fs::path tmp = fs::temp_directory_path() / (std::string("ppc_test_") + token + rank_suffix + shard_suffix);
     std::error_code ec;
     fs::create_directories(tmp, ec);
     (void)ec;
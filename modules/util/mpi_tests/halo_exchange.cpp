@@ -0,0 +1,94 @@
+#include "util/include/halo_exchange.hpp"
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "util/include/decomposition.hpp"
+
+namespace {
+
+int WorldSize() {
+  int size = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  return size;
+}
+
+/// Value of the global cell (@p row, @p col), unique over the grid.
+int64_t CellValue(int64_t row, int64_t col) {
+  return (row * 1000) + col;
+}
+
+}  // namespace
+
+TEST(HaloExchangeRanks, FillsGhostsOf1dBlocksFromNeighbours) {
+  if (WorldSize() < 2) {
+    GTEST_SKIP() << "Needs at least two ranks";
+  }
+  constexpr int kGhost = 2;
+  const ppc::util::BlockDecomposition decomposition(MPI_COMM_WORLD, {5 * static_cast<int64_t>(WorldSize())});
+  const ppc::util::BlockRange local = decomposition.Local(0);
+  std::vector<int64_t> field(ppc::util::HaloExchange<int64_t>::PaddedSize(decomposition, kGhost), -1);
+  ppc::util::HaloExchange<int64_t> halo(decomposition, std::span(field), kGhost);
+
+  // The persistent requests are reused, so the second round must see the updated interior
+  for (int64_t round = 0; round < 2; round++) {
+    for (int64_t i = 0; i < local.count; i++) {
+      field[static_cast<std::size_t>(i + kGhost)] = CellValue(round, local.begin + i);
+    }
+    halo.Exchange();
+    for (int64_t g = 0; g < kGhost; g++) {
+      const int64_t lower = decomposition.Neighbor(0, -1) == MPI_PROC_NULL
+                                ? -1
+                                : CellValue(round, local.begin - kGhost + g);
+      const int64_t upper =
+          decomposition.Neighbor(0, 1) == MPI_PROC_NULL ? -1 : CellValue(round, local.End() + g);
+      EXPECT_EQ(field[static_cast<std::size_t>(g)], lower) << "round " << round << ", ghost " << g;
+      EXPECT_EQ(field[static_cast<std::size_t>(local.count + kGhost + g)], upper)
+          << "round " << round << ", ghost " << g;
+    }
+  }
+}
+
+TEST(HaloExchangeRanks, FillsFaceGhostsOf2dBlocksFromNeighbours) {
+  if (WorldSize() < 2) {
+    GTEST_SKIP() << "Needs at least two ranks";
+  }
+  const ppc::util::BlockDecomposition decomposition(MPI_COMM_WORLD, {12, 10});
+  const ppc::util::BlockRange rows = decomposition.Local(0);
+  const ppc::util::BlockRange cols = decomposition.Local(1);
+  const int64_t stride = cols.count + 2;
+  std::vector<int64_t> field(ppc::util::HaloExchange<int64_t>::PaddedSize(decomposition, 1), -1);
+  auto at = [&](int64_t row, int64_t col) -> int64_t & {
+    return field[static_cast<std::size_t>((row * stride) + col)];
+  };
+  for (int64_t r = 0; r < rows.count; r++) {
+    for (int64_t c = 0; c < cols.count; c++) {
+      at(r + 1, c + 1) = CellValue(rows.begin + r, cols.begin + c);
+    }
+  }
+
+  ppc::util::HaloExchange<int64_t> halo(decomposition, std::span(field));
+  halo.Exchange();
+
+  const bool has_above = decomposition.Neighbor(0, -1) != MPI_PROC_NULL;
+  const bool has_below = decomposition.Neighbor(0, 1) != MPI_PROC_NULL;
+  for (int64_t c = 0; c < cols.count; c++) {
+    EXPECT_EQ(at(0, c + 1), has_above ? CellValue(rows.begin - 1, cols.begin + c) : -1) << "column " << c;
+    EXPECT_EQ(at(rows.count + 1, c + 1), has_below ? CellValue(rows.End(), cols.begin + c) : -1) << "column " << c;
+  }
+  const bool has_left = decomposition.Neighbor(1, -1) != MPI_PROC_NULL;
+  const bool has_right = decomposition.Neighbor(1, 1) != MPI_PROC_NULL;
+  for (int64_t r = 0; r < rows.count; r++) {
+    EXPECT_EQ(at(r + 1, 0), has_left ? CellValue(rows.begin + r, cols.begin - 1) : -1) << "row " << r;
+    EXPECT_EQ(at(r + 1, cols.count + 1), has_right ? CellValue(rows.begin + r, cols.End()) : -1) << "row " << r;
+  }
+  // Corners are not part of a face exchange
+  EXPECT_EQ(at(0, 0), -1);
+  EXPECT_EQ(at(rows.count + 1, cols.count + 1), -1);
+}
@@ -0,0 +1,28 @@
+#include "util/include/node_shared.hpp"
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+TEST(NodeSharedRanks, EveryRankRejectsDataShorterOnRoot) {
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  // Only the root's data is read, so the other ranks pass none and must not wait for the root in the window
+  const std::vector<int> values(rank == 0 ? 3 : 0);
+  EXPECT_THROW(ppc::util::NodeSharedArray<int>(values, 4), std::runtime_error);
+}
+
+TEST(NodeSharedRanks, EveryRankSeesRootData) {
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  std::vector<double> values(rank == 0 ? 1000 : 0);
+  std::iota(values.begin(), values.end(), 0.5);
+  const ppc::util::NodeSharedArray<double> shared(values, 1000);
+  ASSERT_EQ(shared.View().size(), 1000U);
+  EXPECT_EQ(shared.View().front(), 0.5);
+  EXPECT_EQ(shared.View().back(), 999.5);
+}
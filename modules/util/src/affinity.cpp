@@ -0,0 +1,236 @@
+#include "util/include/affinity.hpp"
+
+#include <omp.h>
+#include <oneapi/tbb/task_arena.h>
+#include <oneapi/tbb/task_scheduler_observer.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <libenvpp/detail/get.hpp>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "util/include/topology.hpp"
+#include "util/include/util.hpp"
+
+#ifdef __linux__
+#  include <sched.h>
+#endif
+
+namespace {
+
+std::mutex affinity_mutex;
+std::vector<int> affinity_cpus;
+
+/// Parses a Linux cpulist such as "0-3,8,10-11".
+std::vector<int> ParseCpuList(const std::string &list) {
+  std::vector<int> cpus;
+  for (std::size_t start = 0; start < list.size();) {
+    const std::size_t separator = std::min(list.find(',', start), list.size());
+    const std::string range = list.substr(start, separator - start);
+    const std::size_t dash = range.find('-');
+    try {
+      const int first = std::stoi(range.substr(0, dash));
+      const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+      for (int cpu = first; cpu <= last; cpu++) {
+        cpus.push_back(cpu);
+      }
+    } catch (const std::exception &) {
+      return {};
+    }
+    start = separator + 1;
+  }
+  return cpus;
+}
+
+std::vector<int> GetAllowedCpus() {
+  std::vector<int> cpus;
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &set)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#endif
+  return cpus;
+}
+
+/// Binds the calling thread to the set @p cpus; false when pinning is unsupported, refused or @p cpus is empty.
+bool PinCurrentThreadToCpus(const std::vector<int> &cpus) {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (const int cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &set);
+    }
+  }
+  return CPU_COUNT(&set) > 0 && sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  (void)cpus;
+  return false;
+#endif
+}
+
+}  // namespace
+
+class ppc::util::ScopedThreadAffinity::TbbObserver final : public tbb::task_scheduler_observer {
+ public:
+  TbbObserver() {
+    observe(true);
+  }
+  TbbObserver(const TbbObserver &) = delete;
+  TbbObserver &operator=(const TbbObserver &) = delete;
+  ~TbbObserver() override {
+    observe(false);
+  }
+
+  void on_scheduler_entry(bool is_worker) override {
+    if (is_worker) {
+      PinCurrentThread(AffinityCpuForThread(tbb::this_task_arena::current_thread_index()));
+    }
+  }
+};
+
+ppc::util::AffinityPolicy ppc::util::GetAffinityPolicy() {
+  const auto policy = env::get<std::string>("PPC_AFFINITY");
+  if (!policy.has_value() || policy.value().empty() || policy.value() == "none") {
+    return AffinityPolicy::kNone;
+  }
+  if (policy.value() == "compact") {
+    return AffinityPolicy::kCompact;
+  }
+  if (policy.value() == "scatter") {
+    return AffinityPolicy::kScatter;
+  }
+  throw std::runtime_error("Invalid PPC_AFFINITY '" + policy.value() + "', expected none, compact or scatter");
+}
+
+std::vector<std::vector<int>> ppc::util::GetNumaNodeCpus() {
+  const std::vector<int> allowed = GetAllowedCpus();
+  std::vector<std::vector<int>> nodes;
+  const std::filesystem::path node_root("/sys/devices/system/node");
+  std::error_code error;
+  for (int node = 0; std::filesystem::exists(node_root / ("node" + std::to_string(node)), error); node++) {
+    std::ifstream file(node_root / ("node" + std::to_string(node)) / "cpulist");
+    std::string list;
+    std::getline(file, list);
+    std::vector<int> cpus;
+    std::ranges::copy_if(ParseCpuList(list), std::back_inserter(cpus),
+                         [&allowed](int cpu) { return std::ranges::find(allowed, cpu) != allowed.end(); });
+    if (!cpus.empty()) {
+      nodes.push_back(std::move(cpus));
+    }
+  }
+  if (nodes.empty() && !allowed.empty()) {
+    nodes.push_back(allowed);
+  }
+  return nodes;
+}
+
+std::vector<int> ppc::util::MakeAffinityCpuOrder(AffinityPolicy policy,
+                                                 const std::vector<std::vector<int>> &numa_nodes) {
+  std::vector<int> order;
+  if (policy == AffinityPolicy::kCompact) {
+    for (const auto &node : numa_nodes) {
+      order.insert(order.end(), node.begin(), node.end());
+    }
+  } else if (policy == AffinityPolicy::kScatter) {
+    std::size_t longest = 0;
+    for (const auto &node : numa_nodes) {
+      longest = std::max(longest, node.size());
+    }
+    for (std::size_t i = 0; i < longest; i++) {
+      for (const auto &node : numa_nodes) {
+        if (i < node.size()) {
+          order.push_back(node[i]);
+        }
+      }
+    }
+  }
+  return order;
+}
+
+bool ppc::util::PinCurrentThread(int cpu) {
+#ifdef __linux__
+  if (cpu < 0 || cpu >= CPU_SETSIZE) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  (void)cpu;
+  return false;
+#endif
+}
+
+int ppc::util::AffinityCpuForThread(int thread_index) {
+  const std::scoped_lock lock(affinity_mutex);
+  if (affinity_cpus.empty() || thread_index < 0) {
+    return -1;
+  }
+  return affinity_cpus[static_cast<std::size_t>(thread_index) % affinity_cpus.size()];
+}
+
+std::vector<int> ppc::util::GetAffinityCpus() {
+  const std::scoped_lock lock(affinity_mutex);
+  return affinity_cpus;
+}
+
+ppc::util::ScopedThreadAffinity::ScopedThreadAffinity(AffinityPolicy policy, int num_threads) {
+  num_threads = std::max(num_threads, 1);
+  if (policy == AffinityPolicy::kNone) {
+    return;
+  }
+  const std::vector<int> order = MakeAffinityCpuOrder(policy, GetNumaNodeCpus());
+  if (order.empty()) {
+    return;
+  }
+  const int local_rank = GetNodeTopology().local_rank;
+  const int local_size = GetNodeTopology().local_size;
+  // Split the order between ranks of a node; oversubscribed ranks wrap around instead of sharing one slice
+  const auto slice = std::max<std::size_t>(order.size() / static_cast<std::size_t>(local_size), 1);
+  std::vector<int> cpus;
+  for (std::size_t i = 0; i < std::min(static_cast<std::size_t>(num_threads), slice); i++) {
+    cpus.push_back(order[((static_cast<std::size_t>(local_rank) * slice) + i) % order.size()]);
+  }
+  {
+    const std::scoped_lock lock(affinity_mutex);
+    affinity_cpus = cpus;
+  }
+
+  // The calling thread keeps the whole slice, so threads it starts later (the STL pool) do not inherit one CPU
+  main_thread_cpus_ = GetAllowedCpus();
+#pragma omp parallel default(none) shared(cpus) num_threads(num_threads)
+  {
+    if (omp_get_thread_num() == 0) {
+      PinCurrentThreadToCpus(cpus);
+    } else {
+      PinCurrentThread(AffinityCpuForThread(omp_get_thread_num()));
+    }
+  }
+
+  tbb_observer_ = std::make_unique<TbbObserver>();
+}
+
+ppc::util::ScopedThreadAffinity::~ScopedThreadAffinity() {
+  tbb_observer_.reset();
+  PinCurrentThreadToCpus(main_thread_cpus_);
+  const std::scoped_lock lock(affinity_mutex);
+  affinity_cpus.clear();
+}
@@ -0,0 +1,103 @@
+#include "util/include/autotuner.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <libenvpp/detail/get.hpp>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include "task/include/task.hpp"
+#include "util/include/util.hpp"
+
+std::optional<std::string> ppc::util::GetAutotuneCachePath() {
+  const auto path = env::get<std::string>("PPC_AUTOTUNE_CACHE");
+  if (path.has_value() && !path.value().empty()) {
+    return path.value();
+  }
+  return std::nullopt;
+}
+
+std::size_t ppc::util::AutotuneSizeBucket(std::size_t size) {
+  return size == 0 ? 0 : static_cast<std::size_t>(std::bit_width(size) - 1);
+}
+
+ppc::util::AutotuneCache::AutotuneCache(std::string path) : path_(std::move(path)) {
+  if (path_.empty() || !std::filesystem::exists(path_)) {
+    return;
+  }
+  std::ifstream file(path_);
+  try {
+    const auto cache = nlohmann::json::parse(file);
+    for (const auto &[key, entry] : cache.at("choices").items()) {
+      AutotuneChoice choice;
+      choice.task = entry.at("task").get<std::string>();
+      choice.type = ppc::task::TypeOfTaskFromString(entry.at("type").get<std::string>());
+      choice.num_threads = entry.at("num_threads").get<int>();
+      choice.seconds = entry.at("seconds").get<double>();
+      choices_.emplace(key, std::move(choice));
+    }
+  } catch (const nlohmann::json::exception &e) {
+    throw std::runtime_error("Invalid autotuning cache " + path_ + ": " + e.what());
+  }
+}
+
+std::string ppc::util::AutotuneCache::Key(std::string_view tuner, std::size_t bucket) {
+  return std::string(tuner) + "/hw_threads:" + std::to_string(std::thread::hardware_concurrency()) +
+         "/bucket:" + std::to_string(bucket);
+}
+
+std::optional<ppc::util::AutotuneChoice> ppc::util::AutotuneCache::Find(std::string_view tuner,
+                                                                        std::size_t bucket) const {
+  const auto it = choices_.find(Key(tuner, bucket));
+  if (it == choices_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void ppc::util::AutotuneCache::Store(std::string_view tuner, std::size_t bucket, const AutotuneChoice &choice) {
+  choices_.insert_or_assign(Key(tuner, bucket), choice);
+  if (!path_.empty()) {
+    Save();
+  }
+}
+
+void ppc::util::AutotuneCache::Save() const {
+  nlohmann::json cache;
+  cache["choices"] = nlohmann::json::object();
+  for (const auto &[key, choice] : choices_) {
+    cache["choices"][key] = {{"task", choice.task},
+                             {"type", std::string(ppc::task::TypeOfTaskToString(choice.type))},
+                             {"num_threads", choice.num_threads},
+                             {"seconds", choice.seconds}};
+  }
+  // Written next to the cache and renamed, so concurrent readers never see a partial file
+  const std::filesystem::path target(path_);
+  // Suffixed with the process id, so that processes saving at the same time never write the same temporary
+  const std::filesystem::path temporary = target.string() + ".tmp." + std::to_string(GetProcessId());
+  {
+    std::ofstream file(temporary);
+    file << cache.dump(2) << '\n';
+    file.flush();
+    if (!file) {
+      std::error_code ignored;
+      std::filesystem::remove(temporary, ignored);
+      throw std::runtime_error("Cannot write autotuning cache " + temporary.string());
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(temporary, target, error);
+  if (error) {
+    std::error_code ignored;
+    std::filesystem::remove(temporary, ignored);
+    throw std::runtime_error("Cannot replace autotuning cache " + path_ + ": " + error.message());
+  }
+}
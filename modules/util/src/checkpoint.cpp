@@ -0,0 +1,338 @@
+#include "util/include/checkpoint.hpp"
+
+#include <mpi.h>
+
+#include <array>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <libenvpp/detail/get.hpp>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "util/include/util.hpp"
+
+namespace {
+
+constexpr std::array<char, 8> kMagic = {'P', 'P', 'C', 'C', 'K', 'P', 'T', '1'};
+
+/// Outcome of reading a checkpoint header, broadcast by rank 0.
+enum class HeaderStatus : int {
+  kUsable = 0,
+  kAbsent = 1,
+  kCorrupt = 2,
+};
+
+struct Header {
+  std::vector<std::uint64_t> sizes;
+  std::uint64_t header_bytes = 0;
+};
+
+void AppendU64(std::vector<std::byte> &out, std::uint64_t value) {
+  const auto *bytes = reinterpret_cast<const std::byte *>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(value));
+}
+
+/// Magic, rank count, fingerprint length and bytes, then one state size per rank.
+std::vector<std::byte> EncodeHeader(const std::string &fingerprint, const std::vector<std::uint64_t> &sizes) {
+  std::vector<std::byte> header;
+  const auto *magic = reinterpret_cast<const std::byte *>(kMagic.data());
+  header.insert(header.end(), magic, magic + kMagic.size());
+  AppendU64(header, sizes.size());
+  AppendU64(header, fingerprint.size());
+  const auto *text = reinterpret_cast<const std::byte *>(fingerprint.data());
+  header.insert(header.end(), text, text + fingerprint.size());
+  for (const std::uint64_t size : sizes) {
+    AppendU64(header, size);
+  }
+  return header;
+}
+
+bool ReadU64(std::ifstream &file, std::uint64_t &value) {
+  return static_cast<bool>(file.read(reinterpret_cast<char *>(&value), sizeof(value)));
+}
+
+/// Parses the header of @p path and checks that the file holds @p num_ranks states for @p fingerprint.
+HeaderStatus DecodeHeader(const std::string &path, const std::string &fingerprint, std::uint64_t num_ranks,
+                          Header &header) {
+  std::error_code error;
+  if (!std::filesystem::exists(path, error)) {
+    return HeaderStatus::kAbsent;
+  }
+  std::ifstream file(path, std::ios::binary);
+  std::array<char, kMagic.size()> magic{};
+  std::uint64_t stored_ranks = 0;
+  std::uint64_t fingerprint_size = 0;
+  if (!file.read(magic.data(), magic.size()) || magic != kMagic || !ReadU64(file, stored_ranks) ||
+      !ReadU64(file, fingerprint_size) || fingerprint_size > (std::uint64_t{1} << 20)) {
+    return HeaderStatus::kCorrupt;
+  }
+  std::string stored_fingerprint(fingerprint_size, '\0');
+  if (!file.read(stored_fingerprint.data(), static_cast<std::streamsize>(fingerprint_size))) {
+    return HeaderStatus::kCorrupt;
+  }
+  if (stored_ranks != num_ranks || stored_fingerprint != fingerprint) {
+    return HeaderStatus::kAbsent;
+  }
+  header.sizes.resize(num_ranks);
+  for (std::uint64_t &size : header.sizes) {
+    if (!ReadU64(file, size)) {
+      return HeaderStatus::kCorrupt;
+    }
+  }
+  header.header_bytes = static_cast<std::uint64_t>(file.tellg());
+  const std::uint64_t expected = std::accumulate(header.sizes.begin(), header.sizes.end(), header.header_bytes);
+  return std::filesystem::file_size(path, error) == expected && !error ? HeaderStatus::kUsable
+                                                                        : HeaderStatus::kCorrupt;
+}
+
+int WorldRank() {
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  return rank;
+}
+
+int WorldSize() {
+  int size = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  return size;
+}
+
+/// True on every rank if @p ok holds on every rank.
+bool AllRanksOk(bool ok) {
+  int local = ok ? 1 : 0;
+  int global = 0;
+  MPI_Allreduce(&local, &global, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  return global != 0;
+}
+
+/// Removes the temporary of a failed write, so that no partial checkpoint is left behind.
+void RemoveTemporary(const std::string &temporary) {
+  std::error_code error;
+  std::filesystem::remove(temporary, error);
+}
+
+void ReplaceFile(const std::string &temporary, const std::string &path) {
+  std::error_code error;
+  std::filesystem::rename(temporary, path, error);
+  if (error) {
+    RemoveTemporary(temporary);
+    throw std::runtime_error("Cannot replace checkpoint " + path + ": " + error.message());
+  }
+}
+
+void WriteLocalCheckpoint(const std::string &path, const std::string &fingerprint,
+                          std::span<const std::byte> local_state) {
+  const auto header = EncodeHeader(fingerprint, {local_state.size()});
+  const std::string temporary = path + ".tmp";
+  bool written = false;
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(header.data()), static_cast<std::streamsize>(header.size()));
+    file.write(reinterpret_cast<const char *>(local_state.data()), static_cast<std::streamsize>(local_state.size()));
+    file.flush();
+    written = static_cast<bool>(file);
+  }
+  if (!written) {
+    RemoveTemporary(temporary);
+    throw std::runtime_error("Cannot write checkpoint " + temporary);
+  }
+  ReplaceFile(temporary, path);
+}
+
+void WriteMpiCheckpoint(const std::string &path, const std::string &fingerprint,
+                        std::span<const std::byte> local_state) {
+  const int rank = WorldRank();
+  const std::uint64_t local_size = local_state.size();
+  std::vector<std::uint64_t> sizes(static_cast<std::size_t>(WorldSize()));
+  MPI_Allgather(&local_size, 1, MPI_UINT64_T, sizes.data(), 1, MPI_UINT64_T, MPI_COMM_WORLD);
+  const auto header = EncodeHeader(fingerprint, sizes);
+
+  // Rank 0 writes the header followed by its own state, the others only their states
+  std::vector<std::byte> payload;
+  if (rank == 0) {
+    payload = header;
+    payload.insert(payload.end(), local_state.begin(), local_state.end());
+  }
+  const std::span<const std::byte> written = rank == 0 ? std::span<const std::byte>(payload) : local_state;
+  std::uint64_t offset = 0;
+  MPI_Exscan(&local_size, &offset, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+  offset = rank == 0 ? 0 : header.size() + offset;
+  if (!AllRanksOk(written.size() <= static_cast<std::size_t>(INT_MAX))) {
+    throw std::runtime_error("Checkpoint state of a rank exceeds 2 GiB");
+  }
+
+  const std::string temporary = path + ".tmp";
+  MPI_File file = MPI_FILE_NULL;
+  const int open_result = MPI_File_open(MPI_COMM_WORLD, temporary.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                                        MPI_INFO_NULL, &file);
+  if (!AllRanksOk(open_result == MPI_SUCCESS)) {
+    if (open_result == MPI_SUCCESS) {
+      MPI_File_close(&file);
+    }
+    if (rank == 0) {
+      RemoveTemporary(temporary);
+    }
+    throw std::runtime_error("Cannot open checkpoint " + temporary);
+  }
+  const std::uint64_t total = std::accumulate(sizes.begin(), sizes.end(), std::uint64_t{header.size()});
+  int result = MPI_File_set_size(file, static_cast<MPI_Offset>(total));
+  if (result == MPI_SUCCESS) {
+    result = MPI_File_write_at_all(file, static_cast<MPI_Offset>(offset), written.data(),
+                                   static_cast<int>(written.size()), MPI_BYTE, MPI_STATUS_IGNORE);
+  }
+  MPI_File_close(&file);
+  if (!AllRanksOk(result == MPI_SUCCESS)) {
+    if (rank == 0) {
+      RemoveTemporary(temporary);
+    }
+    throw std::runtime_error("Cannot write checkpoint " + temporary);
+  }
+  bool replaced = true;
+  if (rank == 0) {
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    replaced = !error;
+    if (!replaced) {
+      RemoveTemporary(temporary);
+    }
+  }
+  if (!AllRanksOk(replaced)) {
+    throw std::runtime_error("Cannot replace checkpoint " + path);
+  }
+}
+
+std::optional<std::vector<std::byte>> ReadLocalCheckpoint(const std::string &path, const std::string &fingerprint) {
+  Header header;
+  const HeaderStatus status = DecodeHeader(path, fingerprint, 1, header);
+  if (status == HeaderStatus::kCorrupt) {
+    throw std::runtime_error("Corrupt checkpoint " + path);
+  }
+  if (status == HeaderStatus::kAbsent) {
+    return std::nullopt;
+  }
+  std::vector<std::byte> state(header.sizes.front());
+  std::ifstream file(path, std::ios::binary);
+  file.seekg(static_cast<std::streamoff>(header.header_bytes));
+  if (!file.read(reinterpret_cast<char *>(state.data()), static_cast<std::streamsize>(state.size()))) {
+    throw std::runtime_error("Corrupt checkpoint " + path);
+  }
+  return state;
+}
+
+std::optional<std::vector<std::byte>> ReadMpiCheckpoint(const std::string &path, const std::string &fingerprint) {
+  const int rank = WorldRank();
+  const int size = WorldSize();
+  Header header;
+  int status = static_cast<int>(HeaderStatus::kAbsent);
+  if (rank == 0) {
+    status = static_cast<int>(DecodeHeader(path, fingerprint, static_cast<std::uint64_t>(size), header));
+  }
+  MPI_Bcast(&status, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  if (status == static_cast<int>(HeaderStatus::kCorrupt)) {
+    throw std::runtime_error("Corrupt checkpoint " + path);
+  }
+  if (status == static_cast<int>(HeaderStatus::kAbsent)) {
+    return std::nullopt;
+  }
+  header.sizes.resize(static_cast<std::size_t>(size));
+  MPI_Bcast(header.sizes.data(), size, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+  MPI_Bcast(&header.header_bytes, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+
+  const auto local_size = header.sizes[static_cast<std::size_t>(rank)];
+  const std::uint64_t offset =
+      std::accumulate(header.sizes.begin(), header.sizes.begin() + rank, header.header_bytes);
+  std::vector<std::byte> state(local_size);
+  MPI_File file = MPI_FILE_NULL;
+  int result = MPI_File_open(MPI_COMM_WORLD, path.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file);
+  if (!AllRanksOk(result == MPI_SUCCESS)) {
+    if (result == MPI_SUCCESS) {
+      MPI_File_close(&file);
+    }
+    throw std::runtime_error("Cannot open checkpoint " + path);
+  }
+  result = MPI_File_read_at_all(file, static_cast<MPI_Offset>(offset), state.data(), static_cast<int>(state.size()),
+                                MPI_BYTE, MPI_STATUS_IGNORE);
+  MPI_File_close(&file);
+  if (!AllRanksOk(result == MPI_SUCCESS)) {
+    throw std::runtime_error("Cannot read checkpoint " + path);
+  }
+  return state;
+}
+
+}  // namespace
+
+double ppc::util::GetCheckpointInterval() {
+  const auto interval = env::get<double>("PPC_CHECKPOINT_INTERVAL");
+  return interval.has_value() && interval.value() > 0.0 ? interval.value() : 0.0;
+}
+
+std::string ppc::util::GetCheckpointDir() {
+  const auto dir = env::get<std::string>("PPC_CHECKPOINT_DIR");
+  if (dir.has_value() && !dir.value().empty()) {
+    return dir.value();
+  }
+  const auto uid = env::get<std::string>("PPC_TEST_UID");
+  const std::string token = uid.has_value() ? test::SanitizeToken(uid.value()) : std::string("default");
+  return (std::filesystem::temp_directory_path() / ("ppc_checkpoint_" + token)).string();
+}
+
+void ppc::util::WriteCheckpoint(const std::string &path, const std::string &fingerprint,
+                                std::span<const std::byte> local_state) {
+  const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+  if (!parent.empty() && (!IsMpiActive() || WorldRank() == 0)) {
+    std::error_code error;
+    std::filesystem::create_directories(parent, error);
+  }
+  if (!IsMpiActive()) {
+    WriteLocalCheckpoint(path, fingerprint, local_state);
+    return;
+  }
+  // The directory exists before any rank opens the file
+  MPI_Barrier(MPI_COMM_WORLD);
+  WriteMpiCheckpoint(path, fingerprint, local_state);
+}
+
+std::optional<std::vector<std::byte>> ppc::util::ReadCheckpoint(const std::string &path,
+                                                                const std::string &fingerprint) {
+  return IsMpiActive() ? ReadMpiCheckpoint(path, fingerprint) : ReadLocalCheckpoint(path, fingerprint);
+}
+
+ppc::util::Checkpointer::Checkpointer(const std::string &name, std::string fingerprint)
+    : path_((std::filesystem::path(GetCheckpointDir()) / (test::SanitizeToken(name) + ".ckpt")).string()),
+      fingerprint_(std::move(fingerprint)),
+      interval_(GetCheckpointInterval()) {}
+
+bool ppc::util::Checkpointer::Due() const {
+  int due = std::chrono::duration<double>(std::chrono::steady_clock::now() - last_checkpoint_).count() >= interval_
+                ? 1
+                : 0;
+  if (IsMpiActive()) {
+    MPI_Bcast(&due, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  }
+  return due != 0;
+}
+
+void ppc::util::Checkpointer::Complete() {
+  if (!Enabled()) {
+    return;
+  }
+  if (IsMpiActive()) {
+    MPI_Barrier(MPI_COMM_WORLD);
+  }
+  if (!IsMpiActive() || WorldRank() == 0) {
+    std::error_code error;
+    std::filesystem::remove(path_, error);
+  }
+}
@@ -0,0 +1,132 @@
+#include "util/include/clock.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <libenvpp/detail/get.hpp>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#  include <cpuid.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#  include <array>
+#endif
+
+namespace {
+
+using ppc::util::ClockSource;
+using ppc::util::detail::ReadClockTicks;
+
+constexpr uint64_t kCalibrationNanoseconds = 2'000'000;
+constexpr int kOverheadReads = 1000;
+
+/// Monotonic nanoseconds the TSC rate is measured against.
+uint64_t ReferenceNanoseconds() {
+  return ReadClockTicks(ClockSource::kMonotonicRaw);
+}
+
+/// A tick count and the reference time it was taken at.
+struct BracketedReading {
+  uint64_t ticks = 0;
+  double reference_ns = 0.0;
+};
+
+/// Reads @p source between two reference readings and takes their midpoint as its reference time.
+BracketedReading ReadBracketed(ClockSource source) {
+  const uint64_t before = ReferenceNanoseconds();
+  const uint64_t ticks = ReadClockTicks(source);
+  const uint64_t after = ReferenceNanoseconds();
+  return {.ticks = ticks, .reference_ns = 0.5 * static_cast<double>(before + after)};
+}
+
+double MeasureSecondsPerTick(ClockSource source) {
+  if (source == ClockSource::kMonotonicRaw) {
+    return 1e-9;
+  }
+  const BracketedReading begin = ReadBracketed(source);
+  BracketedReading end = begin;
+  while (end.reference_ns - begin.reference_ns < static_cast<double>(kCalibrationNanoseconds)) {
+    end = ReadBracketed(source);
+  }
+  return (end.reference_ns - begin.reference_ns) * 1e-9 / static_cast<double>(end.ticks - begin.ticks);
+}
+
+uint64_t SmallestTickStep(ClockSource source) {
+  uint64_t smallest = std::numeric_limits<uint64_t>::max();
+  uint64_t previous = ReadClockTicks(source);
+  for (int i = 0; i < kOverheadReads; i++) {
+    const uint64_t current = ReadClockTicks(source);
+    if (current > previous) {
+      smallest = std::min(smallest, current - previous);
+    }
+    previous = current;
+  }
+  return smallest == std::numeric_limits<uint64_t>::max() ? 1 : smallest;
+}
+
+}  // namespace
+
+std::string_view ppc::util::ClockSourceToString(ClockSource source) {
+  return source == ClockSource::kTsc ? "tsc" : "monotonic_raw";
+}
+
+bool ppc::util::InvariantTscAvailable() {
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+  unsigned int eax = 0;
+  unsigned int ebx = 0;
+  unsigned int ecx = 0;
+  unsigned int edx = 0;
+  if (__get_cpuid(0x80000000U, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007U) {
+    return false;
+  }
+  __get_cpuid(0x80000007U, &eax, &ebx, &ecx, &edx);
+  return (edx & (1U << 8U)) != 0;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  std::array<int, 4> info{};
+  __cpuid(info.data(), static_cast<int>(0x80000000U));
+  if (static_cast<unsigned int>(info[0]) < 0x80000007U) {
+    return false;
+  }
+  __cpuid(info.data(), static_cast<int>(0x80000007U));
+  return (info[3] & (1 << 8)) != 0;
+#else
+  return false;
+#endif
+}
+
+ppc::util::ClockSource ppc::util::GetClockSource() {
+  const auto source = env::get<std::string>("PPC_CLOCK");
+  if (!source.has_value() || source.value().empty()) {
+    return InvariantTscAvailable() ? ClockSource::kTsc : ClockSource::kMonotonicRaw;
+  }
+  if (source.value() == "monotonic_raw") {
+    return ClockSource::kMonotonicRaw;
+  }
+  if (source.value() == "tsc") {
+    if (!InvariantTscAvailable()) {
+      throw std::runtime_error("PPC_CLOCK=tsc but the CPU does not report an invariant TSC");
+    }
+    return ClockSource::kTsc;
+  }
+  throw std::runtime_error("Invalid PPC_CLOCK '" + source.value() + "', expected tsc or monotonic_raw");
+}
+
+ppc::util::ClockCalibration ppc::util::detail::CalibrateClock(ClockSource source) {
+  ClockCalibration calibration;
+  calibration.source = source;
+  calibration.seconds_per_tick = MeasureSecondsPerTick(source);
+  calibration.resolution = static_cast<double>(SmallestTickStep(source)) * calibration.seconds_per_tick;
+
+  // rdtsc and clock_gettime() are opaque to the optimizer, so the loop is not elided
+  const uint64_t begin = ReadClockTicks(source);
+  for (int i = 0; i < kOverheadReads; i++) {
+    (void)ReadClockTicks(source);
+  }
+  const uint64_t end = ReadClockTicks(source);
+  calibration.overhead =
+      static_cast<double>(end - begin) * calibration.seconds_per_tick / static_cast<double>(kOverheadReads + 1);
+  calibration.origin_ticks = ReadClockTicks(source);
+  return calibration;
+}
@@ -0,0 +1,180 @@
+#include "util/include/data_loader.hpp"
+
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+
+#include "util/include/util.hpp"
+
+#if defined(__linux__) || defined(__APPLE__)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#  define PPC_HAS_MMAP 1
+#endif
+
+namespace {
+
+struct CachedMapping {
+  std::filesystem::file_time_type write_time;
+  std::uintmax_t size = 0;
+  std::shared_ptr<const ppc::util::MappedFile> file;
+};
+
+std::mutex cache_mutex;
+std::unordered_map<std::string, CachedMapping> cache;
+
+/// Reads one whitespace-separated header token of a PNM file, skipping '#' comments.
+std::string NextPnmToken(std::span<const std::byte> bytes, std::size_t &pos) {
+  auto at = [&](std::size_t i) -> char { return static_cast<char>(bytes[i]); };
+  while (pos < bytes.size()) {
+    if (std::isspace(static_cast<unsigned char>(at(pos))) != 0) {
+      pos++;
+    } else if (at(pos) == '#') {
+      while (pos < bytes.size() && at(pos) != '\n') {
+        pos++;
+      }
+    } else {
+      break;
+    }
+  }
+  std::string token;
+  while (pos < bytes.size() && std::isspace(static_cast<unsigned char>(at(pos))) == 0) {
+    token.push_back(at(pos++));
+  }
+  return token;
+}
+
+int ParsePnmNumber(const std::string &token) {
+  if (token.empty() || token.size() > 9 || token.find_first_not_of("0123456789") != std::string::npos) {
+    throw std::runtime_error("Malformed PNM header value: '" + token + "'");
+  }
+  return std::stoi(token);
+}
+
+}  // namespace
+
+ppc::util::MappedFile::MappedFile(std::string path) : path_(std::move(path)) {
+#ifdef PPC_HAS_MMAP
+  const int fd = open(path_.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open " + path_);
+  }
+  struct stat info{};
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    throw std::runtime_error("Failed to stat " + path_);
+  }
+  size_ = static_cast<std::size_t>(info.st_size);
+  if (size_ > 0) {
+    void *address = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address == MAP_FAILED) {
+      close(fd);
+      throw std::runtime_error("Failed to map " + path_);
+    }
+    data_ = static_cast<const std::byte *>(address);
+    mapped_ = true;
+  }
+  close(fd);
+#else
+  std::ifstream file(path_, std::ios::binary | std::ios::ate);
+  if (!file) {
+    throw std::runtime_error("Failed to open " + path_);
+  }
+  size_ = static_cast<std::size_t>(file.tellg());
+  auto *buffer = new std::byte[size_ == 0 ? 1 : size_];
+  file.seekg(0);
+  file.read(reinterpret_cast<char *>(buffer), static_cast<std::streamsize>(size_));
+  data_ = buffer;
+  if (!file) {
+    delete[] buffer;
+    throw std::runtime_error("Failed to read " + path_);
+  }
+#endif
+}
+
+ppc::util::MappedFile::~MappedFile() {
+#ifdef PPC_HAS_MMAP
+  if (mapped_) {
+    munmap(const_cast<std::byte *>(data_), size_);
+  }
+#else
+  delete[] data_;
+#endif
+}
+
+std::shared_ptr<const ppc::util::MappedFile> ppc::util::MapDataFile(const std::string &path) {
+  std::error_code ec;
+  const auto write_time = std::filesystem::last_write_time(path, ec);
+  const bool has_time = !ec;
+  const auto size = std::filesystem::file_size(path, ec);
+  const bool cacheable = has_time && !ec;
+
+  const std::scoped_lock lock(cache_mutex);
+  if (cacheable) {
+    const auto it = cache.find(path);
+    if (it != cache.end() && it->second.write_time == write_time && it->second.size == size) {
+      return it->second.file;
+    }
+  }
+  auto file = std::make_shared<const MappedFile>(path);
+  if (cacheable) {
+    cache.insert_or_assign(path, CachedMapping{.write_time = write_time, .size = size, .file = file});
+  }
+  return file;
+}
+
+std::shared_ptr<const ppc::util::MappedFile> ppc::util::MapTaskData(const std::string &id_path,
+                                                                    const std::string &relative_path) {
+  return MapDataFile(GetAbsoluteTaskPath(id_path, relative_path));
+}
+
+void ppc::util::ClearDataFileCache() {
+  const std::scoped_lock lock(cache_mutex);
+  cache.clear();
+}
+
+ppc::util::ImageView ppc::util::ParsePnm(std::span<const std::byte> bytes) {
+  std::size_t pos = 0;
+  const std::string magic = NextPnmToken(bytes, pos);
+  int channels = 0;
+  if (magic == "P6") {
+    channels = 3;
+  } else if (magic == "P5") {
+    channels = 1;
+  } else {
+    throw std::runtime_error("Unsupported PNM format: '" + magic + "'");
+  }
+  const int width = ParsePnmNumber(NextPnmToken(bytes, pos));
+  const int height = ParsePnmNumber(NextPnmToken(bytes, pos));
+  const int max_value = ParsePnmNumber(NextPnmToken(bytes, pos));
+  if (max_value <= 0 || max_value > 255) {
+    throw std::runtime_error("Only 8-bit PNM images are supported");
+  }
+  // Exactly one whitespace byte separates the header from the pixels
+  pos++;
+  const auto pixel_bytes = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) *
+                           static_cast<std::size_t>(channels);
+  if (pos > bytes.size() || bytes.size() - pos < pixel_bytes) {
+    throw std::runtime_error("PNM pixel data is truncated");
+  }
+  const auto *pixels = reinterpret_cast<const uint8_t *>(bytes.data() + pos);
+  return {.width = width, .height = height, .channels = channels, .pixels = {pixels, pixel_bytes}};
+}
+
+ppc::util::MappedImage ppc::util::MapTaskImage(const std::string &id_path, const std::string &relative_path) {
+  auto file = MapTaskData(id_path, relative_path);
+  const ImageView image = ParsePnm(file->Bytes());
+  return {.file = std::move(file), .image = image};
+}
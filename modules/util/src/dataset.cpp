@@ -0,0 +1,305 @@
+#include "util/include/dataset.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "util/include/decomposition.hpp"
+#include "util/include/thread_pool.hpp"
+#include "util/include/util.hpp"
+
+#if defined(__linux__) || defined(__APPLE__)
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+namespace {
+
+static_assert(std::endian::native == std::endian::little, "Dataset files are little-endian");
+
+constexpr std::array<char, 8> kMagic = {'P', 'P', 'C', 'D', 'S', 'E', 'T', '\0'};
+constexpr uint64_t kDataAlignment = 64;
+constexpr uint32_t kMaxDimensions = 32;
+/// Largest piece handed to one MPI-IO call, whose count is an int.
+constexpr std::size_t kMaxIoBytes = std::size_t{1} << 30;
+
+template <typename T>
+void WriteValue(std::ofstream &file, const T &value) {
+  file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+T ReadValue(std::ifstream &file, const std::string &path) {
+  T value{};
+  if (!file.read(reinterpret_cast<char *>(&value), sizeof(T))) {
+    throw std::runtime_error("Dataset header of " + path + " is truncated");
+  }
+  return value;
+}
+
+uint64_t HeaderBytes(std::size_t dimensions, std::size_t chunks) {
+  return kMagic.size() + (4 * sizeof(uint32_t)) + (dimensions * sizeof(uint64_t)) + (2 * sizeof(uint64_t)) +
+         (chunks * 3 * sizeof(uint64_t));
+}
+
+/// Reads @p out.size() bytes at @p offset; safe to call from several threads at once.
+void ReadAt(const std::string &path, uint64_t offset, std::span<std::byte> out) {
+#if defined(__linux__) || defined(__APPLE__)
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  std::size_t done = 0;
+  while (done < out.size()) {
+    const ssize_t got = pread(fd, out.data() + done, out.size() - done, static_cast<off_t>(offset + done));
+    if (got <= 0) {
+      close(fd);
+      throw std::runtime_error("Failed to read " + path);
+    }
+    done += static_cast<std::size_t>(got);
+  }
+  close(fd);
+#else
+  std::ifstream file(path, std::ios::binary);
+  file.seekg(static_cast<std::streamoff>(offset));
+  if (!file.read(reinterpret_cast<char *>(out.data()), static_cast<std::streamsize>(out.size()))) {
+    throw std::runtime_error("Failed to read " + path);
+  }
+#endif
+}
+
+}  // namespace
+
+std::size_t ppc::util::DatasetTypeSize(DatasetType type) {
+  switch (type) {
+    case DatasetType::kInt8:
+    case DatasetType::kUInt8:
+      return 1;
+    case DatasetType::kInt32:
+    case DatasetType::kUInt32:
+    case DatasetType::kFloat32:
+      return 4;
+    case DatasetType::kInt64:
+    case DatasetType::kUInt64:
+    case DatasetType::kFloat64:
+      return 8;
+  }
+  throw std::runtime_error("Unknown dataset element type");
+}
+
+uint64_t ppc::util::DatasetHeader::NumElements() const {
+  uint64_t count = shape.empty() ? 0 : 1;
+  for (const uint64_t extent : shape) {
+    count *= extent;
+  }
+  return count;
+}
+
+uint64_t ppc::util::DatasetChecksum(std::span<const std::byte> bytes) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (const std::byte byte : bytes) {
+    hash ^= static_cast<uint64_t>(byte);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+void ppc::util::WriteDatasetBytes(const std::string &path, DatasetType type, std::span<const std::byte> data,
+                                  const std::vector<uint64_t> &shape, uint64_t chunk_elements) {
+  DatasetHeader header{.type = type, .shape = shape, .chunk_elements = chunk_elements, .chunks = {}};
+  const std::size_t element_size = DatasetTypeSize(type);
+  if (shape.empty() || shape.size() > kMaxDimensions || header.NumElements() * element_size != data.size()) {
+    throw std::runtime_error("Dataset shape does not match the data written to " + path);
+  }
+  if (chunk_elements == 0) {
+    throw std::runtime_error("Dataset chunks must hold at least one element");
+  }
+  const uint64_t num_chunks = (header.NumElements() + chunk_elements - 1) / chunk_elements;
+  const uint64_t data_offset =
+      (HeaderBytes(shape.size(), num_chunks) + kDataAlignment - 1) / kDataAlignment * kDataAlignment;
+  uint64_t offset = data_offset;
+  for (uint64_t chunk = 0; chunk < num_chunks; chunk++) {
+    const uint64_t begin = chunk * chunk_elements * element_size;
+    const uint64_t bytes = std::min<uint64_t>(chunk_elements * element_size, data.size() - begin);
+    header.chunks.push_back({.offset = offset, .bytes = bytes, .checksum = DatasetChecksum(data.subspan(begin, bytes))});
+    offset += bytes;
+  }
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  file.write(kMagic.data(), kMagic.size());
+  WriteValue(file, DatasetHeader::kVersion);
+  WriteValue(file, static_cast<uint32_t>(type));
+  WriteValue(file, static_cast<uint32_t>(shape.size()));
+  WriteValue(file, uint32_t{0});
+  for (const uint64_t extent : shape) {
+    WriteValue(file, extent);
+  }
+  WriteValue(file, chunk_elements);
+  WriteValue(file, num_chunks);
+  for (const DatasetChunk &chunk : header.chunks) {
+    WriteValue(file, chunk.offset);
+    WriteValue(file, chunk.bytes);
+    WriteValue(file, chunk.checksum);
+  }
+  const std::vector<char> padding(data_offset - HeaderBytes(shape.size(), num_chunks), 0);
+  file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+  file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+  if (!file) {
+    throw std::runtime_error("Failed to write " + path);
+  }
+}
+
+ppc::util::DatasetReader::DatasetReader(std::string path, bool verify_checksums)
+    : path_(std::move(path)), verify_checksums_(verify_checksums) {
+  std::ifstream file(path_, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Failed to open " + path_);
+  }
+  std::array<char, kMagic.size()> magic{};
+  file.read(magic.data(), magic.size());
+  if (!file || magic != kMagic) {
+    throw std::runtime_error(path_ + " is not a dataset file");
+  }
+  if (ReadValue<uint32_t>(file, path_) != DatasetHeader::kVersion) {
+    throw std::runtime_error("Unsupported dataset version in " + path_);
+  }
+  header_.type = static_cast<DatasetType>(ReadValue<uint32_t>(file, path_));
+  const std::size_t element_size = DatasetTypeSize(header_.type);
+  const auto dimensions = ReadValue<uint32_t>(file, path_);
+  ReadValue<uint32_t>(file, path_);
+  if (dimensions == 0 || dimensions > kMaxDimensions) {
+    throw std::runtime_error("Corrupt dataset shape in " + path_);
+  }
+  for (uint32_t dim = 0; dim < dimensions; dim++) {
+    header_.shape.push_back(ReadValue<uint64_t>(file, path_));
+  }
+  header_.chunk_elements = ReadValue<uint64_t>(file, path_);
+  const auto num_chunks = ReadValue<uint64_t>(file, path_);
+  const uint64_t num_elements = header_.NumElements();
+  if (header_.chunk_elements == 0 || num_chunks != (num_elements + header_.chunk_elements - 1) / header_.chunk_elements) {
+    throw std::runtime_error("Corrupt dataset chunk table in " + path_);
+  }
+
+  std::error_code ec;
+  const auto file_size = std::filesystem::file_size(path_, ec);
+  uint64_t expected_offset = 0;
+  for (uint64_t chunk = 0; chunk < num_chunks; chunk++) {
+    DatasetChunk entry{.offset = ReadValue<uint64_t>(file, path_),
+                       .bytes = ReadValue<uint64_t>(file, path_),
+                       .checksum = ReadValue<uint64_t>(file, path_)};
+    const uint64_t elements = std::min(header_.chunk_elements, num_elements - (chunk * header_.chunk_elements));
+    const bool contiguous = chunk == 0 || entry.offset == expected_offset;
+    if (entry.bytes != elements * element_size || !contiguous || (!ec && entry.offset + entry.bytes > file_size)) {
+      throw std::runtime_error("Corrupt dataset chunk table in " + path_);
+    }
+    expected_offset = entry.offset + entry.bytes;
+    header_.chunks.push_back(entry);
+  }
+}
+
+std::size_t ppc::util::DatasetReader::ChunkRangeBytes(std::size_t first_chunk, std::size_t num_chunks) const {
+  if (first_chunk + num_chunks > header_.chunks.size()) {
+    throw std::runtime_error("Chunk range is outside of dataset " + path_);
+  }
+  std::size_t bytes = 0;
+  for (std::size_t chunk = first_chunk; chunk < first_chunk + num_chunks; chunk++) {
+    bytes += header_.chunks[chunk].bytes;
+  }
+  return bytes;
+}
+
+void ppc::util::DatasetReader::VerifyChunks(std::size_t first_chunk, std::size_t num_chunks,
+                                            std::span<const std::byte> data) const {
+  if (!verify_checksums_) {
+    return;
+  }
+  std::size_t offset = 0;
+  for (std::size_t chunk = first_chunk; chunk < first_chunk + num_chunks; chunk++) {
+    const DatasetChunk &entry = header_.chunks[chunk];
+    if (DatasetChecksum(data.subspan(offset, entry.bytes)) != entry.checksum) {
+      throw std::runtime_error("Checksum mismatch in chunk " + std::to_string(chunk) + " of " + path_);
+    }
+    offset += entry.bytes;
+  }
+}
+
+void ppc::util::DatasetReader::ReadChunksBytes(std::size_t first_chunk, std::size_t num_chunks,
+                                               std::span<std::byte> out) const {
+  if (out.size() != ChunkRangeBytes(first_chunk, num_chunks)) {
+    throw std::runtime_error("Output buffer does not match the chunk range of " + path_);
+  }
+  if (num_chunks == 0) {
+    return;
+  }
+  const uint64_t range_begin = header_.chunks[first_chunk].offset;
+  GetThreadPool().ParallelFor(0, static_cast<int>(num_chunks), [&](int index) {
+    const DatasetChunk &entry = header_.chunks[first_chunk + static_cast<std::size_t>(index)];
+    const std::span<std::byte> target = out.subspan(entry.offset - range_begin, entry.bytes);
+    ReadAt(path_, entry.offset, target);
+    if (verify_checksums_ && DatasetChecksum(target) != entry.checksum) {
+      throw std::runtime_error("Checksum mismatch in chunk " + std::to_string(first_chunk + index) + " of " + path_);
+    }
+  });
+}
+
+void ppc::util::DatasetReader::LocalChunkRange(MPI_Comm comm, std::size_t &first_chunk, std::size_t &num_chunks,
+                                               std::size_t &bytes) const {
+  int rank = 0;
+  int size = 1;
+  if (IsMpiActive()) {
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+  }
+  const BlockRange block = BlockPartition(static_cast<int64_t>(header_.chunks.size()), size, rank);
+  first_chunk = static_cast<std::size_t>(block.begin);
+  num_chunks = static_cast<std::size_t>(block.count);
+  bytes = ChunkRangeBytes(first_chunk, num_chunks);
+}
+
+void ppc::util::DatasetReader::ReadChunksCollective(MPI_Comm comm, std::size_t first_chunk, std::size_t num_chunks,
+                                                    std::span<std::byte> out) const {
+  if (!IsMpiActive()) {
+    ReadChunksBytes(first_chunk, num_chunks, out);
+    return;
+  }
+  MPI_File file = MPI_FILE_NULL;
+  if (MPI_File_open(comm, path_.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file) != MPI_SUCCESS) {
+    throw std::runtime_error("MPI-IO failed to open " + path_);
+  }
+  const uint64_t begin = num_chunks == 0 ? 0 : header_.chunks[first_chunk].offset;
+  // read_at_all is collective, so every rank issues as many calls as the rank with the largest slice
+  unsigned long long local_pieces = (out.size() + kMaxIoBytes - 1) / kMaxIoBytes;
+  unsigned long long pieces = local_pieces;
+  MPI_Allreduce(&local_pieces, &pieces, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, comm);
+  int status = MPI_SUCCESS;
+  for (unsigned long long piece = 0; piece < pieces; piece++) {
+    const std::size_t offset = std::min<std::size_t>(piece * kMaxIoBytes, out.size());
+    const std::size_t count = std::min(kMaxIoBytes, out.size() - offset);
+    const int res = MPI_File_read_at_all(file, static_cast<MPI_Offset>(begin + offset), out.data() + offset,
+                                         static_cast<int>(count), MPI_BYTE, MPI_STATUS_IGNORE);
+    if (res != MPI_SUCCESS) {
+      status = res;
+    }
+  }
+  MPI_File_close(&file);
+  if (status != MPI_SUCCESS) {
+    throw std::runtime_error("MPI-IO failed to read " + path_);
+  }
+  VerifyChunks(first_chunk, num_chunks, out);
+}
@@ -0,0 +1,59 @@
+#include "util/include/decomposition.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "util/include/util.hpp"
+
+ppc::util::BlockDecomposition::BlockDecomposition(MPI_Comm comm, std::vector<int64_t> extents, std::vector<int> dims)
+    : extents_(std::move(extents)), dims_(std::move(dims)) {
+  const std::size_t ndims = extents_.size();
+  if (ndims == 0) {
+    throw std::runtime_error("Block decomposition needs at least one dimension");
+  }
+  if (dims_.empty()) {
+    dims_.assign(ndims, 0);
+  }
+  if (dims_.size() != ndims) {
+    throw std::runtime_error("Block decomposition got a process count for every dimension but one");
+  }
+  coords_.assign(ndims, 0);
+  lower_.assign(ndims, MPI_PROC_NULL);
+  upper_.assign(ndims, MPI_PROC_NULL);
+  if (!IsMpiActive()) {
+    dims_.assign(ndims, 1);
+    return;
+  }
+
+  int size = 1;
+  MPI_Comm_size(comm, &size);
+  int fixed = 1;
+  for (const int count : dims_) {
+    fixed *= count > 0 ? count : 1;
+  }
+  if (size % fixed != 0 || (std::ranges::find(dims_, 0) == dims_.end() && fixed != size)) {
+    throw std::runtime_error("Process counts per dimension do not fit a communicator of " + std::to_string(size));
+  }
+  MPI_Dims_create(size, static_cast<int>(ndims), dims_.data());
+  const std::vector<int> periods(ndims, 0);
+  MPI_Cart_create(comm, static_cast<int>(ndims), dims_.data(), periods.data(), 0, &cart_comm_);
+  int rank = 0;
+  MPI_Comm_rank(cart_comm_, &rank);
+  MPI_Cart_coords(cart_comm_, rank, static_cast<int>(ndims), coords_.data());
+  for (std::size_t dim = 0; dim < ndims; dim++) {
+    MPI_Cart_shift(cart_comm_, static_cast<int>(dim), 1, &lower_[dim], &upper_[dim]);
+  }
+}
+
+ppc::util::BlockDecomposition::~BlockDecomposition() {
+  if (cart_comm_ != MPI_COMM_NULL && IsMpiActive()) {
+    MPI_Comm_free(&cart_comm_);
+  }
+}
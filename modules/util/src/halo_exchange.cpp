@@ -0,0 +1,143 @@
+#include "util/include/halo_exchange.hpp"
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "util/include/decomposition.hpp"
+#include "util/include/util.hpp"
+
+namespace {
+
+/// Tag of a message travelling along @p dim towards lower or higher indices.
+int DirectionTag(int dim, bool towards_upper) {
+  return (2 * dim) + (towards_upper ? 1 : 0);
+}
+
+}  // namespace
+
+ppc::util::HaloExchangeBytes::HaloExchangeBytes(const BlockDecomposition &decomposition, std::byte *field,
+                                                std::size_t element_size, int ghost)
+    : comm_(decomposition.Comm()) {
+  const int ndims = decomposition.NumDims();
+  if (ndims > 2) {
+    throw std::runtime_error("Halo exchange supports 1D and 2D decompositions");
+  }
+  if (ghost < 1) {
+    throw std::runtime_error("Halo exchange needs at least one ghost cell");
+  }
+  for (int dim = 0; dim < ndims; dim++) {
+    if (decomposition.Local(dim).count < ghost) {
+      throw std::runtime_error("Local block is thinner than the ghost width");
+    }
+  }
+  if (comm_ == MPI_COMM_NULL || !IsMpiActive()) {
+    return;
+  }
+  try {
+    CreateFaces(decomposition, field, element_size, ghost);
+  } catch (...) {
+    Release();
+    throw;
+  }
+}
+
+void ppc::util::HaloExchangeBytes::CreateFaces(const BlockDecomposition &decomposition, std::byte *field,
+                                               std::size_t element_size, int ghost) {
+  const int ndims = decomposition.NumDims();
+  // At most three types and eight requests, so recording a created handle never reallocates
+  types_.reserve(3);
+  requests_.reserve(8);
+  MPI_Datatype element = MPI_DATATYPE_NULL;
+  MPI_Type_contiguous(static_cast<int>(element_size), MPI_BYTE, &element);
+  types_.push_back(element);
+  const auto g = static_cast<int64_t>(ghost);
+  const auto es = static_cast<int64_t>(element_size);
+
+  if (ndims == 1) {
+    const int64_t length = decomposition.Local(0).count;
+    MPI_Datatype face = MPI_DATATYPE_NULL;
+    MPI_Type_contiguous(ghost, element, &face);
+    MPI_Type_commit(&face);
+    types_.push_back(face);
+    AddFace(face, field + (g * es), field, decomposition.Neighbor(0, -1), DirectionTag(0, false),
+            DirectionTag(0, true));
+    AddFace(face, field + (length * es), field + ((length + g) * es), decomposition.Neighbor(0, 1),
+            DirectionTag(0, true), DirectionTag(0, false));
+    return;
+  }
+
+  const int64_t rows = decomposition.Local(0).count;
+  const int64_t cols = decomposition.Local(1).count;
+  const int64_t stride = cols + (2 * g);
+  auto at = [&](int64_t row, int64_t col) { return field + (((row * stride) + col) * es); };
+  MPI_Datatype row_face = MPI_DATATYPE_NULL;
+  MPI_Type_vector(ghost, static_cast<int>(cols), static_cast<int>(stride), element, &row_face);
+  MPI_Type_commit(&row_face);
+  types_.push_back(row_face);
+  MPI_Datatype col_face = MPI_DATATYPE_NULL;
+  MPI_Type_vector(static_cast<int>(rows), ghost, static_cast<int>(stride), element, &col_face);
+  MPI_Type_commit(&col_face);
+  types_.push_back(col_face);
+
+  AddFace(row_face, at(g, g), at(0, g), decomposition.Neighbor(0, -1), DirectionTag(0, false), DirectionTag(0, true));
+  AddFace(row_face, at(rows, g), at(rows + g, g), decomposition.Neighbor(0, 1), DirectionTag(0, true),
+          DirectionTag(0, false));
+  AddFace(col_face, at(g, g), at(g, 0), decomposition.Neighbor(1, -1), DirectionTag(1, false), DirectionTag(1, true));
+  AddFace(col_face, at(g, cols), at(g, cols + g), decomposition.Neighbor(1, 1), DirectionTag(1, true),
+          DirectionTag(1, false));
+}
+
+void ppc::util::HaloExchangeBytes::AddFace(MPI_Datatype face, std::byte *send, std::byte *recv, int neighbor,
+                                           int send_tag, int recv_tag) {
+  if (neighbor == MPI_PROC_NULL) {
+    return;
+  }
+  MPI_Request &send_request = requests_.emplace_back(MPI_REQUEST_NULL);
+  MPI_Send_init(send, 1, face, neighbor, send_tag, comm_, &send_request);
+  MPI_Request &recv_request = requests_.emplace_back(MPI_REQUEST_NULL);
+  MPI_Recv_init(recv, 1, face, neighbor, recv_tag, comm_, &recv_request);
+}
+
+void ppc::util::HaloExchangeBytes::Start() {
+  if (started_) {
+    throw std::runtime_error("Halo exchange started twice without Wait()");
+  }
+  if (!requests_.empty()) {
+    MPI_Startall(static_cast<int>(requests_.size()), requests_.data());
+  }
+  started_ = true;
+}
+
+void ppc::util::HaloExchangeBytes::Wait() {
+  if (!started_) {
+    return;
+  }
+  if (!requests_.empty()) {
+    MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(), MPI_STATUSES_IGNORE);
+  }
+  started_ = false;
+}
+
+ppc::util::HaloExchangeBytes::~HaloExchangeBytes() {
+  if (!IsMpiActive()) {
+    return;
+  }
+  Wait();
+  Release();
+}
+
+void ppc::util::HaloExchangeBytes::Release() {
+  for (MPI_Request &request : requests_) {
+    if (request != MPI_REQUEST_NULL) {
+      MPI_Request_free(&request);
+    }
+  }
+  requests_.clear();
+  for (MPI_Datatype &type : types_) {
+    MPI_Type_free(&type);
+  }
+  types_.clear();
+}
@@ -0,0 +1,132 @@
+#include "util/include/hardware_counters.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <libenvpp/detail/get.hpp>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#ifdef __linux__
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef __linux__
+int OpenPerfEvent(ppc::util::HardwareEvent event, pid_t thread) {
+  perf_event_attr attr{};
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof(attr);
+  switch (event) {
+    case ppc::util::HardwareEvent::kCycles:
+      attr.config = PERF_COUNT_HW_CPU_CYCLES;
+      break;
+    case ppc::util::HardwareEvent::kInstructions:
+      attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+      break;
+    case ppc::util::HardwareEvent::kCacheMisses:
+      attr.config = PERF_COUNT_HW_CACHE_MISSES;
+      break;
+    case ppc::util::HardwareEvent::kBranchMisses:
+      attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+      break;
+  }
+  attr.disabled = 1;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, thread, -1, -1, 0));
+}
+
+/// Thread ids of this process; only the calling thread when /proc is not mounted.
+std::vector<pid_t> ListProcessThreads() {
+  std::vector<pid_t> threads;
+  std::error_code error;
+  for (const auto &entry : std::filesystem::directory_iterator("/proc/self/task", error)) {
+    try {
+      threads.push_back(static_cast<pid_t>(std::stoi(entry.path().filename().string())));
+    } catch (const std::exception &) {
+      continue;
+    }
+  }
+  if (threads.empty()) {
+    threads.push_back(0);
+  }
+  return threads;
+}
+#endif
+
+}  // namespace
+
+bool ppc::util::HardwareCountersEnabled() {
+  const auto enabled = env::get<int>("PPC_PERF_COUNTERS");
+  return enabled.has_value() && enabled.value() != 0;
+}
+
+ppc::util::HardwareCounters::HardwareCounters() {
+#ifdef __linux__
+  // inherit only reaches threads created after the event is opened, so workers that already exist get their own
+  for (const pid_t thread : ListProcessThreads()) {
+    auto &thread_fds = fds_.emplace_back();
+    for (std::size_t i = 0; i < kNumHardwareEvents; i++) {
+      thread_fds[i] = OpenPerfEvent(static_cast<HardwareEvent>(i), thread);
+    }
+  }
+#endif
+}
+
+ppc::util::HardwareCounters::~HardwareCounters() {
+#ifdef __linux__
+  for (const auto &thread_fds : fds_) {
+    for (const int fd : thread_fds) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+  }
+#endif
+}
+
+bool ppc::util::HardwareCounters::IsAvailable() const {
+  return std::ranges::any_of(fds_, [](const auto &thread_fds) {
+    return std::ranges::any_of(thread_fds, [](int fd) { return fd >= 0; });
+  });
+}
+
+void ppc::util::HardwareCounters::Start() {
+#ifdef __linux__
+  for (const auto &thread_fds : fds_) {
+    for (const int fd : thread_fds) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+  }
+#endif
+}
+
+void ppc::util::HardwareCounters::Stop() {
+#ifdef __linux__
+  for (const auto &thread_fds : fds_) {
+    for (std::size_t i = 0; i < kNumHardwareEvents; i++) {
+      if (thread_fds[i] < 0) {
+        continue;
+      }
+      ioctl(thread_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+      uint64_t value = 0;
+      if (read(thread_fds[i], &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value))) {
+        totals_[i] += value;
+      }
+    }
+  }
+#endif
+}
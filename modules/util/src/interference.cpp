@@ -0,0 +1,194 @@
+#include "util/include/interference.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <libenvpp/detail/get.hpp>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "util/include/clock.hpp"
+#include "util/include/util.hpp"
+
+namespace {
+
+constexpr int kTrials = 3;
+constexpr uint64_t kCoreSteps = uint64_t{1} << 20;
+
+std::optional<ppc::util::InterferenceSample> quiet_reference;
+
+/// Seconds of the fastest of kTrials runs of @p kernel.
+template <typename Kernel>
+double BestTime(const Kernel &kernel) {
+  double best = std::numeric_limits<double>::infinity();
+  for (int trial = 0; trial < kTrials; trial++) {
+    const double begin = ppc::util::ClockNow();
+    kernel();
+    best = std::min(best, ppc::util::ClockNow() - begin);
+  }
+  return best;
+}
+
+double MeasureTriadBandwidth(std::size_t elements) {
+  // Kept between probes so that only the first one pays for page faults
+  static std::vector<double> a;
+  static std::vector<double> b;
+  static std::vector<double> c;
+  if (a.size() != elements) {
+    a.assign(elements, 0.0);
+    b.assign(elements, 1.0);
+    c.assign(elements, 2.0);
+  }
+  const double seconds = BestTime([] {
+    for (std::size_t i = 0; i < a.size(); i++) {
+      a[i] = b[i] + (3.0 * c[i]);
+    }
+  });
+  if (a[elements / 2] != 7.0 || seconds <= 0.0) {
+    return 0.0;
+  }
+  return 3.0 * sizeof(double) * static_cast<double>(elements) / seconds;
+}
+
+double MeasureCoreSteps() {
+  // Every step depends on the previous one, so the rate follows the core clock rather than the memory system
+  volatile uint64_t seed = 1;
+  volatile uint64_t sink = 0;
+  const double seconds = BestTime([&seed, &sink] {
+    uint64_t value = seed;
+    for (uint64_t step = 0; step < kCoreSteps; step++) {
+      value = (value * 6364136223846793005ULL) + 1442695040888963407ULL;
+    }
+    sink = value;
+  });
+  return seconds > 0.0 ? static_cast<double>(kCoreSteps) / seconds : 0.0;
+}
+
+void WriteCgroupFile(const std::filesystem::path &path, const std::string &value) {
+  std::ofstream file(path);
+  file << value << '\n';
+  file.flush();
+  if (!file) {
+    throw std::runtime_error("Cannot write '" + value + "' to " + path.string());
+  }
+}
+
+}  // namespace
+
+ppc::util::InterferenceMode ppc::util::GetInterferenceMode() {
+  const auto mode = env::get<std::string>("PPC_PERF_INTERFERENCE");
+  if (!mode.has_value() || mode.value().empty() || mode.value() == "off") {
+    return InterferenceMode::kOff;
+  }
+  if (mode.value() == "record") {
+    return InterferenceMode::kRecord;
+  }
+  if (mode.value() == "pause") {
+    return InterferenceMode::kPause;
+  }
+  throw std::runtime_error("Invalid PPC_PERF_INTERFERENCE '" + mode.value() + "', expected off, record or pause");
+}
+
+double ppc::util::GetInterferenceThreshold() {
+  const auto threshold = env::get<double>("PPC_PERF_INTERFERENCE_THRESHOLD");
+  if (!threshold.has_value()) {
+    return 0.1;
+  }
+  if (threshold.value() <= 0.0 || threshold.value() >= 1.0) {
+    throw std::runtime_error("PPC_PERF_INTERFERENCE_THRESHOLD must be between 0 and 1");
+  }
+  return threshold.value();
+}
+
+int ppc::util::GetInterferenceRetries() {
+  const auto retries = env::get<int>("PPC_PERF_INTERFERENCE_RETRIES");
+  if (!retries.has_value()) {
+    return 3;
+  }
+  if (retries.value() < 0) {
+    throw std::runtime_error("PPC_PERF_INTERFERENCE_RETRIES must not be negative");
+  }
+  return retries.value();
+}
+
+ppc::util::InterferenceSample ppc::util::MeasureInterferenceSample(std::size_t stream_elements) {
+  if (stream_elements == 0) {
+    throw std::runtime_error("Interference probe needs at least one element");
+  }
+  InterferenceSample sample;
+  sample.bytes_per_second = MeasureTriadBandwidth(stream_elements);
+  sample.core_steps_per_second = MeasureCoreSteps();
+  return sample;
+}
+
+double ppc::util::InterferenceSlowdown(const InterferenceSample &sample, const InterferenceSample &reference) {
+  double slowdown = 0.0;
+  if (reference.bytes_per_second > 0.0) {
+    slowdown = std::max(slowdown, 1.0 - (sample.bytes_per_second / reference.bytes_per_second));
+  }
+  if (reference.core_steps_per_second > 0.0) {
+    slowdown = std::max(slowdown, 1.0 - (sample.core_steps_per_second / reference.core_steps_per_second));
+  }
+  return slowdown;
+}
+
+ppc::util::InterferenceProbe ppc::util::ProbeInterference() {
+  const bool mpi_active = IsMpiActive();
+  if (mpi_active) {
+    // Ranks probe together, so that each sees the load of the others as it will during the benchmark
+    MPI_Barrier(MPI_COMM_WORLD);
+  }
+  InterferenceProbe probe;
+  probe.sample = MeasureInterferenceSample();
+  if (!quiet_reference) {
+    quiet_reference = probe.sample;
+  }
+  quiet_reference->bytes_per_second = std::max(quiet_reference->bytes_per_second, probe.sample.bytes_per_second);
+  quiet_reference->core_steps_per_second =
+      std::max(quiet_reference->core_steps_per_second, probe.sample.core_steps_per_second);
+  probe.slowdown = InterferenceSlowdown(probe.sample, *quiet_reference);
+  if (mpi_active) {
+    MPI_Allreduce(MPI_IN_PLACE, &probe.slowdown, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  }
+  return probe;
+}
+
+std::optional<ppc::util::InterferenceSample> ppc::util::GetInterferenceReference() {
+  return quiet_reference;
+}
+
+std::optional<std::string> ppc::util::GetPerfCgroup() {
+  const auto cgroup = env::get<std::string>("PPC_PERF_CGROUP");
+  if (!cgroup.has_value() || cgroup.value().empty()) {
+    return std::nullopt;
+  }
+  return cgroup.value();
+}
+
+std::string ppc::util::JoinCgroup(const std::string &cgroup, const std::string &cpus) {
+#ifdef __linux__
+  const std::filesystem::path root(cgroup);
+  if (!std::filesystem::exists(root / "cgroup.procs")) {
+    throw std::runtime_error("PPC_PERF_CGROUP '" + cgroup + "' is not a cgroup v2 directory");
+  }
+  if (!cpus.empty()) {
+    WriteCgroupFile(root / "cpuset.cpus", cpus);
+  }
+  // cgroup v2 moves every thread of the process, including those MPI has already started
+  WriteCgroupFile(root / "cgroup.procs", "0");
+  std::ifstream effective(root / "cpuset.cpus.effective");
+  std::string list;
+  std::getline(effective, list);
+  return list;
+#else
+  (void)cpus;
+  throw std::runtime_error("PPC_PERF_CGROUP '" + cgroup + "' is set, but cgroups exist only on Linux");
+#endif
+}
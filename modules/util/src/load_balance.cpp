@@ -0,0 +1,102 @@
+#include "util/include/load_balance.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace {
+
+struct BusyRegistry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<std::atomic<int64_t>>> busy_ns;
+};
+
+BusyRegistry &GetRegistry() {
+  static BusyRegistry registry;
+  return registry;
+}
+
+/// The counter is written by its own thread only and read by trackers on other threads.
+std::atomic<int64_t> &CurrentThreadBusyNs() {
+  thread_local std::atomic<int64_t> *busy_ns = nullptr;
+  if (busy_ns == nullptr) {
+    BusyRegistry &registry = GetRegistry();
+    const std::scoped_lock lock(registry.mutex);
+    busy_ns = registry.busy_ns.emplace_back(std::make_unique<std::atomic<int64_t>>(0)).get();
+  }
+  return *busy_ns;
+}
+
+int64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+ppc::util::ScopedBusyTime::ScopedBusyTime() : begin_ns_(NowNs()) {}
+
+ppc::util::ScopedBusyTime::~ScopedBusyTime() {
+  CurrentThreadBusyNs().fetch_add(NowNs() - begin_ns_, std::memory_order_relaxed);
+}
+
+std::vector<double> ppc::util::GetThreadBusyTimes() {
+  BusyRegistry &registry = GetRegistry();
+  const std::scoped_lock lock(registry.mutex);
+  std::vector<double> times;
+  times.reserve(registry.busy_ns.size());
+  for (const auto &busy_ns : registry.busy_ns) {
+    times.push_back(static_cast<double>(busy_ns->load(std::memory_order_relaxed)) * 1e-9);
+  }
+  return times;
+}
+
+ppc::util::LoadImbalance ppc::util::ComputeLoadImbalance(std::span<const double> times) {
+  LoadImbalance imbalance;
+  if (times.empty()) {
+    return imbalance;
+  }
+  const auto [min, max] = std::ranges::minmax_element(times);
+  imbalance.min = *min;
+  imbalance.max = *max;
+  double sum = 0.0;
+  for (const double time : times) {
+    sum += time;
+  }
+  imbalance.mean = sum / static_cast<double>(times.size());
+  if (imbalance.mean > 0.0) {
+    imbalance.factor = imbalance.max / imbalance.mean;
+  }
+  return imbalance;
+}
+
+void ppc::util::LoadBalanceTracker::Start() {
+  start_busy_ = GetThreadBusyTimes();
+}
+
+void ppc::util::LoadBalanceTracker::Stop(double run_time) {
+  const std::vector<double> now = GetThreadBusyTimes();
+  busy_.resize(std::max(busy_.size(), now.size()), 0.0);
+  for (std::size_t thread = 0; thread < now.size(); thread++) {
+    const double start = thread < start_busy_.size() ? start_busy_[thread] : 0.0;
+    busy_[thread] += now[thread] - start;
+  }
+  run_time_ += run_time;
+  runs_++;
+}
+
+std::vector<double> ppc::util::LoadBalanceTracker::ThreadBusyTimes() const {
+  std::vector<double> busy;
+  for (const double time : busy_) {
+    if (time > 0.0) {
+      busy.push_back(time);
+    }
+  }
+  return busy;
+}
@@ -0,0 +1,216 @@
+#include "util/include/memory_tracking.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <libenvpp/detail/get.hpp>
+#include <new>
+#include <string>
+
+#if defined(__linux__) || defined(__APPLE__)
+#  include <sys/resource.h>
+#  include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef PPC_ALLOCATION_COUNTER
+std::atomic<uint64_t> allocation_count{0};
+std::atomic<uint64_t> allocation_bytes{0};
+
+void CountAllocation(std::size_t size) noexcept {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void *CountedAllocate(std::size_t size) noexcept {
+  CountAllocation(size);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void *CountedAllocateAligned(std::size_t size, std::align_val_t alignment) noexcept {
+  CountAllocation(size);
+  const auto align = static_cast<std::size_t>(alignment);
+  const std::size_t rounded = ((size == 0 ? 1 : size) + align - 1) / align * align;
+#  ifdef _WIN32
+  return _aligned_malloc(rounded, align);
+#  else
+  return std::aligned_alloc(align, rounded);
+#  endif
+}
+
+void AlignedFree(void *ptr) noexcept {
+#  ifdef _WIN32
+  _aligned_free(ptr);
+#  else
+  std::free(ptr);
+#  endif
+}
+#endif
+
+#ifdef __linux__
+/// Reads a "Name:   <value> kB" line from /proc/self/status.
+uint64_t ReadProcStatusKb(const std::string &name) {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.starts_with(name + ":")) {
+      return std::strtoull(line.c_str() + name.size() + 1, nullptr, 10) * 1024;
+    }
+  }
+  return 0;
+}
+
+/// Resets VmHWM to the current RSS; supported since Linux 4.0.
+bool ResetPeakRss() {
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  clear_refs << "5";
+  return clear_refs.good();
+}
+#endif
+
+}  // namespace
+
+#ifdef PPC_ALLOCATION_COUNTER
+void *operator new(std::size_t size) {
+  if (void *ptr = CountedAllocate(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) {
+  if (void *ptr = CountedAllocate(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t & /*tag*/) noexcept {
+  return CountedAllocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t & /*tag*/) noexcept {
+  return CountedAllocate(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  if (void *ptr = CountedAllocateAligned(size, alignment)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  if (void *ptr = CountedAllocateAligned(size, alignment)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t /*alignment*/) noexcept {
+  AlignedFree(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t /*alignment*/) noexcept {
+  AlignedFree(ptr);
+}
+
+void operator delete(void *ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+  AlignedFree(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+  AlignedFree(ptr);
+}
+#endif
+
+bool ppc::util::AllocationCounterEnabled() {
+#ifdef PPC_ALLOCATION_COUNTER
+  return true;
+#else
+  return false;
+#endif
+}
+
+ppc::util::AllocationStats ppc::util::GetAllocationStats() {
+#ifdef PPC_ALLOCATION_COUNTER
+  return {.count = allocation_count.load(std::memory_order_relaxed),
+          .bytes = allocation_bytes.load(std::memory_order_relaxed)};
+#else
+  return {};
+#endif
+}
+
+uint64_t ppc::util::GetCurrentRssBytes() {
+#ifdef __linux__
+  std::ifstream statm("/proc/self/statm");
+  uint64_t size_pages = 0;
+  uint64_t resident_pages = 0;
+  if (statm >> size_pages >> resident_pages) {
+    return resident_pages * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  }
+#endif
+  return 0;
+}
+
+uint64_t ppc::util::GetPeakRssBytes() {
+#ifdef __linux__
+  if (const uint64_t peak = ReadProcStatusKb("VmHWM"); peak > 0) {
+    return peak;
+  }
+#endif
+#if defined(__linux__) || defined(__APPLE__)
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#  ifdef __APPLE__
+    return static_cast<uint64_t>(usage.ru_maxrss);
+#  else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#  endif
+  }
+#endif
+  return 0;
+}
+
+bool ppc::util::MemoryTrackingEnabled() {
+  const auto enabled = env::get<int>("PPC_PERF_MEMORY");
+  return enabled.has_value() && enabled.value() != 0;
+}
+
+void ppc::util::MemoryTracker::Start() {
+#ifdef __linux__
+  ResetPeakRss();
+#endif
+  start_rss_bytes_ = std::max(GetCurrentRssBytes(), GetPeakRssBytes());
+  start_allocations_ = GetAllocationStats();
+}
+
+void ppc::util::MemoryTracker::Stop() {
+  const AllocationStats now = GetAllocationStats();
+  allocations_.count += now.count - start_allocations_.count;
+  allocations_.bytes += now.bytes - start_allocations_.bytes;
+  const uint64_t peak = GetPeakRssBytes();
+  if (peak > start_rss_bytes_) {
+    peak_rss_delta_bytes_ = std::max(peak_rss_delta_bytes_, peak - start_rss_bytes_);
+  }
+}
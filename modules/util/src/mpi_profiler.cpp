@@ -0,0 +1,287 @@
+#include "util/include/mpi_profiler.hpp"
+
+#include <mpi.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+using ppc::util::kNumMpiCalls;
+using ppc::util::kNumProfiledStages;
+using ppc::util::MpiCall;
+
+constexpr int kNoStage = -1;
+
+std::atomic<int> current_stage{kNoStage};
+
+struct AtomicCallStats {
+  std::atomic<uint64_t> calls{0};
+  std::atomic<uint64_t> bytes{0};
+  std::atomic<uint64_t> nanoseconds{0};
+};
+
+std::array<std::array<AtomicCallStats, kNumMpiCalls>, kNumProfiledStages> profile;
+
+#ifdef PPC_MPI_PROFILER
+uint64_t TypeBytes(int count, MPI_Datatype datatype) {
+  int size = 0;
+  PMPI_Type_size(datatype, &size);
+  return count > 0 && size > 0 ? static_cast<uint64_t>(count) * static_cast<uint64_t>(size) : 0;
+}
+
+uint64_t SumBytes(const int counts[], MPI_Datatype datatype, MPI_Comm comm) {
+  int size = 0;
+  PMPI_Comm_size(comm, &size);
+  uint64_t total = 0;
+  for (int i = 0; i < size; i++) {
+    total += TypeBytes(counts[i], datatype);
+  }
+  return total;
+}
+
+bool IsRoot(int root, MPI_Comm comm) {
+  int rank = 0;
+  PMPI_Comm_rank(comm, &rank);
+  return rank == root;
+}
+
+/// Times one intercepted call and attributes it to the current stage.
+class CallRecorder {
+ public:
+  explicit CallRecorder(MpiCall call) : stage_(current_stage.load(std::memory_order_relaxed)), call_(call) {
+    if (stage_ != kNoStage) {
+      begin_ = PMPI_Wtime();
+    }
+  }
+  CallRecorder(const CallRecorder &) = delete;
+  CallRecorder &operator=(const CallRecorder &) = delete;
+  ~CallRecorder() {
+    if (stage_ == kNoStage) {
+      return;
+    }
+    auto &stats = profile[static_cast<std::size_t>(stage_)][static_cast<std::size_t>(call_)];
+    stats.calls.fetch_add(1, std::memory_order_relaxed);
+    stats.bytes.fetch_add(bytes_, std::memory_order_relaxed);
+    stats.nanoseconds.fetch_add(static_cast<uint64_t>((PMPI_Wtime() - begin_) * 1e9), std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] bool Active() const {
+    return stage_ != kNoStage;
+  }
+
+  void AddBytes(uint64_t bytes) {
+    bytes_ += bytes;
+  }
+
+ private:
+  int stage_;
+  MpiCall call_;
+  double begin_ = 0.0;
+  uint64_t bytes_ = 0;
+};
+#endif
+
+}  // namespace
+
+bool ppc::util::MpiProfilerEnabled() {
+#ifdef PPC_MPI_PROFILER
+  return true;
+#else
+  return false;
+#endif
+}
+
+void ppc::util::ResetMpiProfile() {
+  for (auto &stage : profile) {
+    for (auto &stats : stage) {
+      stats.calls.store(0, std::memory_order_relaxed);
+      stats.bytes.store(0, std::memory_order_relaxed);
+      stats.nanoseconds.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+ppc::util::MpiCallStats ppc::util::GetMpiCallStats(ProfiledStage stage, MpiCall call) {
+  const auto &stats = profile[static_cast<std::size_t>(stage)][static_cast<std::size_t>(call)];
+  return {.calls = stats.calls.load(std::memory_order_relaxed),
+          .bytes = stats.bytes.load(std::memory_order_relaxed),
+          .time = static_cast<double>(stats.nanoseconds.load(std::memory_order_relaxed)) * 1e-9};
+}
+
+ppc::util::ScopedMpiProfileStage::ScopedMpiProfileStage(ProfiledStage stage)
+    : previous_stage_(current_stage.exchange(static_cast<int>(stage))) {}
+
+ppc::util::ScopedMpiProfileStage::~ScopedMpiProfileStage() {
+  current_stage.store(previous_stage_);
+}
+
+#ifdef PPC_MPI_PROFILER
+int MPI_Send(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  CallRecorder recorder(MpiCall::kSend);
+  if (recorder.Active()) {
+    recorder.AddBytes(TypeBytes(count, datatype));
+  }
+  return PMPI_Send(buf, count, datatype, dest, tag, comm);
+}
+
+int MPI_Recv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm, MPI_Status *status) {
+  CallRecorder recorder(MpiCall::kRecv);
+  if (recorder.Active()) {
+    recorder.AddBytes(TypeBytes(count, datatype));
+  }
+  return PMPI_Recv(buf, count, datatype, source, tag, comm, status);
+}
+
+int MPI_Isend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+              MPI_Request *request) {
+  CallRecorder recorder(MpiCall::kIsend);
+  if (recorder.Active()) {
+    recorder.AddBytes(TypeBytes(count, datatype));
+  }
+  return PMPI_Isend(buf, count, datatype, dest, tag, comm, request);
+}
+
+int MPI_Irecv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm,
+              MPI_Request *request) {
+  CallRecorder recorder(MpiCall::kIrecv);
+  if (recorder.Active()) {
+    recorder.AddBytes(TypeBytes(count, datatype));
+  }
+  return PMPI_Irecv(buf, count, datatype, source, tag, comm, request);
+}
+
+int MPI_Wait(MPI_Request *request, MPI_Status *status) {
+  const CallRecorder recorder(MpiCall::kWait);
+  return PMPI_Wait(request, status);
+}
+
+int MPI_Waitall(int count, MPI_Request array_of_requests[], MPI_Status *array_of_statuses) {
+  const CallRecorder recorder(MpiCall::kWaitall);
+  return PMPI_Waitall(count, array_of_requests, array_of_statuses);
+}
+
+int MPI_Sendrecv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, int dest, int sendtag, void *recvbuf,
+                 int recvcount, MPI_Datatype recvtype, int source, int recvtag, MPI_Comm comm, MPI_Status *status) {
+  CallRecorder recorder(MpiCall::kSendrecv);
+  if (recorder.Active()) {
+    recorder.AddBytes(TypeBytes(sendcount, sendtype) + TypeBytes(recvcount, recvtype));
+  }
+  return PMPI_Sendrecv(sendbuf, sendcount, sendtype, dest, sendtag, recvbuf, recvcount, recvtype, source, recvtag,
+                       comm, status);
+}
+
+int MPI_Bcast(void *buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm) {
+  CallRecorder recorder(MpiCall::kBcast);
+  if (recorder.Active()) {
+    recorder.AddBytes(TypeBytes(count, datatype));
+  }
+  return PMPI_Bcast(buffer, count, datatype, root, comm);
+}
+
+int MPI_Scatter(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  CallRecorder recorder(MpiCall::kScatter);
+  if (recorder.Active()) {
+    int size = 1;
+    PMPI_Comm_size(comm, &size);
+    recorder.AddBytes(IsRoot(root, comm) ? TypeBytes(sendcount, sendtype) * static_cast<uint64_t>(size)
+                                         : TypeBytes(recvcount, recvtype));
+  }
+  return PMPI_Scatter(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+}
+
+int MPI_Scatterv(const void *sendbuf, const int sendcounts[], const int displs[], MPI_Datatype sendtype,
+                 void *recvbuf, int recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  CallRecorder recorder(MpiCall::kScatterv);
+  if (recorder.Active()) {
+    recorder.AddBytes(IsRoot(root, comm) ? SumBytes(sendcounts, sendtype, comm) : TypeBytes(recvcount, recvtype));
+  }
+  return PMPI_Scatterv(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount, recvtype, root, comm);
+}
+
+int MPI_Gather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+               MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  CallRecorder recorder(MpiCall::kGather);
+  if (recorder.Active()) {
+    int size = 1;
+    PMPI_Comm_size(comm, &size);
+    recorder.AddBytes(IsRoot(root, comm) ? TypeBytes(recvcount, recvtype) * static_cast<uint64_t>(size)
+                                         : TypeBytes(sendcount, sendtype));
+  }
+  return PMPI_Gather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+}
+
+int MPI_Gatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                const int displs[], MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  CallRecorder recorder(MpiCall::kGatherv);
+  if (recorder.Active()) {
+    recorder.AddBytes(IsRoot(root, comm) ? SumBytes(recvcounts, recvtype, comm) : TypeBytes(sendcount, sendtype));
+  }
+  return PMPI_Gatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, root, comm);
+}
+
+int MPI_Allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                  MPI_Datatype recvtype, MPI_Comm comm) {
+  CallRecorder recorder(MpiCall::kAllgather);
+  if (recorder.Active()) {
+    int size = 1;
+    PMPI_Comm_size(comm, &size);
+    recorder.AddBytes(TypeBytes(recvcount, recvtype) * static_cast<uint64_t>(size));
+  }
+  return PMPI_Allgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+}
+
+int MPI_Allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                   const int displs[], MPI_Datatype recvtype, MPI_Comm comm) {
+  CallRecorder recorder(MpiCall::kAllgatherv);
+  if (recorder.Active()) {
+    recorder.AddBytes(SumBytes(recvcounts, recvtype, comm));
+  }
+  return PMPI_Allgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm);
+}
+
+int MPI_Reduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root,
+               MPI_Comm comm) {
+  CallRecorder recorder(MpiCall::kReduce);
+  if (recorder.Active()) {
+    recorder.AddBytes(TypeBytes(count, datatype));
+  }
+  return PMPI_Reduce(sendbuf, recvbuf, count, datatype, op, root, comm);
+}
+
+int MPI_Allreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+  CallRecorder recorder(MpiCall::kAllreduce);
+  if (recorder.Active()) {
+    recorder.AddBytes(TypeBytes(count, datatype));
+  }
+  return PMPI_Allreduce(sendbuf, recvbuf, count, datatype, op, comm);
+}
+
+int MPI_Alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                 MPI_Datatype recvtype, MPI_Comm comm) {
+  CallRecorder recorder(MpiCall::kAlltoall);
+  if (recorder.Active()) {
+    int size = 1;
+    PMPI_Comm_size(comm, &size);
+    recorder.AddBytes(TypeBytes(sendcount, sendtype) * static_cast<uint64_t>(size));
+  }
+  return PMPI_Alltoall(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+}
+
+int MPI_Alltoallv(const void *sendbuf, const int sendcounts[], const int sdispls[], MPI_Datatype sendtype,
+                  void *recvbuf, const int recvcounts[], const int rdispls[], MPI_Datatype recvtype, MPI_Comm comm) {
+  CallRecorder recorder(MpiCall::kAlltoallv);
+  if (recorder.Active()) {
+    recorder.AddBytes(SumBytes(sendcounts, sendtype, comm));
+  }
+  return PMPI_Alltoallv(sendbuf, sendcounts, sdispls, sendtype, recvbuf, recvcounts, rdispls, recvtype, comm);
+}
+
+int MPI_Barrier(MPI_Comm comm) {
+  const CallRecorder recorder(MpiCall::kBarrier);
+  return PMPI_Barrier(comm);
+}
+#endif
@@ -0,0 +1,93 @@
+#include "util/include/node_shared.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+
+#include "util/include/topology.hpp"
+#include "util/include/util.hpp"
+
+namespace {
+
+/// Largest piece handed to one MPI_Bcast, whose count is an int.
+constexpr std::size_t kMaxBcastBytes = std::size_t{1} << 30;
+
+}  // namespace
+
+ppc::util::NodeSharedBuffer::NodeSharedBuffer(std::span<const std::byte> data, std::size_t bytes, int root)
+    : bytes_(bytes) {
+  if (!IsMpiActive()) {
+    if (data.size() < bytes) {
+      throw std::runtime_error("Node shared buffer is larger than the data it shares");
+    }
+    copy_.assign(data.begin(), data.begin() + static_cast<std::ptrdiff_t>(bytes));
+    data_ = copy_.data();
+    return;
+  }
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  // Every rank must throw together, otherwise the others would wait in MPI_Win_allocate_shared
+  int valid = rank != root || data.size() >= bytes ? 1 : 0;
+  MPI_Bcast(&valid, 1, MPI_INT, root, MPI_COMM_WORLD);
+  if (valid == 0) {
+    throw std::runtime_error("Node shared buffer is larger than the data it shares");
+  }
+
+  const NodeTopology &topology = GetNodeTopology();
+  // MPI_Win_allocate_shared rejects zero-sized windows on some implementations
+  const auto local_bytes = static_cast<MPI_Aint>(topology.local_rank == 0 ? std::max<std::size_t>(bytes, 1) : 0);
+  void *local_base = nullptr;
+  MPI_Win_allocate_shared(local_bytes, 1, MPI_INFO_NULL, topology.node_comm, &local_base, &window_);
+  MPI_Aint leader_bytes = 0;
+  int disp_unit = 1;
+  void *leader_base = nullptr;
+  MPI_Win_shared_query(window_, 0, &leader_bytes, &disp_unit, &leader_base);
+  auto *base = static_cast<std::byte *>(leader_base);
+
+  MPI_Win_fence(0, window_);
+  if (rank == root && bytes > 0) {
+    std::memcpy(base, data.data(), bytes);
+  }
+  MPI_Win_fence(0, window_);
+  BroadcastBetweenNodes(base, root);
+  MPI_Win_fence(0, window_);
+  data_ = base;
+}
+
+void ppc::util::NodeSharedBuffer::BroadcastBetweenNodes(std::byte *base, int root) {
+  const NodeTopology &topology = GetNodeTopology();
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  if (topology.local_size == size) {
+    return;
+  }
+  // The root may not lead its node, but it wrote into the window its leader broadcasts from
+  int has_root = rank == root ? 1 : 0;
+  MPI_Allreduce(MPI_IN_PLACE, &has_root, 1, MPI_INT, MPI_MAX, topology.node_comm);
+  MPI_Comm leaders = MPI_COMM_NULL;
+  MPI_Comm_split(MPI_COMM_WORLD, topology.local_rank == 0 ? 0 : MPI_UNDEFINED, rank, &leaders);
+  if (leaders == MPI_COMM_NULL) {
+    return;
+  }
+  int leader_rank = 0;
+  MPI_Comm_rank(leaders, &leader_rank);
+  int root_leader = has_root != 0 ? leader_rank : -1;
+  MPI_Allreduce(MPI_IN_PLACE, &root_leader, 1, MPI_INT, MPI_MAX, leaders);
+  for (std::size_t offset = 0; offset < bytes_; offset += kMaxBcastBytes) {
+    const std::size_t count = std::min(kMaxBcastBytes, bytes_ - offset);
+    MPI_Bcast(base + offset, static_cast<int>(count), MPI_BYTE, root_leader, leaders);
+  }
+  MPI_Comm_free(&leaders);
+}
+
+ppc::util::NodeSharedBuffer::~NodeSharedBuffer() {
+  if (window_ != MPI_WIN_NULL && IsMpiActive()) {
+    MPI_Win_free(&window_);
+  }
+}
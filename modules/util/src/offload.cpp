@@ -0,0 +1,110 @@
+#include "util/include/offload.hpp"
+
+#include <omp.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <libenvpp/detail/get.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+using ppc::util::kNumOffloadDirections;
+using ppc::util::OffloadTransferStats;
+
+struct AtomicTransferStats {
+  std::atomic<uint64_t> copies{0};
+  std::atomic<uint64_t> bytes{0};
+  std::atomic<uint64_t> nanoseconds{0};
+};
+
+std::array<AtomicTransferStats, kNumOffloadDirections> transfers;
+
+std::array<OffloadTransferStats, kNumOffloadDirections> SnapshotTransfers() {
+  return {ppc::util::GetOffloadTransferStats(ppc::util::OffloadDirection::kHostToDevice),
+          ppc::util::GetOffloadTransferStats(ppc::util::OffloadDirection::kDeviceToHost)};
+}
+
+}  // namespace
+
+bool ppc::util::OffloadDeviceAvailable() {
+  return omp_get_num_devices() > 0;
+}
+
+int ppc::util::GetOffloadDevice() {
+  const int num_devices = omp_get_num_devices();
+  const auto device = env::get<int>("PPC_OFFLOAD_DEVICE");
+  if (device.has_value()) {
+    const bool is_host = device.value() == omp_get_initial_device();
+    if (!is_host && (device.value() < 0 || device.value() >= num_devices)) {
+      throw std::runtime_error("PPC_OFFLOAD_DEVICE=" + std::to_string(device.value()) + " but the runtime has " +
+                               std::to_string(num_devices) + " offload devices and the host is device " +
+                               std::to_string(omp_get_initial_device()));
+    }
+    return device.value();
+  }
+  const int default_device = omp_get_default_device();
+  return default_device >= 0 && default_device < num_devices ? default_device : omp_get_initial_device();
+}
+
+void ppc::util::OffloadSynchronize() {
+#pragma omp taskwait
+}
+
+void ppc::util::OffloadCopy(void *dst, const void *src, std::size_t bytes, OffloadDirection direction, int device) {
+  if (bytes == 0) {
+    return;
+  }
+  const int host = omp_get_initial_device();
+  const bool to_device = direction == OffloadDirection::kHostToDevice;
+  const double begin = omp_get_wtime();
+  const int result = omp_target_memcpy(dst, src, bytes, 0, 0, to_device ? device : host, to_device ? host : device);
+  const double elapsed = omp_get_wtime() - begin;
+  if (result != 0) {
+    throw std::runtime_error("omp_target_memcpy of " + std::to_string(bytes) + " bytes failed for device " +
+                             std::to_string(device));
+  }
+  auto &stats = transfers.at(static_cast<std::size_t>(direction));
+  stats.copies.fetch_add(1, std::memory_order_relaxed);
+  stats.bytes.fetch_add(bytes, std::memory_order_relaxed);
+  stats.nanoseconds.fetch_add(static_cast<uint64_t>(elapsed * 1e9), std::memory_order_relaxed);
+}
+
+void ppc::util::ResetOffloadTransfers() {
+  for (auto &stats : transfers) {
+    stats.copies.store(0, std::memory_order_relaxed);
+    stats.bytes.store(0, std::memory_order_relaxed);
+    stats.nanoseconds.store(0, std::memory_order_relaxed);
+  }
+}
+
+ppc::util::OffloadTransferStats ppc::util::GetOffloadTransferStats(OffloadDirection direction) {
+  const auto &stats = transfers.at(static_cast<std::size_t>(direction));
+  return {.copies = stats.copies.load(std::memory_order_relaxed),
+          .bytes = stats.bytes.load(std::memory_order_relaxed),
+          .time = static_cast<double>(stats.nanoseconds.load(std::memory_order_relaxed)) * 1e-9};
+}
+
+void ppc::util::OffloadTransferTracker::Start() {
+  begin_ = SnapshotTransfers();
+}
+
+void ppc::util::OffloadTransferTracker::Stop() {
+  const auto end = SnapshotTransfers();
+  for (std::size_t i = 0; i < kNumOffloadDirections; i++) {
+    totals_[i].copies += end[i].copies - begin_[i].copies;
+    totals_[i].bytes += end[i].bytes - begin_[i].bytes;
+    totals_[i].time += end[i].time - begin_[i].time;
+  }
+}
+
+double ppc::util::OffloadTransferTracker::Time() const {
+  double time = 0.0;
+  for (const auto &stats : totals_) {
+    time += stats.time;
+  }
+  return time;
+}
@@ -0,0 +1,51 @@
+#include "util/include/per_thread.hpp"
+
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+struct IndexRegistry {
+  std::mutex mutex;
+  std::vector<std::size_t> released;
+  std::size_t next = 0;
+};
+
+/// Never destroyed: runtime worker threads may exit after static destructors have run.
+IndexRegistry &GetRegistry() {
+  static auto *registry = new IndexRegistry();
+  return *registry;
+}
+
+struct ThreadIndex {
+  ThreadIndex() {
+    IndexRegistry &registry = GetRegistry();
+    const std::scoped_lock lock(registry.mutex);
+    if (!registry.released.empty()) {
+      value = registry.released.back();
+      registry.released.pop_back();
+    } else if (registry.next < ppc::util::kMaxThreadSlots) {
+      value = registry.next++;
+    } else {
+      throw std::runtime_error("More threads than PerThread slots");
+    }
+  }
+  ThreadIndex(const ThreadIndex &) = delete;
+  ThreadIndex &operator=(const ThreadIndex &) = delete;
+  ~ThreadIndex() {
+    IndexRegistry &registry = GetRegistry();
+    const std::scoped_lock lock(registry.mutex);
+    registry.released.push_back(value);
+  }
+
+  std::size_t value = 0;
+};
+
+}  // namespace
+
+std::size_t ppc::util::ThisThreadIndex() {
+  thread_local const ThreadIndex index;
+  return index.value;
+}
@@ -0,0 +1,122 @@
+#include "util/include/perf_baseline.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <libenvpp/detail/get.hpp>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+double TimeUnitToSeconds(const std::string &unit) {
+  static const std::unordered_map<std::string, double> kUnits = {
+      {"ns", 1e-9}, {"us", 1e-6}, {"ms", 1e-3}, {"s", 1.0}};
+  const auto it = kUnits.find(unit);
+  if (it == kUnits.end()) {
+    throw std::runtime_error("Unknown benchmark time unit '" + unit + "'");
+  }
+  return it->second;
+}
+
+double Median(std::vector<double> values) {
+  std::ranges::sort(values);
+  const std::size_t middle = values.size() / 2;
+  return values.size() % 2 == 1 ? values[middle] : 0.5 * (values[middle - 1] + values[middle]);
+}
+
+}  // namespace
+
+std::optional<std::string> ppc::util::GetPerfBaselinePath() {
+  const auto path = env::get<std::string>("PPC_PERF_BASELINE");
+  if (path.has_value() && !path.value().empty()) {
+    return path.value();
+  }
+  return std::nullopt;
+}
+
+double ppc::util::GetPerfRegressionThreshold() {
+  const auto val = env::get<double>("PPC_PERF_REGRESSION_THRESHOLD");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return 0.1;
+}
+
+double ppc::util::GetPerfRegressionAlpha() {
+  const auto val = env::get<double>("PPC_PERF_REGRESSION_ALPHA");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return 0.05;
+}
+
+ppc::util::PerfSamples ppc::util::LoadPerfSamples(const std::string &path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open performance baseline " + path);
+  }
+  nlohmann::json payload;
+  try {
+    file >> payload;
+  } catch (const nlohmann::json::parse_error &e) {
+    throw std::runtime_error("Malformed performance baseline " + path + ": " + e.what());
+  }
+  if (!payload.is_object() || !payload.contains("benchmarks") || !payload["benchmarks"].is_array()) {
+    throw std::runtime_error("Performance baseline " + path + " has no benchmarks array");
+  }
+  PerfSamples samples;
+  for (const auto &entry : payload["benchmarks"]) {
+    if (entry.value("run_type", "iteration") != "iteration" || entry.value("error_occurred", false) ||
+        !entry.contains("real_time")) {
+      continue;
+    }
+    const std::string name = entry.value("run_name", entry.value("name", ""));
+    const double seconds = entry["real_time"].get<double>() * TimeUnitToSeconds(entry.value("time_unit", "ns"));
+    samples[name].push_back(seconds);
+  }
+  return samples;
+}
+
+double ppc::util::MannWhitneySlowerPValue(const std::vector<double> &current, const std::vector<double> &baseline) {
+  if (current.empty() || baseline.empty()) {
+    return 1.0;
+  }
+  double u = 0.0;
+  for (const double slow : current) {
+    for (const double fast : baseline) {
+      u += slow > fast ? 1.0 : (slow == fast ? 0.5 : 0.0);
+    }
+  }
+  const auto n1 = static_cast<double>(current.size());
+  const auto n2 = static_cast<double>(baseline.size());
+  const double mean = n1 * n2 / 2.0;
+  const double sigma = std::sqrt(n1 * n2 * (n1 + n2 + 1.0) / 12.0);
+  const double z = (u - mean - 0.5) / sigma;
+  return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+ppc::util::PerfComparison ppc::util::ComparePerfSamples(const std::vector<double> &current,
+                                                        const std::vector<double> &baseline, double threshold,
+                                                        double alpha) {
+  PerfComparison comparison;
+  if (current.empty() || baseline.empty()) {
+    return comparison;
+  }
+  comparison.current_median = Median(current);
+  comparison.baseline_median = Median(baseline);
+  if (comparison.baseline_median <= 0.0) {
+    return comparison;
+  }
+  comparison.slowdown = (comparison.current_median / comparison.baseline_median) - 1.0;
+  if (current.size() >= kMinSamplesForTest && baseline.size() >= kMinSamplesForTest) {
+    comparison.p_value = MannWhitneySlowerPValue(current, baseline);
+  }
+  comparison.regression = comparison.slowdown > threshold && (!comparison.p_value || *comparison.p_value < alpha);
+  return comparison;
+}
@@ -0,0 +1,9 @@
+#include "util/include/random.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+uint64_t ppc::util::TestInputSeed() {
+  return static_cast<uint64_t>(static_cast<uint32_t>(::testing::GTEST_FLAG(random_seed)));
+}
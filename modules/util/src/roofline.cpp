@@ -0,0 +1,137 @@
+#include "util/include/roofline.hpp"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <libenvpp/detail/get.hpp>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "util/include/util.hpp"
+
+namespace {
+
+constexpr int kTrials = 5;
+
+std::once_flag probe_once;
+std::optional<ppc::util::MachinePeaks> probed_peaks;
+
+/// Seconds of the fastest of kTrials parallel runs of @p kernel.
+template <typename Kernel>
+double BestParallelTime(int num_threads, const Kernel &kernel) {
+  double best = std::numeric_limits<double>::infinity();
+  for (int trial = 0; trial < kTrials; trial++) {
+    const double begin = omp_get_wtime();
+#pragma omp parallel num_threads(num_threads)
+    kernel(omp_get_thread_num(), omp_get_num_threads());
+    best = std::min(best, omp_get_wtime() - begin);
+  }
+  return best;
+}
+
+double MeasurePeakFlops(int num_threads) {
+  constexpr std::size_t kChains = 32;
+  constexpr int kSteps = 1 << 16;
+  std::vector<double> sinks(static_cast<std::size_t>(num_threads), 0.0);
+  const double seconds = BestParallelTime(num_threads, [&sinks](int thread, int /*threads*/) {
+    std::array<double, kChains> chains{};
+    for (std::size_t i = 0; i < kChains; i++) {
+      chains[i] = 1.0 + (1e-3 * static_cast<double>(i + static_cast<std::size_t>(thread)));
+    }
+    // Scale and shift keep the chains bounded while every step depends on the previous one
+    const double scale = 0.999999;
+    const double shift = 1e-6;
+    for (int step = 0; step < kSteps; step++) {
+      for (double &value : chains) {
+        value = (value * scale) + shift;
+      }
+    }
+    double sum = 0.0;
+    for (const double value : chains) {
+      sum += value;
+    }
+    sinks[static_cast<std::size_t>(thread)] = sum;
+  });
+  double sink = 0.0;
+  for (const double value : sinks) {
+    sink += value;
+  }
+  if (!(sink > 0.0) || seconds <= 0.0) {
+    return 0.0;
+  }
+  return 2.0 * static_cast<double>(kChains) * static_cast<double>(kSteps) * static_cast<double>(num_threads) /
+         seconds;
+}
+
+double MeasureTriadBandwidth(int num_threads, std::size_t elements) {
+  std::vector<double> a(elements);
+  std::vector<double> b(elements);
+  std::vector<double> c(elements);
+  auto range = [elements](int thread, int threads) {
+    const std::size_t begin = elements * static_cast<std::size_t>(thread) / static_cast<std::size_t>(threads);
+    const std::size_t end = elements * static_cast<std::size_t>(thread + 1) / static_cast<std::size_t>(threads);
+    return std::pair{begin, end};
+  };
+  // First touch on the threads that run the triad places the pages on their NUMA nodes
+  (void)BestParallelTime(num_threads, [&](int thread, int threads) {
+    const auto [begin, end] = range(thread, threads);
+    for (std::size_t i = begin; i < end; i++) {
+      a[i] = 0.0;
+      b[i] = 1.0;
+      c[i] = 2.0;
+    }
+  });
+  const double seconds = BestParallelTime(num_threads, [&](int thread, int threads) {
+    const auto [begin, end] = range(thread, threads);
+    for (std::size_t i = begin; i < end; i++) {
+      a[i] = b[i] + (3.0 * c[i]);
+    }
+  });
+  if (a[elements / 2] != 7.0 || seconds <= 0.0) {
+    return 0.0;
+  }
+  return 3.0 * sizeof(double) * static_cast<double>(elements) / seconds;
+}
+
+}  // namespace
+
+bool ppc::util::RooflineEnabled() {
+  const auto enabled = env::get<int>("PPC_PERF_ROOFLINE");
+  return enabled.has_value() && enabled.value() != 0;
+}
+
+ppc::util::MachinePeaks ppc::util::MeasureMachinePeaks(int num_threads, std::size_t stream_elements) {
+  if (num_threads <= 0 || stream_elements == 0) {
+    throw std::runtime_error("Roofline probe needs at least one thread and one element");
+  }
+  MachinePeaks peaks;
+  peaks.flops_per_second = MeasurePeakFlops(num_threads);
+  peaks.bytes_per_second = MeasureTriadBandwidth(num_threads, stream_elements);
+  return peaks;
+}
+
+const ppc::util::MachinePeaks &ppc::util::ProbeMachinePeaks() {
+  std::call_once(probe_once, [] { probed_peaks = MeasureMachinePeaks(std::max(GetNumThreads(), 1)); });
+  return *probed_peaks;
+}
+
+std::optional<ppc::util::MachinePeaks> ppc::util::GetProbedMachinePeaks() {
+  return probed_peaks;
+}
+
+double ppc::util::RooflineFraction(double flops_per_second, double bytes_per_second, const MachinePeaks &peaks) {
+  double fraction = 0.0;
+  if (peaks.flops_per_second > 0.0) {
+    fraction = std::max(fraction, flops_per_second / peaks.flops_per_second);
+  }
+  if (peaks.bytes_per_second > 0.0) {
+    fraction = std::max(fraction, bytes_per_second / peaks.bytes_per_second);
+  }
+  return fraction;
+}
@@ -0,0 +1,163 @@
+#include "util/include/schedule.hpp"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <exception>
+#include <libenvpp/detail/get.hpp>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "util/include/schedule_policy.hpp"
+#include "util/include/thread_pool.hpp"
+
+namespace {
+
+constexpr std::array<std::pair<ppc::util::ScheduleKind, std::string_view>, 4> kScheduleKinds = {{
+    {ppc::util::ScheduleKind::kAuto, "auto"},
+    {ppc::util::ScheduleKind::kStatic, "static"},
+    {ppc::util::ScheduleKind::kDynamic, "dynamic"},
+    {ppc::util::ScheduleKind::kGuided, "guided"},
+}};
+
+constexpr std::array<std::pair<ppc::util::TbbPartitioner, std::string_view>, 4> kTbbPartitioners = {{
+    {ppc::util::TbbPartitioner::kAuto, "auto"},
+    {ppc::util::TbbPartitioner::kSimple, "simple"},
+    {ppc::util::TbbPartitioner::kAffinity, "affinity"},
+    {ppc::util::TbbPartitioner::kStatic, "static"},
+}};
+
+template <typename Enum, std::size_t N>
+Enum ParseName(const std::array<std::pair<Enum, std::string_view>, N> &names, std::string_view value,
+               std::string_view spec) {
+  for (const auto &[key, name] : names) {
+    if (name == value) {
+      return key;
+    }
+  }
+  throw std::runtime_error("Unknown schedule value '" + std::string(value) + "' in '" + std::string(spec) + "'");
+}
+
+template <typename Enum, std::size_t N>
+std::string_view NameOf(const std::array<std::pair<Enum, std::string_view>, N> &names, Enum value) {
+  for (const auto &[key, name] : names) {
+    if (key == value) {
+      return name;
+    }
+  }
+  return "auto";
+}
+
+std::size_t ParseGrainSize(const std::string &value, std::string_view spec) {
+  std::size_t parsed = 0;
+  long long grain = -1;
+  try {
+    grain = std::stoll(value, &parsed);
+  } catch (const std::exception &) {
+    parsed = 0;
+  }
+  if (parsed != value.size() || grain < 0) {
+    throw std::runtime_error("Invalid schedule grain '" + value + "' in '" + std::string(spec) + "'");
+  }
+  return static_cast<std::size_t>(grain);
+}
+
+}  // namespace
+
+ppc::util::SchedulePolicy ppc::util::ParseSchedulePolicy(std::string_view spec) {
+  SchedulePolicy policy;
+  for (std::size_t start = 0; start < spec.size();) {
+    const std::size_t separator = std::min(spec.find(',', start), spec.size());
+    const std::string_view setting = spec.substr(start, separator - start);
+    start = separator + 1;
+    if (setting.empty()) {
+      continue;
+    }
+    const std::size_t equals = setting.find('=');
+    if (equals == std::string_view::npos) {
+      throw std::runtime_error("Schedule setting '" + std::string(setting) + "' in '" + std::string(spec) +
+                               "' is not key=value");
+    }
+    const std::string_view key = setting.substr(0, equals);
+    const std::string_view value = setting.substr(equals + 1);
+    if (key == "kind") {
+      policy.kind = ParseName(kScheduleKinds, value, spec);
+    } else if (key == "grain") {
+      policy.grain_size = ParseGrainSize(std::string(value), spec);
+    } else if (key == "partitioner") {
+      policy.partitioner = ParseName(kTbbPartitioners, value, spec);
+    } else {
+      throw std::runtime_error("Unknown schedule setting '" + std::string(key) + "' in '" + std::string(spec) + "'");
+    }
+  }
+  return policy;
+}
+
+std::string ppc::util::SchedulePolicyToString(const SchedulePolicy &policy) {
+  const SchedulePolicy defaults;
+  std::vector<std::string> settings;
+  if (policy.kind != defaults.kind) {
+    settings.push_back("kind=" + std::string(NameOf(kScheduleKinds, policy.kind)));
+  }
+  if (policy.grain_size != defaults.grain_size) {
+    settings.push_back("grain=" + std::to_string(policy.grain_size));
+  }
+  if (policy.partitioner != defaults.partitioner) {
+    settings.push_back("partitioner=" + std::string(NameOf(kTbbPartitioners, policy.partitioner)));
+  }
+  std::string result;
+  for (const auto &setting : settings) {
+    result += (result.empty() ? "" : ",") + setting;
+  }
+  return result;
+}
+
+ppc::util::SchedulePolicy ppc::util::GetSchedulePolicy() {
+  const auto schedule = env::get<std::string>("PPC_SCHEDULE");
+  return schedule.has_value() ? ParseSchedulePolicy(schedule.value()) : SchedulePolicy{};
+}
+
+std::vector<ppc::util::SchedulePolicy> ppc::util::GetPerfScheduleSweep() {
+  const auto sweep = env::get<std::string>("PPC_PERF_SCHEDULE_SWEEP");
+  std::vector<SchedulePolicy> policies;
+  if (!sweep.has_value()) {
+    return policies;
+  }
+  const std::string_view value = sweep.value();
+  for (std::size_t start = 0; start <= value.size();) {
+    const std::size_t separator = std::min(value.find(';', start), value.size());
+    policies.push_back(ParseSchedulePolicy(value.substr(start, separator - start)));
+    start = separator + 1;
+  }
+  return policies;
+}
+
+ppc::util::ScopedSchedulePolicy::ScopedSchedulePolicy(const SchedulePolicy &policy)
+    : set_schedule_("PPC_SCHEDULE", SchedulePolicyToString(policy)),
+      pool_(GetThreadPool()),
+      previous_pool_policy_(pool_.GetDefaultSchedulePolicy()) {
+  pool_.SetDefaultSchedulePolicy(policy);
+}
+
+ppc::util::ScopedSchedulePolicy::~ScopedSchedulePolicy() {
+  pool_.SetDefaultSchedulePolicy(previous_pool_policy_);
+}
+
+omp_sched_t ppc::util::detail::ToOmpSchedule(ScheduleKind kind) {
+  switch (kind) {
+    case ScheduleKind::kStatic:
+      return omp_sched_static;
+    case ScheduleKind::kDynamic:
+      return omp_sched_dynamic;
+    case ScheduleKind::kGuided:
+      return omp_sched_guided;
+    case ScheduleKind::kAuto:
+      break;
+  }
+  return omp_sched_auto;
+}
@@ -0,0 +1,81 @@
+#include "util/include/scratch_arena.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+std::atomic<std::uint64_t> next_arena_id{1};
+
+/// Last arena looked up by this thread; ids are never reused, so a stale entry cannot match.
+thread_local std::uint64_t cached_arena_id = 0;
+thread_local ppc::util::ThreadScratchArena *cached_arena = nullptr;
+
+std::size_t AlignUp(std::size_t value, std::size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace
+
+void *ppc::util::ThreadScratchArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+  while (block_ < blocks_.size()) {
+    Block &block = blocks_[block_];
+    const auto base = reinterpret_cast<std::uintptr_t>(block.data.get());
+    const std::size_t begin = AlignUp(base + offset_, alignment) - base;
+    if (begin + bytes <= block.size) {
+      const std::size_t in_use = in_use_.load(std::memory_order_relaxed) + (begin + bytes - offset_);
+      in_use_.store(in_use, std::memory_order_relaxed);
+      if (in_use > peak_.load(std::memory_order_relaxed)) {
+        peak_.store(in_use, std::memory_order_relaxed);
+      }
+      offset_ = begin + bytes;
+      return block.data.get() + begin;
+    }
+    block_++;
+    offset_ = 0;
+  }
+
+  const std::size_t previous_size = blocks_.empty() ? 0 : blocks_.back().size;
+  const std::size_t size = std::max({kMinBlockSize, previous_size * 2, bytes + alignment});
+  blocks_.push_back({.data = std::make_unique_for_overwrite<std::byte[]>(size), .size = size});
+  block_ = blocks_.size() - 1;
+  offset_ = 0;
+  return do_allocate(bytes, alignment);
+}
+
+ppc::util::ScratchArena::ScratchArena() : id_(next_arena_id.fetch_add(1)) {}
+
+ppc::util::ThreadScratchArena &ppc::util::ScratchArena::Local() {
+  if (cached_arena_id == id_) {
+    return *cached_arena;
+  }
+  const std::scoped_lock lock(mutex_);
+  auto &arena = arenas_[std::this_thread::get_id()];
+  if (!arena) {
+    arena = std::make_unique<ThreadScratchArena>();
+  }
+  cached_arena_id = id_;
+  cached_arena = arena.get();
+  return *arena;
+}
+
+void ppc::util::ScratchArena::Release() {
+  const std::scoped_lock lock(mutex_);
+  for (const auto &[thread_id, arena] : arenas_) {
+    arena->Rewind({});
+  }
+}
+
+std::size_t ppc::util::ScratchArena::PeakBytes() const {
+  const std::scoped_lock lock(mutex_);
+  std::size_t total = 0;
+  for (const auto &[thread_id, arena] : arenas_) {
+    total += arena->PeakBytes();
+  }
+  return total;
+}
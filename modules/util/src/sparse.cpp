@@ -0,0 +1,108 @@
+#include "util/include/sparse.hpp"
+
+#include <mpi.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "util/include/decomposition.hpp"
+#include "util/include/util.hpp"
+
+std::vector<int64_t> ppc::util::detail::OffsetsFromSortedRows(std::span<const int32_t> sorted_rows,
+                                                              int32_t num_rows) {
+  std::vector<int64_t> offsets(static_cast<std::size_t>(num_rows) + 1);
+  tbb::parallel_for(int32_t{0}, num_rows + 1, [&](int32_t row) {
+    offsets[static_cast<std::size_t>(row)] = std::ranges::lower_bound(sorted_rows, row) - sorted_rows.begin();
+  });
+  return offsets;
+}
+
+void ppc::util::detail::CommPosition(MPI_Comm comm, int &rank, int &size) {
+  rank = 0;
+  size = 1;
+  if (IsMpiActive()) {
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+  }
+}
+
+ppc::util::CsrGraph ppc::util::BuildGraph(int32_t num_vertices, std::span<const Edge> edges, bool undirected) {
+  detail::CheckIndices(edges | std::views::transform(&Edge::from), num_vertices, "Vertex");
+  detail::CheckIndices(edges | std::views::transform(&Edge::to), num_vertices, "Vertex");
+  std::vector<Edge> arcs(undirected ? edges.size() * 2 : edges.size());
+  tbb::parallel_for(std::size_t{0}, edges.size(), [&](std::size_t i) {
+    arcs[i] = edges[i];
+    if (undirected) {
+      arcs[edges.size() + i] = {.from = edges[i].to, .to = edges[i].from};
+    }
+  });
+  tbb::parallel_sort(arcs.begin(), arcs.end(), [](const Edge &lhs, const Edge &rhs) {
+    return std::tie(lhs.from, lhs.to) < std::tie(rhs.from, rhs.to);
+  });
+  auto same_arc = [&](std::size_t i) { return arcs[i].from == arcs[i - 1].from && arcs[i].to == arcs[i - 1].to; };
+  const std::vector<int64_t> slots = detail::RunSlots(arcs.size(), same_arc);
+  const std::size_t unique = arcs.empty() ? 0 : static_cast<std::size_t>(slots.back()) + 1;
+
+  CsrGraph graph;
+  graph.num_vertices = num_vertices;
+  std::vector<int32_t> sources(unique);
+  graph.neighbors.resize(unique);
+  tbb::parallel_for(std::size_t{0}, arcs.size(), [&](std::size_t i) {
+    if (i == 0 || !same_arc(i)) {
+      sources[static_cast<std::size_t>(slots[i])] = arcs[i].from;
+      graph.neighbors[static_cast<std::size_t>(slots[i])] = arcs[i].to;
+    }
+  });
+  graph.offsets = detail::OffsetsFromSortedRows(sources, num_vertices);
+  return graph;
+}
+
+ppc::util::BlockRange ppc::util::NonZeroBalancedRows(std::span<const int64_t> offsets, int parts, int index) {
+  const auto rows = static_cast<int64_t>(offsets.size()) - 1;
+  const int64_t nonzeros = offsets.back();
+  if (nonzeros == 0) {
+    return BlockPartition(rows, parts, index);
+  }
+  auto boundary = [&](int part) -> int64_t {
+    if (part >= parts) {
+      return rows;
+    }
+    const int64_t target = nonzeros * part / parts;
+    return std::ranges::lower_bound(offsets.first(static_cast<std::size_t>(rows)), target) - offsets.begin();
+  };
+  const int64_t begin = boundary(index);
+  return {.begin = begin, .count = boundary(index + 1) - begin};
+}
+
+std::vector<int32_t> ppc::util::BreadthFirstSearch(const CsrGraph &graph, int32_t source) {
+  if (source < 0 || source >= graph.num_vertices) {
+    throw std::runtime_error("BFS source " + std::to_string(source) + " is not a vertex");
+  }
+  std::vector<int32_t> distance(static_cast<std::size_t>(graph.num_vertices), -1);
+  std::vector<int32_t> frontier = {source};
+  std::vector<int32_t> next;
+  distance[static_cast<std::size_t>(source)] = 0;
+  for (int32_t level = 1; !frontier.empty(); level++) {
+    next.clear();
+    for (const int32_t vertex : frontier) {
+      for (const int32_t neighbor : graph.Neighbors(vertex)) {
+        int32_t &seen = distance[static_cast<std::size_t>(neighbor)];
+        if (seen < 0) {
+          seen = level;
+          next.push_back(neighbor);
+        }
+      }
+    }
+    frontier.swap(next);
+  }
+  return distance;
+}
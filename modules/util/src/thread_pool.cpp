@@ -0,0 +1,197 @@
+#include "util/include/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "util/include/affinity.hpp"
+#include "util/include/load_balance.hpp"
+#include "util/include/schedule_policy.hpp"
+#include "util/include/trace.hpp"
+#include "util/include/util.hpp"
+
+namespace {
+
+std::atomic<ppc::util::ThreadPool *> installed_pool{nullptr};
+
+thread_local const ppc::util::ThreadPool *current_worker_pool = nullptr;
+thread_local std::size_t current_worker_index = 0;
+
+}  // namespace
+
+ppc::util::ThreadPool::ThreadPool(int num_threads)
+    : num_threads_(std::max(num_threads, 1)), default_policy_(GetSchedulePolicy()) {
+  // The caller of ParallelFor() is one of the participants; keep one worker so Submit() always makes progress
+  const auto num_workers = static_cast<std::size_t>(std::max(num_threads_ - 1, 1));
+  queues_.reserve(num_workers);
+  for (std::size_t i = 0; i < num_workers; i++) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+  workers_.reserve(num_workers);
+  for (std::size_t i = 0; i < num_workers; i++) {
+    workers_.emplace_back([this, i] { WorkerLoop(i); });
+  }
+}
+
+ppc::util::ThreadPool::~ThreadPool() {
+  {
+    const std::scoped_lock lock(wake_mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread &worker : workers_) {
+    worker.join();
+  }
+}
+
+ppc::util::ThreadPool::ChunkPlan ppc::util::ThreadPool::PlanChunks(std::uint64_t range, std::uint64_t participants,
+                                                                   const SchedulePolicy &policy) {
+  const auto grain = static_cast<std::uint64_t>(policy.grain_size);
+  ChunkPlan plan;
+  auto fixed_size = [&plan, range](std::uint64_t chunk_size) {
+    plan.chunk_size = chunk_size;
+    plan.num_chunks = (range + chunk_size - 1) / chunk_size;
+  };
+  switch (policy.kind) {
+    case ScheduleKind::kDynamic:
+      fixed_size(std::max<std::uint64_t>(grain, 1));
+      break;
+    case ScheduleKind::kGuided:
+      plan.offsets.push_back(0);
+      for (std::uint64_t done = 0; done < range;) {
+        const std::uint64_t remaining = range - done;
+        done += std::min(remaining, std::max({(remaining + participants - 1) / participants, grain, std::uint64_t{1}}));
+        plan.offsets.push_back(done);
+      }
+      plan.num_chunks = plan.offsets.size() - 1;
+      break;
+    case ScheduleKind::kStatic:
+    case ScheduleKind::kAuto:
+      if (grain != 0) {
+        fixed_size(grain);
+      } else {
+        const std::uint64_t per_thread = policy.kind == ScheduleKind::kStatic ? 1 : kChunksPerThread;
+        plan.num_chunks = std::min<std::uint64_t>(range, participants * per_thread);
+      }
+      break;
+  }
+  return plan;
+}
+
+int ppc::util::ThreadPool::ActiveThreads() const {
+  return std::clamp(ppc::util::GetNumThreads(), 1, num_threads_);
+}
+
+void ppc::util::ThreadPool::RunChunks(ParallelForState &state) {
+  {
+    const std::scoped_lock lock(state.mutex);
+    state.active++;
+  }
+  {
+    // Both scopes must close before the caller of ParallelFor() is released
+    const TraceScope trace("ParallelFor", "thread_pool");
+    const ScopedBusyTime busy;
+    for (std::uint64_t chunk = state.next_chunk++; chunk < state.num_chunks; chunk = state.next_chunk++) {
+      try {
+        state.run_chunk(chunk);
+      } catch (...) {
+        state.next_chunk = state.num_chunks;
+        const std::scoped_lock lock(state.mutex);
+        if (!state.error) {
+          state.error = std::current_exception();
+        }
+      }
+    }
+  }
+  {
+    const std::scoped_lock lock(state.mutex);
+    state.active--;
+  }
+  state.done.notify_all();
+}
+
+void ppc::util::ThreadPool::Push(Job job) {
+  // Workers keep their own jobs local; other threads spread jobs round-robin
+  const std::size_t index =
+      current_worker_pool == this ? current_worker_index : next_queue_.fetch_add(1) % queues_.size();
+  {
+    const std::scoped_lock lock(queues_[index]->mutex);
+    queues_[index]->jobs.push_back(std::move(job));
+  }
+  {
+    const std::scoped_lock lock(wake_mutex_);
+    pending_++;
+  }
+  wake_.notify_one();
+}
+
+bool ppc::util::ThreadPool::TryPop(std::size_t worker_index, Job &job) {
+  {
+    WorkerQueue &own = *queues_[worker_index];
+    const std::scoped_lock lock(own.mutex);
+    if (!own.jobs.empty()) {
+      job = std::move(own.jobs.back());
+      own.jobs.pop_back();
+      return true;
+    }
+  }
+  for (std::size_t offset = 1; offset < queues_.size(); offset++) {
+    WorkerQueue &victim = *queues_[(worker_index + offset) % queues_.size()];
+    const std::scoped_lock lock(victim.mutex);
+    if (!victim.jobs.empty()) {
+      job = std::move(victim.jobs.front());
+      victim.jobs.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void ppc::util::ThreadPool::WorkerLoop(std::size_t worker_index) {
+  current_worker_pool = this;
+  current_worker_index = worker_index;
+  // The calling thread of ParallelFor() is participant 0
+  PinCurrentThread(AffinityCpuForThread(static_cast<int>(worker_index) + 1));
+  if (TraceEnabled()) {
+    SetTraceThreadName("ppc pool worker " + std::to_string(worker_index + 1));
+  }
+  while (true) {
+    Job job;
+    if (TryPop(worker_index, job)) {
+      {
+        const std::scoped_lock lock(wake_mutex_);
+        pending_--;
+      }
+      job();
+      continue;
+    }
+    std::unique_lock lock(wake_mutex_);
+    wake_.wait(lock, [this] { return stopping_ || pending_ > 0; });
+    if (stopping_ && pending_ <= 0) {
+      return;
+    }
+  }
+}
+
+ppc::util::ThreadPool &ppc::util::GetThreadPool() {
+  if (ThreadPool *pool = installed_pool.load()) {
+    return *pool;
+  }
+  static ThreadPool fallback_pool(GetNumThreads());
+  return fallback_pool;
+}
+
+ppc::util::ScopedThreadPool::ScopedThreadPool(int num_threads)
+    : pool_(num_threads), previous_(installed_pool.exchange(&pool_)) {}
+
+ppc::util::ScopedThreadPool::~ScopedThreadPool() {
+  installed_pool.store(previous_);
+}
@@ -0,0 +1,114 @@
+#include "util/include/topology.hpp"
+
+#include <mpi.h>
+#include <omp.h>
+
+#include <algorithm>
+#include <atomic>
+#include <libenvpp/detail/get.hpp>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "util/include/util.hpp"
+
+#ifdef __linux__
+#  include <sched.h>
+#endif
+
+namespace {
+
+std::atomic<const ppc::util::NodeTopology *> installed_topology{nullptr};
+
+/// CPUs in the union of the affinity masks of the ranks in @p node_comm, so cpusets and launcher bindings such as
+/// --bind-to are respected. Collective over @p node_comm unless it is MPI_COMM_SELF.
+int CountNodeCpus(MPI_Comm node_comm) {
+  const int hardware_cpus = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1U));
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+    for (int cpu = 0; cpu < std::min(hardware_cpus, CPU_SETSIZE); cpu++) {
+      CPU_SET(cpu, &set);
+    }
+  }
+  if (node_comm != MPI_COMM_SELF) {
+    MPI_Allreduce(MPI_IN_PLACE, &set, static_cast<int>(sizeof(set)), MPI_UNSIGNED_CHAR, MPI_BOR, node_comm);
+  }
+  return std::max(CPU_COUNT(&set), 1);
+#else
+  (void)node_comm;
+  return hardware_cpus;
+#endif
+}
+
+}  // namespace
+
+ppc::util::ThreadBudgetMode ppc::util::GetThreadBudgetMode() {
+  const auto mode = env::get<std::string>("PPC_THREAD_BUDGET");
+  if (!mode.has_value() || mode.value().empty() || mode.value() == "auto") {
+    return ThreadBudgetMode::kAuto;
+  }
+  if (mode.value() == "off") {
+    return ThreadBudgetMode::kOff;
+  }
+  throw std::runtime_error("Invalid PPC_THREAD_BUDGET '" + mode.value() + "', expected auto or off");
+}
+
+int ppc::util::ComputeThreadBudget(int requested, int node_cpus, int local_rank, int local_size) {
+  local_size = std::max(local_size, 1);
+  const int base = std::max(node_cpus, 1) / local_size;
+  const int extra = std::max(node_cpus, 1) % local_size;
+  const int share = base + (local_rank < extra ? 1 : 0);
+  return std::clamp(share, 1, std::max(requested, 1));
+}
+
+const ppc::util::NodeTopology &ppc::util::GetNodeTopology() {
+  static const NodeTopology kSingleRank{.node_cpus = CountNodeCpus(MPI_COMM_SELF)};
+  const NodeTopology *topology = installed_topology.load();
+  return topology != nullptr ? *topology : kSingleRank;
+}
+
+ppc::util::ScopedHybridTopology::ScopedHybridTopology() : ScopedHybridTopology(GetThreadBudgetMode()) {}
+
+ppc::util::ScopedHybridTopology::ScopedHybridTopology(ThreadBudgetMode mode)
+    : previous_omp_threads_(omp_get_max_threads()) {
+  if (IsMpiActive()) {
+    MPI_Comm_rank(MPI_COMM_WORLD, &topology_.world_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &topology_.world_size);
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, topology_.world_rank, MPI_INFO_NULL,
+                        &topology_.node_comm);
+    MPI_Comm_rank(topology_.node_comm, &topology_.local_rank);
+    MPI_Comm_size(topology_.node_comm, &topology_.local_size);
+    // Node leaders count themselves; the exclusive prefix sum numbers the nodes by their lowest world rank
+    const int leader = topology_.local_rank == 0 ? 1 : 0;
+    MPI_Allreduce(&leader, &topology_.num_nodes, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    int node_index = 0;
+    MPI_Exscan(&leader, &node_index, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    topology_.node_index = topology_.world_rank == 0 ? 0 : node_index;
+    MPI_Bcast(&topology_.node_index, 1, MPI_INT, 0, topology_.node_comm);
+  }
+  topology_.node_cpus = CountNodeCpus(topology_.node_comm);
+
+  const int requested = GetNumThreads();
+  thread_budget_ = requested;
+  if (topology_.local_size > 1 && mode == ThreadBudgetMode::kAuto) {
+    thread_budget_ = ComputeThreadBudget(requested, topology_.node_cpus, topology_.local_rank, topology_.local_size);
+  }
+  if (thread_budget_ != requested) {
+    budget_env_.emplace("PPC_NUM_THREADS", std::to_string(thread_budget_));
+    omp_set_num_threads(thread_budget_);
+  }
+  previous_topology_ = installed_topology.exchange(&topology_);
+}
+
+ppc::util::ScopedHybridTopology::~ScopedHybridTopology() {
+  installed_topology.store(previous_topology_);
+  if (budget_env_) {
+    budget_env_.reset();
+    omp_set_num_threads(previous_omp_threads_);
+  }
+  if (topology_.node_comm != MPI_COMM_SELF && IsMpiActive()) {
+    MPI_Comm_free(&topology_.node_comm);
+  }
+}
@@ -0,0 +1,181 @@
+#include "util/include/trace.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <libenvpp/detail/get.hpp>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "util/include/util.hpp"
+
+namespace {
+
+struct ThreadBuffer {
+  std::size_t index = 0;
+  std::string name;
+  std::vector<ppc::util::TraceEvent> events;
+};
+
+/// Buffers stay owned by the registry after their thread exits so that its events can still be flushed.
+struct TraceRegistry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+TraceRegistry &GetRegistry() {
+  static TraceRegistry registry;
+  return registry;
+}
+
+ThreadBuffer &CurrentThreadBuffer() {
+  thread_local ThreadBuffer *buffer = nullptr;
+  if (buffer == nullptr) {
+    TraceRegistry &registry = GetRegistry();
+    const std::scoped_lock lock(registry.mutex);
+    auto owned = std::make_unique<ThreadBuffer>();
+    owned->index = registry.buffers.size();
+    owned->events.reserve(1024);
+    buffer = owned.get();
+    registry.buffers.push_back(std::move(owned));
+  }
+  return *buffer;
+}
+
+int64_t NowNs() {
+  static const auto kEpoch = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - kEpoch).count();
+}
+
+/// -1 until the first TraceEnabled() call reads PPC_TRACE.
+std::atomic<int> trace_state{-1};
+
+}  // namespace
+
+bool ppc::util::TraceEnabled() {
+  int state = trace_state.load(std::memory_order_relaxed);
+  if (state < 0) {
+    const auto enabled = env::get<int>("PPC_TRACE");
+    state = (enabled.has_value() && enabled.value() != 0) ? 1 : 0;
+    trace_state.store(state, std::memory_order_relaxed);
+  }
+  return state != 0;
+}
+
+void ppc::util::SetTraceEnabled(bool enabled) {
+  trace_state.store(enabled ? 1 : 0, std::memory_order_relaxed);
+}
+
+void ppc::util::SetTraceThreadName(std::string name) {
+  CurrentThreadBuffer().name = std::move(name);
+}
+
+std::vector<ppc::util::TraceEvent> ppc::util::CollectTraceEvents() {
+  TraceRegistry &registry = GetRegistry();
+  const std::scoped_lock lock(registry.mutex);
+  std::vector<TraceEvent> events;
+  for (const auto &buffer : registry.buffers) {
+    events.insert(events.end(), buffer->events.begin(), buffer->events.end());
+  }
+  return events;
+}
+
+void ppc::util::ClearTrace() {
+  TraceRegistry &registry = GetRegistry();
+  const std::scoped_lock lock(registry.mutex);
+  for (const auto &buffer : registry.buffers) {
+    buffer->events.clear();
+  }
+}
+
+void ppc::util::WriteTrace(const std::filesystem::path &path, int rank) {
+  nlohmann::json trace_events = nlohmann::json::array();
+  {
+    TraceRegistry &registry = GetRegistry();
+    const std::scoped_lock lock(registry.mutex);
+    for (const auto &buffer : registry.buffers) {
+      if (buffer->events.empty()) {
+        continue;
+      }
+      const std::string thread_name =
+          buffer->name.empty() ? "thread " + std::to_string(buffer->index) : buffer->name;
+      trace_events.push_back({{"name", "thread_name"},
+                              {"ph", "M"},
+                              {"pid", rank},
+                              {"tid", buffer->index},
+                              {"args", {{"name", thread_name}}}});
+      for (const TraceEvent &event : buffer->events) {
+        // Chrome trace timestamps are microseconds
+        trace_events.push_back({{"name", event.name},
+                                {"cat", event.category},
+                                {"ph", "X"},
+                                {"ts", static_cast<double>(event.begin_ns) * 1e-3},
+                                {"dur", static_cast<double>(event.duration_ns) * 1e-3},
+                                {"pid", rank},
+                                {"tid", event.thread_index}});
+      }
+    }
+  }
+  trace_events.push_back(
+      {{"name", "process_name"}, {"ph", "M"}, {"pid", rank}, {"args", {{"name", "rank " + std::to_string(rank)}}}});
+
+  std::ofstream file(path);
+  if (!file) {
+    throw std::runtime_error("Failed to open " + path.string());
+  }
+  file << nlohmann::json{{"traceEvents", std::move(trace_events)}, {"displayTimeUnit", "ns"}}.dump() << '\n';
+}
+
+std::filesystem::path ppc::util::TraceFilePath(int rank) {
+  const auto tmp_dir = env::get<std::string>("PPC_TEST_TMPDIR");
+  const std::filesystem::path dir =
+      tmp_dir.has_value() ? std::filesystem::path(tmp_dir.value()) : std::filesystem::temp_directory_path();
+  const auto shard = GetTestShard();
+  const std::string shard_suffix = shard ? "_shard" + std::to_string(shard->index) : std::string{};
+  return dir / ("ppc_trace_rank" + std::to_string(rank) + shard_suffix + ".json");
+}
+
+void ppc::util::FlushTrace(int rank) {
+  if (!TraceEnabled()) {
+    return;
+  }
+  // Runners flush from their main thread
+  if (ThreadBuffer &buffer = CurrentThreadBuffer(); buffer.name.empty()) {
+    buffer.name = "main";
+  }
+  const std::filesystem::path path = TraceFilePath(rank);
+  try {
+    WriteTrace(path, rank);
+    std::cerr << "[  TRACE  ] Written to " << path.string() << '\n';
+  } catch (const std::exception &e) {
+    std::cerr << "[  TRACE  ] " << e.what() << '\n';
+  }
+}
+
+ppc::util::TraceScope::TraceScope(const char *name, const char *category) : name_(name), category_(category) {
+  if (TraceEnabled()) {
+    begin_ns_ = NowNs();
+  }
+}
+
+ppc::util::TraceScope::~TraceScope() {
+  if (begin_ns_ < 0) {
+    return;
+  }
+  const int64_t end_ns = NowNs();
+  ThreadBuffer &buffer = CurrentThreadBuffer();
+  buffer.events.push_back({.name = name_,
+                           .category = category_,
+                           .begin_ns = begin_ns_,
+                           .duration_ns = end_ns - begin_ns_,
+                           .thread_index = buffer.index});
+}
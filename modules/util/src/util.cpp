@@ -4,9 +4,27 @@
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
 #include <filesystem>
+#include <fstream>
 #include <libenvpp/detail/get.hpp>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#  include <process.h>
+#else
+#  include <unistd.h>
+#endif
 
 namespace {
 
@@ -15,8 +33,45 @@ std::string GetAbsolutePath(const std::string &relative_path) {
   return path.string();
 }
 
+struct CachedSettings {
+  std::filesystem::file_time_type write_time;
+  std::uintmax_t size = 0;
+  std::shared_ptr<const nlohmann::json> json;
+};
+
 }  // namespace
 
+std::shared_ptr<const nlohmann::json> ppc::util::LoadSettingsJson(const std::string &settings_file_path) {
+  static std::mutex cache_mutex;
+  static std::unordered_map<std::string, CachedSettings> cache;
+
+  std::error_code error;
+  const auto write_time = std::filesystem::last_write_time(settings_file_path, error);
+  const auto size = error ? std::uintmax_t{0} : std::filesystem::file_size(settings_file_path, error);
+  const bool cacheable = !error;
+
+  const std::scoped_lock lock(cache_mutex);
+  if (cacheable) {
+    const auto it = cache.find(settings_file_path);
+    if (it != cache.end() && it->second.write_time == write_time && it->second.size == size) {
+      return it->second.json;
+    }
+  }
+
+  std::ifstream file(settings_file_path);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open " + settings_file_path);
+  }
+  auto settings = InitJSONPtr();
+  file >> *settings;
+
+  std::shared_ptr<const nlohmann::json> json = std::move(settings);
+  if (cacheable) {
+    cache.insert_or_assign(settings_file_path, CachedSettings{.write_time = write_time, .size = size, .json = json});
+  }
+  return json;
+}
+
 std::string ppc::util::GetAbsoluteTaskPath(const std::string &id_path, const std::string &relative_path) {
   std::filesystem::path task_relative = std::filesystem::path(id_path) / "data" / relative_path;
   return GetAbsolutePath(task_relative.string());
@@ -30,6 +85,70 @@ int ppc::util::GetNumThreads() {
   return 1;
 }
 
+std::vector<int> ppc::util::GetPerfThreadSweep() {
+  const auto sweep = env::get<std::string>("PPC_PERF_THREAD_SWEEP");
+  std::vector<int> thread_counts;
+  if (!sweep.has_value()) {
+    return thread_counts;
+  }
+  const std::string &value = sweep.value();
+  for (std::size_t start = 0; start <= value.size();) {
+    const std::size_t separator = std::min(value.find(',', start), value.size());
+    const std::string token = value.substr(start, separator - start);
+    std::size_t parsed = 0;
+    int thread_count = 0;
+    try {
+      thread_count = std::stoi(token, &parsed);
+    } catch (const std::exception &) {
+      parsed = 0;
+    }
+    if (parsed != token.size() || thread_count <= 0) {
+      throw std::runtime_error("Invalid PPC_PERF_THREAD_SWEEP entry '" + token + "' in '" + value + "'");
+    }
+    thread_counts.push_back(thread_count);
+    start = separator + 1;
+  }
+  return thread_counts;
+}
+
+std::optional<ppc::util::TestShard> ppc::util::GetTestShard() {
+  auto parse = [](const std::string &token, const std::string &value) {
+    std::size_t parsed = 0;
+    int number = -1;
+    try {
+      number = std::stoi(token, &parsed);
+    } catch (const std::exception &) {
+      parsed = 0;
+    }
+    if (parsed != token.size() || number < 0) {
+      throw std::runtime_error("Invalid test shard '" + value + "'");
+    }
+    return number;
+  };
+  TestShard shard;
+  if (const auto value = env::get<std::string>("PPC_SHARD"); value.has_value()) {
+    const std::size_t separator = value->find('/');
+    if (separator == std::string::npos) {
+      throw std::runtime_error("Invalid PPC_SHARD '" + *value + "', expected <index>/<total>");
+    }
+    shard.index = parse(value->substr(0, separator), *value);
+    shard.total = parse(value->substr(separator + 1), *value);
+  } else {
+    const auto index = env::get<std::string>("GTEST_SHARD_INDEX");
+    const auto total = env::get<std::string>("GTEST_TOTAL_SHARDS");
+    if (!index.has_value() || !total.has_value()) {
+      return std::nullopt;
+    }
+    shard.index = parse(*index, *index + "/" + *total);
+    shard.total = parse(*total, *index + "/" + *total);
+  }
+  if (shard.index >= shard.total) {
+    throw std::runtime_error("Test shard index " + std::to_string(shard.index) + " is not below the total " +
+                             std::to_string(shard.total));
+  }
+  return shard;
+}
+
 int ppc::util::GetNumProc() {
   const auto num_proc = env::get<int>("PPC_NUM_PROC");
   if (num_proc.has_value()) {
@@ -77,6 +196,22 @@ void ppc::util::ConfigureMpiEnvironment() {
 #endif
 }
 
+bool ppc::util::IsMpiActive() {
+  int initialized = 0;
+  int finalized = 0;
+  MPI_Initialized(&initialized);
+  MPI_Finalized(&finalized);
+  return initialized != 0 && finalized == 0;
+}
+
+int ppc::util::GetProcessId() {
+#ifdef _WIN32
+  return _getpid();
+#else
+  return static_cast<int>(getpid());
+#endif
+}
+
 void ppc::util::SynchronizeMpiRanks() {
   int initialized = 0;
   if (MPI_Initialized(&initialized) != MPI_SUCCESS || initialized == 0) {
@@ -0,0 +1,77 @@
+#include "util/include/affinity.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <libenvpp/detail/environment.hpp>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+TEST(Affinity, PolicyDefaultsToNone) {
+  const env::detail::set_scoped_environment_variable policy("PPC_AFFINITY", "none");
+  EXPECT_EQ(ppc::util::GetAffinityPolicy(), ppc::util::AffinityPolicy::kNone);
+}
+
+TEST(Affinity, ParsesPolicies) {
+  {
+    const env::detail::set_scoped_environment_variable policy("PPC_AFFINITY", "compact");
+    EXPECT_EQ(ppc::util::GetAffinityPolicy(), ppc::util::AffinityPolicy::kCompact);
+  }
+  {
+    const env::detail::set_scoped_environment_variable policy("PPC_AFFINITY", "scatter");
+    EXPECT_EQ(ppc::util::GetAffinityPolicy(), ppc::util::AffinityPolicy::kScatter);
+  }
+}
+
+TEST(Affinity, ThrowsOnUnknownPolicy) {
+  const env::detail::set_scoped_environment_variable policy("PPC_AFFINITY", "spread");
+  EXPECT_THROW(ppc::util::GetAffinityPolicy(), std::runtime_error);
+}
+
+TEST(Affinity, CompactOrderFillsNodesInTurn) {
+  const std::vector<std::vector<int>> nodes = {{0, 1, 2}, {4, 5}};
+  const std::vector<int> expected = {0, 1, 2, 4, 5};
+  EXPECT_EQ(ppc::util::MakeAffinityCpuOrder(ppc::util::AffinityPolicy::kCompact, nodes), expected);
+}
+
+TEST(Affinity, ScatterOrderAlternatesNodes) {
+  const std::vector<std::vector<int>> nodes = {{0, 1, 2}, {4, 5}};
+  const std::vector<int> expected = {0, 4, 1, 5, 2};
+  EXPECT_EQ(ppc::util::MakeAffinityCpuOrder(ppc::util::AffinityPolicy::kScatter, nodes), expected);
+}
+
+TEST(Affinity, NoneLeavesThreadsUnpinned) {
+  const ppc::util::ScopedThreadAffinity affinity(ppc::util::AffinityPolicy::kNone, 2);
+  EXPECT_EQ(ppc::util::AffinityCpuForThread(0), -1);
+  EXPECT_TRUE(ppc::util::GetAffinityCpus().empty());
+}
+
+TEST(Affinity, CallingThreadKeepsRankSliceAndGetsMaskBack) {
+  const std::vector<std::vector<int>> before = ppc::util::GetNumaNodeCpus();
+  {
+    const ppc::util::ScopedThreadAffinity affinity(ppc::util::AffinityPolicy::kCompact, 2);
+    std::vector<int> slice = ppc::util::GetAffinityCpus();
+    if (slice.empty()) {
+      GTEST_SKIP() << "Thread pinning is unsupported";
+    }
+    std::ranges::sort(slice);
+    slice.erase(std::ranges::unique(slice).begin(), slice.end());
+    // The calling thread may run on every CPU of the slice, not only on the one of thread 0
+    std::vector<int> allowed;
+    for (const auto &node : ppc::util::GetNumaNodeCpus()) {
+      allowed.insert(allowed.end(), node.begin(), node.end());
+    }
+    std::ranges::sort(allowed);
+    EXPECT_EQ(allowed, slice);
+  }
+  EXPECT_EQ(ppc::util::GetNumaNodeCpus(), before);
+}
+
+TEST(Affinity, FirstTouchFillWritesEveryElement) {
+  std::vector<double> data(1000, 0.0);
+  ppc::util::FirstTouchFill(std::span<double>(data), 2.5);
+  for (const double value : data) {
+    EXPECT_DOUBLE_EQ(value, 2.5);
+  }
+}
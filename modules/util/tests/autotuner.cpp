@@ -0,0 +1,182 @@
+#include "util/include/autotuner.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <libenvpp/detail/environment.hpp>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "task/include/task.hpp"
+#include "util/include/util.hpp"
+
+namespace autotuner_test {
+
+std::atomic<int> seq_runs{0};
+std::atomic<int> omp_runs{0};
+std::atomic<int> tbb_runs{0};
+
+/// Sums the input after sleeping @p kSleepMs, so backends differ only in how long they take.
+template <ppc::task::TypeOfTask kType, int kSleepMs>
+class SleepingSum : public ppc::task::Task<std::vector<int>, int> {
+ public:
+  explicit SleepingSum(std::vector<int> in) {
+    SetTypeOfTask(kType);
+    GetInput() = std::move(in);
+  }
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return kType;
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return true;
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    if constexpr (kType == ppc::task::TypeOfTask::kSEQ) {
+      seq_runs++;
+    } else if constexpr (kType == ppc::task::TypeOfTask::kOMP) {
+      omp_runs++;
+    } else {
+      tbb_runs++;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(kSleepMs));
+    GetOutput() = 0;
+    for (const int value : GetInput()) {
+      GetOutput() += value;
+    }
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+using SlowSeq = SleepingSum<ppc::task::TypeOfTask::kSEQ, 5>;
+using FastOmp = SleepingSum<ppc::task::TypeOfTask::kOMP, 0>;
+using DisabledTbb = SleepingSum<ppc::task::TypeOfTask::kTBB, 0>;
+using Tuner = ppc::util::Autotuner<std::vector<int>, int, SlowSeq, FastOmp, DisabledTbb>;
+
+/// Fails its Run() stage, leaving the pipeline unfinished.
+class FailingSeq : public ppc::task::Task<std::vector<int>, int> {
+ public:
+  explicit FailingSeq(std::vector<int> in) {
+    SetTypeOfTask(ppc::task::TypeOfTask::kSEQ);
+    GetInput() = std::move(in);
+  }
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return ppc::task::TypeOfTask::kSEQ;
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return true;
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    return false;
+  }
+
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+}  // namespace autotuner_test
+
+namespace {
+
+std::size_t SizeOf(const std::vector<int> &input) {
+  return input.size();
+}
+
+/// File in the temporary directory named after the running test and this process, so concurrent runs keep apart.
+std::filesystem::path TempPath(const std::string &name) {
+  return std::filesystem::temp_directory_path() /
+         (ppc::util::test::MakeCurrentGTestToken("autotuner") + "_" +
+          std::to_string(ppc::util::GetProcessId()) + "_" + name);
+}
+
+std::string WriteSettings() {
+  const auto path = TempPath("settings.json");
+  std::ofstream(path) << R"({"tasks": {"seq": "enabled", "omp": "enabled", "tbb": "disabled"}})";
+  return path.string();
+}
+
+}  // namespace
+
+TEST(Autotuner, SizeBucketsArePowersOfTwo) {
+  EXPECT_EQ(ppc::util::AutotuneSizeBucket(0), 0U);
+  EXPECT_EQ(ppc::util::AutotuneSizeBucket(1), 0U);
+  EXPECT_EQ(ppc::util::AutotuneSizeBucket(2), 1U);
+  EXPECT_EQ(ppc::util::AutotuneSizeBucket(1023), 9U);
+  EXPECT_EQ(ppc::util::AutotuneSizeBucket(1024), 10U);
+}
+
+TEST(Autotuner, RoutesToFastestBackendAndPersistsChoice) {
+  using autotuner_test::Tuner;
+  const env::detail::set_scoped_environment_variable num_threads("PPC_NUM_THREADS", "2");
+  EXPECT_EQ(Tuner::CandidateThreadCounts(), (std::vector<int>{1, 2}));
+
+  const std::string settings = WriteSettings();
+  const auto cache_path = TempPath("cache.json");
+  std::filesystem::remove(cache_path);
+  autotuner_test::seq_runs = 0;
+  autotuner_test::tbb_runs = 0;
+
+  Tuner tuner("autotuner_test", SizeOf, settings, {}, cache_path.string());
+  EXPECT_EQ(tuner.Run(std::vector<int>(100, 1)), 100);
+  const int calibration_seq_runs = autotuner_test::seq_runs.load();
+  EXPECT_GT(calibration_seq_runs, 0);
+  EXPECT_EQ(autotuner_test::tbb_runs.load(), 0);
+
+  // Same bucket: routed to the cached winner without probing the slow backend again
+  EXPECT_EQ(tuner.Run(std::vector<int>(120, 2)), 240);
+  EXPECT_EQ(autotuner_test::seq_runs.load(), calibration_seq_runs);
+
+  Tuner reloaded("autotuner_test", SizeOf, settings, {}, cache_path.string());
+  const auto choice = reloaded.Choose(std::vector<int>(64, 0));
+  EXPECT_EQ(choice.type, ppc::task::TypeOfTask::kOMP);
+  EXPECT_GT(choice.num_threads, 0);
+  EXPECT_EQ(autotuner_test::seq_runs.load(), calibration_seq_runs);
+
+  std::filesystem::remove(cache_path);
+  std::filesystem::remove(settings);
+}
+
+TEST(Autotuner, RejectsMalformedCache) {
+  const auto cache_path = TempPath("broken.json");
+  std::ofstream(cache_path) << R"({"choices": {"key": {"task": 1}}})";
+  EXPECT_THROW(ppc::util::AutotuneCache(cache_path.string()), std::runtime_error);
+  std::filesystem::remove(cache_path);
+}
+
+TEST(Autotuner, FailingCandidateEndsItsPipeline) {
+  const std::string settings = WriteSettings();
+  ppc::util::Autotuner<std::vector<int>, int, autotuner_test::FailingSeq> tuner("autotuner_failing", SizeOf, settings,
+                                                                                {}, std::nullopt);
+  EXPECT_THROW((void)tuner.Run(std::vector<int>(8, 1)), std::runtime_error);
+  // The failed task was ended before it was destroyed, so it is not reported as left mid-pipeline
+  EXPECT_FALSE(ppc::util::DestructorFailureFlag::Get());
+  std::filesystem::remove(settings);
+}
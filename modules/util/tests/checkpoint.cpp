@@ -0,0 +1,117 @@
+#include "util/include/checkpoint.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <libenvpp/detail/environment.hpp>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "util/include/util.hpp"
+
+namespace {
+
+/// Counts iterations; the counter is the whole checkpointed state.
+struct Counter {
+  int iteration = 0;
+
+  [[nodiscard]] std::vector<std::byte> SaveState() const {
+    std::vector<std::byte> state(sizeof(iteration));
+    std::memcpy(state.data(), &iteration, sizeof(iteration));
+    return state;
+  }
+
+  bool LoadState(std::span<const std::byte> state) {
+    if (state.size() != sizeof(iteration)) {
+      return false;
+    }
+    std::memcpy(&iteration, state.data(), sizeof(iteration));
+    return true;
+  }
+};
+
+static_assert(ppc::util::Checkpointable<Counter>);
+
+/// Directory named after the running test and this process, so concurrent runs keep apart.
+std::filesystem::path CheckpointDir() {
+  return std::filesystem::temp_directory_path() / (ppc::util::test::MakeCurrentGTestToken("checkpoint") + "_" +
+                                                   std::to_string(ppc::util::GetProcessId()));
+}
+
+}  // namespace
+
+TEST(Checkpoint, RoundTripsLocalState) {
+  const auto path = (CheckpointDir() / "round_trip.ckpt").string();
+  const std::vector<std::byte> state = {std::byte{1}, std::byte{2}, std::byte{3}};
+  ppc::util::WriteCheckpoint(path, "size:3", state);
+
+  EXPECT_EQ(ppc::util::ReadCheckpoint(path, "size:3"), state);
+  EXPECT_FALSE(ppc::util::ReadCheckpoint(path, "size:4").has_value());
+  EXPECT_FALSE(ppc::util::ReadCheckpoint(path + ".missing", "size:3").has_value());
+  std::filesystem::remove_all(CheckpointDir());
+}
+
+TEST(Checkpoint, RejectsTruncatedFile) {
+  const auto path = (CheckpointDir() / "truncated.ckpt").string();
+  ppc::util::WriteCheckpoint(path, "input", std::vector<std::byte>(64, std::byte{7}));
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+  EXPECT_THROW((void)ppc::util::ReadCheckpoint(path, "input"), std::runtime_error);
+
+  std::ofstream(path, std::ios::trunc) << "not a checkpoint";
+  EXPECT_THROW((void)ppc::util::ReadCheckpoint(path, "input"), std::runtime_error);
+  std::filesystem::remove_all(CheckpointDir());
+}
+
+TEST(Checkpoint, FailedReplaceRemovesTemporary) {
+  // A directory in place of the checkpoint makes the final rename fail
+  const auto path = (CheckpointDir() / "blocked.ckpt").string();
+  std::filesystem::create_directories(path);
+  EXPECT_THROW(ppc::util::WriteCheckpoint(path, "input", std::vector<std::byte>(8, std::byte{1})), std::runtime_error);
+  EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+  std::filesystem::remove_all(CheckpointDir());
+}
+
+TEST(Checkpoint, CheckpointerIsDisabledByDefault) {
+  const env::detail::set_scoped_environment_variable interval("PPC_CHECKPOINT_INTERVAL", "0");
+  ppc::util::Checkpointer checkpointer("disabled", "input");
+  Counter counter;
+  EXPECT_FALSE(checkpointer.Enabled());
+  EXPECT_FALSE(checkpointer.Step(counter));
+  EXPECT_FALSE(checkpointer.Resume(counter));
+  EXPECT_FALSE(std::filesystem::exists(checkpointer.Path()));
+}
+
+TEST(Checkpoint, CheckpointerResumesInterruptedRun) {
+  const env::detail::set_scoped_environment_variable interval("PPC_CHECKPOINT_INTERVAL", "1e-9");
+  const env::detail::set_scoped_environment_variable dir("PPC_CHECKPOINT_DIR", CheckpointDir().string());
+
+  {
+    ppc::util::Checkpointer checkpointer("my task", "input");
+    EXPECT_EQ(std::filesystem::path(checkpointer.Path()).parent_path(), CheckpointDir());
+    Counter counter;
+    EXPECT_FALSE(checkpointer.Resume(counter));
+    for (counter.iteration = 1; counter.iteration <= 5; counter.iteration++) {
+      EXPECT_TRUE(checkpointer.Step(counter));
+    }
+    // Stops here as if the run were killed, leaving the checkpoint of iteration 5 behind
+  }
+
+  ppc::util::Checkpointer checkpointer("my task", "input");
+  Counter counter;
+  ASSERT_TRUE(checkpointer.Resume(counter));
+  EXPECT_EQ(counter.iteration, 5);
+
+  ppc::util::Checkpointer other_input("my task", "other input");
+  Counter fresh;
+  EXPECT_FALSE(other_input.Resume(fresh));
+  EXPECT_EQ(fresh.iteration, 0);
+
+  checkpointer.Complete();
+  EXPECT_FALSE(std::filesystem::exists(checkpointer.Path()));
+  std::filesystem::remove_all(CheckpointDir());
+}
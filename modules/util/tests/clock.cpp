@@ -0,0 +1,60 @@
+#include "util/include/clock.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <libenvpp/detail/environment.hpp>
+#include <stdexcept>
+#include <thread>
+
+#include "task/include/task.hpp"
+#include "util/include/perf_test_util.hpp"
+
+TEST(Clock, TracksSteadyClock) {
+  const auto &calibration = ppc::util::GetClockCalibration();
+  EXPECT_GT(calibration.resolution, 0.0);
+  EXPECT_GT(calibration.overhead, 0.0);
+
+  // The steady interval lies inside the measured one; preemption can only widen the measured one
+  const double begin = ppc::util::ClockNow();
+  const auto steady_begin = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  const std::chrono::duration<double> steady = std::chrono::steady_clock::now() - steady_begin;
+  const double end = ppc::util::ClockNow();
+
+  EXPECT_GE(begin, 0.0);
+  EXPECT_GE(end - begin, 0.95 * steady.count());
+  EXPECT_LT(end - begin, (1.05 * steady.count()) + 0.05);
+}
+
+TEST(Clock, CalibratesEverySource) {
+  const auto raw = ppc::util::detail::CalibrateClock(ppc::util::ClockSource::kMonotonicRaw);
+  EXPECT_DOUBLE_EQ(raw.seconds_per_tick, 1e-9);
+  if (!ppc::util::InvariantTscAvailable()) {
+    GTEST_SKIP() << "No invariant TSC";
+  }
+  const auto tsc = ppc::util::detail::CalibrateClock(ppc::util::ClockSource::kTsc);
+  // Between 100 MHz and 100 GHz
+  EXPECT_GT(tsc.seconds_per_tick, 1e-11);
+  EXPECT_LT(tsc.seconds_per_tick, 1e-8);
+}
+
+TEST(Clock, ReadsSourceFromEnvironment) {
+  {
+    const env::detail::set_scoped_environment_variable clock("PPC_CLOCK", "monotonic_raw");
+    EXPECT_EQ(ppc::util::GetClockSource(), ppc::util::ClockSource::kMonotonicRaw);
+  }
+  const env::detail::set_scoped_environment_variable clock("PPC_CLOCK", "hpet");
+  EXPECT_THROW((void)ppc::util::GetClockSource(), std::runtime_error);
+}
+
+TEST(Clock, EveryBackendReadsTheSameClock) {
+  const auto seq_timer = ppc::util::detail::MakeTechnologyTimer(ppc::task::TypeOfTask::kSEQ);
+  const auto tbb_timer = ppc::util::detail::MakeTechnologyTimer(ppc::task::TypeOfTask::kTBB);
+  const double seq_begin = seq_timer();
+  const double tbb_now = tbb_timer();
+  const double seq_end = seq_timer();
+  EXPECT_LE(seq_begin, tbb_now);
+  EXPECT_LE(tbb_now, seq_end);
+  EXPECT_THROW((void)ppc::util::detail::MakeTechnologyTimer(ppc::task::TypeOfTask::kUnknown), std::runtime_error);
+}
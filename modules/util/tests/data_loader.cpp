@@ -0,0 +1,87 @@
+#include "util/include/data_loader.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "util/include/util.hpp"
+
+namespace {
+
+/// Writes @p contents to a temporary file named after the running test and this process, so concurrent runs keep
+/// apart.
+std::filesystem::path WriteTempFile(const std::string &name, std::string_view contents) {
+  const auto path = std::filesystem::temp_directory_path() /
+                    (ppc::util::test::MakeCurrentGTestToken("data_loader") + "_" +
+                     std::to_string(ppc::util::GetProcessId()) + "_" + name);
+  std::ofstream(path, std::ios::binary).write(contents.data(), static_cast<std::streamsize>(contents.size()));
+  return path;
+}
+
+std::span<const std::byte> AsBytes(std::string_view text) {
+  return std::as_bytes(std::span(text.data(), text.size()));
+}
+
+}  // namespace
+
+TEST(DataLoader, MapsWholeFile) {
+  const auto path = WriteTempFile("ppc_data_loader_map.bin", "abcdef");
+  const ppc::util::MappedFile file(path.string());
+  ASSERT_EQ(file.Bytes().size(), 6U);
+  EXPECT_EQ(static_cast<char>(file.Bytes()[2]), 'c');
+  std::filesystem::remove(path);
+}
+
+TEST(DataLoader, ViewsBinaryArraysWithoutCopying) {
+  const std::array<int32_t, 3> values = {1, -2, 3};
+  const auto path = WriteTempFile("ppc_data_loader_ints.bin",
+                                  std::string_view(reinterpret_cast<const char *>(values.data()), sizeof(values)));
+  const ppc::util::MappedFile file(path.string());
+  const auto view = file.As<int32_t>();
+  ASSERT_EQ(view.size(), values.size());
+  EXPECT_EQ(view[1], -2);
+  EXPECT_THROW((void)file.As<int64_t>(), std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(DataLoader, CachesMappingsUntilFileChanges) {
+  const auto path = WriteTempFile("ppc_data_loader_cache.bin", "1234");
+  const auto first = ppc::util::MapDataFile(path.string());
+  EXPECT_EQ(ppc::util::MapDataFile(path.string()), first);
+
+  WriteTempFile("ppc_data_loader_cache.bin", "123456");
+  const auto changed = ppc::util::MapDataFile(path.string());
+  EXPECT_NE(changed, first);
+  EXPECT_EQ(changed->Bytes().size(), 6U);
+  ppc::util::ClearDataFileCache();
+  std::filesystem::remove(path);
+}
+
+TEST(DataLoader, ThrowsForMissingFile) {
+  EXPECT_THROW(ppc::util::MapDataFile("/nonexistent/ppc_data_loader.bin"), std::runtime_error);
+}
+
+TEST(DataLoader, ParsesPpmWithComments) {
+  const std::string ppm = std::string("P6\n# comment\n2 1\n255\n") + std::string("\x01\x02\x03\x04\x05\x06", 6);
+  const auto image = ppc::util::ParsePnm(AsBytes(ppm));
+  EXPECT_EQ(image.width, 2);
+  EXPECT_EQ(image.height, 1);
+  EXPECT_EQ(image.channels, 3);
+  ASSERT_EQ(image.pixels.size(), 6U);
+  EXPECT_EQ(image.pixels[5], 6);
+}
+
+TEST(DataLoader, RejectsTruncatedOrUnsupportedImages) {
+  EXPECT_THROW(ppc::util::ParsePnm(AsBytes("P6\n2 2\n255\n\x01")), std::runtime_error);
+  EXPECT_THROW(ppc::util::ParsePnm(AsBytes("P3\n1 1\n255\n1 2 3")), std::runtime_error);
+  EXPECT_THROW(ppc::util::ParsePnm(AsBytes("P5\n1 1\n65535\n\x01\x02")), std::runtime_error);
+}
@@ -0,0 +1,129 @@
+#include "util/include/dataset.hpp"
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "util/include/util.hpp"
+
+namespace {
+
+/// Temporary file named after the running test and the process @p owner_pid, so concurrent runs keep apart.
+std::string TempDatasetPath(const std::string &name, int owner_pid = ppc::util::GetProcessId()) {
+  return (std::filesystem::temp_directory_path() /
+          (ppc::util::test::MakeCurrentGTestToken("dataset") + "_" + std::to_string(owner_pid) + "_" + name))
+      .string();
+}
+
+std::vector<int32_t> Iota(std::size_t count) {
+  std::vector<int32_t> values(count);
+  std::iota(values.begin(), values.end(), -5);
+  return values;
+}
+
+}  // namespace
+
+TEST(Dataset, RoundTripsHeaderAndData) {
+  const auto path = TempDatasetPath("ppc_dataset_round_trip.bin");
+  const std::vector<int32_t> values = Iota(30);
+  ppc::util::WriteDataset(path, std::span<const int32_t>(values), {5, 6}, 7);
+
+  const ppc::util::DatasetReader reader(path);
+  EXPECT_EQ(reader.Header().type, ppc::util::DatasetType::kInt32);
+  EXPECT_EQ(reader.Header().shape, (std::vector<uint64_t>{5, 6}));
+  ASSERT_EQ(reader.Header().chunks.size(), 5U);
+  EXPECT_EQ(reader.Header().chunks.front().offset % 64, 0U);
+  EXPECT_EQ(reader.Header().chunks.back().bytes, 2 * sizeof(int32_t));
+  EXPECT_EQ(reader.ReadAll<int32_t>(), values);
+  std::filesystem::remove(path);
+}
+
+TEST(Dataset, ReadsChunkRange) {
+  const auto path = TempDatasetPath("ppc_dataset_range.bin");
+  const std::vector<int32_t> values = Iota(20);
+  ppc::util::WriteDataset(path, std::span<const int32_t>(values), {20}, 4);
+
+  const ppc::util::DatasetReader reader(path);
+  std::vector<int32_t> middle(8);
+  reader.ReadChunksBytes(2, 2, std::as_writable_bytes(std::span(middle)));
+  EXPECT_EQ(middle, std::vector<int32_t>(values.begin() + 8, values.begin() + 16));
+  std::filesystem::remove(path);
+}
+
+TEST(Dataset, DetectsCorruptedChunk) {
+  const auto path = TempDatasetPath("ppc_dataset_corrupt.bin");
+  const std::vector<int32_t> values = Iota(16);
+  ppc::util::WriteDataset(path, std::span<const int32_t>(values), {16}, 4);
+  const uint64_t offset = ppc::util::DatasetReader(path).Header().chunks[1].offset;
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(static_cast<std::streamoff>(offset));
+    file.put('\x7f');
+  }
+
+  EXPECT_THROW((void)ppc::util::DatasetReader(path).ReadAll<int32_t>(), std::runtime_error);
+  EXPECT_NO_THROW((void)ppc::util::DatasetReader(path, false).ReadAll<int32_t>());
+  std::filesystem::remove(path);
+}
+
+TEST(Dataset, RejectsMismatchedTypeAndShape) {
+  const auto path = TempDatasetPath("ppc_dataset_type.bin");
+  const std::vector<int32_t> values = Iota(6);
+  EXPECT_THROW(ppc::util::WriteDataset(path, std::span<const int32_t>(values), {4}, 2), std::runtime_error);
+  ppc::util::WriteDataset(path, std::span<const int32_t>(values), {2, 3}, 2);
+  EXPECT_THROW((void)ppc::util::DatasetReader(path).ReadAll<float>(), std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(Dataset, RejectsForeignFile) {
+  const auto path = TempDatasetPath("ppc_dataset_foreign.bin");
+  std::ofstream(path, std::ios::binary) << "not a dataset at all";
+  EXPECT_THROW(ppc::util::DatasetReader{path}, std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(Dataset, LocalChunksCoverDatasetAcrossRanks) {
+  const std::vector<int32_t> values = Iota(50);
+  int rank = 0;
+  int initialized = 0;
+  int owner_pid = ppc::util::GetProcessId();
+  MPI_Initialized(&initialized);
+  if (initialized != 0) {
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    // Every rank reads the file rank 0 writes
+    MPI_Bcast(&owner_pid, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  }
+  const auto path = TempDatasetPath("ppc_dataset_local.bin", owner_pid);
+  if (rank == 0) {
+    ppc::util::WriteDataset(path, std::span<const int32_t>(values), {50}, 8);
+  }
+  if (initialized != 0) {
+    MPI_Barrier(MPI_COMM_WORLD);
+  }
+
+  const ppc::util::DatasetReader reader(path);
+  const auto slice = reader.ReadLocalChunks<int32_t>(MPI_COMM_WORLD);
+  ASSERT_LE(slice.first_element + slice.data.size(), values.size());
+  for (std::size_t i = 0; i < slice.data.size(); i++) {
+    EXPECT_EQ(slice.data[i], values[slice.first_element + i]);
+  }
+  std::size_t total = slice.data.size();
+  if (initialized != 0) {
+    MPI_Allreduce(MPI_IN_PLACE, &total, 1, MPI_UNSIGNED_LONG, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Barrier(MPI_COMM_WORLD);
+  }
+  EXPECT_EQ(total, values.size());
+  if (rank == 0) {
+    std::filesystem::remove(path);
+  }
+}
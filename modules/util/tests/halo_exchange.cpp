@@ -0,0 +1,66 @@
+#include "util/include/halo_exchange.hpp"
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "util/include/decomposition.hpp"
+
+TEST(Decomposition, BlockPartitionGivesRemainderToFirstBlocks) {
+  EXPECT_EQ(ppc::util::BlockPartition(10, 3, 0).begin, 0);
+  EXPECT_EQ(ppc::util::BlockPartition(10, 3, 0).count, 4);
+  EXPECT_EQ(ppc::util::BlockPartition(10, 3, 1).begin, 4);
+  EXPECT_EQ(ppc::util::BlockPartition(10, 3, 2).begin, 7);
+  EXPECT_EQ(ppc::util::BlockPartition(10, 3, 2).End(), 10);
+  EXPECT_EQ(ppc::util::BlockPartition(2, 4, 3).count, 0);
+}
+
+TEST(Decomposition, SingleProcessOwnsWholeGrid) {
+  const ppc::util::BlockDecomposition decomposition(MPI_COMM_WORLD, {6, 9});
+  ASSERT_EQ(decomposition.NumDims(), 2);
+  EXPECT_EQ(decomposition.Local(0).count, 6);
+  EXPECT_EQ(decomposition.Local(1).count, 9);
+  EXPECT_EQ(decomposition.Neighbor(0, -1), MPI_PROC_NULL);
+  EXPECT_EQ(decomposition.Neighbor(1, 1), MPI_PROC_NULL);
+}
+
+TEST(Decomposition, RejectsEmptyOrMismatchedDims) {
+  EXPECT_THROW(ppc::util::BlockDecomposition(MPI_COMM_WORLD, {}), std::runtime_error);
+  EXPECT_THROW(ppc::util::BlockDecomposition(MPI_COMM_WORLD, {4, 4}, {1}), std::runtime_error);
+}
+
+TEST(HaloExchange, LeavesGridEdgeGhostsUntouched) {
+  const ppc::util::BlockDecomposition decomposition(MPI_COMM_WORLD, {4, 5});
+  std::vector<double> field(ppc::util::HaloExchange<double>::PaddedSize(decomposition, 1), -1.0);
+  EXPECT_EQ(field.size(), 6U * 7U);
+  ppc::util::HaloExchange<double> halo(decomposition, std::span(field));
+  halo.Exchange();
+  EXPECT_EQ(field.front(), -1.0);
+  EXPECT_EQ(field.back(), -1.0);
+}
+
+TEST(HaloExchange, RejectsWrongFieldSizeAndThinBlocks) {
+  const ppc::util::BlockDecomposition decomposition(MPI_COMM_WORLD, {3});
+  std::vector<int> field(4);
+  EXPECT_THROW(ppc::util::HaloExchange<int>(decomposition, std::span(field)), std::runtime_error);
+  std::vector<int> wide(ppc::util::HaloExchange<int>::PaddedSize(decomposition, 4));
+  EXPECT_THROW(ppc::util::HaloExchange<int>(decomposition, std::span(wide), 4), std::runtime_error);
+}
+
+TEST(HaloExchange, PendingAllreduceDeliversResult) {
+  const std::array<int64_t, 2> local = {3, -4};
+  std::array<int64_t, 2> global{};
+  {
+    ppc::util::PendingAllreduce<int64_t> sum(local, global, MPI_MAX);
+    sum.Wait();
+    EXPECT_TRUE(sum.Test());
+  }
+  EXPECT_EQ(global[0], 3);
+  EXPECT_EQ(global[1], -4);
+}
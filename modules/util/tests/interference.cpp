@@ -0,0 +1,55 @@
+#include "util/include/interference.hpp"
+
+#include <gtest/gtest.h>
+
+#include <libenvpp/detail/environment.hpp>
+#include <stdexcept>
+
+TEST(Interference, ParsesModes) {
+  {
+    const env::detail::set_scoped_environment_variable mode("PPC_PERF_INTERFERENCE", "off");
+    EXPECT_EQ(ppc::util::GetInterferenceMode(), ppc::util::InterferenceMode::kOff);
+  }
+  {
+    const env::detail::set_scoped_environment_variable mode("PPC_PERF_INTERFERENCE", "record");
+    EXPECT_EQ(ppc::util::GetInterferenceMode(), ppc::util::InterferenceMode::kRecord);
+  }
+  {
+    const env::detail::set_scoped_environment_variable mode("PPC_PERF_INTERFERENCE", "pause");
+    EXPECT_EQ(ppc::util::GetInterferenceMode(), ppc::util::InterferenceMode::kPause);
+  }
+  const env::detail::set_scoped_environment_variable mode("PPC_PERF_INTERFERENCE", "retry");
+  EXPECT_THROW((void)ppc::util::GetInterferenceMode(), std::runtime_error);
+}
+
+TEST(Interference, RejectsThresholdOutsideUnitInterval) {
+  const env::detail::set_scoped_environment_variable threshold("PPC_PERF_INTERFERENCE_THRESHOLD", "1.5");
+  EXPECT_THROW((void)ppc::util::GetInterferenceThreshold(), std::runtime_error);
+}
+
+TEST(Interference, SlowdownIsTheLargerDrop) {
+  const ppc::util::InterferenceSample reference{.bytes_per_second = 10.0, .core_steps_per_second = 100.0};
+  // Bandwidth dropped by 30 %, core rate by 10 %
+  const ppc::util::InterferenceSample interfered{.bytes_per_second = 7.0, .core_steps_per_second = 90.0};
+  EXPECT_DOUBLE_EQ(ppc::util::InterferenceSlowdown(interfered, reference), 0.3);
+  const ppc::util::InterferenceSample faster{.bytes_per_second = 12.0, .core_steps_per_second = 110.0};
+  EXPECT_DOUBLE_EQ(ppc::util::InterferenceSlowdown(faster, reference), 0.0);
+  EXPECT_DOUBLE_EQ(ppc::util::InterferenceSlowdown(reference, ppc::util::InterferenceSample{}), 0.0);
+}
+
+TEST(Interference, ProbeKeepsTheBestRatesAsReference) {
+  const auto first = ppc::util::ProbeInterference();
+  EXPECT_GT(first.sample.bytes_per_second, 0.0);
+  EXPECT_GT(first.sample.core_steps_per_second, 0.0);
+  const auto second = ppc::util::ProbeInterference();
+  const auto reference = ppc::util::GetInterferenceReference();
+  ASSERT_TRUE(reference.has_value());
+  EXPECT_GE(reference->bytes_per_second, second.sample.bytes_per_second);
+  EXPECT_GE(reference->core_steps_per_second, second.sample.core_steps_per_second);
+  EXPECT_GE(second.slowdown, 0.0);
+  EXPECT_LT(second.slowdown, 1.0);
+}
+
+TEST(Interference, JoinCgroupThrowsForMissingDirectory) {
+  EXPECT_THROW((void)ppc::util::JoinCgroup("/nonexistent/ppc_cgroup"), std::runtime_error);
+}
@@ -0,0 +1,46 @@
+#include "util/include/load_balance.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+TEST(LoadBalance, ImbalanceOfEqualTimesIsOne) {
+  const std::vector<double> times = {2.0, 2.0, 2.0};
+  const auto imbalance = ppc::util::ComputeLoadImbalance(times);
+  EXPECT_DOUBLE_EQ(imbalance.min, 2.0);
+  EXPECT_DOUBLE_EQ(imbalance.mean, 2.0);
+  EXPECT_DOUBLE_EQ(imbalance.max, 2.0);
+  EXPECT_DOUBLE_EQ(imbalance.factor, 1.0);
+}
+
+TEST(LoadBalance, ImbalanceIsMaxOverMean) {
+  const std::vector<double> times = {1.0, 1.0, 4.0};
+  const auto imbalance = ppc::util::ComputeLoadImbalance(times);
+  EXPECT_DOUBLE_EQ(imbalance.min, 1.0);
+  EXPECT_DOUBLE_EQ(imbalance.mean, 2.0);
+  EXPECT_DOUBLE_EQ(imbalance.max, 4.0);
+  EXPECT_DOUBLE_EQ(imbalance.factor, 2.0);
+}
+
+TEST(LoadBalance, EmptyTimesAreBalanced) {
+  EXPECT_DOUBLE_EQ(ppc::util::ComputeLoadImbalance({}).factor, 1.0);
+}
+
+TEST(LoadBalance, TrackerCollectsBusyTimeOfWorkingThreads) {
+  ppc::util::LoadBalanceTracker tracker;
+  tracker.Start();
+  std::thread worker([] {
+    const ppc::util::ScopedBusyTime busy;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  });
+  worker.join();
+  tracker.Stop(0.5);
+
+  EXPECT_EQ(tracker.Runs(), 1U);
+  EXPECT_DOUBLE_EQ(tracker.RunTime(), 0.5);
+  const std::vector<double> busy = tracker.ThreadBusyTimes();
+  ASSERT_EQ(busy.size(), 1U);
+  EXPECT_GE(busy[0], 0.015);
+}
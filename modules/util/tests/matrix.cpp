@@ -0,0 +1,114 @@
+#include "util/include/matrix.hpp"
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "util/include/util.hpp"
+
+namespace {
+
+ppc::util::Matrix<double> MakeSequential(std::size_t rows, std::size_t cols, ppc::util::MatrixLayout layout,
+                                         std::size_t tile = 8) {
+  ppc::util::Matrix<double> matrix(rows, cols, layout, tile);
+  for (std::size_t row = 0; row < rows; row++) {
+    for (std::size_t col = 0; col < cols; col++) {
+      matrix(row, col) = static_cast<double>((row * cols) + col) * 0.5;
+    }
+  }
+  return matrix;
+}
+
+}  // namespace
+
+TEST(Matrix, OffsetsFollowLayout) {
+  const ppc::util::Matrix<double> row_major(3, 5, ppc::util::MatrixLayout::kRowMajor);
+  const ppc::util::Matrix<double> col_major(3, 5, ppc::util::MatrixLayout::kColMajor);
+  const ppc::util::Matrix<double> tiled(10, 10, ppc::util::MatrixLayout::kTiled, 8);
+  EXPECT_EQ(row_major.Offset(1, 2), 7U);
+  EXPECT_EQ(col_major.Offset(1, 2), 7U);
+  EXPECT_EQ(col_major.Offset(2, 1), 5U);
+  EXPECT_EQ(tiled.Offset(1, 2), 10U);
+  EXPECT_EQ(tiled.Offset(0, 8), 64U);
+  EXPECT_EQ(tiled.Offset(9, 9), (3U * 64U) + 9U);
+  EXPECT_EQ(tiled.Storage().size(), 4U * 64U);
+}
+
+TEST(Matrix, StorageIsCacheLineAligned) {
+  const ppc::util::Matrix<float> matrix(7, 3, ppc::util::MatrixLayout::kTiled, 4);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(matrix.Storage().data()) % 64, 0U);
+  EXPECT_THROW(ppc::util::Matrix<double>(4, 4, ppc::util::MatrixLayout::kTiled, 2), std::runtime_error);
+}
+
+TEST(Matrix, LayoutConversionKeepsElements) {
+  const auto original = MakeSequential(11, 6, ppc::util::MatrixLayout::kRowMajor);
+  const auto round_trip = original.ToLayout(ppc::util::MatrixLayout::kTiled, 4)
+                              .ToLayout(ppc::util::MatrixLayout::kColMajor)
+                              .ToLayout(ppc::util::MatrixLayout::kRowMajor);
+  for (std::size_t row = 0; row < original.Rows(); row++) {
+    for (std::size_t col = 0; col < original.Cols(); col++) {
+      EXPECT_EQ(round_trip(row, col), original(row, col));
+    }
+  }
+}
+
+TEST(Matrix, BlockViewAliasesMatrix) {
+  auto matrix = MakeSequential(6, 6, ppc::util::MatrixLayout::kColMajor);
+  const auto block = matrix.Block(2, 3, 2, 3);
+  EXPECT_EQ(block(1, 2), matrix(3, 5));
+  block(0, 0) = -1.0;
+  EXPECT_EQ(matrix(2, 3), -1.0);
+  EXPECT_EQ(block.BasePointer(), &matrix(2, 3));
+  EXPECT_THROW((void)matrix.Block(4, 4, 3, 1), std::runtime_error);
+}
+
+TEST(Matrix, TiledBlockTypeRequiresTileBoundaries) {
+  if (!ppc::util::IsMpiActive()) {
+    GTEST_SKIP() << "Needs MPI for derived datatypes";
+  }
+  const auto matrix = MakeSequential(20, 20, ppc::util::MatrixLayout::kTiled);
+  EXPECT_THROW((void)matrix.Block(4, 0, 8, 8).MpiBlockType(), std::runtime_error);
+  const auto edge = matrix.Block(16, 8, 4, 12).MpiBlockType();
+  int size = 0;
+  MPI_Type_size(edge.Get(), &size);
+  EXPECT_EQ(static_cast<std::size_t>(size), 2U * 64U * sizeof(double));
+}
+
+TEST(Matrix, GemmMatchesNaiveProductForEveryLayout) {
+  constexpr std::size_t kM = 13;
+  constexpr std::size_t kK = 9;
+  constexpr std::size_t kN = 17;
+  const auto a = MakeSequential(kM, kK, ppc::util::MatrixLayout::kRowMajor);
+  const auto b = MakeSequential(kK, kN, ppc::util::MatrixLayout::kRowMajor);
+  ppc::util::Matrix<double> expected(kM, kN);
+  for (std::size_t i = 0; i < kM; i++) {
+    for (std::size_t j = 0; j < kN; j++) {
+      double sum = 0.0;
+      for (std::size_t k = 0; k < kK; k++) {
+        sum += a(i, k) * b(k, j);
+      }
+      expected(i, j) = (2.0 * sum) + 3.0;
+    }
+  }
+  for (const auto layout :
+       {ppc::util::MatrixLayout::kRowMajor, ppc::util::MatrixLayout::kColMajor, ppc::util::MatrixLayout::kTiled}) {
+    ppc::util::Matrix<double> c(kM, kN, layout, 8);
+    for (std::size_t i = 0; i < kM; i++) {
+      for (std::size_t j = 0; j < kN; j++) {
+        c(i, j) = 1.0;
+      }
+    }
+    ppc::util::Gemm(a.ToLayout(layout, 8), b.ToLayout(layout, 8), c, 2.0, 3.0);
+    for (std::size_t i = 0; i < kM; i++) {
+      for (std::size_t j = 0; j < kN; j++) {
+        EXPECT_DOUBLE_EQ(c(i, j), expected(i, j));
+      }
+    }
+  }
+  ppc::util::Matrix<double> mismatched(kM, kM);
+  EXPECT_THROW(ppc::util::Gemm(a, b, mismatched), std::runtime_error);
+}
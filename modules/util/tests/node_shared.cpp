@@ -0,0 +1,27 @@
+#include "util/include/node_shared.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+TEST(NodeShared, ViewHoldsRootData) {
+  std::vector<double> values(1000);
+  std::iota(values.begin(), values.end(), 0.5);
+  const ppc::util::NodeSharedArray<double> shared(values, values.size());
+  ASSERT_EQ(shared.View().size(), values.size());
+  EXPECT_TRUE(std::equal(values.begin(), values.end(), shared.View().begin()));
+}
+
+TEST(NodeShared, EmptyArrayHasEmptyView) {
+  const ppc::util::NodeSharedArray<int> shared(std::span<const int>{}, 0);
+  EXPECT_TRUE(shared.View().empty());
+}
+
+TEST(NodeShared, RejectsDataShorterThanBuffer) {
+  const std::vector<int> values(3);
+  EXPECT_THROW(ppc::util::NodeSharedArray<int>(values, 4), std::runtime_error);
+}
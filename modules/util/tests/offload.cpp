@@ -0,0 +1,105 @@
+#include "util/include/offload.hpp"
+
+#include <gtest/gtest.h>
+
+#include <omp.h>
+
+#include <cstddef>
+#include <libenvpp/detail/environment.hpp>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "task/include/task.hpp"
+#include "util/include/perf_test_util.hpp"
+
+namespace {
+
+/// Squares its input on the offload device, or on the host without one.
+class SquareOffloadTask : public ppc::task::Task<std::vector<int>, std::vector<int>> {
+ public:
+  explicit SquareOffloadTask(std::vector<int> in) {
+    SetTypeOfTask(ppc::task::TypeOfTask::kOffload);
+    GetInput() = std::move(in);
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return !GetInput().empty();
+  }
+
+  bool PreProcessingImpl() override {
+    GetOutput().resize(GetInput().size());
+    return true;
+  }
+
+  bool RunImpl() override {
+    ppc::util::DeviceBuffer<int> values(GetInput().size());
+    values.Upload(GetInput());
+    int *data = values.Data();
+    const int size = static_cast<int>(values.Size());
+#pragma omp target teams distribute parallel for is_device_ptr(data) device(values.Device())
+    for (int i = 0; i < size; i++) {
+      data[i] *= data[i];
+    }
+    values.Download(GetOutput());
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+}  // namespace
+
+TEST(Offload, DeviceBufferRoundTripsAndRecordsTransfers) {
+  ppc::util::ResetOffloadTransfers();
+  std::vector<double> host(64);
+  std::iota(host.begin(), host.end(), 0.0);
+  ppc::util::DeviceBuffer<double> buffer(host.size());
+  buffer.Upload(host);
+
+  std::vector<double> copy(host.size());
+  buffer.Download(copy);
+  EXPECT_EQ(copy, host);
+
+  const auto uploads = ppc::util::GetOffloadTransferStats(ppc::util::OffloadDirection::kHostToDevice);
+  const auto downloads = ppc::util::GetOffloadTransferStats(ppc::util::OffloadDirection::kDeviceToHost);
+  EXPECT_EQ(uploads.copies, 1U);
+  EXPECT_EQ(uploads.bytes, host.size() * sizeof(double));
+  EXPECT_EQ(downloads.copies, 1U);
+  EXPECT_GE(downloads.time, 0.0);
+
+  EXPECT_THROW(buffer.Upload(std::vector<double>(3)), std::runtime_error);
+  ppc::util::ResetOffloadTransfers();
+  EXPECT_EQ(ppc::util::GetOffloadTransferStats(ppc::util::OffloadDirection::kHostToDevice).copies, 0U);
+}
+
+TEST(Offload, RejectsMissingDevice) {
+  const env::detail::set_scoped_environment_variable device("PPC_OFFLOAD_DEVICE", "1000");
+  EXPECT_THROW((void)ppc::util::GetOffloadDevice(), std::runtime_error);
+}
+
+TEST(Offload, AcceptsInitialDevice) {
+  const int host = omp_get_initial_device();
+  const env::detail::set_scoped_environment_variable device("PPC_OFFLOAD_DEVICE", std::to_string(host));
+  EXPECT_EQ(ppc::util::GetOffloadDevice(), host);
+}
+
+TEST(Offload, BenchmarkTracksTransfersInsideRun) {
+  const ppc::task::TaskPtr<std::vector<int>, std::vector<int>> task =
+      std::make_unique<SquareOffloadTask>(std::vector<int>{1, 2, 3, 4});
+  ppc::util::OffloadTransferTracker tracker;
+  ppc::util::detail::RunProbes probes;
+  probes.offload_transfers = &tracker;
+  const ppc::util::StageTimes times = ppc::util::detail::RunTaskForBenchmark(task, probes);
+
+  EXPECT_EQ(task->GetOutput(), (std::vector<int>{1, 4, 9, 16}));
+  EXPECT_EQ(tracker.Stats(ppc::util::OffloadDirection::kHostToDevice).bytes, 4 * sizeof(int));
+  EXPECT_EQ(tracker.Stats(ppc::util::OffloadDirection::kDeviceToHost).copies, 1U);
+  EXPECT_LE(tracker.Time(), times.run);
+}
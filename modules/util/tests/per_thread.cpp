@@ -0,0 +1,105 @@
+#include "util/include/per_thread.hpp"
+
+#include <gtest/gtest.h>
+
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <latch>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "util/include/thread_pool.hpp"
+
+TEST(PerThread, PaddedValuesDoNotShareCacheLines) {
+  static_assert(sizeof(ppc::util::Padded<char>) == ppc::util::kCacheLineSize);
+  std::vector<ppc::util::Padded<int>> slots(3);
+  const auto first = reinterpret_cast<std::uintptr_t>(&slots[0].value);
+  const auto second = reinterpret_cast<std::uintptr_t>(&slots[1].value);
+  EXPECT_EQ(first % ppc::util::kCacheLineSize, 0U);
+  EXPECT_EQ(second - first, ppc::util::kCacheLineSize);
+}
+
+TEST(PerThread, CombinesCountsOfEveryBackend) {
+  constexpr int kIterations = 10'000;
+  ppc::util::PerThread<int64_t> counter;
+#pragma omp parallel for num_threads(4) default(none) shared(counter)
+  for (int i = 0; i < kIterations; i++) {
+    counter.Local()++;
+  }
+  tbb::parallel_for(0, kIterations, [&](int /*i*/) { counter.Local()++; });
+  ppc::util::GetThreadPool().ParallelFor(0, kIterations, [&](int /*i*/) { counter.Local()++; });
+  EXPECT_EQ(counter.Combine(), 3 * kIterations);
+  counter.Reset();
+  EXPECT_EQ(counter.Combine(), 0);
+}
+
+TEST(PerThread, CombineUsesInitialValueAndOperation) {
+  ppc::util::PerThread<int64_t> maximum(-1);
+  std::vector<std::thread> threads;
+  for (int64_t value = 0; value < 4; value++) {
+    threads.emplace_back([&maximum, value] { maximum.Local() = value * 10; });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(maximum.Combine([](int64_t lhs, int64_t rhs) { return std::max(lhs, rhs); }), 30);
+}
+
+TEST(PerThread, CombineFoldsOnlyUsedSlots) {
+  ppc::util::PerThread<int64_t> counter(5);
+  EXPECT_EQ(counter.Combine(), 5);
+  // Both threads stay alive until each has its slot, so they hold distinct indices
+  std::latch all_alive(2);
+  std::vector<std::thread> threads;
+  for (int64_t add = 1; add <= 2; add++) {
+    threads.emplace_back([&counter, &all_alive, add] {
+      counter.Local() += add;
+      all_alive.arrive_and_wait();
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  // The other 62 slots of the chunk still hold 5 but were never handed out
+  EXPECT_EQ(counter.Combine(), 6 + 7);
+  counter.Reset();
+  EXPECT_EQ(counter.Combine(), 5);
+}
+
+TEST(PerThread, SlotsCarryOverToThreadsReusingAnIndex) {
+  ppc::util::PerThread<int64_t> counter;
+  // Each thread exits before the next starts, so they may share one recycled index
+  for (int64_t add = 1; add <= 3; add++) {
+    std::thread([&counter, add] { counter.Local() += add; }).join();
+  }
+  EXPECT_EQ(counter.Combine(), 1 + 2 + 3);
+}
+
+TEST(PerThread, ThreadIndicesAreDistinctAndReused) {
+  constexpr int kThreads = 4;
+  std::set<std::size_t> seen;
+  std::mutex mutex;
+  std::latch all_alive(kThreads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; i++) {
+    threads.emplace_back([&] {
+      const std::size_t index = ppc::util::ThisThreadIndex();
+      {
+        const std::scoped_lock lock(mutex);
+        EXPECT_TRUE(seen.insert(index).second);
+      }
+      all_alive.arrive_and_wait();
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  std::size_t reused = 0;
+  std::thread([&reused] { reused = ppc::util::ThisThreadIndex(); }).join();
+  EXPECT_TRUE(seen.contains(reused));
+}
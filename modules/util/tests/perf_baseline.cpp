@@ -0,0 +1,62 @@
+#include "util/include/perf_baseline.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "util/include/util.hpp"
+
+TEST(PerfBaseline, LoadKeepsIterationsInSeconds) {
+  const auto path = std::filesystem::temp_directory_path() /
+                    ("ppc_perf_baseline_test_" + std::to_string(ppc::util::GetProcessId()) + ".json");
+  nlohmann::json payload;
+  payload["benchmarks"] = nlohmann::json::array({
+      {{"name", "task/manual_time"}, {"run_name", "task/manual_time"}, {"run_type", "iteration"},
+       {"real_time", 2.0}, {"time_unit", "ms"}},
+      {{"name", "task/manual_time"}, {"run_name", "task/manual_time"}, {"run_type", "iteration"},
+       {"real_time", 3000.0}, {"time_unit", "us"}},
+      {{"name", "task/manual_time_mean"}, {"run_name", "task/manual_time"}, {"run_type", "aggregate"},
+       {"real_time", 2.5}, {"time_unit", "ms"}},
+      {{"name", "broken"}, {"run_name", "broken"}, {"run_type", "iteration"}, {"error_occurred", true}},
+  });
+  std::ofstream(path) << payload.dump();
+  const auto samples = ppc::util::LoadPerfSamples(path.string());
+  std::filesystem::remove(path);
+  ASSERT_EQ(samples.size(), 1U);
+  ASSERT_EQ(samples.at("task/manual_time").size(), 2U);
+  EXPECT_DOUBLE_EQ(samples.at("task/manual_time")[0], 2e-3);
+  EXPECT_DOUBLE_EQ(samples.at("task/manual_time")[1], 3e-3);
+  EXPECT_THROW((void)ppc::util::LoadPerfSamples(path.string()), std::runtime_error);
+}
+
+TEST(PerfBaseline, ConsistentSlowdownIsRegression) {
+  const std::vector<double> baseline = {1.00, 1.02, 0.98, 1.01, 0.99};
+  const std::vector<double> current = {1.30, 1.28, 1.33, 1.31, 1.29};
+  const auto comparison = ppc::util::ComparePerfSamples(current, baseline, 0.1, 0.05);
+  EXPECT_NEAR(comparison.slowdown, 0.30, 1e-9);
+  ASSERT_TRUE(comparison.p_value.has_value());
+  EXPECT_LT(*comparison.p_value, 0.05);
+  EXPECT_TRUE(comparison.regression);
+}
+
+TEST(PerfBaseline, NoiseWithinThresholdOrInsignificantIsNotRegression) {
+  const std::vector<double> baseline = {1.00, 1.02, 0.98, 1.01, 0.99};
+  const auto noise = ppc::util::ComparePerfSamples({1.01, 0.97, 1.04, 1.00, 1.02}, baseline, 0.1, 0.05);
+  EXPECT_FALSE(noise.regression);
+  // Median is 20% slower, but the repetitions overlap too much for the rank test
+  const auto overlapping = ppc::util::ComparePerfSamples({0.97, 1.20, 1.25, 0.98, 1.22}, baseline, 0.1, 0.05);
+  EXPECT_GT(overlapping.slowdown, 0.1);
+  EXPECT_FALSE(overlapping.regression);
+}
+
+TEST(PerfBaseline, SingleRepetitionFallsBackToMedians) {
+  const auto comparison = ppc::util::ComparePerfSamples({1.5}, {1.0, 1.1, 0.9}, 0.1, 0.05);
+  EXPECT_FALSE(comparison.p_value.has_value());
+  EXPECT_TRUE(comparison.regression);
+  EXPECT_FALSE(ppc::util::ComparePerfSamples({1.05}, {1.0}, 0.1, 0.05).regression);
+}
@@ -0,0 +1,295 @@
+#include "util/include/perf_test_util.hpp"
+
+#include <gtest/gtest.h>
+
+#include <benchmark/benchmark.h>
+#include <omp.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <libenvpp/detail/environment.hpp>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "task/include/task.hpp"
+#include "util/include/hardware_counters.hpp"
+#include "util/include/memory_tracking.hpp"
+#include "util/include/mpi_profiler.hpp"
+#include "util/include/num_threads.hpp"
+#include "util/include/task_descriptor_util.hpp"
+
+namespace {
+
+class SlowPreProcessingTask : public ppc::task::Task<int, int> {
+ public:
+  explicit SlowPreProcessingTask(int in) {
+    SetTypeOfTask(ppc::task::TypeOfTask::kSEQ);
+    GetInput() = in;
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return GetInput() > 0;
+  }
+
+  bool PreProcessingImpl() override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    return true;
+  }
+
+  bool RunImpl() override {
+    GetOutput() = GetInput();
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+class SharedInputPerfTest : public ppc::util::BaseRunPerfTests<int, int> {
+ public:
+  static int input_calls;
+
+ protected:
+  bool CheckTestOutputData(int & /*output_data*/) override {
+    return true;
+  }
+
+  int GetTestInputData() override {
+    input_calls++;
+    return 7;
+  }
+};
+
+int SharedInputPerfTest::input_calls = 0;
+
+ppc::util::PerfTestParam<int, int> MakeSharedInputParam(const std::string &name) {
+  return {ppc::task::TaskGetter<SlowPreProcessingTask, const int &>, name, ppc::task::TaskCategory::kThreads,
+          ppc::task::TaskDescriptor{.display_name = name}, ppc::util::WorkEstimator<int>{}};
+}
+
+}  // namespace
+
+// Every implementation of a suite gets its own fixture, but all of them read the input generated for the first one
+TEST_P(SharedInputPerfTest, InputIsGeneratedOncePerSuite) {
+  EXPECT_EQ(*GetSharedTestInputData(), 7);
+  EXPECT_EQ(*GetSharedTestInputData(), 7);
+  EXPECT_EQ(input_calls, 1);
+}
+
+INSTANTIATE_TEST_SUITE_P(PerfTestUtil, SharedInputPerfTest,
+                         ::testing::Values(MakeSharedInputParam("first"), MakeSharedInputParam("second")));
+
+TEST(PerfTestUtil, RunTaskForBenchmarkTimesEveryStage) {
+  const ppc::task::TaskPtr<int, int> task = std::make_unique<SlowPreProcessingTask>(3);
+  const ppc::util::StageTimes times = ppc::util::detail::RunTaskForBenchmark(task);
+
+  EXPECT_GE(times.pre_processing, 0.04);
+  EXPECT_GE(times.validation, 0.0);
+  EXPECT_GE(times.run, 0.0);
+  EXPECT_GE(times.post_processing, 0.0);
+  EXPECT_LT(times.run, times.pre_processing);
+  EXPECT_EQ(task->GetOutput(), 3);
+}
+
+TEST(PerfTestUtil, MaxStageTimesKeepsLocalTimesForThreadBackends) {
+  const ppc::util::StageTimes times{.validation = 1.0, .pre_processing = 2.0, .run = 3.0, .post_processing = 4.0};
+  const auto reduced = ppc::util::detail::MaxStageTimesAcrossMpiRanks(times, ppc::task::TypeOfTask::kTBB);
+
+  EXPECT_DOUBLE_EQ(reduced.validation, 1.0);
+  EXPECT_DOUBLE_EQ(reduced.pre_processing, 2.0);
+  EXPECT_DOUBLE_EQ(reduced.run, 3.0);
+  EXPECT_DOUBLE_EQ(reduced.post_processing, 4.0);
+}
+
+TEST(PerfTestUtil, ReduceStageSamplesSpansRunStage) {
+  std::vector<ppc::util::detail::StageSample> samples(2);
+  samples[0].times = {.validation = 1.0, .pre_processing = 2.0, .run = 0.5, .post_processing = 4.0};
+  samples[0].run_begin = 10.0;
+  samples[0].run_end = 10.5;
+  samples[1].run_begin = 20.0;
+  samples[1].run_end = 21.25;
+  const auto reduced = ppc::util::detail::ReduceStageSamples(samples, ppc::task::TypeOfTask::kSEQ);
+
+  ASSERT_EQ(reduced.size(), 2U);
+  EXPECT_DOUBLE_EQ(reduced[0].validation, 1.0);
+  EXPECT_DOUBLE_EQ(reduced[0].pre_processing, 2.0);
+  EXPECT_DOUBLE_EQ(reduced[0].run, 0.5);
+  EXPECT_DOUBLE_EQ(reduced[0].post_processing, 4.0);
+  EXPECT_DOUBLE_EQ(reduced[1].run, 1.25);
+}
+
+TEST(PerfTestUtil, DeferredBenchmarkRecordsRunTimestamps) {
+  const ppc::task::TaskPtr<int, int> task = std::make_unique<SlowPreProcessingTask>(7);
+  const auto timer = ppc::util::detail::MakeGlobalTimer(ppc::task::TypeOfTask::kSEQ, 0.0);
+  const auto sample = ppc::util::detail::RunTaskForDeferredBenchmark(task, timer);
+
+  EXPECT_GE(sample.times.pre_processing, 0.04);
+  EXPECT_GE(sample.run_end, sample.run_begin);
+  EXPECT_DOUBLE_EQ(sample.times.run, sample.run_end - sample.run_begin);
+  EXPECT_EQ(task->GetOutput(), 7);
+}
+
+TEST(PerfTestUtil, RunTaskForBenchmarkReusesResetTask) {
+  const ppc::task::TaskPtr<int, int> task = std::make_unique<SlowPreProcessingTask>(5);
+  for (int iteration = 0; iteration < 2; iteration++) {
+    task->Reset();
+    const ppc::util::StageTimes times = ppc::util::detail::RunTaskForBenchmark(task);
+    EXPECT_GE(times.run, 0.0);
+    EXPECT_EQ(task->GetOutput(), 5);
+  }
+}
+
+TEST(PerfTestUtil, HardwareCountersAreDisabledByDefault) {
+  const env::detail::set_scoped_environment_variable counters("PPC_PERF_COUNTERS", "0");
+  EXPECT_FALSE(ppc::util::HardwareCountersEnabled());
+}
+
+TEST(PerfTestUtil, RunTaskForBenchmarkCountsHardwareEventsAroundRun) {
+  ppc::util::HardwareCounters counters;
+  const ppc::task::TaskPtr<int, int> task = std::make_unique<SlowPreProcessingTask>(7);
+  ppc::util::detail::RunTaskForBenchmark(task, {.hardware_counters = &counters});
+
+  EXPECT_EQ(task->GetOutput(), 7);
+  if (!counters.IsAvailable()) {
+    GTEST_SKIP() << "Hardware performance counters are not available";
+  }
+  const auto instructions = counters.Totals()[static_cast<std::size_t>(ppc::util::HardwareEvent::kInstructions)];
+  const auto cycles = counters.Totals()[static_cast<std::size_t>(ppc::util::HardwareEvent::kCycles)];
+  EXPECT_GT(instructions + cycles, 0U);
+}
+
+TEST(PerfTestUtil, HardwareCountersIncludeWorkersStartedBeforehand) {
+  constexpr int kWorkers = 3;
+  auto spin = [] {
+    uint64_t value = 1;
+    for (int step = 0; step < (1 << 22); step++) {
+      value = (value * 6364136223846793005ULL) + 1442695040888963407ULL;
+    }
+    benchmark::DoNotOptimize(value);
+  };
+  constexpr auto kInstructions = static_cast<std::size_t>(ppc::util::HardwareEvent::kInstructions);
+
+  ppc::util::HardwareCounters single;
+  single.Start();
+  spin();
+  single.Stop();
+  if (!single.IsAvailable() || single.Totals()[kInstructions] == 0) {
+    GTEST_SKIP() << "Hardware performance counters are not available";
+  }
+
+  // The workers exist before the counters are built, like pool threads of a parallel backend
+  std::atomic<bool> go{false};
+  std::vector<std::thread> workers;
+  for (int i = 0; i < kWorkers; i++) {
+    workers.emplace_back([&go, &spin] {
+      while (!go.load()) {
+        std::this_thread::yield();
+      }
+      spin();
+    });
+  }
+  ppc::util::HardwareCounters counters;
+  counters.Start();
+  go.store(true);
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  counters.Stop();
+  EXPECT_GT(counters.Totals()[kInstructions], 2 * single.Totals()[kInstructions]);
+}
+
+TEST(PerfTestUtil, MemoryTrackerMeasuresRssGrowth) {
+  if (ppc::util::GetPeakRssBytes() == 0) {
+    GTEST_SKIP() << "RSS is not available on this platform";
+  }
+  constexpr std::size_t kBytes = std::size_t{64} << 20;
+  ppc::util::MemoryTracker tracker;
+  tracker.Start();
+  {
+    std::vector<char> buffer(kBytes, 1);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  tracker.Stop();
+  EXPECT_GE(tracker.PeakRssDeltaBytes(), kBytes / 2);
+}
+
+TEST(PerfTestUtil, MemoryTrackerCountsAllocations) {
+  if (!ppc::util::AllocationCounterEnabled()) {
+    GTEST_SKIP() << "Built without USE_ALLOCATION_COUNTER";
+  }
+  ppc::util::MemoryTracker tracker;
+  tracker.Start();
+  for (int i = 0; i < 10; i++) {
+    auto value = std::make_unique<int>(i);
+    benchmark::DoNotOptimize(value.get());
+  }
+  tracker.Stop();
+  EXPECT_GE(tracker.Allocations().count, 10U);
+  EXPECT_GE(tracker.Allocations().bytes, 10 * sizeof(int));
+}
+
+TEST(PerfTestUtil, MpiCallNamesMatchEnumerators) {
+  EXPECT_EQ(ppc::util::MpiCallName(ppc::util::MpiCall::kSend), "Send");
+  EXPECT_EQ(ppc::util::MpiCallName(ppc::util::MpiCall::kAllreduce), "Allreduce");
+  EXPECT_EQ(ppc::util::MpiCallName(ppc::util::MpiCall::kBarrier), "Barrier");
+}
+
+TEST(PerfTestUtil, ResetMpiProfileClearsStatistics) {
+  ppc::util::ResetMpiProfile();
+  const auto stats = ppc::util::GetMpiCallStats(ppc::util::ProfiledStage::kRun, ppc::util::MpiCall::kBcast);
+  EXPECT_EQ(stats.calls, 0U);
+  EXPECT_EQ(stats.bytes, 0U);
+  EXPECT_DOUBLE_EQ(stats.time, 0.0);
+}
+
+TEST(PerfTestUtil, CoefficientOfVariationOfEqualValuesIsZero) {
+  EXPECT_DOUBLE_EQ(ppc::util::detail::CoefficientOfVariation({2.0, 2.0, 2.0}), 0.0);
+  EXPECT_DOUBLE_EQ(ppc::util::detail::CoefficientOfVariation({1.0}), 0.0);
+}
+
+TEST(PerfTestUtil, CoefficientOfVariationUsesSampleStddev) {
+  EXPECT_NEAR(ppc::util::detail::CoefficientOfVariation({1.0, 3.0}), std::sqrt(2.0) / 2.0, 1e-12);
+}
+
+TEST(PerfTestUtil, Percentile90UsesNearestRank) {
+  EXPECT_DOUBLE_EQ(ppc::util::detail::Percentile90({5.0, 1.0, 4.0, 2.0, 3.0, 10.0, 9.0, 8.0, 7.0, 6.0}), 9.0);
+  EXPECT_DOUBLE_EQ(ppc::util::detail::Percentile90({3.0}), 3.0);
+  EXPECT_DOUBLE_EQ(ppc::util::detail::Percentile90({}), 0.0);
+}
+
+TEST(PerfTestUtil, ScopedNumThreadsOverridesAndRestoresThreadCount) {
+  env::detail::set_scoped_environment_variable scoped("PPC_NUM_THREADS", "1");
+  const int omp_threads = omp_get_max_threads();
+  {
+    const ppc::util::ScopedNumThreads num_threads_scope(3);
+    EXPECT_EQ(ppc::util::GetNumThreads(), 3);
+    EXPECT_EQ(omp_get_max_threads(), 3);
+  }
+  EXPECT_EQ(ppc::util::GetNumThreads(), 1);
+  EXPECT_EQ(omp_get_max_threads(), omp_threads);
+}
+
+TEST(PerfTestUtil, OnlyThreadedBackendsAreSwept) {
+  EXPECT_TRUE(ppc::util::IsThreadSweepTaskType(ppc::task::TypeOfTask::kOMP));
+  EXPECT_TRUE(ppc::util::IsThreadSweepTaskType(ppc::task::TypeOfTask::kTBB));
+  EXPECT_TRUE(ppc::util::IsThreadSweepTaskType(ppc::task::TypeOfTask::kSTL));
+  EXPECT_TRUE(ppc::util::IsThreadSweepTaskType(ppc::task::TypeOfTask::kALL));
+  EXPECT_FALSE(ppc::util::IsThreadSweepTaskType(ppc::task::TypeOfTask::kSEQ));
+  EXPECT_FALSE(ppc::util::IsThreadSweepTaskType(ppc::task::TypeOfTask::kMPI));
+}
+
+TEST(PerfTestUtil, InputSizeRangeIsGeometricAndIncludesUpperBound) {
+  EXPECT_EQ(ppc::util::InputSizeRange(16, 64), (std::vector<std::size_t>{16, 32, 64}));
+  EXPECT_EQ(ppc::util::InputSizeRange(1000, 5000, 4), (std::vector<std::size_t>{1000, 4000, 5000}));
+  EXPECT_EQ(ppc::util::InputSizeRange(7, 7), (std::vector<std::size_t>{7}));
+  EXPECT_THROW((void)ppc::util::InputSizeRange(0, 8), std::runtime_error);
+  EXPECT_THROW((void)ppc::util::InputSizeRange(8, 4), std::runtime_error);
+}
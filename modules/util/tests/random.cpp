@@ -0,0 +1,56 @@
+#include "util/include/random.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+TEST(Random, PhiloxMatchesReferenceVectors) {
+  EXPECT_EQ(ppc::util::Philox4x32({0, 0, 0, 0}, {0, 0}),
+            (ppc::util::PhiloxCounter{0x6627e8d5U, 0xe169c58dU, 0xbc57ac4cU, 0x9b00dbd8U}));
+  EXPECT_EQ(ppc::util::Philox4x32({0xffffffffU, 0xffffffffU, 0xffffffffU, 0xffffffffU}, {0xffffffffU, 0xffffffffU}),
+            (ppc::util::PhiloxCounter{0x408f276dU, 0x41c83b0eU, 0xa20bc7c6U, 0x6d5451fdU}));
+}
+
+TEST(Random, UniformStaysInRange) {
+  const ppc::util::CounterRng rng(42);
+  for (uint64_t i = 0; i < 1000; i++) {
+    const int value = rng.Uniform(i, -3, 3);
+    EXPECT_GE(value, -3);
+    EXPECT_LE(value, 3);
+    const double real = rng.Uniform(i, 0.5, 1.0);
+    EXPECT_GE(real, 0.5);
+    EXPECT_LT(real, 1.0);
+  }
+}
+
+TEST(Random, StreamsAndSeedsDiffer) {
+  const ppc::util::CounterRng rng(1);
+  EXPECT_NE(rng.Bits(0), ppc::util::CounterRng(1, 1).Bits(0));
+  EXPECT_NE(rng.Bits(0), ppc::util::CounterRng(2).Bits(0));
+  EXPECT_NE(rng.Bits(0), rng.Bits(1));
+}
+
+TEST(Random, ParallelFillMatchesSerialGeneration) {
+  const ppc::util::CounterRng rng(ppc::util::TestInputSeed(), 7);
+  const auto values = ppc::util::GenerateUniform<int64_t>(10000, -1000, 1000, rng);
+  for (std::size_t i = 0; i < values.size(); i++) {
+    ASSERT_EQ(values[i], rng.Uniform<int64_t>(i, -1000, 1000));
+  }
+
+  std::vector<int64_t> tail(3000);
+  ppc::util::FillUniform<int64_t>(std::span(tail), 7000, -1000, 1000, rng);
+  EXPECT_EQ(tail, std::vector<int64_t>(values.begin() + 7000, values.end()));
+}
+
+TEST(Random, LocalSliceMatchesWholeSequence) {
+  const ppc::util::CounterRng rng(5);
+  const auto whole = ppc::util::GenerateUniform(123, 0.0F, 1.0F, rng);
+  const auto slice = ppc::util::GenerateLocalUniform(MPI_COMM_WORLD, 123, 0.0F, 1.0F, rng);
+  ASSERT_LE(slice.first_index + slice.data.size(), whole.size());
+  for (std::size_t i = 0; i < slice.data.size(); i++) {
+    EXPECT_EQ(slice.data[i], whole[slice.first_index + i]);
+  }
+}
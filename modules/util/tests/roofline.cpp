@@ -0,0 +1,44 @@
+#include "util/include/roofline.hpp"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+namespace {
+
+struct TaskWithWork {
+  static ppc::util::WorkModel EstimateWork(const int &n) {
+    ppc::util::WorkModel work;
+    work.flops = 2.0 * n;
+    work.bytes = 8.0 * n;
+    return work;
+  }
+};
+
+struct TaskWithoutWork {};
+
+}  // namespace
+
+TEST(Roofline, EstimateWorkIsDetectedByConcept) {
+  static_assert(ppc::util::HasEstimateWork<TaskWithWork, int>);
+  static_assert(!ppc::util::HasEstimateWork<TaskWithoutWork, int>);
+  EXPECT_DOUBLE_EQ(TaskWithWork::EstimateWork(4).flops, 8.0);
+}
+
+TEST(Roofline, FractionIsTheBindingUtilization) {
+  ppc::util::MachinePeaks peaks;
+  peaks.flops_per_second = 100.0;
+  peaks.bytes_per_second = 10.0;
+  // Memory bound: 5 B/s of 10 B/s while 10 FLOP/s is far from the compute peak
+  EXPECT_DOUBLE_EQ(ppc::util::RooflineFraction(10.0, 5.0, peaks), 0.5);
+  // Compute bound: high arithmetic intensity
+  EXPECT_DOUBLE_EQ(ppc::util::RooflineFraction(80.0, 1.0, peaks), 0.8);
+  EXPECT_DOUBLE_EQ(ppc::util::RooflineFraction(80.0, 1.0, ppc::util::MachinePeaks{}), 0.0);
+}
+
+TEST(Roofline, ProbeMeasuresPositivePeaks) {
+  const auto peaks = ppc::util::MeasureMachinePeaks(1, 1 << 16);
+  EXPECT_GT(peaks.flops_per_second, 0.0);
+  EXPECT_GT(peaks.bytes_per_second, 0.0);
+  EXPECT_THROW((void)ppc::util::MeasureMachinePeaks(0), std::runtime_error);
+}
@@ -0,0 +1,75 @@
+#include "util/include/schedule.hpp"
+
+#include <gtest/gtest.h>
+
+#include <omp.h>
+
+#include <atomic>
+#include <cstddef>
+#include <libenvpp/detail/environment.hpp>
+#include <stdexcept>
+#include <vector>
+
+TEST(Schedule, ParsesAndPrintsPolicies) {
+  const auto policy = ppc::util::ParseSchedulePolicy("kind=dynamic,grain=64,partitioner=simple");
+  EXPECT_EQ(policy.kind, ppc::util::ScheduleKind::kDynamic);
+  EXPECT_EQ(policy.grain_size, 64U);
+  EXPECT_EQ(policy.partitioner, ppc::util::TbbPartitioner::kSimple);
+  EXPECT_EQ(ppc::util::SchedulePolicyToString(policy), "kind=dynamic,grain=64,partitioner=simple");
+  EXPECT_EQ(ppc::util::ParseSchedulePolicy(""), ppc::util::SchedulePolicy{});
+  EXPECT_EQ(ppc::util::SchedulePolicyToString(ppc::util::ParseSchedulePolicy("partitioner=affinity")),
+            "partitioner=affinity");
+
+  EXPECT_THROW((void)ppc::util::ParseSchedulePolicy("kind=fastest"), std::runtime_error);
+  EXPECT_THROW((void)ppc::util::ParseSchedulePolicy("grain=-1"), std::runtime_error);
+  EXPECT_THROW((void)ppc::util::ParseSchedulePolicy("chunk=4"), std::runtime_error);
+  EXPECT_THROW((void)ppc::util::ParseSchedulePolicy("dynamic"), std::runtime_error);
+}
+
+TEST(Schedule, ReadsPolicyAndSweepFromEnvironment) {
+  EXPECT_EQ(ppc::util::GetSchedulePolicy(), ppc::util::SchedulePolicy{});
+  {
+    const ppc::util::ScopedSchedulePolicy scope(ppc::util::ParseSchedulePolicy("kind=guided,grain=8"));
+    EXPECT_EQ(ppc::util::GetSchedulePolicy().kind, ppc::util::ScheduleKind::kGuided);
+    EXPECT_EQ(ppc::util::GetSchedulePolicy().grain_size, 8U);
+  }
+  EXPECT_EQ(ppc::util::GetSchedulePolicy(), ppc::util::SchedulePolicy{});
+
+  const env::detail::set_scoped_environment_variable sweep("PPC_PERF_SCHEDULE_SWEEP",
+                                                           "kind=static;kind=dynamic,grain=16");
+  const auto policies = ppc::util::GetPerfScheduleSweep();
+  ASSERT_EQ(policies.size(), 2U);
+  EXPECT_EQ(policies[0].kind, ppc::util::ScheduleKind::kStatic);
+  EXPECT_EQ(policies[1].grain_size, 16U);
+}
+
+TEST(Schedule, OmpParallelForCoversRangeAndRestoresSchedule) {
+  omp_sched_t kind_before = omp_sched_auto;
+  int chunk_before = 0;
+  omp_get_schedule(&kind_before, &chunk_before);
+  for (const char *spec : {"", "kind=static,grain=3", "kind=dynamic", "kind=guided,grain=5"}) {
+    std::vector<std::atomic<int>> visits(501);
+    ppc::util::OmpParallelFor(0, static_cast<int>(visits.size()), [&visits](int i) { visits[i]++; },
+                              ppc::util::ParseSchedulePolicy(spec), 3);
+    for (const auto &count : visits) {
+      ASSERT_EQ(count.load(), 1) << spec;
+    }
+  }
+  omp_sched_t kind_after = omp_sched_auto;
+  int chunk_after = 0;
+  omp_get_schedule(&kind_after, &chunk_after);
+  EXPECT_EQ(kind_after, kind_before);
+  EXPECT_EQ(chunk_after, chunk_before);
+}
+
+TEST(Schedule, TbbParallelForCoversRangeWithEveryPartitioner) {
+  for (const char *spec : {"", "partitioner=simple,grain=16", "partitioner=affinity", "partitioner=static"}) {
+    std::vector<std::atomic<int>> visits(777);
+    ppc::util::TbbParallelFor(std::size_t{0}, visits.size(), [&visits](std::size_t i) { visits[i]++; },
+                              ppc::util::ParseSchedulePolicy(spec));
+    for (const auto &count : visits) {
+      ASSERT_EQ(count.load(), 1) << spec;
+    }
+  }
+  ppc::util::TbbParallelFor(5, 5, [](int /*i*/) { FAIL(); });
+}
@@ -0,0 +1,58 @@
+#include "util/include/scratch_arena.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+TEST(ScratchArena, ScopeRewindsAllocations) {
+  ppc::util::ScratchArena arena;
+  const void *first = nullptr;
+  {
+    const ppc::util::ScratchArena::Scope scope(arena);
+    std::pmr::vector<int> buffer(128, 1, scope.Resource());
+    first = buffer.data();
+  }
+  {
+    const ppc::util::ScratchArena::Scope scope(arena);
+    std::pmr::vector<int> buffer(128, 2, scope.Resource());
+    EXPECT_EQ(buffer.data(), first);
+  }
+  EXPECT_GE(arena.PeakBytes(), 128 * sizeof(int));
+}
+
+TEST(ScratchArena, AllocationsAreAligned) {
+  ppc::util::ScratchArena arena;
+  auto *resource = arena.Resource();
+  EXPECT_NE(resource->allocate(3, 1), nullptr);
+  void *aligned = resource->allocate(64, 64);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 64, 0U);
+}
+
+TEST(ScratchArena, GrowsBeyondFirstBlock) {
+  ppc::util::ScratchArena arena;
+  const ppc::util::ScratchArena::Scope scope(arena);
+  std::pmr::vector<std::byte> large(std::size_t{1} << 20, std::byte{0}, scope.Resource());
+  EXPECT_EQ(large.size(), std::size_t{1} << 20);
+}
+
+TEST(ScratchArena, ReleaseReusesMemoryAndKeepsPeak) {
+  ppc::util::ScratchArena arena;
+  void *first = arena.Resource()->allocate(1024);
+  arena.Release();
+  EXPECT_EQ(arena.Resource()->allocate(1024), first);
+  EXPECT_EQ(arena.PeakBytes(), 1024U);
+}
+
+TEST(ScratchArena, ThreadsUseSeparateArenas) {
+  ppc::util::ScratchArena arena;
+  void *main_block = arena.Resource()->allocate(256);
+  void *worker_block = nullptr;
+  std::thread worker([&] { worker_block = arena.Resource()->allocate(256); });
+  worker.join();
+  EXPECT_NE(main_block, worker_block);
+  EXPECT_EQ(arena.PeakBytes(), 512U);
+}
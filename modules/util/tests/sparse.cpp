@@ -0,0 +1,112 @@
+#include "util/include/sparse.hpp"
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "util/include/decomposition.hpp"
+#include "util/include/random.hpp"
+#include "util/include/util.hpp"
+
+namespace {
+
+std::vector<ppc::util::Triplet<double>> RandomTriplets(int32_t rows, int32_t cols, std::size_t count) {
+  const ppc::util::CounterRng rng(ppc::util::TestInputSeed());
+  std::vector<ppc::util::Triplet<double>> triplets(count);
+  for (std::size_t i = 0; i < count; i++) {
+    triplets[i] = {.row = rng.Uniform<int32_t>(3 * i, 0, rows - 1),
+                   .col = rng.Uniform<int32_t>((3 * i) + 1, 0, cols - 1),
+                   .value = rng.Uniform<double>((3 * i) + 2, -1.0, 1.0)};
+  }
+  return triplets;
+}
+
+}  // namespace
+
+TEST(Sparse, BuildCsrSortsAndSumsDuplicates) {
+  const auto matrix = ppc::util::BuildCsr<int>(3, 4, {{2, 1, 5}, {0, 3, 1}, {0, 0, 2}, {2, 1, 4}, {0, 3, 6}});
+  EXPECT_EQ(matrix.row_offsets, (std::vector<int64_t>{0, 2, 2, 3}));
+  EXPECT_EQ(matrix.col_indices, (std::vector<int32_t>{0, 3, 1}));
+  EXPECT_EQ(matrix.values, (std::vector<int>{2, 7, 9}));
+  EXPECT_THROW((void)ppc::util::BuildCsr<int>(3, 4, {{3, 0, 1}}), std::runtime_error);
+}
+
+TEST(Sparse, FormatsAgreeOnSpMV) {
+  constexpr int32_t kRows = 57;
+  constexpr int32_t kCols = 31;
+  const auto triplets = RandomTriplets(kRows, kCols, 400);
+  const auto csr = ppc::util::BuildCsr(kRows, kCols, triplets);
+  const auto ell = ppc::util::ToEll(csr);
+  const auto csc = ppc::util::ToCsc(csr);
+  EXPECT_EQ(csc.col_offsets.back(), csr.NumNonZeros());
+
+  std::vector<double> x(kCols);
+  for (std::size_t i = 0; i < x.size(); i++) {
+    x[i] = static_cast<double>(i) - 10.0;
+  }
+  std::vector<double> expected(kRows, 0.0);
+  for (const auto &triplet : triplets) {
+    expected[static_cast<std::size_t>(triplet.row)] += triplet.value * x[static_cast<std::size_t>(triplet.col)];
+  }
+  std::vector<double> from_csc(kRows, 0.0);
+  for (std::size_t col = 0; col < x.size(); col++) {
+    const auto begin = static_cast<std::size_t>(csc.col_offsets[col]);
+    const auto end = static_cast<std::size_t>(csc.col_offsets[col + 1]);
+    for (std::size_t i = begin; i < end; i++) {
+      from_csc[static_cast<std::size_t>(csc.row_indices[i])] += csc.values[i] * x[col];
+    }
+  }
+  std::vector<double> from_csr(kRows);
+  std::vector<double> from_ell(kRows);
+  ppc::util::SpMV<double>(csr, x, from_csr);
+  ppc::util::SpMV<double>(ell, x, from_ell);
+  for (std::size_t row = 0; row < expected.size(); row++) {
+    EXPECT_NEAR(from_csr[row], expected[row], 1e-9);
+    EXPECT_NEAR(from_ell[row], expected[row], 1e-9);
+    EXPECT_NEAR(from_csc[row], expected[row], 1e-9);
+  }
+}
+
+TEST(Sparse, RowPartitionCoversMatrixAndBalancesNonZeros) {
+  std::vector<ppc::util::Triplet<float>> triplets;
+  for (int32_t col = 0; col < 40; col++) {
+    triplets.push_back({.row = 0, .col = col, .value = 1.0F});
+  }
+  for (int32_t row = 1; row < 41; row++) {
+    triplets.push_back({.row = row, .col = 0, .value = 1.0F});
+  }
+  const auto matrix = ppc::util::BuildCsr(41, 40, triplets);
+  const auto first = ppc::util::NonZeroBalancedRows(matrix.row_offsets, 2, 0);
+  const auto second = ppc::util::NonZeroBalancedRows(matrix.row_offsets, 2, 1);
+  EXPECT_EQ(first.begin, 0);
+  EXPECT_EQ(first.count, 1);
+  EXPECT_EQ(second.End(), 41);
+  const auto block = ppc::util::ExtractRows(matrix, second);
+  EXPECT_EQ(block.NumNonZeros(), 40);
+  EXPECT_EQ(block.RowCols(0)[0], 0);
+
+  const auto local = ppc::util::LocalRowBlock(matrix, MPI_COMM_WORLD);
+  int64_t local_nonzeros = local.matrix.NumNonZeros();
+  int64_t total = local_nonzeros;
+  if (ppc::util::IsMpiActive()) {
+    MPI_Allreduce(&local_nonzeros, &total, 1, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+  }
+  EXPECT_EQ(total, matrix.NumNonZeros());
+}
+
+TEST(Sparse, GraphDropsRepeatedEdgesAndRunsBfs) {
+  const std::vector<ppc::util::Edge> edges = {{0, 1}, {1, 2}, {0, 1}, {2, 3}, {4, 4}};
+  const auto graph = ppc::util::BuildGraph(6, edges, true);
+  EXPECT_EQ(graph.NumEdges(), 7);
+  ASSERT_EQ(graph.Neighbors(1).size(), 2U);
+  EXPECT_EQ(graph.Neighbors(1)[0], 0);
+  EXPECT_EQ(graph.Neighbors(1)[1], 2);
+  EXPECT_EQ(ppc::util::BreadthFirstSearch(graph, 0), (std::vector<int32_t>{0, 1, 2, 3, -1, -1}));
+  EXPECT_THROW((void)ppc::util::BreadthFirstSearch(graph, 6), std::runtime_error);
+  EXPECT_THROW((void)ppc::util::BuildGraph(2, edges), std::runtime_error);
+}
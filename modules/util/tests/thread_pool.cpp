@@ -0,0 +1,82 @@
+#include "util/include/thread_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <libenvpp/detail/environment.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include "util/include/schedule.hpp"
+
+TEST(ThreadPool, SubmitReturnsResult) {
+  ppc::util::ThreadPool pool(2);
+  auto future = pool.Submit([] { return 42; });
+  EXPECT_EQ(future.get(), 42);
+}
+
+TEST(ThreadPool, SubmitPropagatesException) {
+  ppc::util::ThreadPool pool(1);
+  auto future = pool.Submit([]() -> int { throw std::runtime_error("job failed"); });
+  EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(ThreadPool, ParallelForVisitsEveryIndexOnce) {
+  const env::detail::set_scoped_environment_variable num_threads("PPC_NUM_THREADS", "4");
+  ppc::util::ThreadPool pool(4);
+  std::vector<std::atomic<int>> visits(1000);
+  pool.ParallelFor(std::size_t{0}, visits.size(), [&visits](std::size_t i) { visits[i]++; });
+  for (const auto &count : visits) {
+    EXPECT_EQ(count.load(), 1);
+  }
+}
+
+TEST(ThreadPool, ParallelForVisitsEveryIndexOnceUnderEverySchedule) {
+  const env::detail::set_scoped_environment_variable num_threads("PPC_NUM_THREADS", "3");
+  ppc::util::ThreadPool pool(3);
+  for (const char *spec : {"", "kind=static", "kind=static,grain=7", "kind=dynamic", "kind=dynamic,grain=64",
+                           "kind=guided", "kind=guided,grain=50", "grain=999"}) {
+    std::vector<std::atomic<int>> visits(997);
+    pool.ParallelFor(std::size_t{0}, visits.size(), [&visits](std::size_t i) { visits[i]++; },
+                     ppc::util::ParseSchedulePolicy(spec));
+    for (const auto &count : visits) {
+      ASSERT_EQ(count.load(), 1) << spec;
+    }
+  }
+}
+
+TEST(ThreadPool, ParallelForSupportsNestedCalls) {
+  const env::detail::set_scoped_environment_variable num_threads("PPC_NUM_THREADS", "2");
+  ppc::util::ThreadPool pool(2);
+  std::atomic<int> counter(0);
+  pool.ParallelFor(0, 8, [&](int /*i*/) { pool.ParallelFor(0, 8, [&counter](int /*j*/) { counter++; }); });
+  EXPECT_EQ(counter.load(), 64);
+}
+
+TEST(ThreadPool, ParallelForRethrowsBodyException) {
+  ppc::util::ThreadPool pool(2);
+  EXPECT_THROW(pool.ParallelFor(0, 16,
+                                [](int i) {
+                                  if (i == 7) {
+                                    throw std::runtime_error("body failed");
+                                  }
+                                }),
+               std::runtime_error);
+}
+
+TEST(ThreadPool, ScopedThreadPoolIsInstalledGlobally) {
+  const ppc::util::ScopedThreadPool scoped(3);
+  EXPECT_EQ(ppc::util::GetThreadPool().GetNumThreads(), 3);
+}
+
+TEST(ThreadPool, ScopedSchedulePolicyReplacesTheDefaultOfTheInstalledPool) {
+  const ppc::util::ScopedThreadPool scoped(2);
+  const ppc::util::SchedulePolicy initial = ppc::util::GetThreadPool().GetDefaultSchedulePolicy();
+  const auto dynamic = ppc::util::ParseSchedulePolicy("kind=dynamic,grain=4");
+  {
+    const ppc::util::ScopedSchedulePolicy scope(dynamic);
+    EXPECT_EQ(ppc::util::GetThreadPool().GetDefaultSchedulePolicy(), dynamic);
+  }
+  EXPECT_EQ(ppc::util::GetThreadPool().GetDefaultSchedulePolicy(), initial);
+}
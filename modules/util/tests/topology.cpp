@@ -0,0 +1,68 @@
+#include "util/include/topology.hpp"
+
+#include <gtest/gtest.h>
+
+#include <libenvpp/detail/environment.hpp>
+#include <stdexcept>
+
+#include "util/include/util.hpp"
+
+#ifdef __linux__
+#  include <sched.h>
+#endif
+
+TEST(Topology, BudgetSharesNodeCpusBetweenRanks) {
+  EXPECT_EQ(ppc::util::ComputeThreadBudget(8, 8, 0, 2), 4);
+  EXPECT_EQ(ppc::util::ComputeThreadBudget(8, 7, 0, 2), 4);
+  EXPECT_EQ(ppc::util::ComputeThreadBudget(8, 7, 1, 2), 3);
+}
+
+TEST(Topology, BudgetNeverExceedsRequestAndKeepsOneThread) {
+  EXPECT_EQ(ppc::util::ComputeThreadBudget(2, 16, 0, 2), 2);
+  EXPECT_EQ(ppc::util::ComputeThreadBudget(4, 2, 3, 4), 1);
+  EXPECT_EQ(ppc::util::ComputeThreadBudget(0, 4, 0, 1), 1);
+}
+
+TEST(Topology, ParsesBudgetMode) {
+  {
+    const env::detail::set_scoped_environment_variable mode("PPC_THREAD_BUDGET", "off");
+    EXPECT_EQ(ppc::util::GetThreadBudgetMode(), ppc::util::ThreadBudgetMode::kOff);
+  }
+  {
+    const env::detail::set_scoped_environment_variable mode("PPC_THREAD_BUDGET", "auto");
+    EXPECT_EQ(ppc::util::GetThreadBudgetMode(), ppc::util::ThreadBudgetMode::kAuto);
+  }
+  const env::detail::set_scoped_environment_variable mode("PPC_THREAD_BUDGET", "half");
+  EXPECT_THROW(ppc::util::GetThreadBudgetMode(), std::runtime_error);
+}
+
+TEST(Topology, SingleProcessScopeKeepsThreadCount) {
+  const int requested = ppc::util::GetNumThreads();
+  {
+    const ppc::util::ScopedHybridTopology topology;
+    EXPECT_EQ(topology.Topology().local_size, 1);
+    EXPECT_EQ(topology.ThreadBudget(), requested);
+    EXPECT_EQ(&ppc::util::GetNodeTopology(), &topology.Topology());
+    EXPECT_EQ(ppc::util::GetNumThreads(), requested);
+  }
+  EXPECT_EQ(ppc::util::GetNodeTopology().num_nodes, 1);
+}
+
+TEST(Topology, NestedScopeRestoresOuterTopology) {
+  const ppc::util::ScopedHybridTopology outer;
+  {
+    const ppc::util::ScopedHybridTopology inner;
+    EXPECT_EQ(&ppc::util::GetNodeTopology(), &inner.Topology());
+  }
+  EXPECT_EQ(&ppc::util::GetNodeTopology(), &outer.Topology());
+}
+
+#ifdef __linux__
+TEST(Topology, NodeCpusFollowAffinityMask) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  ASSERT_EQ(sched_getaffinity(0, sizeof(set), &set), 0);
+  const ppc::util::ScopedHybridTopology topology(ppc::util::ThreadBudgetMode::kOff);
+  EXPECT_EQ(topology.Topology().node_cpus, CPU_COUNT(&set));
+}
+#endif
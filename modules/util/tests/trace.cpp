@@ -0,0 +1,79 @@
+#include "util/include/trace.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "util/include/util.hpp"
+
+namespace {
+
+class ScopedTracing {
+ public:
+  ScopedTracing() {
+    ppc::util::SetTraceEnabled(true);
+    ppc::util::ClearTrace();
+  }
+  ScopedTracing(const ScopedTracing &) = delete;
+  ScopedTracing &operator=(const ScopedTracing &) = delete;
+  ~ScopedTracing() {
+    ppc::util::SetTraceEnabled(false);
+    ppc::util::ClearTrace();
+  }
+};
+
+}  // namespace
+
+TEST(Trace, DisabledTracingRecordsNothing) {
+  ppc::util::SetTraceEnabled(false);
+  ppc::util::ClearTrace();
+  { const ppc::util::TraceScope scope("ignored"); }
+  EXPECT_TRUE(ppc::util::CollectTraceEvents().empty());
+}
+
+TEST(Trace, ScopeRecordsOneCompleteEvent) {
+  const ScopedTracing tracing;
+  { const ppc::util::TraceScope scope("region", "test"); }
+  const auto events = ppc::util::CollectTraceEvents();
+  ASSERT_EQ(events.size(), 1U);
+  EXPECT_EQ(std::string_view(events[0].name), "region");
+  EXPECT_EQ(std::string_view(events[0].category), "test");
+  EXPECT_GE(events[0].begin_ns, 0);
+  EXPECT_GE(events[0].duration_ns, 0);
+}
+
+TEST(Trace, ThreadsRecordIntoSeparateBuffers) {
+  const ScopedTracing tracing;
+  { const ppc::util::TraceScope scope("main"); }
+  std::thread worker([] { const ppc::util::TraceScope scope("worker"); });
+  worker.join();
+  const auto events = ppc::util::CollectTraceEvents();
+  ASSERT_EQ(events.size(), 2U);
+  EXPECT_NE(events[0].thread_index, events[1].thread_index);
+}
+
+TEST(Trace, WriteTraceProducesChromeTraceJson) {
+  const ScopedTracing tracing;
+  { const ppc::util::TraceScope scope("Run", "task"); }
+  const auto path = std::filesystem::temp_directory_path() /
+                    ("ppc_trace_test_" + std::to_string(ppc::util::GetProcessId()) + ".json");
+  ppc::util::WriteTrace(path, 3);
+
+  std::ifstream file(path);
+  const auto trace = nlohmann::json::parse(file);
+  bool found = false;
+  for (const auto &event : trace.at("traceEvents")) {
+    if (event.at("ph") == "X") {
+      EXPECT_EQ(event.at("name"), "Run");
+      EXPECT_EQ(event.at("pid"), 3);
+      found = true;
+    }
+  }
+  EXPECT_TRUE(found);
+  std::filesystem::remove(path);
+}
@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <libenvpp/detail/environment.hpp>
 #include <libenvpp/detail/get.hpp>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -187,3 +188,58 @@ TEST(FuncTestUtil, RunTestCasesWithTagFailsWhenTagIsMissing) {
   ExpectSingleNonFatalFailureContains(failures, "No functional test cases matched tag: omp");
   EXPECT_FALSE(callback_was_called);
 }
+
+TEST(GetPerfThreadSweep, ReturnsEmptyWhenUnset) {
+  const auto old = env::get<std::string>("PPC_PERF_THREAD_SWEEP");
+  if (old.has_value()) {
+    env::detail::delete_environment_variable("PPC_PERF_THREAD_SWEEP");
+  }
+  EXPECT_TRUE(ppc::util::GetPerfThreadSweep().empty());
+  if (old.has_value()) {
+    env::detail::set_environment_variable("PPC_PERF_THREAD_SWEEP", *old);
+  }
+}
+
+TEST(GetPerfThreadSweep, ParsesCommaSeparatedCounts) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_THREAD_SWEEP", "1,2,4,8");
+  const std::vector<int> expected{1, 2, 4, 8};
+  EXPECT_EQ(ppc::util::GetPerfThreadSweep(), expected);
+}
+
+TEST(GetPerfThreadSweep, ThrowsOnInvalidEntry) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_THREAD_SWEEP", "1,two,4");
+  EXPECT_THROW(ppc::util::GetPerfThreadSweep(), std::runtime_error);
+}
+
+TEST(GetTestShard, ParsesPpcShard) {
+  env::detail::set_scoped_environment_variable scoped("PPC_SHARD", "2/5");
+  const auto shard = ppc::util::GetTestShard();
+  ASSERT_TRUE(shard.has_value());
+  EXPECT_EQ(shard->index, 2);
+  EXPECT_EQ(shard->total, 5);
+}
+
+TEST(GetTestShard, FallsBackToGTestVariables) {
+  const auto old = env::get<std::string>("PPC_SHARD");
+  if (old.has_value()) {
+    env::detail::delete_environment_variable("PPC_SHARD");
+  }
+  {
+    env::detail::set_scoped_environment_variable index("GTEST_SHARD_INDEX", "1");
+    env::detail::set_scoped_environment_variable total("GTEST_TOTAL_SHARDS", "3");
+    const auto shard = ppc::util::GetTestShard();
+    ASSERT_TRUE(shard.has_value());
+    EXPECT_EQ(shard->index, 1);
+    EXPECT_EQ(shard->total, 3);
+  }
+  if (old.has_value()) {
+    env::detail::set_environment_variable("PPC_SHARD", *old);
+  }
+}
+
+TEST(GetTestShard, ThrowsOnMalformedShard) {
+  for (const char *value : {"3", "a/4", "4/4", "1/-2"}) {
+    env::detail::set_scoped_environment_variable scoped("PPC_SHARD", value);
+    EXPECT_THROW((void)ppc::util::GetTestShard(), std::runtime_error) << value;
+  }
+}
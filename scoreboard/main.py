@@ -1,4 +1,5 @@
 import argparse
+import hashlib
 import json
 import logging
 import re
@@ -6,6 +7,7 @@ import shutil
 import subprocess
 import sys
 from collections import defaultdict
+from concurrent.futures import ThreadPoolExecutor
 from datetime import datetime
 from pathlib import Path
 from zoneinfo import ZoneInfo  # type: ignore
@@ -22,12 +24,19 @@ task_types_threads = ["seq", "omp", "tbb", "stl", "all"]
 task_types_processes = ["mpi", "seq"]
 PERF_STAT_PRIORITY = {"median": 0, "mean": 1, "": 2}
 PERF_TIME_UNIT_TO_SECONDS = {"s": 1.0, "ms": 1e-3, "us": 1e-6, "ns": 1e-9}
+# Bump when the cached benchmark records or commit timestamps change meaning
+SCOREBOARD_CACHE_VERSION = 1
 
 script_dir = Path(__file__).parent
 tasks_dir = script_dir.parent / "tasks"
 task_physical_dirs: dict[str, Path] = {}
 task_info_paths: dict[str, Path] = {}
 process_task_indices: dict[str, int] = {}
+# Tree hash at HEAD of every directory under tasks/, keyed by repo-relative path
+git_tree_hashes: dict[str, str] = {}
+# Last commit timestamp per "<path>@<tree hash>"; persisted in the scoreboard cache
+commit_timestamps: dict[str, int | None] = {}
+_json_file_cache: dict[tuple[str, int, int], dict | None] = {}
 # Salt is derived from the repository root directory name (dynamic)
 REPO_ROOT = script_dir.parent.resolve()
 # Salt format: "learning_process/<repo_name>"
@@ -89,18 +98,28 @@ def _task_info_path(dir_name: str) -> Path:
     return task_info_paths.get(dir_name, tasks_dir / dir_name / "info.json")
 
 
-def _student_info_for_dir(dir_name: str) -> dict:
-    info_path = _task_info_path(dir_name)
-    if not info_path.exists():
-        return {}
+def _read_json_cached(path: Path) -> dict | None:
+    """Parse a small JSON file once per (path, mtime, size); None if missing or invalid."""
     try:
-        with open(info_path, "r") as f:
-            data = json.load(f)
-        if isinstance(data.get("student"), dict):
-            return data.get("student", {})
-    except Exception as e:
-        logger.warning("Failed to parse %s: %s", info_path, e)
-    return {}
+        stat = path.stat()
+    except OSError:
+        return None
+    key = (str(path), stat.st_mtime_ns, stat.st_size)
+    if key not in _json_file_cache:
+        try:
+            with open(path, "r") as f:
+                data = json.load(f)
+            _json_file_cache[key] = data if isinstance(data, dict) else None
+        except Exception as e:
+            logger.warning("Failed to parse %s: %s", path, e)
+            _json_file_cache[key] = None
+    return _json_file_cache[key]
+
+
+def _student_info_for_dir(dir_name: str) -> dict:
+    data = _read_json_cached(_task_info_path(dir_name)) or {}
+    student = data.get("student")
+    return student if isinstance(student, dict) else {}
 
 
 def _student_full_name(student: dict) -> str:
@@ -210,9 +229,29 @@ def discover_tasks(tasks_dir, task_types):
 directories, task_category_map = discover_tasks(tasks_dir, task_types)
 
 
+# Name components that Google Benchmark appends to a run, plus the swept thread count
+_MAIN_RUN_SUFFIXES = (
+    "num_threads:",
+    "iterations:",
+    "repeats:",
+    "min_time:",
+    "min_warmup_time:",
+    "threads:",
+    "manual_time",
+    "real_time",
+    "process_time",
+)
+
+
 def parse_benchmark_name(name: str) -> tuple[str, str, str] | None:
-    """Parse <task>_<impl>_enabled Google Benchmark names."""
-    base_name = name.split("/", maxsplit=1)[0]
+    """Parse <task>_<impl>_enabled Google Benchmark names of main runs.
+
+    Batch, size sweep and schedule variants time different work than the main
+    run, so names with any other suffix are skipped.
+    """
+    base_name, *suffixes = name.split("/")
+    if not all(suffix.startswith(_MAIN_RUN_SUFFIXES) for suffix in suffixes):
+        return None
     match = re.match(
         r"(.+?)_(all|mpi|omp|seq|stl|tbb)_enabled(?:_(mean|median))?$", base_name
     )
@@ -229,9 +268,49 @@ def _perf_record_priority(record: dict) -> int:
     return PERF_STAT_PRIORITY.get(str(record.get("statistic", "")), 3)
 
 
-def load_benchmark_performance_data(benchmarks_dir: Path) -> dict[str, dict]:
+def _select_benchmark_records(payload: dict) -> dict[str, dict]:
+    """Pick the preferred record of every <task>/<impl> found in one benchmark JSON payload."""
+    selected: dict[str, dict] = {}
+    for entry in payload.get("benchmarks", []):
+        parsed_name = parse_benchmark_name(str(entry.get("name", "")))
+        if parsed_name is None:
+            continue
+        task_name, implementation, statistic = parsed_name
+        try:
+            seconds = _benchmark_time_to_seconds(
+                float(entry["real_time"]), str(entry.get("time_unit", "ns"))
+            )
+        except (KeyError, TypeError, ValueError):
+            continue
+        record = {
+            "task": task_name,
+            "implementation": implementation,
+            "seconds": seconds,
+            "statistic": statistic or str(entry.get("aggregate_name", "")),
+        }
+        key = f"{task_name}/{implementation}"
+        previous = selected.get(key)
+        if previous is None or _perf_record_priority(record) < _perf_record_priority(
+            previous
+        ):
+            selected[key] = record
+    return selected
+
+
+def _parse_benchmark_file(content: bytes) -> dict[str, dict]:
+    return _select_benchmark_records(json.loads(content.decode("utf-8")))
+
+
+def load_benchmark_performance_data(
+    benchmarks_dir: Path, cache: dict | None = None, max_workers: int | None = None
+) -> dict[str, dict]:
     """Load Google Benchmark JSON files written by ppc_perf_tests.
 
+    Files are parsed in parallel. When ``cache`` is given it maps the sha256 of a
+    file's content to its selected records: unchanged files are not parsed again,
+    the records of new or changed files are added to it and those of files that
+    are gone are dropped.
+
     Returns raw benchmark times in seconds:
       benchmark task name -> implementation -> seconds
     """
@@ -239,33 +318,52 @@ def load_benchmark_performance_data(benchmarks_dir: Path) -> dict[str, dict]:
         logger.warning("Benchmark JSON directory not found at %s", benchmarks_dir)
         return {}
 
-    selected: dict[tuple[str, str], dict] = {}
-    for json_path in sorted(benchmarks_dir.glob("*.json")):
+    json_paths = sorted(benchmarks_dir.glob("*.json"))
+    digests: dict[Path, str] = {}
+    pending: dict[str, tuple[Path, bytes]] = {}
+    for json_path in json_paths:
         try:
-            with open(json_path, "r", encoding="utf-8") as file:
-                payload = json.load(file)
-        except (OSError, json.JSONDecodeError) as e:
-            logger.warning("Failed to parse benchmark JSON %s: %s", json_path, e)
+            content = json_path.read_bytes()
+        except OSError as e:
+            logger.warning("Failed to read benchmark JSON %s: %s", json_path, e)
             continue
-
-        for entry in payload.get("benchmarks", []):
-            parsed_name = parse_benchmark_name(str(entry.get("name", "")))
-            if parsed_name is None:
-                continue
-            task_name, implementation, statistic = parsed_name
+        digest = hashlib.sha256(content).hexdigest()
+        digests[json_path] = digest
+        if cache is None or digest not in cache:
+            pending.setdefault(digest, (json_path, content))
+
+    parsed: dict[str, dict[str, dict] | None] = {}
+    if pending:
+        with ThreadPoolExecutor(max_workers=max_workers) as pool:
+            futures = {
+                digest: pool.submit(_parse_benchmark_file, content)
+                for digest, (_, content) in pending.items()
+            }
+        for digest, future in futures.items():
             try:
-                seconds = _benchmark_time_to_seconds(
-                    float(entry["real_time"]), str(entry.get("time_unit", "ns"))
+                parsed[digest] = future.result()
+            except (UnicodeDecodeError, json.JSONDecodeError, AttributeError) as e:
+                logger.warning(
+                    "Failed to parse benchmark JSON %s: %s", pending[digest][0], e
                 )
-            except (KeyError, TypeError, ValueError):
-                continue
-            record = {
-                "task": task_name,
-                "implementation": implementation,
-                "seconds": seconds,
-                "statistic": statistic or str(entry.get("aggregate_name", "")),
-            }
-            key = (task_name, implementation)
+                parsed[digest] = None
+    if cache is not None:
+        live = set(digests.values())
+        for digest in [d for d in cache if d not in live]:
+            del cache[digest]
+        cache.update({d: r for d, r in parsed.items() if r is not None})
+    logger.info(
+        "Benchmark JSON files: %d parsed, %d reused from cache",
+        len(pending),
+        len(digests) - sum(1 for d in digests.values() if d in pending),
+    )
+
+    # Keep the earliest file's record on equal priority, as a sequential scan would
+    selected: dict[str, dict] = {}
+    for json_path in json_paths:
+        digest = digests.get(json_path)
+        records = parsed[digest] if digest in parsed else (cache or {}).get(digest)
+        for key, record in (records or {}).items():
             previous = selected.get(key)
             if previous is None or _perf_record_priority(
                 record
@@ -280,6 +378,82 @@ def load_benchmark_performance_data(benchmarks_dir: Path) -> dict[str, dict]:
     return perf_stats
 
 
+def load_scoreboard_cache(cache_path: Path | None) -> dict:
+    """Read the scoreboard cache; a missing, corrupt or outdated file yields an empty cache."""
+    empty = {"version": SCOREBOARD_CACHE_VERSION, "benchmarks": {}, "commits": {}}
+    if cache_path is None or not cache_path.exists():
+        return empty
+    try:
+        with open(cache_path, "r", encoding="utf-8") as f:
+            data = json.load(f)
+    except (OSError, json.JSONDecodeError) as e:
+        logger.warning("Ignoring unreadable scoreboard cache %s: %s", cache_path, e)
+        return empty
+    if not isinstance(data, dict) or data.get("version") != SCOREBOARD_CACHE_VERSION:
+        return empty
+    for section in ("benchmarks", "commits"):
+        if not isinstance(data.get(section), dict):
+            data[section] = {}
+    return data
+
+
+def save_scoreboard_cache(cache_path: Path | None, cache: dict) -> None:
+    if cache_path is None:
+        return
+    try:
+        cache_path.parent.mkdir(parents=True, exist_ok=True)
+        tmp_path = cache_path.with_name(cache_path.name + ".tmp")
+        with open(tmp_path, "w", encoding="utf-8") as f:
+            json.dump(cache, f, sort_keys=True)
+        tmp_path.replace(cache_path)
+    except OSError as e:
+        logger.warning("Failed to write scoreboard cache %s: %s", cache_path, e)
+
+
+def load_git_tree_hashes(repo_root: Path) -> dict[str, str]:
+    """Tree hash at HEAD of every directory under tasks/, from a single git call."""
+    try:
+        result = subprocess.run(
+            ["git", "ls-tree", "-r", "-d", "HEAD", "--", "tasks"],
+            cwd=repo_root,
+            capture_output=True,
+            text=True,
+        )
+    except OSError:
+        return {}
+    hashes = {}
+    for line in result.stdout.splitlines():
+        meta, _, path = line.partition("\t")
+        fields = meta.split()
+        if len(fields) == 3 and fields[1] == "tree":
+            hashes[path] = fields[2]
+    return hashes
+
+
+def _last_commit_timestamp(path: Path) -> int | None:
+    """Timestamp of the last commit touching ``path``.
+
+    Keyed by the path and its tree hash at HEAD, so a task directory that did not
+    change since the cached run is not asked for its git log again.
+    """
+    try:
+        relative = path.resolve().relative_to(REPO_ROOT).as_posix()
+    except ValueError:
+        relative = str(path)
+    tree_hash = git_tree_hashes.get(relative)
+    key = f"{relative}@{tree_hash}" if tree_hash else None
+    if key is not None and key in commit_timestamps:
+        return commit_timestamps[key]
+    result = subprocess.run(
+        ["git", "log", "-1", "--format=%ct", str(path)], capture_output=True, text=True
+    )
+    output = result.stdout.strip()
+    timestamp = int(output) if output.isdigit() else None
+    if key is not None:
+        commit_timestamps[key] = timestamp
+    return timestamp
+
+
 def calculate_performance_metrics(perf_val, eff_num_proc, task_type, seq_val=None):
     """Calculate acceleration and efficiency from raw times in seconds."""
     acceleration = "?"
@@ -531,21 +705,14 @@ def calculate_deadline_penalty(dir, task_type, status, deadlines_cfg, tasks_dir)
     if status == "done" and deadline_str:
         try:
             deadline_dt = datetime.fromisoformat(deadline_str)
-            git_cmd = [
-                "git",
-                "log",
-                "-1",
-                "--format=%ct",
-                str(
-                    _task_physical_dir(
-                        dir[: -len("_disabled")] if dir.endswith("_disabled") else dir
-                    )
-                    / task_type
-                ),
-            ]
-            result = subprocess.run(git_cmd, capture_output=True, text=True)
-            if result.stdout.strip().isdigit():
-                commit_dt = datetime.fromtimestamp(int(result.stdout.strip()))
+            timestamp = _last_commit_timestamp(
+                _task_physical_dir(
+                    dir[: -len("_disabled")] if dir.endswith("_disabled") else dir
+                )
+                / task_type
+            )
+            if timestamp is not None:
+                commit_dt = datetime.fromtimestamp(timestamp)
                 days_late = (commit_dt - deadline_dt).days
                 if days_late > 0:
                     deadline_points = -days_late
@@ -580,8 +747,13 @@ def _build_rows_for_task_types(
     cfg,
     eff_num_proc,
     deadlines_cfg,
+    row_cache: dict | None = None,
 ):
-    """Build rows for the given list of task directories and selected task types."""
+    """Build rows for the given list of task directories and selected task types.
+
+    ``row_cache`` keeps rows built earlier in the same run with the same inputs, so
+    per-group pages reuse the rows of the full page instead of recomputing them.
+    """
     rows = []
 
     def _load_student_info_label(dir_name: str):
@@ -597,6 +769,10 @@ def _build_rows_for_task_types(
         return _student_full_name(s), str(s.get("group_number", ""))
 
     for dir in sorted(dir_names):
+        cache_key = (tuple(selected_task_types), dir)
+        if row_cache is not None and cache_key in row_cache:
+            rows.append(row_cache[cache_key])
+            continue
         row_types = []
         total_count = 0
         for task_type in selected_task_types:
@@ -678,14 +854,15 @@ def _build_rows_for_task_types(
                 variant = "?"
         else:
             variant = "?"
-        rows.append(
-            {
-                "task": label_name,
-                "variant": variant,
-                "types": row_types,
-                "total": total_count,
-            }
-        )
+        row = {
+            "task": label_name,
+            "variant": variant,
+            "types": row_types,
+            "total": total_count,
+        }
+        if row_cache is not None:
+            row_cache[cache_key] = row
+        rows.append(row)
     return rows
 
 
@@ -697,6 +874,33 @@ def main():
       - threads.html: scoreboard for thread-based tasks
       - processes.html: scoreboard for process-based tasks
     """
+    parser = argparse.ArgumentParser(description="Generate HTML scoreboard.")
+    parser.add_argument(
+        "-o", "--output", type=str, required=True, help="Output directory path"
+    )
+    parser.add_argument(
+        "--cache",
+        type=str,
+        default=str(script_dir.parent / "build" / "scoreboard_cache.json"),
+        help="Cache of parsed benchmark results and task commit times",
+    )
+    parser.add_argument(
+        "--no-cache", action="store_true", help="Parse everything from scratch"
+    )
+    parser.add_argument(
+        "-j",
+        "--jobs",
+        type=int,
+        default=None,
+        help="Benchmark JSON files parsed in parallel (default: CPU count)",
+    )
+    args = parser.parse_args()
+
+    cache_path = None if args.no_cache else Path(args.cache)
+    cache = load_scoreboard_cache(cache_path)
+    git_tree_hashes.update(load_git_tree_hashes(REPO_ROOT))
+    commit_timestamps.update(cache["commits"])
+
     cfg, eff_num_proc, deadlines_cfg, plagiarism_cfg_local = load_configurations()
 
     # Make plagiarism config available to rows builder
@@ -750,7 +954,9 @@ def main():
         script_dir.parent / "perf_stat_dir" / "benchmarks",
     ]
     benchmarks_dir = next((p for p in benchmark_dirs if p.exists()), benchmark_dirs[0])
-    perf_stats_raw = load_benchmark_performance_data(benchmarks_dir)
+    perf_stats_raw = load_benchmark_performance_data(
+        benchmarks_dir, cache["benchmarks"], args.jobs
+    )
 
     # Partition tasks by category derived from the filesystem layout.
     threads_task_dirs = [
@@ -800,6 +1006,7 @@ def main():
             perf_stats[t] = _merge_perf_maps(perf_stats.get(t, {}), vals)
 
     # Build rows for each page
+    threads_row_cache: dict = {}
     threads_rows = _build_rows_for_task_types(
         task_types_threads,
         threads_task_dirs,
@@ -807,6 +1014,7 @@ def main():
         cfg,
         eff_num_proc,
         deadlines_cfg,
+        threads_row_cache,
     )
 
     # Processes page: build 3 tasks as columns for a single student
@@ -1049,22 +1257,6 @@ def main():
         proc_group_headers.append({"type": "mpi"})
         proc_group_headers.append({"type": "seq"})
 
-    # Rebuild threads rows with resolved perf stats
-    threads_rows = _build_rows_for_task_types(
-        task_types_threads,
-        threads_task_dirs,
-        perf_stats,
-        cfg,
-        eff_num_proc,
-        deadlines_cfg,
-    )
-
-    parser = argparse.ArgumentParser(description="Generate HTML scoreboard.")
-    parser.add_argument(
-        "-o", "--output", type=str, required=True, help="Output directory path"
-    )
-    args = parser.parse_args()
-
     output_path = Path(args.output)
     output_path.mkdir(parents=True, exist_ok=True)
 
@@ -1107,17 +1299,7 @@ def main():
 
     # ——— Build per-group pages and group menus ————————————————————————
     def _load_group_number(dir_name: str):
-        import json
-
-        info_path = _task_info_path(dir_name)
-        if not info_path.exists():
-            return None
-        try:
-            with open(info_path, "r") as f:
-                data = json.load(f)
-            return data.get("student", {}).get("group_number")
-        except Exception:
-            return None
+        return _student_info_for_dir(dir_name).get("group_number")
 
     def _slugify(text: str) -> str:
         return "".join(
@@ -1145,6 +1327,7 @@ def main():
             cfg,
             eff_num_proc,
             deadlines_cfg,
+            threads_row_cache,
         )
         # Rebuild deadline labels for this page.
         dl_threads_out_g = _thread_deadline_labels(threads_order)
@@ -1252,6 +1435,10 @@ def main():
     else:
         logger.warning("Static directory not found at %s", static_src)
 
+    live_trees = {f"{path}@{tree}" for path, tree in git_tree_hashes.items()}
+    cache["commits"] = {k: v for k, v in commit_timestamps.items() if k in live_trees}
+    save_scoreboard_cache(cache_path, cache)
+
     logger.info(
         "HTML pages generated at %s (index.html, threads.html, processes.html)",
         output_path,
@@ -4,7 +4,16 @@ Tests for loading Google Benchmark performance JSON files.
 
 import json
 
-from main import load_benchmark_performance_data, parse_benchmark_name
+from main import (
+    load_benchmark_performance_data,
+    load_scoreboard_cache,
+    parse_benchmark_name,
+    save_scoreboard_cache,
+)
+
+
+def _write_benchmarks(path, entries):
+    path.write_text(json.dumps({"benchmarks": entries}), encoding="utf-8")
 
 
 class TestLoadBenchmarkPerformanceData:
@@ -26,6 +35,35 @@ class TestLoadBenchmarkPerformanceData:
             "",
         )
 
+    def test_parse_skips_batch_benchmark(self):
+        assert (
+            parse_benchmark_name(
+                "example_threads_omp_enabled/batch:64/iterations:1/manual_time"
+            )
+            is None
+        )
+
+    def test_parse_skips_size_sweep_benchmark(self):
+        assert (
+            parse_benchmark_name(
+                "example_threads_omp_enabled/size_sweep/n:1024/iterations:1/manual_time"
+            )
+            is None
+        )
+
+    def test_parse_skips_schedule_benchmark(self):
+        assert (
+            parse_benchmark_name(
+                "example_threads_omp_enabled/num_threads:4/schedule:kind=dynamic/manual_time"
+            )
+            is None
+        )
+
+    def test_parse_thread_sweep_benchmark_name(self):
+        assert parse_benchmark_name(
+            "example_threads_omp_enabled/num_threads:4/iterations:5/repeats:3/manual_time_mean"
+        ) == ("example_threads", "omp", "")
+
     def test_load_benchmark_json_in_seconds(self, temp_dir):
         benchmarks_dir = temp_dir / "benchmarks"
         benchmarks_dir.mkdir()
@@ -118,3 +156,64 @@ class TestLoadBenchmarkPerformanceData:
         result = load_benchmark_performance_data(benchmarks_dir)
 
         assert result["example_threads"]["tbb"] == "0.2"
+
+    def test_cache_skips_unchanged_files_and_refreshes_changed_ones(self, temp_dir):
+        benchmarks_dir = temp_dir / "benchmarks"
+        benchmarks_dir.mkdir()
+        threads_json = benchmarks_dir / "threads.json"
+        _write_benchmarks(
+            threads_json,
+            [{"name": "example_threads_omp_enabled", "real_time": 2, "time_unit": "s"}],
+        )
+        cache = {}
+
+        assert load_benchmark_performance_data(benchmarks_dir, cache) == {
+            "example_threads": {"omp": "2"}
+        }
+        assert len(cache) == 1
+
+        # A cached entry is used as is, so the file is not parsed again
+        (records,) = cache.values()
+        records["example_threads/omp"]["seconds"] = 3.0
+        result = load_benchmark_performance_data(benchmarks_dir, cache)
+        assert result["example_threads"]["omp"] == "3"
+
+        _write_benchmarks(
+            threads_json,
+            [{"name": "example_threads_omp_enabled", "real_time": 4, "time_unit": "s"}],
+        )
+        result = load_benchmark_performance_data(benchmarks_dir, cache)
+        assert result["example_threads"]["omp"] == "4"
+        assert len(cache) == 1
+
+    def test_parallel_load_keeps_file_order_on_equal_priority(self, temp_dir):
+        benchmarks_dir = temp_dir / "benchmarks"
+        benchmarks_dir.mkdir()
+        for index in range(8):
+            _write_benchmarks(
+                benchmarks_dir / f"run_{index}.json",
+                [
+                    {
+                        "name": "example_threads_tbb_enabled",
+                        "real_time": index + 1,
+                        "time_unit": "s",
+                    }
+                ],
+            )
+        (benchmarks_dir / "broken.json").write_text("{", encoding="utf-8")
+
+        sequential = load_benchmark_performance_data(benchmarks_dir, max_workers=1)
+        parallel = load_benchmark_performance_data(benchmarks_dir, {}, max_workers=4)
+
+        assert sequential == parallel == {"example_threads": {"tbb": "1"}}
+
+    def test_scoreboard_cache_round_trip_and_corrupt_file(self, temp_dir):
+        cache_path = temp_dir / "cache" / "scoreboard_cache.json"
+        cache = load_scoreboard_cache(cache_path)
+        cache["commits"]["tasks/example@abc"] = 1700000000
+        save_scoreboard_cache(cache_path, cache)
+
+        assert load_scoreboard_cache(cache_path) == cache
+
+        cache_path.write_text("not json", encoding="utf-8")
+        assert load_scoreboard_cache(cache_path)["commits"] == {}
@@ -141,6 +141,7 @@ BACKEND_RULES = {
     "tbb": {"openmp", "mpi", "cpp_thread"},
     "mpi": {"openmp", "tbb", "cpp_thread"},
     "stl": {"openmp", "tbb", "mpi"},
+    "offload": {"tbb", "mpi", "cpp_thread"},
     "common": set(API_ORDER),
 }
 
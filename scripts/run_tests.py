@@ -5,8 +5,11 @@ import platform
 import shlex
 import shutil
 import subprocess
+from concurrent.futures import ThreadPoolExecutor
 from pathlib import Path
 
+from detect_ci_task_scope import FULL_SUITE, detect_scope
+
 
 def init_cmd_args():
     import argparse
@@ -39,6 +42,39 @@ def init_cmd_args():
             "Default: 'build'."
         ),
     )
+    parser.add_argument(
+        "--shards",
+        default="1",
+        help=(
+            "Number of concurrent processes that split each non-MPI test run through PPC_SHARD, "
+            "or 'auto' to fill every CPU core with PPC_NUM_THREADS threads per shard. "
+            "MPI suites always run as a single mpirun group. Default: 1."
+        ),
+    )
+    parser.add_argument(
+        "--tasks",
+        nargs="+",
+        help=(
+            "Run only these tasks through their <task>_func_tests / <task>_perf_tests binaries "
+            "(configure with -DPPC_PER_TASK_TESTS=ON). Core tests are skipped."
+        ),
+    )
+    parser.add_argument(
+        "--changed-since",
+        help=(
+            "Select --tasks from the files changed since this git revision, including uncommitted "
+            "and untracked files. Falls back to the full suite when anything outside tasks/ changed."
+        ),
+    )
+    parser.add_argument(
+        "--restarts",
+        type=int,
+        default=0,
+        help=(
+            "Rerun a failed MPI test command up to this many times with a fixed PPC_CHECKPOINT_DIR, "
+            "so tasks that checkpoint (PPC_CHECKPOINT_INTERVAL) resume where they stopped. Default: 0."
+        ),
+    )
     parser.add_argument(
         "--verbose", action="store_true", help="Print commands executed by the script"
     )
@@ -48,8 +84,16 @@ def init_cmd_args():
 
 
 class PPCRunner:
-    def __init__(self, build_dir="build", verbose=False):
+    def __init__(
+        self, build_dir="build", verbose=False, shards="1", tasks=None, restarts=0
+    ):
+        if restarts < 0:
+            raise ValueError(f"--restarts must not be negative, got {restarts}.")
+        self.__restarts = restarts
         self.__ppc_num_threads = None
+        self.__tasks = list(tasks) if tasks else []
+        self.__shards = shards
+        self.__num_shards = 1
         self.__ppc_num_proc = None
         self.__ppc_env = None
         self.__build_dir_path = None
@@ -99,6 +143,8 @@ class PPCRunner:
                 "Required environment variable 'PPC_NUM_PROC' is not set."
             )
 
+        self.__num_shards = self.__resolve_num_shards(self.__shards)
+
         project_path = Path(self.__get_project_path())
         build_dir = Path(self.build_dir)
         if not build_dir.is_absolute():
@@ -128,6 +174,91 @@ class PPCRunner:
         if result.returncode != 0:
             raise Exception(f"Subprocess return {result.returncode}.")
 
+    def __checkpoint_env(self):
+        """A PPC_CHECKPOINT_DIR shared by all restarts, unless the caller already chose one."""
+        if self.__restarts == 0 or self.__ppc_env.get("PPC_CHECKPOINT_DIR"):
+            return {}
+        return {"PPC_CHECKPOINT_DIR": str(self.__build_dir_path / "checkpoints")}
+
+    def __run_exec_with_restarts(self, command, extra_env):
+        """Run an MPI command, rerunning it after a failure while --restarts allows.
+
+        Every attempt shares the PPC_CHECKPOINT_DIR of @p extra_env, so checkpointing tasks pick
+        up the state written by the attempt that failed.
+        """
+        for attempt in range(self.__restarts + 1):
+            try:
+                self.__run_exec(command, extra_env)
+                return
+            except Exception:
+                if attempt == self.__restarts:
+                    raise
+                print(
+                    f"[  RESTART {attempt + 1}/{self.__restarts}  ] Resuming from checkpoints",
+                    flush=True,
+                )
+
+    def __test_binaries(self, kind):
+        """Integrated ppc_<kind>_tests, or the per-task binaries of the selected tasks."""
+        if not self.__tasks:
+            return [self.work_dir / f"ppc_{kind}_tests"]
+        binaries = []
+        for task in self.__tasks:
+            binary = self.work_dir / f"{task}_{kind}_tests"
+            if not binary.exists() and not binary.with_suffix(".exe").exists():
+                raise FileNotFoundError(
+                    f"Per-task binary '{binary}' not found. "
+                    "Configure with -DPPC_PER_TASK_TESTS=ON and build it."
+                )
+            binaries.append(binary)
+        return binaries
+
+    def __resolve_num_shards(self, shards):
+        if str(shards) == "auto":
+            threads_per_shard = max(1, int(self.__ppc_num_threads))
+            return max(1, (os.cpu_count() or 1) // threads_per_shard)
+        num_shards = int(shards)
+        if num_shards < 1:
+            raise ValueError(f"--shards must be positive or 'auto', got {shards}.")
+        return num_shards
+
+    def __run_exec_sharded(self, command):
+        """Run a non-MPI GTest command as concurrent PPC_SHARD slices.
+
+        The output of every slice is buffered and printed in shard order once all of them finish.
+        """
+        if self.__num_shards <= 1:
+            self.__run_exec(command)
+            return
+        if self.verbose:
+            print(
+                f"Executing in {self.__num_shards} shards:",
+                " ".join(shlex.quote(part) for part in command),
+            )
+
+        def run_shard(index):
+            shard_env = self.__ppc_env.copy()
+            shard_env["PPC_SHARD"] = f"{index}/{self.__num_shards}"
+            return subprocess.run(
+                command,
+                shell=False,
+                env=shard_env,
+                stdout=subprocess.PIPE,
+                stderr=subprocess.STDOUT,
+                text=True,
+            )
+
+        with ThreadPoolExecutor(max_workers=self.__num_shards) as pool:
+            results = list(pool.map(run_shard, range(self.__num_shards)))
+        failed = []
+        for index, result in enumerate(results):
+            print(f"[  SHARD {index}/{self.__num_shards}  ]", flush=True)
+            print(result.stdout, end="", flush=True)
+            if result.returncode != 0:
+                failed.append(f"{index} (return {result.returncode})")
+        if failed:
+            raise Exception(f"Shards failed: {', '.join(failed)}.")
+
     def __detect_mpi_impl(self):
         """Detect MPI implementation and return (env_mode, np_flag).
         env_mode: 'openmpi' -> use '-x VAR', 'mpich' -> use '-genvlist VAR1,VAR2', 'unknown' -> pass no env flags.
@@ -172,6 +303,15 @@ class PPCRunner:
             "PPC_BENCHMARK_FILTER",
             "PPC_PERF_IMPL_FILTER",
             "PPC_PERF_CATEGORY_FILTER",
+            "PPC_SHARD",
+            "PPC_CHECKPOINT_DIR",
+            "PPC_CHECKPOINT_INTERVAL",
+            "PPC_CLOCK",
+            "PPC_PERF_INTERFERENCE",
+            "PPC_PERF_INTERFERENCE_THRESHOLD",
+            "PPC_PERF_INTERFERENCE_RETRIES",
+            "PPC_PERF_CGROUP",
+            "PPC_PERF_CPUSET",
         ]
 
         if self.platform == "Windows":
@@ -237,6 +377,7 @@ class PPCRunner:
             "_seq_": ["_seq_", "SeqEnabled"],
             "_stl_": ["_stl_", "StlEnabled"],
             "_tbb_": ["_tbb_", "TbbEnabled"],
+            "_offload_": ["_offload_", "OffloadEnabled"],
         }
         filter_patterns = type_task_patterns.get(type_task, [type_task])
         command = [
@@ -249,30 +390,33 @@ class PPCRunner:
         return command
 
     def run_threads(self):
-        if platform.system() == "Linux" and not self.__ppc_env.get("PPC_ASAN_RUN"):
-            for task_type in ["seq", "stl"]:
-                self.__run_exec(
-                    shlex.split(self.valgrind_cmd)
-                    + [str(self.work_dir / "ppc_func_tests")]
-                    + self.__get_gtest_settings(1, "_" + task_type + "_")
+        for binary in self.__test_binaries("func"):
+            if platform.system() == "Linux" and not self.__ppc_env.get("PPC_ASAN_RUN"):
+                for task_type in ["seq", "stl"]:
+                    self.__run_exec_sharded(
+                        shlex.split(self.valgrind_cmd)
+                        + [str(binary)]
+                        + self.__get_gtest_settings(1, "_" + task_type + "_")
+                    )
+
+            for task_type in ["omp", "seq", "stl", "tbb", "offload"]:
+                self.__run_exec_sharded(
+                    [str(binary)] + self.__get_gtest_settings(1, "_" + task_type + "_")
                 )
 
-        for task_type in ["omp", "seq", "stl", "tbb"]:
-            self.__run_exec(
-                [str(self.work_dir / "ppc_func_tests")]
-                + self.__get_gtest_settings(1, "_" + task_type + "_")
-            )
-
     def run_core(self):
+        if self.__tasks:
+            return
+
         if platform.system() == "Linux" and not self.__ppc_env.get("PPC_ASAN_RUN"):
-            self.__run_exec(
+            self.__run_exec_sharded(
                 shlex.split(self.valgrind_cmd)
                 + [str(self.work_dir / "core_func_tests")]
                 + self.__get_gtest_settings(1, "*")
                 + ["--gtest_filter=*:-*DisabledValgrind"]
             )
 
-        self.__run_exec(
+        self.__run_exec_sharded(
             [str(self.work_dir / "core_func_tests")] + self.__get_gtest_settings(1, "*")
         )
 
@@ -282,20 +426,30 @@ class PPCRunner:
             raise EnvironmentError(
                 "Required environment variable 'PPC_NUM_PROC' is not set."
             )
-        mpi_running = self.__build_mpi_cmd(ppc_num_proc, additional_mpi_args)
+        checkpoint_env = self.__checkpoint_env()
+        mpi_running = self.__build_mpi_cmd(ppc_num_proc, additional_mpi_args, checkpoint_env)
+        if not self.__tasks:
+            self.__run_exec(
+                mpi_running
+                + [str(self.work_dir / "core_mpi_tests")]
+                + self.__get_gtest_settings(1, "*")
+            )
         if not self.__ppc_env.get("PPC_ASAN_RUN"):
-            for task_type in ["all", "mpi"]:
-                self.__run_exec(
-                    mpi_running
-                    + [str(self.work_dir / "ppc_func_tests")]
-                    + self.__get_gtest_settings(1, "_" + task_type + "_")
-                )
+            for binary in self.__test_binaries("func"):
+                for task_type in ["all", "mpi"]:
+                    self.__run_exec_with_restarts(
+                        mpi_running
+                        + [str(binary)]
+                        + self.__get_gtest_settings(1, "_" + task_type + "_"),
+                        checkpoint_env,
+                    )
 
     def run_performance(self):
         output_dir = self.__benchmark_output_dir()
         if output_dir.exists():
             shutil.rmtree(output_dir)
 
+        binaries = self.__test_binaries("perf")
         if not self.__ppc_env.get("PPC_ASAN_RUN"):
             for category, task_type in [
                 ("threads", "all"),
@@ -304,26 +458,61 @@ class PPCRunner:
             ]:
                 extra_env = self.__get_benchmark_env(category, task_type)
                 mpi_running = self.__build_mpi_cmd(self.__ppc_num_proc, "", extra_env)
+                for binary in binaries:
+                    self.__run_exec(
+                        mpi_running
+                        + [str(binary)]
+                        + self.__get_performance_gtest_settings(),
+                        self.__per_binary_benchmark_env(extra_env, binary, binaries),
+                    )
+
+        for task_type in ["omp", "seq", "stl", "tbb", "offload"]:
+            extra_env = self.__get_benchmark_env("threads", task_type)
+            for binary in binaries:
                 self.__run_exec(
-                    mpi_running
-                    + [str(self.work_dir / "ppc_perf_tests")]
-                    + self.__get_performance_gtest_settings(),
-                    extra_env,
+                    [str(binary)] + self.__get_performance_gtest_settings(),
+                    self.__per_binary_benchmark_env(extra_env, binary, binaries),
                 )
 
-        for task_type in ["omp", "seq", "stl", "tbb"]:
-            extra_env = self.__get_benchmark_env("threads", task_type)
-            self.__run_exec(
-                [str(self.work_dir / "ppc_perf_tests")]
-                + self.__get_performance_gtest_settings(),
-                extra_env,
-            )
+    @staticmethod
+    def __per_binary_benchmark_env(extra_env, binary, binaries):
+        """Gives every per-task binary its own PPC_BENCHMARK_OUT so runs do not overwrite each other."""
+        if len(binaries) <= 1:
+            return extra_env
+        out = Path(extra_env["PPC_BENCHMARK_OUT"])
+        task = binary.name.removesuffix("_perf_tests")
+        return {**extra_env, "PPC_BENCHMARK_OUT": str(out.with_name(f"{out.stem}_{task}{out.suffix}"))}
+
+
+def _changed_tasks(revision):
+    """Tasks touched since @p revision, or None when the change needs the full suite."""
+    project_path = Path(__file__).resolve().parent.parent
+
+    def git_lines(*args):
+        result = subprocess.run(
+            ["git", *args], cwd=project_path, check=True, stdout=subprocess.PIPE, text=True
+        )
+        return [line for line in result.stdout.splitlines() if line]
+
+    changed = git_lines("diff", "--name-only", "--no-renames", revision)
+    changed += git_lines("ls-files", "--others", "--exclude-standard")
+    scope, task_scoped = detect_scope(changed, project_path / "tasks")
+    if not task_scoped or scope == FULL_SUITE:
+        return None
+    return scope.split(";")
 
 
 def _execute(args_dict, env):
+    tasks = args_dict.get("tasks")
+    if args_dict.get("changed_since"):
+        tasks = _changed_tasks(args_dict["changed_since"])
+        print(f"Selected tasks: {' '.join(tasks) if tasks else 'all'}", flush=True)
     runner = PPCRunner(
         build_dir=args_dict.get("build_dir", "build"),
         verbose=args_dict.get("verbose", False),
+        shards=args_dict.get("shards", "1"),
+        tasks=tasks,
+        restarts=args_dict.get("restarts", 0),
     )
     runner.setup_env(env)
 
@@ -4,24 +4,33 @@
 #include <benchmark/reporter.h>
 #include <mpi.h>
 
-#include <chrono>
+#include <algorithm>
+#include <array>
 #include <cstddef>
-#include <cstdint>
 #include <cstdlib>
 #include <exception>
 #include <filesystem>
 #include <format>
 #include <fstream>
 #include <iostream>
-#include <memory>
-#include <random>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "oneapi/tbb/global_control.h"
 #include "runners/include/runners.hpp"
+#include "util/include/affinity.hpp"
+#include "util/include/clock.hpp"
+#include "util/include/interference.hpp"
+#include "util/include/perf_baseline.hpp"
+#include "util/include/roofline.hpp"
+#include "util/include/thread_pool.hpp"
+#include "util/include/topology.hpp"
+#include "util/include/trace.hpp"
 #include "util/include/util.hpp"
 
 namespace {
@@ -35,56 +44,168 @@ class NullBenchmarkReporter final : public benchmark::BenchmarkReporter {
   void ReportRuns(const std::vector<Run> & /*report*/) override {}
 };
 
-int RunAllTests() {
-  const int status = RUN_ALL_TESTS();
-  if (ppc::util::DestructorFailureFlag::Get()) {
-    throw std::runtime_error(
-        std::format("[  ERROR  ] Destructor failed with code {}", ppc::util::DestructorFailureFlag::Get()));
-  }
-  return status;
+/// @brief Task prefix, implementation token and swept thread count parsed from a benchmark name.
+struct ScalingKey {
+  std::string task;
+  std::string implementation;
+  int num_threads = 0;
+};
+
+/// @brief True for the name components of a main run: the swept thread count and what Google Benchmark appends.
+bool IsMainRunSuffix(std::string_view suffix) {
+  constexpr std::array<std::string_view, 9> kMainRunSuffixes = {
+      "num_threads:", "iterations:", "repeats:",   "min_time:", "min_warmup_time:",
+      "threads:",     "manual_time", "real_time",  "process_time"};
+  return std::ranges::any_of(kMainRunSuffixes, [suffix](std::string_view tag) { return suffix.starts_with(tag); });
 }
 
-void SyncGTestSeed() {
-  int rank = -1;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-  int seed = ::testing::GTEST_FLAG(random_seed);
-  if (rank == 0 && seed == 0) {
-    try {
-      seed = static_cast<int>((std::random_device{}() % 99999U) + 1U);
-    } catch (...) {
-      seed = 0;
-    }
-    if (seed == 0) {
-      const auto now = static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
-      seed = static_cast<int>((now % 99999ULL) + 1ULL);
+/// @brief Parses the name of a main run or a thread sweep run; batch, size sweep and schedule variants time different
+///        work and yield std::nullopt.
+std::optional<ScalingKey> ParseScalingKey(const std::string &benchmark_name) {
+  const std::string base_name = benchmark_name.substr(0, benchmark_name.find('/'));
+  for (std::size_t pos = benchmark_name.find('/'); pos != std::string::npos;) {
+    const std::size_t next = benchmark_name.find('/', pos + 1);
+    if (!IsMainRunSuffix(std::string_view(benchmark_name).substr(pos + 1, next - pos - 1))) {
+      return std::nullopt;
     }
+    pos = next;
+  }
+  const std::size_t status_pos = base_name.rfind('_');
+  if (status_pos == std::string::npos || status_pos == 0) {
+    return std::nullopt;
+  }
+  const std::size_t impl_pos = base_name.rfind('_', status_pos - 1);
+  if (impl_pos == std::string::npos) {
+    return std::nullopt;
   }
-  MPI_Bcast(&seed, 1, MPI_INT, 0, MPI_COMM_WORLD);
-  ::testing::GTEST_FLAG(random_seed) = seed;
+  ScalingKey key{.task = base_name.substr(0, impl_pos),
+                 .implementation = base_name.substr(impl_pos + 1, status_pos - impl_pos - 1)};
+  constexpr std::string_view kThreadsTag = "/num_threads:";
+  const std::size_t threads_pos = benchmark_name.find(kThreadsTag);
+  if (threads_pos != std::string::npos) {
+    key.num_threads = std::atoi(benchmark_name.c_str() + threads_pos + kThreadsTag.size());
+  }
+  return key;
 }
 
-void SyncGTestFilter() {
-  int rank = -1;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-  std::string filter = (rank == 0) ? ::testing::GTEST_FLAG(filter) : std::string{};
-  int len = static_cast<int>(filter.size());
-  MPI_Bcast(&len, 1, MPI_INT, 0, MPI_COMM_WORLD);
-  if (rank != 0) {
-    filter.resize(static_cast<std::size_t>(len));
+int ScalingWorkers(const ScalingKey &key) {
+  const int num_threads = key.num_threads > 0 ? key.num_threads : ppc::util::GetNumThreads();
+  if (key.implementation == "mpi") {
+    return ppc::util::GetNumProc();
   }
-  if (len > 0) {
-    MPI_Bcast(filter.data(), len, MPI_CHAR, 0, MPI_COMM_WORLD);
+  if (key.implementation == "all") {
+    return ppc::util::GetNumProc() * num_threads;
   }
-  ::testing::GTEST_FLAG(filter) = filter;
+  return num_threads;
 }
 
-bool HasFlag(int argc, char **argv, std::string_view flag) {
-  for (int i = 1; i < argc; ++i) {
-    if (argv[i] != nullptr && std::string_view(argv[i]) == flag) {
-      return true;
+/// @brief JSON reporter that adds speedup and efficiency against the SEQ run of the same task.
+/// @details Runs are buffered until Finalize() because the SEQ baseline may be reported after the parallel runs.
+class ScalingJsonReporter final : public benchmark::JSONReporter {
+ public:
+  void ReportRuns(const std::vector<Run> &report) override {
+    runs_.insert(runs_.end(), report.begin(), report.end());
+  }
+
+  void Finalize() override {
+    AddScalingCounters();
+    if (!runs_.empty()) {
+      benchmark::JSONReporter::ReportRuns(runs_);
+    }
+    benchmark::JSONReporter::Finalize();
+  }
+
+ private:
+  void AddScalingCounters() {
+    std::unordered_map<std::string, std::pair<double, int>> seq_times;
+    for (const auto &run : runs_) {
+      const auto key = ParseScalingKey(run.benchmark_name());
+      if (run.run_type == Run::RT_Iteration && key.has_value() && key->implementation == "seq" &&
+          run.GetAdjustedRealTime() > 0.0) {
+        auto &[sum, count] = seq_times[key->task];
+        sum += run.GetAdjustedRealTime();
+        count++;
+      }
+    }
+    for (auto &run : runs_) {
+      const auto key = ParseScalingKey(run.benchmark_name());
+      if (run.run_type != Run::RT_Iteration || !key.has_value() || key->implementation == "seq") {
+        continue;
+      }
+      const auto seq_it = seq_times.find(key->task);
+      const double time = run.GetAdjustedRealTime();
+      if (seq_it == seq_times.end() || time <= 0.0) {
+        continue;
+      }
+      const double speedup = (seq_it->second.first / seq_it->second.second) / time;
+      run.counters["speedup"] = benchmark::Counter(speedup);
+      run.counters["efficiency"] = benchmark::Counter(speedup / std::max(ScalingWorkers(*key), 1));
+    }
+  }
+
+  std::vector<Run> runs_;
+};
+
+/// @brief Console reporter that also keeps the real time of every repetition for the baseline comparison.
+class RecordingConsoleReporter final : public benchmark::ConsoleReporter {
+ public:
+  RecordingConsoleReporter() : benchmark::ConsoleReporter(OO_Tabular) {}
+
+  void ReportRuns(const std::vector<Run> &report) override {
+    for (const auto &run : report) {
+      if (run.run_type == Run::RT_Iteration && !run.error_occurred) {
+        const double seconds = run.GetAdjustedRealTime() / benchmark::GetTimeUnitMultiplier(run.time_unit);
+        samples_[run.run_name.str()].push_back(seconds);
+      }
+    }
+    benchmark::ConsoleReporter::ReportRuns(report);
+  }
+
+  [[nodiscard]] const ppc::util::PerfSamples &Samples() const {
+    return samples_;
+  }
+
+ private:
+  ppc::util::PerfSamples samples_;
+};
+
+/// @brief Compares the recorded runs with the @p baseline loaded from @p baseline_path and flags a performance
+///        failure on regressions.
+void CompareWithBaseline(const std::string &baseline_path, const ppc::util::PerfSamples &baseline,
+                         const ppc::util::PerfSamples &current) {
+  const double threshold = ppc::util::GetPerfRegressionThreshold();
+  const double alpha = ppc::util::GetPerfRegressionAlpha();
+  std::vector<std::string> names;
+  for (const auto &[name, times] : current) {
+    if (baseline.contains(name)) {
+      names.push_back(name);
+    }
+  }
+  std::ranges::sort(names);
+  for (const auto &name : names) {
+    const auto comparison = ppc::util::ComparePerfSamples(current.at(name), baseline.at(name), threshold, alpha);
+    const std::string p_value = comparison.p_value ? std::format("{:.3g}", *comparison.p_value) : "n/a";
+    const std::string_view tag = comparison.regression ? "[ REGRESSION ]" : "[  BASELINE  ]";
+    std::cout << std::format("{} {}: {:.6g} s against {:.6g} s ({:+.1f}%, p={})", tag, name,
+                             comparison.current_median, comparison.baseline_median, comparison.slowdown * 100.0,
+                             p_value)
+              << '\n';
+    if (comparison.regression) {
+      ppc::util::PerformanceFailureFlag::Set();
     }
   }
-  return false;
+  std::cout << std::format("[  BASELINE  ] {} of {} benchmarks compared with {}", names.size(), current.size(),
+                           baseline_path)
+            << '\n';
+}
+
+int RunAllTests() {
+  const int status = RUN_ALL_TESTS();
+  if (ppc::util::DestructorFailureFlag::Get()) {
+    throw std::runtime_error(
+        std::format("[  ERROR  ] Destructor failed with code {}", ppc::util::DestructorFailureFlag::Get()));
+  }
+  return status;
 }
 
 std::vector<std::string> MakeBenchmarkArgs(const char *program_name, int rank) {
@@ -126,10 +247,89 @@ void InitializeBenchmark(int argc, char **argv, int rank) {
   benchmark::Initialize(&benchmark_argc, benchmark_argv.data());
 }
 
-int RunRegisteredBenchmarks(int rank) {
+/// @brief Records the thread pinning of rank 0 in the benchmark context.
+void AddAffinityContext() {
+  std::string cpus;
+  for (const int cpu : ppc::util::GetAffinityCpus()) {
+    cpus += (cpus.empty() ? "" : ",") + std::to_string(cpu);
+  }
+  const auto policy = ppc::util::AffinityPolicyToString(ppc::util::GetAffinityPolicy());
+  benchmark::AddCustomContext("ppc_affinity", std::string(policy));
+  benchmark::AddCustomContext("ppc_affinity_cpus", cpus.empty() ? "none" : cpus);
+}
+
+/// @brief Records the benchmark clock of rank 0 in the benchmark context; every rank calibrated its own at start-up.
+void AddClockContext() {
+  const auto &clock = ppc::util::GetClockCalibration();
+  benchmark::AddCustomContext("ppc_clock", std::string(ppc::util::ClockSourceToString(clock.source)));
+  benchmark::AddCustomContext("ppc_clock_resolution_ns", std::format("{:.3g}", clock.resolution * 1e9));
+  benchmark::AddCustomContext("ppc_clock_overhead_ns", std::format("{:.3g}", clock.overhead * 1e9));
+}
+
+/// @brief Records the interference probe settings, the quiet reference of rank 0 and its cgroup.
+/// @param cgroup_cpus Effective CPUs of the PPC_PERF_CGROUP cgroup joined at start-up, if any.
+void AddInterferenceContext(const std::optional<std::string> &cgroup_cpus) {
+  const auto mode = ppc::util::GetInterferenceMode();
+  benchmark::AddCustomContext("ppc_interference", std::string(ppc::util::InterferenceModeToString(mode)));
+  if (mode != ppc::util::InterferenceMode::kOff) {
+    benchmark::AddCustomContext("ppc_interference_threshold",
+                                std::format("{:.3g}", ppc::util::GetInterferenceThreshold()));
+    const auto reference = ppc::util::GetInterferenceReference();
+    if (reference) {
+      benchmark::AddCustomContext("ppc_interference_bandwidth", std::format("{:.4g}", reference->bytes_per_second));
+      benchmark::AddCustomContext("ppc_interference_core_rate",
+                                  std::format("{:.4g}", reference->core_steps_per_second));
+    }
+  }
+  if (cgroup_cpus) {
+    benchmark::AddCustomContext("ppc_cgroup", ppc::util::GetPerfCgroup().value_or(""));
+    benchmark::AddCustomContext("ppc_cgroup_cpus", cgroup_cpus->empty() ? "unknown" : *cgroup_cpus);
+  }
+}
+
+/// @brief Probes the roofline peaks of rank 0 for PPC_PERF_ROOFLINE and records them in the benchmark context.
+void AddRooflineContext() {
+  if (!ppc::util::RooflineEnabled()) {
+    return;
+  }
+  const auto &peaks = ppc::util::ProbeMachinePeaks();
+  benchmark::AddCustomContext("ppc_peak_flops_per_second", std::format("{:.4g}", peaks.flops_per_second));
+  benchmark::AddCustomContext("ppc_peak_bytes_per_second", std::format("{:.4g}", peaks.bytes_per_second));
+}
+
+int RunRegisteredBenchmarks(int rank, const std::optional<std::string> &cgroup_cpus) {
   ppc::util::PerformanceFailureFlag::Unset();
+  if (ppc::util::GetInterferenceMode() != ppc::util::InterferenceMode::kOff) {
+    // Seeds the quiet reference of every rank before the first benchmark is compared with it
+    (void)ppc::util::ProbeInterference();
+  }
   if (rank == 0) {
-    benchmark::RunSpecifiedBenchmarks();
+    AddAffinityContext();
+    AddClockContext();
+    AddInterferenceContext(cgroup_cpus);
+    AddRooflineContext();
+    const auto baseline_path = ppc::util::GetPerfBaselinePath();
+    // Loaded before the runs, as PPC_BENCHMARK_OUT may name the same file and is truncated when they start
+    std::optional<ppc::util::PerfSamples> baseline;
+    if (baseline_path) {
+      try {
+        baseline = ppc::util::LoadPerfSamples(*baseline_path);
+      } catch (const std::exception &e) {
+        std::cerr << "[  BASELINE  ] " << e.what() << '\n';
+        ppc::util::PerformanceFailureFlag::Set();
+      }
+    }
+    RecordingConsoleReporter recorder;
+    benchmark::BenchmarkReporter *display_reporter = baseline ? &recorder : nullptr;
+    ScalingJsonReporter file_reporter;
+    if (env::get<std::string>("PPC_BENCHMARK_OUT").has_value()) {
+      benchmark::RunSpecifiedBenchmarks(display_reporter, &file_reporter);
+    } else {
+      benchmark::RunSpecifiedBenchmarks(display_reporter);
+    }
+    if (baseline_path && baseline) {
+      CompareWithBaseline(*baseline_path, *baseline, recorder.Samples());
+    }
   } else {
     NullBenchmarkReporter reporter;
     std::ofstream null_stream;
@@ -186,30 +386,53 @@ int RunPerformanceMain(int argc, char **argv) {
     return init_res;
   }
 
-  tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetNumThreads());
+  // Join the isolated cpuset before topology and affinity read the CPUs this process may use
+  std::optional<std::string> cgroup_cpus;
+  if (const auto cgroup = ppc::util::GetPerfCgroup()) {
+    cgroup_cpus = ppc::util::JoinCgroup(*cgroup, env::get<std::string>("PPC_PERF_CPUSET").value_or(""));
+  }
 
   ::testing::InitGoogleTest(&argc, argv);
 
-  SyncGTestSeed();
-  SyncGTestFilter();
+  ppc::runners::SyncRunnerState();
+  const auto affinity_policy = ppc::runners::ReadAffinityPolicy();
+  const auto thread_budget_mode = ppc::runners::ReadThreadBudgetMode();
+  const int settings_status = SynchronizeStatus(
+      affinity_policy && thread_budget_mode ? EXIT_SUCCESS : EXIT_FAILURE, "PPC_AFFINITY and PPC_THREAD_BUDGET");
+  if (!affinity_policy || !thread_budget_mode || settings_status != EXIT_SUCCESS) {
+    MPI_Finalize();
+    return EXIT_FAILURE;
+  }
+  // Give ranks that share a node a fair slice of its cores; explicit thread sweeps are not limited
+  const ppc::util::ScopedHybridTopology topology(*thread_budget_mode);
+  // Thread sweep benchmarks narrow this limit per run, so allow the largest requested count here
+  int max_threads = ppc::util::GetNumThreads();
+  for (const int num_threads : ppc::util::GetPerfThreadSweep()) {
+    max_threads = std::max(max_threads, num_threads);
+  }
+  tbb::global_control control(tbb::global_control::max_allowed_parallelism, max_threads);
+  const ppc::util::ScopedThreadAffinity affinity(*affinity_policy, max_threads);
+  const ppc::util::ScopedThreadPool thread_pool(max_threads);
+  try {
+    ppc::runners::InstallMpiListeners(argc, argv);
+  } catch (const std::exception &e) {
+    // The settings read here are synced, so every rank fails and finalizes together
+    std::cerr << "[  ERROR  ] " << e.what() << '\n';
+    MPI_Finalize();
+    return EXIT_FAILURE;
+  }
+  // Calibrate before any test so no measured region pays for it
+  (void)ppc::util::GetClockCalibration();
 
   int rank = -1;
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
-  auto &listeners = ::testing::UnitTest::GetInstance()->listeners();
-  const bool print_workers = HasFlag(argc, argv, "--print-workers");
-  if (rank != 0 && !print_workers) {
-    auto *listener = listeners.Release(listeners.default_result_printer());
-    listeners.Append(
-        new ppc::runners::WorkerTestFailurePrinter(std::shared_ptr<::testing::TestEventListener>(listener)));
-  }
-  listeners.Append(new ppc::runners::UnreadMessagesDetector());
-
   int status = SynchronizeStatus(RunAllTestsSafely(), "GTest");
   if (status == EXIT_SUCCESS) {
     InitializeBenchmark(argc, argv, rank);
-    status = SynchronizeStatus(RunRegisteredBenchmarks(rank), "Google Benchmark");
+    status = SynchronizeStatus(RunRegisteredBenchmarks(rank, cgroup_cpus), "Google Benchmark");
   }
+  ppc::util::FlushTrace(rank);
 
   const int finalize_res = MPI_Finalize();
   if (finalize_res != MPI_SUCCESS) {
@@ -1,21 +1,17 @@
 #include <gtest/gtest.h>
 
-#include <stb/stb_image.h>
-
 #include <algorithm>
 #include <array>
-#include <cstddef>
-#include <cstdint>
 #include <numeric>
 #include <stdexcept>
 #include <string>
 #include <tuple>
 #include <utility>
-#include <vector>
 
 #include "example/common/include/common.hpp"
 #include "example/processes/t1/mpi/include/ops_mpi.hpp"
 #include "example/processes/t1/seq/include/ops_seq.hpp"
+#include "util/include/data_loader.hpp"
 #include "util/include/func_test_util.hpp"
 #include "util/include/util.hpp"
 
@@ -38,26 +34,18 @@ class NesterovARunFuncTestsProcesses : public ppc::util::BaseRunFuncTests<InType
   }
 
   void SetInputData() {
-    int width = -1;
-    int height = -1;
-    int channels = -1;
-    std::vector<uint8_t> img;
-    // Read image in RGB to ensure consistent channel count
-    {
-      std::string abs_path = ppc::util::GetAbsoluteTaskPath(PPC_ID_example, "pic.ppm");
-      auto *data = stbi_load(abs_path.c_str(), &width, &height, &channels, STBI_rgb);
-      if (data == nullptr) {
-        throw std::runtime_error("Failed to load image: " + std::string(stbi_failure_reason()));
-      }
-      channels = STBI_rgb;
-      img = std::vector<uint8_t>(data, data + (static_cast<ptrdiff_t>(width * height * channels)));
-      stbi_image_free(data);
-      if (std::cmp_not_equal(width, height)) {
-        throw std::runtime_error("width != height: ");
-      }
+    // Mapped once per process and shared by every test case
+    const auto picture = ppc::util::MapTaskImage(PPC_ID_example, "pic.ppm");
+    const auto &image = picture.image;
+    if (image.channels != 3) {
+      throw std::runtime_error("Expected an RGB image");
+    }
+    if (std::cmp_not_equal(image.width, image.height)) {
+      throw std::runtime_error("width != height: ");
     }
 
-    input_data_ = width - height + std::min(std::accumulate(img.begin(), img.end(), 0), channels);
+    input_data_ = image.width - image.height +
+                  std::min(std::accumulate(image.pixels.begin(), image.pixels.end(), 0), image.channels);
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
@@ -1,9 +1,11 @@
 #include "example/processes/t2/seq/include/ops_seq.hpp"
 
+#include <memory_resource>
 #include <numeric>
 #include <vector>
 
 #include "example/common/include/common.hpp"
+#include "util/include/scratch_arena.hpp"
 #include "util/include/util.hpp"
 
 namespace example_processes_t2 {
@@ -31,7 +33,8 @@ bool NesterovATestTaskSEQ::RunImpl() {
   for (InType i = 0; i < GetInput(); i++) {
     for (InType j = 0; j < GetInput(); j++) {
       for (InType k = 0; k < GetInput(); k++) {
-        std::vector<InType> tmp(i + j + k, 1);
+        const ppc::util::ScratchArena::Scope scratch(GetScratchArena());
+        std::pmr::vector<InType> tmp(i + j + k, 1, scratch.Resource());
         GetOutput() += std::accumulate(tmp.begin(), tmp.end(), 0);
         GetOutput() -= i + j + k;
       }
@@ -2,13 +2,16 @@
 
 #include <mpi.h>
 
-#include <atomic>
+#include <memory_resource>
 #include <numeric>
-#include <thread>
 #include <vector>
 
 #include "example/common/include/common.hpp"
 #include "oneapi/tbb/parallel_for.h"
+#include "util/include/load_balance.hpp"
+#include "util/include/per_thread.hpp"
+#include "util/include/scratch_arena.hpp"
+#include "util/include/thread_pool.hpp"
 #include "util/include/util.hpp"
 
 namespace example_threads {
@@ -32,7 +35,8 @@ bool NesterovATestTaskALL::RunImpl() {
   for (InType i = 0; i < GetInput(); i++) {
     for (InType j = 0; j < GetInput(); j++) {
       for (InType k = 0; k < GetInput(); k++) {
-        std::vector<InType> tmp(i + j + k, 1);
+        const ppc::util::ScratchArena::Scope scratch(GetScratchArena());
+        std::pmr::vector<InType> tmp(i + j + k, 1, scratch.Resource());
         GetOutput() += std::accumulate(tmp.begin(), tmp.end(), 0);
         GetOutput() -= i + j + k;
       }
@@ -41,37 +45,32 @@ bool NesterovATestTaskALL::RunImpl() {
 
   const int num_threads = ppc::util::GetNumThreads();
   {
+    // Every rank runs its own OpenMP team; the hybrid topology keeps the teams of one node within its cores
     GetOutput() *= num_threads;
-
-    int rank = -1;
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-    if (rank == 0) {
-      std::atomic<int> counter(0);
-#pragma omp parallel default(none) shared(counter) num_threads(ppc::util::GetNumThreads())
-      counter++;
-
-      GetOutput() /= counter;
-    } else {
-      GetOutput() /= num_threads;
+    ppc::util::PerThread<int> counter;
+#pragma omp parallel default(none) shared(counter) num_threads(num_threads)
+    {
+      const ppc::util::ScopedBusyTime busy;
+      counter.Local()++;
     }
+    GetOutput() /= counter.Combine();
   }
 
   {
     GetOutput() *= num_threads;
-    std::vector<std::thread> threads(num_threads);
-    std::atomic<int> counter(0);
-    for (std::thread &thread : threads) {
-      thread = std::thread([&counter]() -> void { counter++; });
-      thread.join();
-    }
-    GetOutput() /= counter;
+    ppc::util::PerThread<int> counter;
+    ppc::util::GetThreadPool().ParallelFor(0, num_threads, [&counter](int /*i*/) -> void { counter.Local()++; });
+    GetOutput() /= counter.Combine();
   }
 
   {
     GetOutput() *= num_threads;
-    std::atomic<int> counter(0);
-    tbb::parallel_for(0, ppc::util::GetNumThreads(), [&](int /*i*/) -> void { counter++; });
-    GetOutput() /= counter;
+    ppc::util::PerThread<int> counter;
+    tbb::parallel_for(0, ppc::util::GetNumThreads(), [&](int /*i*/) -> void {
+      const ppc::util::ScopedBusyTime busy;
+      counter.Local()++;
+    });
+    GetOutput() /= counter.Combine();
   }
   MPI_Barrier(MPI_COMM_WORLD);
   return GetOutput() > 0;
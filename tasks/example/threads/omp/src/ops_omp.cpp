@@ -1,10 +1,13 @@
 #include "example/threads/omp/include/ops_omp.hpp"
 
-#include <atomic>
+#include <memory_resource>
 #include <numeric>
 #include <vector>
 
 #include "example/common/include/common.hpp"
+#include "util/include/load_balance.hpp"
+#include "util/include/per_thread.hpp"
+#include "util/include/scratch_arena.hpp"
 #include "util/include/util.hpp"
 
 namespace example_threads {
@@ -28,7 +31,8 @@ bool NesterovATestTaskOMP::RunImpl() {
   for (InType i = 0; i < GetInput(); i++) {
     for (InType j = 0; j < GetInput(); j++) {
       for (InType k = 0; k < GetInput(); k++) {
-        std::vector<InType> tmp(i + j + k, 1);
+        const ppc::util::ScratchArena::Scope scratch(GetScratchArena());
+        std::pmr::vector<InType> tmp(i + j + k, 1, scratch.Resource());
         GetOutput() += std::accumulate(tmp.begin(), tmp.end(), 0);
         GetOutput() -= i + j + k;
       }
@@ -38,11 +42,14 @@ bool NesterovATestTaskOMP::RunImpl() {
   const int num_threads = ppc::util::GetNumThreads();
   GetOutput() *= num_threads;
 
-  std::atomic<int> counter(0);
+  ppc::util::PerThread<int> counter;
 #pragma omp parallel default(none) shared(counter) num_threads(ppc::util::GetNumThreads())
-  counter++;
+  {
+    const ppc::util::ScopedBusyTime busy;
+    counter.Local()++;
+  }
 
-  GetOutput() /= counter;
+  GetOutput() /= counter.Combine();
   return GetOutput() > 0;
 }
 
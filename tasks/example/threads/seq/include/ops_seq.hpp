@@ -2,12 +2,14 @@
 
 #include "example/common/include/common.hpp"
 #include "task/include/task.hpp"
+#include "util/include/roofline.hpp"
 
 namespace example_threads {
 
 class NesterovATestTaskSEQ : public BaseTask<ppc::task::TypeOfTask::kSEQ> {
  public:
   explicit NesterovATestTaskSEQ(const InType &in);
+  static ppc::util::WorkModel EstimateWork(const InType &in);
 
  protected:
   bool ValidationImpl() override;
@@ -1,9 +1,12 @@
 #include "example/threads/seq/include/ops_seq.hpp"
 
+#include <memory_resource>
 #include <numeric>
 #include <vector>
 
 #include "example/common/include/common.hpp"
+#include "util/include/roofline.hpp"
+#include "util/include/scratch_arena.hpp"
 #include "util/include/util.hpp"
 
 namespace example_threads {
@@ -14,6 +17,14 @@ NesterovATestTaskSEQ::NesterovATestTaskSEQ(const InType &in) {
   GetOutput() = 0;
 }
 
+ppc::util::WorkModel NesterovATestTaskSEQ::EstimateWork(const InType &in) {
+  // Run() fills and sums a buffer of i + j + k elements for every (i, j, k); the integer sums are not FLOPs
+  const auto n = static_cast<double>(in);
+  ppc::util::WorkModel work;
+  work.bytes = 3.0 * n * n * n * (n - 1.0) * sizeof(InType);
+  return work;
+}
+
 bool NesterovATestTaskSEQ::ValidationImpl() {
   return (GetInput() > 0) && (GetOutput() == 0);
 }
@@ -31,7 +42,8 @@ bool NesterovATestTaskSEQ::RunImpl() {
   for (InType i = 0; i < GetInput(); i++) {
     for (InType j = 0; j < GetInput(); j++) {
       for (InType k = 0; k < GetInput(); k++) {
-        std::vector<InType> tmp(i + j + k, 1);
+        const ppc::util::ScratchArena::Scope scratch(GetScratchArena());
+        std::pmr::vector<InType> tmp(i + j + k, 1, scratch.Resource());
         GetOutput() += std::accumulate(tmp.begin(), tmp.end(), 0);
         GetOutput() -= i + j + k;
       }
@@ -1,11 +1,13 @@
 #include "example/threads/stl/include/ops_stl.hpp"
 
-#include <atomic>
+#include <memory_resource>
 #include <numeric>
-#include <thread>
 #include <vector>
 
 #include "example/common/include/common.hpp"
+#include "util/include/per_thread.hpp"
+#include "util/include/scratch_arena.hpp"
+#include "util/include/thread_pool.hpp"
 #include "util/include/util.hpp"
 
 namespace example_threads {
@@ -29,7 +31,8 @@ bool NesterovATestTaskSTL::RunImpl() {
   for (InType i = 0; i < GetInput(); i++) {
     for (InType j = 0; j < GetInput(); j++) {
       for (InType k = 0; k < GetInput(); k++) {
-        std::vector<InType> tmp(i + j + k, 1);
+        const ppc::util::ScratchArena::Scope scratch(GetScratchArena());
+        std::pmr::vector<InType> tmp(i + j + k, 1, scratch.Resource());
         GetOutput() += std::accumulate(tmp.begin(), tmp.end(), 0);
         GetOutput() -= i + j + k;
       }
@@ -37,16 +40,12 @@ bool NesterovATestTaskSTL::RunImpl() {
   }
 
   const int num_threads = ppc::util::GetNumThreads();
-  std::vector<std::thread> threads(num_threads);
   GetOutput() *= num_threads;
 
-  std::atomic<int> counter(0);
-  for (std::thread &thread : threads) {
-    thread = std::thread([&counter]() -> void { counter++; });
-    thread.join();
-  }
+  ppc::util::PerThread<int> counter;
+  ppc::util::GetThreadPool().ParallelFor(0, num_threads, [&counter](int /*i*/) -> void { counter.Local()++; });
 
-  GetOutput() /= counter;
+  GetOutput() /= counter.Combine();
   return GetOutput() > 0;
 }
 
@@ -1,14 +1,15 @@
 #include "example/threads/tbb/include/ops_tbb.hpp"
 
-#include <tbb/tbb.h>
-
-#include <atomic>
+#include <memory_resource>
 #include <numeric>
 #include <util/include/util.hpp>
 #include <vector>
 
 #include "example/common/include/common.hpp"
-#include "oneapi/tbb/parallel_for.h"
+#include "util/include/load_balance.hpp"
+#include "util/include/per_thread.hpp"
+#include "util/include/schedule.hpp"
+#include "util/include/scratch_arena.hpp"
 
 namespace example_threads {
 
@@ -31,7 +32,8 @@ bool NesterovATestTaskTBB::RunImpl() {
   for (InType i = 0; i < GetInput(); i++) {
     for (InType j = 0; j < GetInput(); j++) {
       for (InType k = 0; k < GetInput(); k++) {
-        std::vector<InType> tmp(i + j + k, 1);
+        const ppc::util::ScratchArena::Scope scratch(GetScratchArena());
+        std::pmr::vector<InType> tmp(i + j + k, 1, scratch.Resource());
         GetOutput() += std::accumulate(tmp.begin(), tmp.end(), 0);
         GetOutput() -= i + j + k;
       }
@@ -41,10 +43,13 @@ bool NesterovATestTaskTBB::RunImpl() {
   const int num_threads = ppc::util::GetNumThreads();
   GetOutput() *= num_threads;
 
-  std::atomic<int> counter(0);
-  tbb::parallel_for(0, ppc::util::GetNumThreads(), [&](int /*i*/) -> void { counter++; });
+  ppc::util::PerThread<int> counter;
+  ppc::util::TbbParallelFor(0, ppc::util::GetNumThreads(), [&](int /*i*/) -> void {
+    const ppc::util::ScopedBusyTime busy;
+    counter.Local()++;
+  });
 
-  GetOutput() /= counter;
+  GetOutput() /= counter.Combine();
   return GetOutput() > 0;
 }
 
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <cstddef>
 #include <tuple>
+#include <vector>
 
 #include "example/common/include/common.hpp"
 #include "example/threads/all/include/ops_all.hpp"
@@ -9,6 +11,7 @@
 #include "example/threads/stl/include/ops_stl.hpp"
 #include "example/threads/tbb/include/ops_tbb.hpp"
 #include "util/include/perf_test_util.hpp"
+#include "util/include/random.hpp"
 
 namespace example_threads {
 
@@ -26,8 +29,30 @@ class ExampleRunPerfTestThreads : public ppc::util::BaseRunPerfTests<InType, Out
     return input_data_;
   }
 
+  std::vector<InType> GetBatchInputData() final {
+    const ppc::util::CounterRng rng(ppc::util::TestInputSeed());
+    return ppc::util::GenerateUniform<InType>(kBatchSize_, 10, 50, rng);
+  }
+
+  bool CheckBatchOutputData(const std::vector<InType> &inputs, std::vector<OutType> &outputs) final {
+    return inputs == outputs;
+  }
+
+  std::vector<std::size_t> GetInputSizeSweep() final {
+    return ppc::util::InputSizeRange(16, 64);
+  }
+
+  InType GetSizedInputData(std::size_t n) final {
+    return static_cast<InType>(n);
+  }
+
+  bool CheckSizedOutputData(std::size_t n, OutType &output_data) final {
+    return output_data == static_cast<OutType>(n);
+  }
+
  private:
   const int kCount_ = 200;
+  const std::size_t kBatchSize_ = 32;
   InType input_data_{};
 };
 